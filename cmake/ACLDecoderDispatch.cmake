@@ -0,0 +1,56 @@
+cmake_minimum_required (VERSION 3.2)
+
+# The runtime dispatched decoder is compiled once per x86 instruction set, see
+# includes/acl/algorithm/uniformly_sampled/decoder_dispatch.h
+#
+# Usage:
+#    include(ACLDecoderDispatch)
+#    if(ACL_DECODER_DISPATCH_SUPPORTED)
+#        acl_add_decoder_dispatch_library(my_decoder_dispatch)
+#        add_executable(my_target ${MY_SOURCE_FILES} $<TARGET_OBJECTS:my_decoder_dispatch>)
+#    endif()
+
+set(ACL_DECODER_DISPATCH_ROOT_DIR "${CMAKE_CURRENT_LIST_DIR}/..")
+
+if(CMAKE_SYSTEM_PROCESSOR MATCHES "x86|X86|AMD64|amd64|i686")
+	set(ACL_DECODER_DISPATCH_SUPPORTED true)
+else()
+	set(ACL_DECODER_DISPATCH_SUPPORTED false)
+endif()
+
+# Adds an object library with one translation unit per instruction set. It doesn't inherit the
+# instruction set of the targets it is linked into: each unit is compiled with exactly the instruction
+# set it is selected for. Higher instruction sets are explicitly disabled and 'decoder_dispatch_impl.h'
+# fails to compile if they end up enabled anyway.
+function(acl_add_decoder_dispatch_library _target_name)
+	set(_source_dir "${ACL_DECODER_DISPATCH_ROOT_DIR}/sources/acl/algorithm/uniformly_sampled")
+	set(_sse2_file "${_source_dir}/decoder_dispatch_sse2.cpp")
+	set(_sse4_file "${_source_dir}/decoder_dispatch_sse4.cpp")
+	set(_avx_file "${_source_dir}/decoder_dispatch_avx.cpp")
+	set(_avx2_file "${_source_dir}/decoder_dispatch_avx2.cpp")
+
+	add_library(${_target_name} OBJECT ${_sse2_file} ${_sse4_file} ${_avx_file} ${_avx2_file})
+	target_include_directories(${_target_name} PRIVATE "${ACL_DECODER_DISPATCH_ROOT_DIR}/includes")
+
+	if(MSVC)
+		# MSVC has no SSE4 switch, SSE2 is the x64 baseline
+		if(CMAKE_SIZEOF_VOID_P EQUAL 4)
+			set_source_files_properties(${_sse2_file} ${_sse4_file} PROPERTIES COMPILE_FLAGS "/arch:SSE2")
+		endif()
+		set_source_files_properties(${_avx_file} PROPERTIES COMPILE_FLAGS "/arch:AVX")
+		set_source_files_properties(${_avx2_file} PROPERTIES COMPILE_FLAGS "/arch:AVX2")
+
+		target_compile_options(${_target_name} PRIVATE /wd4324)		# structure was padded due to alignment specified
+	else()
+		if(CPU_INSTRUCTION_SET MATCHES "x86")
+			target_compile_options(${_target_name} PRIVATE "-m32")
+		elseif(CPU_INSTRUCTION_SET MATCHES "x64")
+			target_compile_options(${_target_name} PRIVATE "-m64")
+		endif()
+
+		set_source_files_properties(${_sse2_file} PROPERTIES COMPILE_FLAGS "-msse2 -mno-sse3")
+		set_source_files_properties(${_sse4_file} PROPERTIES COMPILE_FLAGS "-msse4.1 -mno-sse4.2")
+		set_source_files_properties(${_avx_file} PROPERTIES COMPILE_FLAGS "-mavx -mno-avx2 -mno-fma")
+		set_source_files_properties(${_avx2_file} PROPERTIES COMPILE_FLAGS "-mavx2 -mno-fma -mno-avx512f")
+	endif()
+endfunction()
@@ -18,7 +18,9 @@ macro(setup_default_compiler_flags _project_name)
 			target_compile_options(${_project_name} PRIVATE /permissive-)
 		endif()
 
-		if(USE_AVX_INSTRUCTIONS)
+		if(USE_AVX2_INSTRUCTIONS)
+			target_compile_options(${_project_name} PRIVATE "/arch:AVX2")
+		elseif(USE_AVX_INSTRUCTIONS)
 			target_compile_options(${_project_name} PRIVATE "/arch:AVX")
 		endif()
 
@@ -35,11 +37,18 @@ macro(setup_default_compiler_flags _project_name)
 		endif()
 
 		if(CPU_INSTRUCTION_SET MATCHES "x86" OR CPU_INSTRUCTION_SET MATCHES "x64")
-			if(USE_AVX_INSTRUCTIONS)
+			if(USE_AVX2_INSTRUCTIONS)
+				target_compile_options(${_project_name} PRIVATE "-mavx2")
+			elseif(USE_AVX_INSTRUCTIONS)
 				target_compile_options(${_project_name} PRIVATE "-mavx")
 			else()
 				target_compile_options(${_project_name} PRIVATE "-msse4.1")
 			endif()
 		endif()
+
+		if(CPU_INSTRUCTION_SET MATCHES "arm64" OR CMAKE_SYSTEM_PROCESSOR MATCHES "aarch64")
+			# Do not fuse multiplications and additions, NEON must round like SSE2
+			target_compile_options(${_project_name} PRIVATE "-ffp-contract=off")
+		endif()
 	endif()
 endmacro()
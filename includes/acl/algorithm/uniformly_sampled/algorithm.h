@@ -31,6 +31,9 @@
 #include "acl/compression/skeleton_error_metric.h"
 #include "acl/decompression/default_output_writer.h"
 
+#include <algorithm>
+#include <new>
+
 namespace acl
 {
 	class UniformlySampledAlgorithm final : public IAlgorithm
@@ -75,6 +78,33 @@ namespace acl
 			uniformly_sampled::decompress_pose(settings, clip, context, sample_time, writer);
 		}
 
+		virtual void decompress_poses(const CompressedClip& clip, void** contexts, const float* sample_times, Transform_32** out_transforms, uint16_t num_transforms, uint32_t num_instances) override
+		{
+			constexpr uint32_t k_max_batch_size = 16;
+
+			uniformly_sampled::DecompressionSettings settings;
+			// Our writers have no default constructor, they are constructed in place for every batch
+			alignas(DefaultOutputWriter) uint8_t writers_buffer[sizeof(DefaultOutputWriter) * k_max_batch_size];
+			DefaultOutputWriter* writers = safe_ptr_cast<DefaultOutputWriter>(&writers_buffer[0]);
+			uniformly_sampled::DecompressionInstance<DefaultOutputWriter> instances[k_max_batch_size];
+
+			for (uint32_t batch_start = 0; batch_start < num_instances; batch_start += k_max_batch_size)
+			{
+				const uint32_t batch_size = std::min(num_instances - batch_start, k_max_batch_size);
+
+				for (uint32_t batch_index = 0; batch_index < batch_size; ++batch_index)
+				{
+					const uint32_t instance_index = batch_start + batch_index;
+					new(&writers[batch_index]) DefaultOutputWriter(out_transforms[instance_index], num_transforms);
+					instances[batch_index].context = contexts[instance_index];
+					instances[batch_index].sample_time = sample_times[instance_index];
+					instances[batch_index].writer = &writers[batch_index];
+				}
+
+				uniformly_sampled::decompress_poses(settings, clip, instances, batch_size);
+			}
+		}
+
 		virtual void decompress_bone(const CompressedClip& clip, void* context, float sample_time, uint16_t sample_bone_index, Quat_32* out_rotation, Vector4_32* out_translation, Vector4_32* out_scale) override
 		{
 			uniformly_sampled::DecompressionSettings settings;
@@ -25,6 +25,7 @@
 ////////////////////////////////////////////////////////////////////////////////
 
 #include "acl/core/bitset.h"
+#include "acl/core/clip_database.h"
 #include "acl/core/compressed_clip.h"
 #include "acl/core/iallocator.h"
 #include "acl/core/range_reduction_types.h"
@@ -33,8 +34,12 @@
 #include "acl/math/vector4_32.h"
 #include "acl/math/quat_packing.h"
 #include "acl/decompression/decompress_data.h"
+#include "acl/decompression/decompress_data_soa.h"
+#include "acl/decompression/memory_access_recorder.h"
 #include "acl/decompression/output_writer.h"
+#include "acl/decompression/segment_streamer.h"
 
+#include <algorithm>
 #include <cstdint>
 
 //////////////////////////////////////////////////////////////////////////
@@ -62,13 +67,66 @@ namespace acl
 		// For the track id method to be more compact, an unreasonable small number of tracks would need to be
 		// animated or constant compared to the total possible number of tracks. Those are likely to be rare.
 
+		//////////////////////////////////////////////////////////////////////////
+		// An optional index of where every bone's tracks start within the compressed data.
+		// It allows 'decompress_bone' to seek directly to the requested bone instead of
+		// skipping every bone that precedes it.
+		// It is built once per compressed clip with 'allocate_track_offset_index' and can be
+		// shared by every decompression context that plays back that clip.
+		//////////////////////////////////////////////////////////////////////////
+		struct TrackOffsetIndex
+		{
+			// Offsets of the first track of a bone, they are identical in every segment
+			struct BoneOffsets
+			{
+				uint32_t constant_track_data_offset;
+				uint32_t clip_range_data_offset;
+				uint32_t format_per_track_data_offset;
+				uint32_t segment_range_data_offset;
+			};
+
+			uint32_t size;
+			uint32_t clip_hash;
+			uint16_t num_bones;
+			uint16_t num_segments;
+			uint32_t padding;
+
+			// Followed in memory by:
+			//    BoneOffsets bone_offsets[num_bones]
+			//    uint32_t bone_bit_offsets[num_segments][num_bones]		// Bit offset of a bone's animated data within a pose
+
+			const BoneOffsets* get_bone_offsets() const { return add_offset_to_ptr<const BoneOffsets>(this, sizeof(TrackOffsetIndex)); }
+			BoneOffsets* get_bone_offsets() { return add_offset_to_ptr<BoneOffsets>(this, sizeof(TrackOffsetIndex)); }
+
+			const uint32_t* get_segment_bone_bit_offsets(uint32_t segment_index) const { return add_offset_to_ptr<const uint32_t>(get_bone_offsets(), (sizeof(BoneOffsets) + (sizeof(uint32_t) * segment_index)) * num_bones); }
+			uint32_t* get_segment_bone_bit_offsets(uint32_t segment_index) { return add_offset_to_ptr<uint32_t>(get_bone_offsets(), (sizeof(BoneOffsets) + (sizeof(uint32_t) * segment_index)) * num_bones); }
+		};
+
+		//////////////////////////////////////////////////////////////////////////
+		// Returns the size in bytes of the track offset index for the provided clip
+		inline uint32_t get_track_offset_index_size(const ClipHeader& header)
+		{
+			return sizeof(TrackOffsetIndex) + ((sizeof(TrackOffsetIndex::BoneOffsets) + (sizeof(uint32_t) * header.num_segments)) * header.num_bones);
+		}
+
 		namespace impl
 		{
 			constexpr size_t k_cache_line_size = 64;
 
-			struct alignas(k_cache_line_size) DecompressionContext
+			// Optional key frame cache, holds the animated samples of the last two key frames decompressed, one per track.
+			// This header lives at the start of the buffer, the cache slots follow it and are laid out one after the other.
+			struct alignas(16) KeyFrameCacheHeader
+			{
+				uint32_t slots_size;
+				uint32_t cached_key_frames[2];		// Which key frame each slot contains
+				uint32_t padding;
+			};
+
+			inline Vector4_32* get_key_frame_cache_slots(KeyFrameCacheHeader& cache) { return add_offset_to_ptr<Vector4_32>(&cache, sizeof(KeyFrameCacheHeader)); }
+
+			// The read-only state of a clip, it can be shared by every instance playing it back
+			struct alignas(k_cache_line_size) ClipDecompressionContext
 			{
-				// Read-only data
 				const SegmentHeader* segment_headers;
 
 				const uint32_t* constant_tracks_bitset;
@@ -77,16 +135,31 @@ namespace acl
 
 				const uint8_t* clip_range_data;
 
-				const uint8_t* format_per_track_data[2];
-				const uint8_t* segment_range_data[2];
-				const uint8_t* animated_track_data[2];
+				const TrackOffsetIndex* track_offset_index;
+
+				ISegmentStreamer* segment_streamer;
 
 				BitSetDescription bitset_desc;
+				uint8_t key_frame_block_size;
 				uint8_t num_rotation_components;
 
-				float clip_duration;
-
 				bool has_mixed_packing;
+				bool is_shared;
+			};
+
+			// The working state of a decompression call, it is built on the stack from the state that persists
+			// between calls: the clip state and the instance state
+			struct alignas(k_cache_line_size) DecompressionContext
+			{
+				// Read-only data, lives in its own context to be shared between instances
+				const ClipDecompressionContext* clip;
+
+				const uint8_t* format_per_track_data[2];
+				const uint8_t* segment_range_data[2];
+				const uint8_t* animated_track_data[2];
+
+				// Optional key frame cache, see KeyFrameCacheHeader
+				KeyFrameCacheHeader* key_frame_cache;
 
 				// Read-write data
 				alignas(k_cache_line_size) uint32_t constant_track_offset;
@@ -100,9 +173,53 @@ namespace acl
 				uint32_t key_frame_byte_offsets[2];
 				int32_t key_frame_bit_offsets[2];
 
+				// The key frame offsets point to the start of the current track in its block of key frames,
+				// every track stores the samples of the block contiguously
+				uint8_t key_frame_block_sample_indices[2];
+				uint8_t key_frame_block_num_samples[2];
+
+				float interpolation_alpha;
+
+				// Seek cache, persists between calls to speed up sequential playback
+				float sample_time;
+				uint32_t key_frames[2];
+				uint16_t segment_indices[2];
+
+				// Where the data of both segments starts, the segment data pointers above are derived from it
+				alignas(k_cache_line_size) const uint8_t* segment_data[2];
+			};
+
+			// The part of a decompression context that persists between calls and differs for every instance
+			// playing back a clip. The rest is either read-only or reset by every seek.
+			struct InstanceDecompressionContext
+			{
+				const uint8_t* segment_data[2];
+
 				float interpolation_alpha;
+				float sample_time;
+				uint32_t key_frames[2];
+				uint16_t segment_indices[2];
+			};
+
+			// What 'allocate_decompression_context' returns, the clip state along with the state of a single instance
+			struct StandaloneDecompressionContext
+			{
+				ClipDecompressionContext clip;
+				InstanceDecompressionContext instance;
+
+				// Optional key frame cache, see KeyFrameCacheHeader
+				KeyFrameCacheHeader* key_frame_cache;
 			};
 
+			static_assert(sizeof(ClipDecompressionContext) == k_cache_line_size, "The clip context should fit in a single cache line");
+			static_assert(sizeof(StandaloneDecompressionContext) <= k_cache_line_size * 2, "The standalone context should fit in two cache lines");
+
+			constexpr uint16_t k_invalid_segment_index = 0xFFFF;
+			constexpr uint32_t k_invalid_key_frame = 0xFFFFFFFF;
+
+			// How many instances 'decompress_poses' decompresses together, each needs a working context on the stack
+			constexpr uint32_t k_max_num_batched_instances = 16;
+
 			// We use adapters to wrap the DecompressionSettings
 			// This allows us to re-use the code for skipping and decompressing Vector3 samples
 			// Code generation will generate specialized code for each specialization
@@ -120,6 +237,8 @@ namespace acl
 				constexpr RangeReductionFlags8 get_clip_range_reduction(RangeReductionFlags8 flags) const { return settings.get_clip_range_reduction(flags); }
 				constexpr RangeReductionFlags8 get_segment_range_reduction(RangeReductionFlags8 flags) const { return settings.get_segment_range_reduction(flags); }
 				constexpr bool supports_mixed_packing() const { return settings.supports_mixed_packing(); }
+				constexpr bool is_memory_access_recorded() const { return settings.is_memory_access_recorded(); }
+				void record_memory_access(CompressedDataSection8 section, const void* data, uint32_t size) const { settings.record_memory_access(section, data, size); }
 
 				SettingsType settings;
 			};
@@ -138,12 +257,22 @@ namespace acl
 				constexpr RangeReductionFlags8 get_clip_range_reduction(RangeReductionFlags8 flags) const { return settings.get_clip_range_reduction(flags); }
 				constexpr RangeReductionFlags8 get_segment_range_reduction(RangeReductionFlags8 flags) const { return settings.get_segment_range_reduction(flags); }
 				constexpr bool supports_mixed_packing() const { return settings.supports_mixed_packing(); }
+				constexpr bool is_memory_access_recorded() const { return settings.is_memory_access_recorded(); }
+				void record_memory_access(CompressedDataSection8 section, const void* data, uint32_t size) const { settings.record_memory_access(section, data, size); }
 
 				SettingsType settings;
 			};
 
+			// A clip that lives in a clip database doesn't contain its bitsets and constant track data,
+			// the database owns them and they can only be found with the database overloads
+			inline bool is_clip_in_database(const ClipHeader& header)
+			{
+				return !header.default_tracks_bitset_offset.is_valid();
+			}
+
+			// The bitsets and the constant track data can live outside of the compressed clip when it is part of a clip database
 			template<class SettingsType>
-			inline void initialize_context(const SettingsType& settings, const ClipHeader& header, DecompressionContext& context)
+			inline void initialize_clip_decompression_context(const SettingsType& settings, const ClipHeader& header, const uint32_t* default_tracks_bitset, const uint32_t* constant_tracks_bitset, const uint8_t* constant_track_data, ClipDecompressionContext& context)
 			{
 				const RotationFormat8 rotation_format = settings.get_rotation_format(header.rotation_format);
 				const VectorFormat8 translation_format = settings.get_translation_format(header.translation_format);
@@ -177,23 +306,19 @@ namespace acl
 				}
 #endif
 
-				context.clip_duration = float(header.num_samples - 1) / float(header.sample_rate);
 				context.segment_headers = header.get_segment_headers();
-				context.default_tracks_bitset = header.get_default_tracks_bitset();
+				context.default_tracks_bitset = default_tracks_bitset;
 
-				context.constant_tracks_bitset = header.get_constant_tracks_bitset();
-				context.constant_track_data = header.get_constant_track_data();
+				context.constant_tracks_bitset = constant_tracks_bitset;
+				context.constant_track_data = constant_track_data;
 				context.clip_range_data = header.get_clip_range_data();
 
-				for (uint8_t key_frame_index = 0; key_frame_index < 2; ++key_frame_index)
-				{
-					context.format_per_track_data[key_frame_index] = nullptr;
-					context.segment_range_data[key_frame_index] = nullptr;
-					context.animated_track_data[key_frame_index] = nullptr;
-				}
+				context.track_offset_index = nullptr;
+				context.segment_streamer = nullptr;
 
 				const uint32_t num_tracks_per_bone = header.has_scale ? 3 : 2;
 				context.bitset_desc = BitSetDescription::make_from_num_bits(header.num_bones * num_tracks_per_bone);
+				context.key_frame_block_size = header.key_frame_block_size;
 				context.num_rotation_components = rotation_format == RotationFormat8::Quat_128 ? 4 : 3;
 
 				// If all tracks are variable, no need for any extra padding except at the very end of the data
@@ -201,6 +326,22 @@ namespace acl
 				const bool is_every_format_variable = is_rotation_format_variable(rotation_format) && is_vector_format_variable(translation_format) && is_vector_format_variable(scale_format);
 				const bool is_any_format_variable = is_rotation_format_variable(rotation_format) || is_vector_format_variable(translation_format) || is_vector_format_variable(scale_format);
 				context.has_mixed_packing = !is_every_format_variable && is_any_format_variable;
+				context.is_shared = false;
+			}
+
+			// Resets the playback state of a context that reads the provided clip state
+			inline void reset_context(const ClipDecompressionContext& clip_context, DecompressionContext& context)
+			{
+				context.clip = &clip_context;
+
+				for (uint8_t key_frame_index = 0; key_frame_index < 2; ++key_frame_index)
+				{
+					context.format_per_track_data[key_frame_index] = nullptr;
+					context.segment_range_data[key_frame_index] = nullptr;
+					context.animated_track_data[key_frame_index] = nullptr;
+				}
+
+				context.key_frame_cache = nullptr;
 
 				context.constant_track_offset = 0;
 				context.constant_track_data_offset = 0;
@@ -208,6 +349,187 @@ namespace acl
 				context.clip_range_data_offset = 0;
 				context.format_per_track_data_offset = 0;
 				context.segment_range_data_offset = 0;
+
+				for (uint8_t key_frame_index = 0; key_frame_index < 2; ++key_frame_index)
+				{
+					context.key_frame_byte_offsets[key_frame_index] = 0;
+					context.key_frame_bit_offsets[key_frame_index] = 0;
+					context.key_frame_block_sample_indices[key_frame_index] = 0;
+					context.key_frame_block_num_samples[key_frame_index] = 1;
+					context.segment_data[key_frame_index] = nullptr;
+				}
+
+				context.interpolation_alpha = 0.0f;
+				context.sample_time = 0.0f;
+				context.key_frames[0] = context.key_frames[1] = 0;
+				context.segment_indices[0] = context.segment_indices[1] = k_invalid_segment_index;
+			}
+
+			inline void reset_instance_context(InstanceDecompressionContext& context)
+			{
+				context.segment_data[0] = context.segment_data[1] = nullptr;
+				context.interpolation_alpha = 0.0f;
+				context.sample_time = 0.0f;
+				context.key_frames[0] = context.key_frames[1] = 0;
+				context.segment_indices[0] = context.segment_indices[1] = k_invalid_segment_index;
+			}
+
+			template<class SettingsType>
+			inline void initialize_context(const SettingsType& settings, const ClipHeader& header, const uint32_t* default_tracks_bitset, const uint32_t* constant_tracks_bitset, const uint8_t* constant_track_data, StandaloneDecompressionContext& context)
+			{
+				initialize_clip_decompression_context(settings, header, default_tracks_bitset, constant_tracks_bitset, constant_track_data, context.clip);
+				reset_instance_context(context.instance);
+				context.key_frame_cache = nullptr;
+			}
+
+			template<class SettingsType>
+			inline void initialize_context(const SettingsType& settings, const ClipHeader& header, StandaloneDecompressionContext& context)
+			{
+				initialize_context(settings, header, header.get_default_tracks_bitset(), header.get_constant_tracks_bitset(), header.get_constant_track_data(), context);
+			}
+
+			// Builds a decompression context on the stack from the state that persists between calls.
+			// Everything else is reset by 'seek' before it is read.
+			inline void load_context(const ClipDecompressionContext& clip_context, const InstanceDecompressionContext& instance_context, KeyFrameCacheHeader* key_frame_cache, DecompressionContext& context)
+			{
+				context.clip = &clip_context;
+				context.key_frame_cache = key_frame_cache;
+
+				for (uint8_t key_frame_index = 0; key_frame_index < 2; ++key_frame_index)
+				{
+					context.segment_data[key_frame_index] = instance_context.segment_data[key_frame_index];
+					context.key_frames[key_frame_index] = instance_context.key_frames[key_frame_index];
+					context.segment_indices[key_frame_index] = instance_context.segment_indices[key_frame_index];
+				}
+
+				context.interpolation_alpha = instance_context.interpolation_alpha;
+				context.sample_time = instance_context.sample_time;
+			}
+
+			inline void store_context(const DecompressionContext& context, InstanceDecompressionContext& instance_context)
+			{
+				for (uint8_t key_frame_index = 0; key_frame_index < 2; ++key_frame_index)
+				{
+					instance_context.segment_data[key_frame_index] = context.segment_data[key_frame_index];
+					instance_context.key_frames[key_frame_index] = context.key_frames[key_frame_index];
+					instance_context.segment_indices[key_frame_index] = context.segment_indices[key_frame_index];
+				}
+
+				instance_context.interpolation_alpha = context.interpolation_alpha;
+				instance_context.sample_time = context.sample_time;
+			}
+
+			inline void load_standalone_context(const void* opaque_context, DecompressionContext& context)
+			{
+				const StandaloneDecompressionContext& standalone_context = *safe_ptr_cast<const StandaloneDecompressionContext>(opaque_context);
+				ACL_ASSERT(!standalone_context.clip.is_shared, "Expected a standalone decompression context");
+
+				load_context(standalone_context.clip, standalone_context.instance, standalone_context.key_frame_cache, context);
+			}
+
+			inline void store_standalone_context(const DecompressionContext& context, void* opaque_context)
+			{
+				store_context(context, safe_ptr_cast<StandaloneDecompressionContext>(opaque_context)->instance);
+			}
+
+			inline float get_clip_duration(const ClipHeader& header)
+			{
+				return float(header.num_samples - 1) / float(header.sample_rate);
+			}
+
+			inline bool is_key_frame_in_segment(const SegmentHeader& segment_header, uint32_t key_frame)
+			{
+				return key_frame >= segment_header.clip_sample_offset && key_frame < segment_header.clip_sample_offset + segment_header.num_samples;
+			}
+
+			inline uint16_t find_segment_index(const ClipHeader& header, const DecompressionContext& context, uint32_t key_frame)
+			{
+				// Playback is usually sequential, try the last segment used and its neighbors first
+				const uint16_t cached_segment_index = context.segment_indices[0];
+				if (cached_segment_index != k_invalid_segment_index)
+				{
+					if (is_key_frame_in_segment(context.clip->segment_headers[cached_segment_index], key_frame))
+						return cached_segment_index;
+
+					if (cached_segment_index + 1 < header.num_segments && is_key_frame_in_segment(context.clip->segment_headers[cached_segment_index + 1], key_frame))
+						return cached_segment_index + 1;
+
+					if (cached_segment_index > 0 && is_key_frame_in_segment(context.clip->segment_headers[cached_segment_index - 1], key_frame))
+						return cached_segment_index - 1;
+				}
+
+				// Binary search for the last segment that starts at or before our key frame
+				uint16_t first_segment_index = 0;
+				uint16_t num_segments_left = header.num_segments;
+				while (num_segments_left > 0)
+				{
+					const uint16_t half_num_segments = num_segments_left / 2;
+					const uint16_t middle_segment_index = first_segment_index + half_num_segments;
+
+					if (context.clip->segment_headers[middle_segment_index].clip_sample_offset <= key_frame)
+					{
+						first_segment_index = middle_segment_index + 1;
+						num_segments_left -= half_num_segments + 1;
+					}
+					else
+						num_segments_left = half_num_segments;
+				}
+
+				ACL_ENSURE(first_segment_index > 0, "Failed to find segment.");
+
+				const uint16_t segment_index = first_segment_index - 1;
+				ACL_ENSURE(is_key_frame_in_segment(context.clip->segment_headers[segment_index], key_frame), "Failed to find segment.");
+				return segment_index;
+			}
+
+			inline const uint8_t* get_streamed_segment_data(const uint8_t* segment_data, uint32_t segment_data_offset, PtrOffset32<uint8_t> offset)
+			{
+				return offset.is_valid() ? (segment_data + (uint32_t(offset) - segment_data_offset)) : nullptr;
+			}
+
+			inline const uint8_t* get_resident_segment_data(uint16_t segment_index, const DecompressionContext& context)
+			{
+				// Nothing is animated, there is nothing to stream
+				const SegmentHeader& segment_header = context.clip->segment_headers[segment_index];
+				if (!acl::impl::get_segment_data_header_offset(segment_header).is_valid())
+					return nullptr;
+
+				const uint8_t* segment_data = context.clip->segment_streamer->get_segment_data(segment_index);
+				ACL_ENSURE(segment_data != nullptr, "Segment %u isn't resident", segment_index);
+				return segment_data;
+			}
+
+			// Our segment offsets are relative to the clip header, rebase them on the streamed segment data
+			inline void set_streamed_segment_data(const SegmentHeader& segment_header, uint8_t key_frame_index, DecompressionContext& context)
+			{
+				const uint8_t* segment_data = context.segment_data[key_frame_index];
+				const PtrOffset32<uint8_t> segment_data_offset = acl::impl::get_segment_data_header_offset(segment_header);
+
+				context.format_per_track_data[key_frame_index] = get_streamed_segment_data(segment_data, segment_data_offset, segment_header.format_per_track_data_offset);
+				context.segment_range_data[key_frame_index] = get_streamed_segment_data(segment_data, segment_data_offset, segment_header.range_data_offset);
+				context.animated_track_data[key_frame_index] = get_streamed_segment_data(segment_data, segment_data_offset, segment_header.track_data_offset);
+			}
+
+			// Points the animated data offsets of a key frame to the start of a bone in the block of key frames that contains it
+			inline void set_key_frame_offsets(const SegmentHeader& segment_header, uint32_t segment_key_frame, uint32_t bone_bit_offset, uint8_t key_frame_index, DecompressionContext& context)
+			{
+				// Whole poses are the common case, avoid the division
+				uint32_t block_sample_index = 0;
+				uint32_t block_num_samples = 1;
+				if (context.clip->key_frame_block_size != 1)
+				{
+					block_sample_index = segment_key_frame % context.clip->key_frame_block_size;
+					const uint32_t num_samples_left = segment_header.num_samples - (segment_key_frame - block_sample_index);
+					block_num_samples = num_samples_left < context.clip->key_frame_block_size ? num_samples_left : context.clip->key_frame_block_size;
+				}
+
+				const uint32_t block_key_frame = segment_key_frame - block_sample_index;
+				const uint32_t bit_offset = (block_key_frame * segment_header.animated_pose_bit_size) + (block_num_samples * bone_bit_offset);
+
+				context.key_frame_byte_offsets[key_frame_index] = bit_offset / 8;
+				context.key_frame_bit_offsets[key_frame_index] = int32_t(bit_offset);
+				context.key_frame_block_sample_indices[key_frame_index] = uint8_t(block_sample_index);
+				context.key_frame_block_num_samples[key_frame_index] = uint8_t(block_num_samples);
 			}
 
 			template<class SettingsType>
@@ -220,59 +542,256 @@ namespace acl
 				context.format_per_track_data_offset = 0;
 				context.segment_range_data_offset = 0;
 
-				uint32_t key_frame0;
-				uint32_t key_frame1;
-				calculate_interpolation_keys(header.num_samples, context.clip_duration, sample_time, key_frame0, key_frame1, context.interpolation_alpha);
+				// Seeking to the same sample time again reuses the key frames and interpolation alpha we already have
+				if (sample_time != context.sample_time || context.segment_indices[0] == k_invalid_segment_index)
+				{
+					calculate_interpolation_keys(header.num_samples, get_clip_duration(header), sample_time, context.key_frames[0], context.key_frames[1], context.interpolation_alpha);
+					context.sample_time = sample_time;
+				}
 
-				uint32_t segment_key_frame0 = 0;
-				uint32_t segment_key_frame1 = 0;
+				const uint32_t key_frame0 = context.key_frames[0];
+				const uint32_t key_frame1 = context.key_frames[1];
 
-				// Find segments
-				// TODO: Use binary search?
-				uint32_t segment_key_frame = 0;
-				const SegmentHeader* segment_header0 = nullptr;
-				const SegmentHeader* segment_header1 = nullptr;
-				for (uint16_t segment_index = 0; segment_index < header.num_segments; ++segment_index)
+				const uint16_t segment_index0 = find_segment_index(header, context, key_frame0);
+				const SegmentHeader* segment_header0 = &context.clip->segment_headers[segment_index0];
+
+				uint16_t segment_index1 = segment_index0;
+				if (!is_key_frame_in_segment(*segment_header0, key_frame1))
+				{
+					segment_index1 = segment_index0 + 1;
+					ACL_ENSURE(segment_index1 < header.num_segments, "Invalid segment index: %u", segment_index1);
+				}
+
+				const SegmentHeader* segment_header1 = &context.clip->segment_headers[segment_index1];
+
+				if (settings.is_memory_access_recorded())
 				{
-					const SegmentHeader& segment_header = context.segment_headers[segment_index];
+					settings.record_memory_access(CompressedDataSection8::ClipHeader, &header, sizeof(ClipHeader));
+					settings.record_memory_access(CompressedDataSection8::SegmentHeaders, segment_header0, sizeof(SegmentHeader));
+					if (segment_index1 != segment_index0)
+						settings.record_memory_access(CompressedDataSection8::SegmentHeaders, segment_header1, sizeof(SegmentHeader));
+				}
 
-					if (key_frame0 >= segment_key_frame && key_frame0 < segment_key_frame + segment_header.num_samples)
+				if (context.clip->segment_streamer != nullptr)
+				{
+					// Streamed segments are only requested when we cross a segment boundary
+					if (segment_index0 != context.segment_indices[0] || segment_index1 != context.segment_indices[1])
 					{
-						segment_header0 = &segment_header;
-						segment_key_frame0 = key_frame0 - segment_key_frame;
+						context.segment_data[0] = get_resident_segment_data(segment_index0, context);
+						context.segment_data[1] = segment_index1 != segment_index0 ? get_resident_segment_data(segment_index1, context) : context.segment_data[0];
 
-						if (key_frame1 >= segment_key_frame && key_frame1 < segment_key_frame + segment_header.num_samples)
+						// Give the streamer a whole segment worth of playback to bring in the next one
+						const bool is_playing_backward = context.segment_indices[0] != k_invalid_segment_index && segment_index0 < context.segment_indices[0];
+						if (is_playing_backward)
 						{
-							segment_header1 = &segment_header;
-							segment_key_frame1 = key_frame1 - segment_key_frame;
+							if (segment_index0 > 0)
+								context.clip->segment_streamer->prefetch_segment(uint16_t(segment_index0 - 1));
 						}
+						else if (segment_index1 + 1 < header.num_segments)
+							context.clip->segment_streamer->prefetch_segment(uint16_t(segment_index1 + 1));
+					}
+
+					set_streamed_segment_data(*segment_header0, 0, context);
+					set_streamed_segment_data(*segment_header1, 1, context);
+				}
+				else
+				{
+					context.format_per_track_data[0] = header.get_format_per_track_data(*segment_header0);
+					context.format_per_track_data[1] = header.get_format_per_track_data(*segment_header1);
+					context.segment_range_data[0] = header.get_segment_range_data(*segment_header0);
+					context.segment_range_data[1] = header.get_segment_range_data(*segment_header1);
+					context.animated_track_data[0] = header.get_track_data(*segment_header0);
+					context.animated_track_data[1] = header.get_track_data(*segment_header1);
+				}
+
+				context.segment_indices[0] = segment_index0;
+				context.segment_indices[1] = segment_index1;
+
+				const uint32_t segment_key_frame0 = key_frame0 - segment_header0->clip_sample_offset;
+				const uint32_t segment_key_frame1 = key_frame1 - segment_header1->clip_sample_offset;
+
+				set_key_frame_offsets(*segment_header0, segment_key_frame0, 0, 0, context);
+				set_key_frame_offsets(*segment_header1, segment_key_frame1, 0, 1, context);
+			}
+
+			inline void seek_to_bone(const ClipHeader& header, uint32_t bone_index, DecompressionContext& context)
+			{
+				const TrackOffsetIndex& index = *context.clip->track_offset_index;
+				const TrackOffsetIndex::BoneOffsets& bone_offsets = index.get_bone_offsets()[bone_index];
+
+				const uint32_t num_tracks_per_bone = header.has_scale ? 3 : 2;
+				context.default_track_offset = bone_index * num_tracks_per_bone;
+				context.constant_track_offset = bone_index * num_tracks_per_bone;
+				context.constant_track_data_offset = bone_offsets.constant_track_data_offset;
+				context.clip_range_data_offset = bone_offsets.clip_range_data_offset;
+				context.format_per_track_data_offset = bone_offsets.format_per_track_data_offset;
+				context.segment_range_data_offset = bone_offsets.segment_range_data_offset;
+
+				for (uint8_t key_frame_index = 0; key_frame_index < 2; ++key_frame_index)
+				{
+					const uint16_t segment_index = context.segment_indices[key_frame_index];
+					const SegmentHeader& segment_header = context.clip->segment_headers[segment_index];
+					const uint32_t segment_key_frame = context.key_frames[key_frame_index] - segment_header.clip_sample_offset;
+					const uint32_t bone_bit_offset = index.get_segment_bone_bit_offsets(segment_index)[bone_index];
+
+					set_key_frame_offsets(segment_header, segment_key_frame, bone_bit_offset, key_frame_index, context);
+				}
+			}
+
+			// Bit set words are read from the most significant bit, these select every third bit starting with the first, second, and third bit of a word
+			constexpr uint32_t k_every_third_bit_masks[3] = { 0x92492492, 0x49249249, 0x24924924 };
+
+			// Counts the constant and animated tracks of each type in a range of whole bones, one bit set word at a time.
+			// The range starts on a bone boundary which lets us find the type of a track from its offset alone.
+			template<class SettingsType>
+			inline void count_constant_and_animated_tracks(const SettingsType& settings, const DecompressionContext& context, uint32_t first_track_offset, uint32_t num_tracks, uint32_t num_tracks_per_bone, uint32_t* out_num_constant_tracks, uint32_t* out_num_animated_tracks)
+			{
+				if (num_tracks == 0)
+					return;
+
+				const uint32_t end_track_offset = first_track_offset + num_tracks;
+				const uint32_t first_word_index = first_track_offset / 32;
+				const uint32_t last_word_index = (end_track_offset - 1) / 32;
+
+				if (settings.is_memory_access_recorded())
+				{
+					const uint32_t num_bytes = (last_word_index - first_word_index + 1) * sizeof(uint32_t);
+					settings.record_memory_access(CompressedDataSection8::DefaultTracksBitset, context.clip->default_tracks_bitset + first_word_index, num_bytes);
+					settings.record_memory_access(CompressedDataSection8::ConstantTracksBitset, context.clip->constant_tracks_bitset + first_word_index, num_bytes);
+				}
+
+				uint32_t num_default_tracks[3] = { 0, 0, 0 };
+				uint32_t num_constant_tracks[3] = { 0, 0, 0 };
+
+				for (uint32_t word_index = first_word_index; word_index <= last_word_index; ++word_index)
+				{
+					const uint32_t word_track_offset = word_index * 32;
+					const uint32_t first_bit_index = first_track_offset > word_track_offset ? first_track_offset - word_track_offset : 0;
+					const uint32_t end_bit_index = end_track_offset < word_track_offset + 32 ? end_track_offset - word_track_offset : 32;
+					const uint32_t range_mask = (0xFFFFFFFF >> first_bit_index) & (0xFFFFFFFF << (32 - end_bit_index));
+
+					const uint32_t default_tracks = context.clip->default_tracks_bitset[word_index] & range_mask;
+					const uint32_t constant_tracks = context.clip->constant_tracks_bitset[word_index] & ~default_tracks & range_mask;
+
+					for (uint32_t track_type = 0; track_type < num_tracks_per_bone; ++track_type)
+					{
+						uint32_t track_type_mask;
+						if (num_tracks_per_bone == 2)
+							track_type_mask = track_type == 0 ? 0xAAAAAAAA : 0x55555555;
 						else
-						{
-							ACL_ENSURE(segment_index + 1 < header.num_segments, "Invalid segment index: %u", segment_index + 1);
-							const SegmentHeader& next_segment_header = context.segment_headers[segment_index + 1];
-							segment_header1 = &next_segment_header;
-							segment_key_frame1 = key_frame1 - (segment_key_frame + segment_header.num_samples);
-						}
+							track_type_mask = k_every_third_bit_masks[(track_type + 3 - (word_track_offset % 3)) % 3];
 
-						break;
+						num_default_tracks[track_type] += count_set_bits(default_tracks & track_type_mask);
+						num_constant_tracks[track_type] += count_set_bits(constant_tracks & track_type_mask);
 					}
+				}
 
-					segment_key_frame += segment_header.num_samples;
+				// Every bone has one track of each type
+				const uint32_t num_bones = num_tracks / num_tracks_per_bone;
+				for (uint32_t track_type = 0; track_type < num_tracks_per_bone; ++track_type)
+				{
+					out_num_constant_tracks[track_type] += num_constant_tracks[track_type];
+					out_num_animated_tracks[track_type] += num_bones - num_default_tracks[track_type] - num_constant_tracks[track_type];
 				}
+			}
+
+			// Skips every track of the next bones at once, only the bitsets and the variable bit rates are read
+			template<class SettingsType>
+			inline void skip_bones(const SettingsType& settings, const ClipHeader& header, uint32_t num_bones_to_skip, DecompressionContext& context)
+			{
+				const TranslationDecompressionSettingsAdapter<SettingsType> translation_adapter(settings);
+				const ScaleDecompressionSettingsAdapter<SettingsType> scale_adapter(settings);
+
+				const RotationFormat8 rotation_format = settings.get_rotation_format(header.rotation_format);
+				const VectorFormat8 translation_format = translation_adapter.get_vector_format(header);
+				const VectorFormat8 scale_format = scale_adapter.get_vector_format(header);
+				const RangeReductionFlags8 clip_range_reduction = settings.get_clip_range_reduction(header.clip_range_reduction);
+				const RangeReductionFlags8 segment_range_reduction = settings.get_segment_range_reduction(header.segment_range_reduction);
+
+				// Count how many tracks of each type we skip: rotation, translation, and scale
+				const uint32_t num_tracks_per_bone = header.has_scale ? 3 : 2;
+				const uint32_t num_tracks_to_skip = num_bones_to_skip * num_tracks_per_bone;
+				uint32_t num_constant_tracks[3] = { 0, 0, 0 };
+				uint32_t num_animated_tracks[3] = { 0, 0, 0 };
+				count_constant_and_animated_tracks(settings, context, context.default_track_offset, num_tracks_to_skip, num_tracks_per_bone, num_constant_tracks, num_animated_tracks);
+
+				context.default_track_offset += num_tracks_to_skip;
+				context.constant_track_offset += num_tracks_to_skip;
+
+				const RotationFormat8 packed_constant_rotation_format = is_rotation_format_variable(rotation_format) ? get_highest_variant_precision(get_rotation_variant(rotation_format)) : rotation_format;
+				context.constant_track_data_offset += num_constant_tracks[0] * get_packed_rotation_size(packed_constant_rotation_format);
+				context.constant_track_data_offset += (num_constant_tracks[1] + num_constant_tracks[2]) * get_packed_vector_size(VectorFormat8::Vector3_96);
+
+				if (are_any_enum_flags_set(clip_range_reduction, RangeReductionFlags8::Rotations))
+					context.clip_range_data_offset += num_animated_tracks[0] * context.clip->num_rotation_components * sizeof(float) * 2;
+				if (are_any_enum_flags_set(clip_range_reduction, RangeReductionFlags8::Translations))
+					context.clip_range_data_offset += num_animated_tracks[1] * k_clip_range_reduction_vector3_range_size;
+				if (are_any_enum_flags_set(clip_range_reduction, RangeReductionFlags8::Scales))
+					context.clip_range_data_offset += num_animated_tracks[2] * k_clip_range_reduction_vector3_range_size;
+
+				if (are_any_enum_flags_set(segment_range_reduction, RangeReductionFlags8::Rotations))
+					context.segment_range_data_offset += num_animated_tracks[0] * context.clip->num_rotation_components * k_segment_range_reduction_num_bytes_per_component * 2;
+				if (are_any_enum_flags_set(segment_range_reduction, RangeReductionFlags8::Translations))
+					context.segment_range_data_offset += num_animated_tracks[1] * 3 * k_segment_range_reduction_num_bytes_per_component * 2;
+				if (are_any_enum_flags_set(segment_range_reduction, RangeReductionFlags8::Scales))
+					context.segment_range_data_offset += num_animated_tracks[2] * 3 * k_segment_range_reduction_num_bytes_per_component * 2;
+
+				// Fixed width tracks have a known size while variable tracks store their bit rate, one per track
+				uint32_t num_fixed_bytes = 0;
+				uint32_t num_variable_tracks = 0;
+
+				if (is_rotation_format_variable(rotation_format))
+					num_variable_tracks += num_animated_tracks[0];
+				else
+					num_fixed_bytes += num_animated_tracks[0] * get_packed_rotation_size(rotation_format);
 
-				ACL_ENSURE(segment_header0 != nullptr, "Failed to find segment.");
+				if (is_vector_format_variable(translation_format))
+					num_variable_tracks += num_animated_tracks[1];
+				else
+					num_fixed_bytes += num_animated_tracks[1] * get_packed_vector_size(translation_format);
+
+				if (is_vector_format_variable(scale_format))
+					num_variable_tracks += num_animated_tracks[2];
+				else
+					num_fixed_bytes += num_animated_tracks[2] * get_packed_vector_size(scale_format);
+
+				const bool has_mixed_packing = settings.supports_mixed_packing() && context.clip->has_mixed_packing;
+
+				for (uint8_t key_frame_index = 0; key_frame_index < 2; ++key_frame_index)
+				{
+					const uint8_t* format_per_track_data = context.format_per_track_data[key_frame_index] + context.format_per_track_data_offset;
+
+					if (settings.is_memory_access_recorded())
+						settings.record_memory_access(CompressedDataSection8::FormatPerTrackData, format_per_track_data, num_variable_tracks);
+
+					uint32_t num_variable_bits = 0;
+					for (uint32_t track_index = 0; track_index < num_variable_tracks; ++track_index)
+					{
+						uint32_t num_bits_at_bit_rate = get_num_bits_at_bit_rate(format_per_track_data[track_index]) * 3;	// 3 components
+
+						if (has_mixed_packing)
+							num_bits_at_bit_rate = align_to(num_bits_at_bit_rate, k_mixed_packing_alignment_num_bits);
+
+						num_variable_bits += num_bits_at_bit_rate;
+					}
+
+					// Fixed width formats only track byte offsets while variable formats only track bit offsets unless we have both.
+					// Every skipped track stores all the samples of the block.
+					const uint32_t block_num_samples = context.key_frame_block_num_samples[key_frame_index];
+					if (num_variable_tracks == 0 && !has_mixed_packing)
+					{
+						context.key_frame_byte_offsets[key_frame_index] += block_num_samples * num_fixed_bytes;
+					}
+					else
+					{
+						context.key_frame_bit_offsets[key_frame_index] += block_num_samples * ((num_fixed_bytes * 8) + num_variable_bits);
 
-				context.format_per_track_data[0] = header.get_format_per_track_data(*segment_header0);
-				context.format_per_track_data[1] = header.get_format_per_track_data(*segment_header1);
-				context.segment_range_data[0] = header.get_segment_range_data(*segment_header0);
-				context.segment_range_data[1] = header.get_segment_range_data(*segment_header1);
-				context.animated_track_data[0] = header.get_track_data(*segment_header0);
-				context.animated_track_data[1] = header.get_track_data(*segment_header1);
+						if (has_mixed_packing)
+							context.key_frame_byte_offsets[key_frame_index] = context.key_frame_bit_offsets[key_frame_index] / 8;
+					}
+				}
 
-				context.key_frame_byte_offsets[0] = (segment_key_frame0 * segment_header0->animated_pose_bit_size) / 8;
-				context.key_frame_byte_offsets[1] = (segment_key_frame1 * segment_header1->animated_pose_bit_size) / 8;
-				context.key_frame_bit_offsets[0] = segment_key_frame0 * segment_header0->animated_pose_bit_size;
-				context.key_frame_bit_offsets[1] = segment_key_frame1 * segment_header1->animated_pose_bit_size;
+				context.format_per_track_data_offset += num_variable_tracks;
 			}
 		}
 
@@ -302,6 +821,51 @@ namespace acl
 
 			// Whether tracks must all be variable or all fixed width, or if they can be mixed and require padding
 			constexpr bool supports_mixed_packing() const { return true; }
+
+			// Whether clips where every animated track is variable use the structure of arrays decompression path.
+			// This is opt-in: rotations are normalized with a reciprocal square root estimate refined with
+			// Newton-Raphson and the results can differ from the scalar path in the last few bits.
+			// Bones are also written out of order, see 'OutputWriter::requires_ordered_writes'.
+			constexpr bool supports_soa_decompression() const { return false; }
+
+			// Whether every read of the compressed clip data is reported to 'record_memory_access'
+			constexpr bool is_memory_access_recorded() const { return false; }
+			void record_memory_access(CompressedDataSection8 section, const void* data, uint32_t size) const {}
+		};
+
+		//////////////////////////////////////////////////////////////////////////
+		// Decompression settings that record every read of the compressed clip data
+		// in a 'MemoryAccessRecorder'. They are used to measure how many bytes and cache
+		// lines a decompression call touches and in which order, it is much slower than
+		// regular decompression and meant for analysis only.
+		//
+		// The settings to instrument are provided as the base to strip the same code.
+		//////////////////////////////////////////////////////////////////////////
+		template<class SettingsType = DecompressionSettings>
+		struct InstrumentedDecompressionSettings : public SettingsType
+		{
+			explicit InstrumentedDecompressionSettings(MemoryAccessRecorder& recorder_, const SettingsType& settings = SettingsType())
+				: SettingsType(settings)
+				, recorder(&recorder_)
+			{}
+
+			constexpr bool is_memory_access_recorded() const { return true; }
+			void record_memory_access(CompressedDataSection8 section, const void* data, uint32_t size) const { recorder->record(section, data, size); }
+
+			MemoryAccessRecorder* recorder;
+		};
+
+		//////////////////////////////////////////////////////////////////////////
+		// Describes a single pose to sample when decompressing a batch of instances.
+		// Every instance in a batch must play back the same compressed clip and
+		// must own a distinct decompression context allocated for it.
+		//////////////////////////////////////////////////////////////////////////
+		template<class OutputWriterType>
+		struct DecompressionInstance
+		{
+			void* context;
+			float sample_time;
+			OutputWriterType* writer;
 		};
 
 		template<class SettingsType>
@@ -309,45 +873,983 @@ namespace acl
 		{
 			using namespace impl;
 
-			DecompressionContext* context = allocate_type<DecompressionContext>(allocator);
+			ACL_ENSURE(!is_clip_in_database(get_clip_header(clip)), "The clip lives in a clip database, use the database overload");
 
-			ACL_ASSERT(is_aligned_to(&context->segment_headers, k_cache_line_size), "Read-only decompression context is misaligned");
-			ACL_ASSERT(is_aligned_to(&context->constant_track_offset, k_cache_line_size), "Read-write decompression context is misaligned");
+			StandaloneDecompressionContext* context = allocate_type<StandaloneDecompressionContext>(allocator);
+
+			ACL_ASSERT(is_aligned_to(&context->clip, k_cache_line_size), "Read-only decompression context is misaligned");
 
 			initialize_context(settings, get_clip_header(clip), *context);
 
 			return context;
 		}
 
-		inline void deallocate_decompression_context(IAllocator& allocator, void* opaque_context)
+		//////////////////////////////////////////////////////////////////////////
+		// Allocates a decompression context for a clip that lives in a clip database.
+		// The compressed clip to decompress is the one returned by 'ClipDatabase::get_clip'.
+		// The database must outlive the context.
+		//////////////////////////////////////////////////////////////////////////
+		template<class SettingsType>
+		inline void* allocate_decompression_context(IAllocator& allocator, const SettingsType& settings, const ClipDatabase& database, uint32_t clip_index)
 		{
 			using namespace impl;
 
-			DecompressionContext* context = safe_ptr_cast<DecompressionContext>(opaque_context);
-			deallocate_type<DecompressionContext>(allocator, context);
-		}
+			ACL_ENSURE(database.is_valid(false), "Clip database is invalid");
 
-		template<class SettingsType, class OutputWriterType>
-		inline void decompress_pose(const SettingsType& settings, const CompressedClip& clip, void* opaque_context, float sample_time, OutputWriterType& writer)
-		{
-			static_assert(std::is_base_of<DecompressionSettings, SettingsType>::value, "SettingsType must derive from DecompressionSettings!");
-			static_assert(std::is_base_of<OutputWriter, OutputWriterType>::value, "OutputWriterType must derive from OutputWriter!");
+			StandaloneDecompressionContext* context = allocate_type<StandaloneDecompressionContext>(allocator);
 
-			using namespace impl;
+			ACL_ASSERT(is_aligned_to(&context->clip, k_cache_line_size), "Read-only decompression context is misaligned");
 
-			ACL_ENSURE(clip.get_algorithm_type() == AlgorithmType8::UniformlySampled, "Invalid algorithm type [%s], expected [%s]", get_algorithm_name(clip.get_algorithm_type()), get_algorithm_name(AlgorithmType8::UniformlySampled));
-			ACL_ENSURE(clip.is_valid(false), "Clip is invalid");
+			const ClipHeader& header = get_clip_header(database.get_clip(clip_index));
+			initialize_context(settings, header, database.get_default_tracks_bitset(clip_index), database.get_constant_tracks_bitset(clip_index), database.get_constant_track_data(clip_index), *context);
+
+			return context;
+		}
+
+		inline void deallocate_decompression_context(IAllocator& allocator, void* opaque_context)
+		{
+			using namespace impl;
+
+			StandaloneDecompressionContext* context = safe_ptr_cast<StandaloneDecompressionContext>(opaque_context);
+			deallocate_type<StandaloneDecompressionContext>(allocator, context);
+		}
+
+		namespace impl
+		{
+			template<class SettingsType>
+			inline TrackOffsetIndex* allocate_track_offset_index(IAllocator& allocator, const SettingsType& settings, const CompressedClip& clip, const uint32_t* default_tracks_bitset, const uint32_t* constant_tracks_bitset, const uint8_t* constant_track_data)
+			{
+				ACL_ENSURE(clip.get_algorithm_type() == AlgorithmType8::UniformlySampled, "Invalid algorithm type [%s], expected [%s]", get_algorithm_name(clip.get_algorithm_type()), get_algorithm_name(AlgorithmType8::UniformlySampled));
+				ACL_ENSURE(clip.is_valid(false), "Clip is invalid");
+
+				const ClipHeader& header = get_clip_header(clip);
+				const uint32_t index_size = get_track_offset_index_size(header);
+
+				TrackOffsetIndex* index = safe_ptr_cast<TrackOffsetIndex>(allocator.allocate(index_size, alignof(TrackOffsetIndex)));
+				index->size = index_size;
+				index->clip_hash = clip.get_hash();
+				index->num_bones = header.num_bones;
+				index->num_segments = header.num_segments;
+				index->padding = 0;
+
+				const TranslationDecompressionSettingsAdapter<SettingsType> translation_adapter(settings);
+				const ScaleDecompressionSettingsAdapter<SettingsType> scale_adapter(settings);
+
+				// Fixed width formats only track byte offsets while variable formats only track bit offsets
+				const bool is_any_format_variable = is_rotation_format_variable(settings.get_rotation_format(header.rotation_format))
+					|| is_vector_format_variable(settings.get_translation_format(header.translation_format))
+					|| is_vector_format_variable(settings.get_scale_format(header.scale_format));
+
+				// Skip through the first key frame of every segment and record where each bone starts in a pose,
+				// the offsets are scaled by the number of key frames in a block when we seek
+				ClipDecompressionContext clip_context;
+				initialize_clip_decompression_context(settings, header, default_tracks_bitset, constant_tracks_bitset, constant_track_data, clip_context);
+
+				DecompressionContext context;
+				reset_context(clip_context, context);
+
+				TrackOffsetIndex::BoneOffsets* bone_offsets = index->get_bone_offsets();
+
+				for (uint16_t segment_index = 0; segment_index < header.num_segments; ++segment_index)
+				{
+					const SegmentHeader& segment_header = context.clip->segment_headers[segment_index];
+					context.format_per_track_data[0] = header.get_format_per_track_data(segment_header);
+					context.segment_range_data[0] = header.get_segment_range_data(segment_header);
+					context.animated_track_data[0] = header.get_track_data(segment_header);
+
+					context.constant_track_offset = 0;
+					context.constant_track_data_offset = 0;
+					context.default_track_offset = 0;
+					context.clip_range_data_offset = 0;
+					context.format_per_track_data_offset = 0;
+					context.segment_range_data_offset = 0;
+					context.key_frame_byte_offsets[0] = 0;
+					context.key_frame_bit_offsets[0] = 0;
+					context.key_frame_block_sample_indices[0] = 0;
+					context.key_frame_block_num_samples[0] = 1;
+
+					uint32_t* bone_bit_offsets = index->get_segment_bone_bit_offsets(segment_index);
+
+					for (uint16_t bone_index = 0; bone_index < header.num_bones; ++bone_index)
+					{
+						if (segment_index == 0)
+						{
+							bone_offsets[bone_index].constant_track_data_offset = context.constant_track_data_offset;
+							bone_offsets[bone_index].clip_range_data_offset = context.clip_range_data_offset;
+							bone_offsets[bone_index].format_per_track_data_offset = context.format_per_track_data_offset;
+							bone_offsets[bone_index].segment_range_data_offset = context.segment_range_data_offset;
+						}
+
+						bone_bit_offsets[bone_index] = is_any_format_variable ? uint32_t(context.key_frame_bit_offsets[0]) : (context.key_frame_byte_offsets[0] * 8);
+
+						skip_rotation(settings, header, context);
+						skip_vector(translation_adapter, header, context);
+
+						if (header.has_scale)
+							skip_vector(scale_adapter, header, context);
+					}
+				}
+
+				return index;
+			}
+		}
+
+		template<class SettingsType>
+		inline TrackOffsetIndex* allocate_track_offset_index(IAllocator& allocator, const SettingsType& settings, const CompressedClip& clip)
+		{
+			static_assert(std::is_base_of<DecompressionSettings, SettingsType>::value, "SettingsType must derive from DecompressionSettings!");
+
+			const ClipHeader& header = get_clip_header(clip);
+			ACL_ENSURE(!impl::is_clip_in_database(header), "The clip lives in a clip database, use the database overload");
+
+			return impl::allocate_track_offset_index(allocator, settings, clip, header.get_default_tracks_bitset(), header.get_constant_tracks_bitset(), header.get_constant_track_data());
+		}
+
+		// Builds the track offset index of a clip that lives in a clip database
+		template<class SettingsType>
+		inline TrackOffsetIndex* allocate_track_offset_index(IAllocator& allocator, const SettingsType& settings, const ClipDatabase& database, uint32_t clip_index)
+		{
+			static_assert(std::is_base_of<DecompressionSettings, SettingsType>::value, "SettingsType must derive from DecompressionSettings!");
+
+			ACL_ENSURE(database.is_valid(false), "Clip database is invalid");
+
+			return impl::allocate_track_offset_index(allocator, settings, database.get_clip(clip_index), database.get_default_tracks_bitset(clip_index), database.get_constant_tracks_bitset(clip_index), database.get_constant_track_data(clip_index));
+		}
+
+		inline void deallocate_track_offset_index(IAllocator& allocator, TrackOffsetIndex* index)
+		{
+			if (index == nullptr)
+				return;
+
+			allocator.deallocate(index, index->size);
+		}
+
+		//////////////////////////////////////////////////////////////////////////
+		// Attaches a track offset index to a decompression context, 'decompress_bone' will use it to
+		// sample a single bone in constant time. The index must have been built for the same clip as the
+		// context and it must outlive it. Use nullptr to detach it.
+		//////////////////////////////////////////////////////////////////////////
+		inline void set_track_offset_index(void* opaque_context, const TrackOffsetIndex* index)
+		{
+			using namespace impl;
+
+			// Shared and standalone contexts both start with the clip state
+			ClipDecompressionContext& clip_context = *safe_ptr_cast<ClipDecompressionContext>(opaque_context);
+			clip_context.track_offset_index = index;
+		}
+
+		//////////////////////////////////////////////////////////////////////////
+		// Attaches a segment streamer to a decompression context. Segment data is then requested from
+		// the streamer every time a segment boundary is crossed and only the first 'get_resident_clip_size'
+		// bytes of the compressed clip need to be resident. The streamer is also told which segment
+		// playback will reach next so it can prefetch it. It must outlive the context, use nullptr to detach it.
+		// A track offset index must be built from the full compressed clip before its segments are streamed.
+		//////////////////////////////////////////////////////////////////////////
+		inline void set_segment_streamer(void* opaque_context, ISegmentStreamer* streamer)
+		{
+			using namespace impl;
+
+			// Shared and standalone contexts both start with the clip state
+			ClipDecompressionContext& clip_context = *safe_ptr_cast<ClipDecompressionContext>(opaque_context);
+			clip_context.segment_streamer = streamer;
+
+			// Our segment data pointers might come from somewhere else now, force them to be refreshed.
+			// Instances of a shared context keep their own, the streamer must be attached before they start playing back.
+			if (!clip_context.is_shared)
+			{
+				InstanceDecompressionContext& instance_context = safe_ptr_cast<StandaloneDecompressionContext>(opaque_context)->instance;
+				instance_context.segment_indices[0] = instance_context.segment_indices[1] = k_invalid_segment_index;
+			}
+		}
+
+		//////////////////////////////////////////////////////////////////////////
+		// Returns the size in bytes of the key frame cache for the provided clip
+		inline uint32_t get_key_frame_cache_size(const CompressedClip& clip)
+		{
+			const ClipHeader& header = get_clip_header(clip);
+			const uint32_t num_tracks_per_bone = header.has_scale ? 3 : 2;
+			return sizeof(impl::KeyFrameCacheHeader) + (sizeof(Vector4_32) * num_tracks_per_bone * header.num_bones * 2);
+		}
+
+		//////////////////////////////////////////////////////////////////////////
+		// Attaches a key frame cache to a decompression context. 'decompress_pose' then keeps the animated
+		// samples of the two key frames it interpolates in it. When playback moves on to the next key frame,
+		// the other one is still cached and only the new key frame is unpacked. Seeking elsewhere in the clip
+		// unpacks both key frames again. This halves the unpacking work of sequential playback, forward or backward.
+		// The buffer must be at least 'get_key_frame_cache_size' bytes, aligned to 16 bytes, and it must outlive
+		// the context. Use nullptr to detach it. A shared decompression context cannot have a key frame cache.
+		//////////////////////////////////////////////////////////////////////////
+		inline void set_key_frame_cache(void* opaque_context, void* buffer, uint32_t buffer_size)
+		{
+			using namespace impl;
+
+			ACL_ENSURE(buffer == nullptr || is_aligned_to(buffer, alignof(KeyFrameCacheHeader)), "Key frame cache is not aligned");
+			ACL_ENSURE(buffer == nullptr || buffer_size >= sizeof(KeyFrameCacheHeader), "Key frame cache is too small: %u", buffer_size);
+			ACL_ENSURE(!safe_ptr_cast<const ClipDecompressionContext>(opaque_context)->is_shared, "A shared decompression context cannot have a key frame cache");
+
+			KeyFrameCacheHeader* key_frame_cache = safe_ptr_cast<KeyFrameCacheHeader>(buffer);
+			safe_ptr_cast<StandaloneDecompressionContext>(opaque_context)->key_frame_cache = key_frame_cache;
+			if (key_frame_cache != nullptr)
+			{
+				key_frame_cache->slots_size = buffer_size - uint32_t(sizeof(KeyFrameCacheHeader));
+				key_frame_cache->cached_key_frames[0] = key_frame_cache->cached_key_frames[1] = k_invalid_key_frame;
+				key_frame_cache->padding = 0;
+			}
+		}
+
+		//////////////////////////////////////////////////////////////////////////
+		// Most of a decompression context is identical for every instance that plays back
+		// the same clip. A shared decompression context holds that state, it is built once per
+		// clip and is only ever read from afterwards: any number of instances on any number
+		// of threads can use it at the same time. Every instance then only needs a small
+		// instance decompression context to track where it is in the clip.
+		//
+		// A track offset index and a segment streamer can be attached to a shared context with
+		// 'set_track_offset_index' and 'set_segment_streamer' before any instance uses it.
+		// A segment streamer attached to a shared context must be thread safe if its instances are.
+		//////////////////////////////////////////////////////////////////////////
+		template<class SettingsType>
+		inline void* allocate_shared_decompression_context(IAllocator& allocator, const SettingsType& settings, const CompressedClip& clip)
+		{
+			using namespace impl;
+
+			const ClipHeader& header = get_clip_header(clip);
+			ACL_ENSURE(!is_clip_in_database(header), "The clip lives in a clip database, use the database overload");
+
+			ClipDecompressionContext* context = allocate_type<ClipDecompressionContext>(allocator);
+			initialize_clip_decompression_context(settings, header, header.get_default_tracks_bitset(), header.get_constant_tracks_bitset(), header.get_constant_track_data(), *context);
+			context->is_shared = true;
+
+			return context;
+		}
+
+		template<class SettingsType>
+		inline void* allocate_shared_decompression_context(IAllocator& allocator, const SettingsType& settings, const ClipDatabase& database, uint32_t clip_index)
+		{
+			using namespace impl;
+
+			ACL_ENSURE(database.is_valid(false), "Clip database is invalid");
+
+			const ClipHeader& header = get_clip_header(database.get_clip(clip_index));
+
+			ClipDecompressionContext* context = allocate_type<ClipDecompressionContext>(allocator);
+			initialize_clip_decompression_context(settings, header, database.get_default_tracks_bitset(clip_index), database.get_constant_tracks_bitset(clip_index), database.get_constant_track_data(clip_index), *context);
+			context->is_shared = true;
+
+			return context;
+		}
+
+		inline void deallocate_shared_decompression_context(IAllocator& allocator, void* opaque_shared_context)
+		{
+			using namespace impl;
+
+			ClipDecompressionContext* context = safe_ptr_cast<ClipDecompressionContext>(opaque_shared_context);
+			deallocate_type<ClipDecompressionContext>(allocator, context);
+		}
+
+		// The size of a decompression context and of a shared decompression context
+		constexpr size_t get_decompression_context_size() { return sizeof(impl::StandaloneDecompressionContext); }
+		constexpr size_t get_shared_decompression_context_size() { return sizeof(impl::ClipDecompressionContext); }
+
+		// The size and alignment of an instance decompression context, use them to set up a 'PoolAllocator'
+		constexpr size_t get_instance_decompression_context_size() { return sizeof(impl::InstanceDecompressionContext); }
+		constexpr size_t get_instance_decompression_context_alignment() { return alignof(impl::InstanceDecompressionContext); }
+
+		//////////////////////////////////////////////////////////////////////////
+		// Allocates the per instance state needed to play back a clip with a shared decompression context.
+		// Instance contexts are small and allocated often, a 'PoolAllocator' keeps them dense in memory.
+		//////////////////////////////////////////////////////////////////////////
+		inline void* allocate_instance_decompression_context(IAllocator& allocator)
+		{
+			using namespace impl;
+
+			InstanceDecompressionContext* context = allocate_type<InstanceDecompressionContext>(allocator);
+			reset_instance_context(*context);
+
+			return context;
+		}
+
+		inline void deallocate_instance_decompression_context(IAllocator& allocator, void* opaque_instance_context)
+		{
+			using namespace impl;
+
+			InstanceDecompressionContext* context = safe_ptr_cast<InstanceDecompressionContext>(opaque_instance_context);
+			deallocate_type<InstanceDecompressionContext>(allocator, context);
+		}
+
+		namespace impl
+		{
+			// Builds a decompression context on the stack from the instance state, the shared clip state is read in place
+			inline void load_instance_context(const void* opaque_shared_context, const void* opaque_instance_context, DecompressionContext& context)
+			{
+				const ClipDecompressionContext& shared_context = *safe_ptr_cast<const ClipDecompressionContext>(opaque_shared_context);
+				const InstanceDecompressionContext& instance_context = *safe_ptr_cast<const InstanceDecompressionContext>(opaque_instance_context);
+
+				ACL_ENSURE(shared_context.is_shared, "Expected a shared decompression context");
+
+				load_context(shared_context, instance_context, nullptr, context);
+			}
+
+			inline void store_instance_context(const DecompressionContext& context, void* opaque_instance_context)
+			{
+				store_context(context, *safe_ptr_cast<InstanceDecompressionContext>(opaque_instance_context));
+			}
+		}
+
+		namespace impl
+		{
+			template<class SettingsType>
+			inline bool is_soa_decompression_enabled(const SettingsType& settings, const ClipHeader& header)
+			{
+				if (!settings.supports_soa_decompression())
+					return false;
+
+				if (settings.get_rotation_format(header.rotation_format) != RotationFormat8::QuatDropW_Variable || !settings.is_rotation_format_supported(RotationFormat8::QuatDropW_Variable))
+					return false;
+
+				if (settings.get_translation_format(header.translation_format) != VectorFormat8::Vector3_Variable || !settings.is_translation_format_supported(VectorFormat8::Vector3_Variable))
+					return false;
+
+				if (header.has_scale && (settings.get_scale_format(header.scale_format) != VectorFormat8::Vector3_Variable || !settings.is_scale_format_supported(VectorFormat8::Vector3_Variable)))
+					return false;
+
+				return true;
+			}
+
+			inline void get_soa_bone_indices(const SoATrackBatch& batch, uint16_t* out_bone_indices)
+			{
+				for (uint32_t lane_index = 0; lane_index < batch.num_lanes; ++lane_index)
+					out_bone_indices[lane_index] = batch.lanes[lane_index].bone_index;
+			}
+
+			// Writers receive at most 'k_num_soa_writer_lanes' lanes at a time
+			inline uint32_t get_num_soa_writer_lanes(const SoATrackBatch& batch, uint32_t first_lane_index)
+			{
+				const uint32_t num_lanes_left = batch.num_lanes - first_lane_index;
+				return num_lanes_left < k_num_soa_writer_lanes ? num_lanes_left : k_num_soa_writer_lanes;
+			}
+
+			template<class OutputWriterType>
+			inline void write_soa_rotations(const DecompressionContext& context, const SoATrackBatch& batch, OutputWriterType& writer)
+			{
+				if (writer.supports_soa_writes())
+				{
+					// Skip the transpose, the writer takes the components as they are
+					uint16_t bone_indices[k_num_soa_lanes];
+					get_soa_bone_indices(batch, bone_indices);
+
+					SoAVector_32 x;
+					SoAVector_32 y;
+					SoAVector_32 z;
+					SoAVector_32 w;
+					decompress_and_interpolate_soa_rotation_components(context, batch, x, y, z, w);
+
+					for (uint32_t group_index = 0; group_index < k_num_soa_writer_groups; ++group_index)
+					{
+						const uint32_t first_lane_index = group_index * k_num_soa_writer_lanes;
+						if (first_lane_index >= batch.num_lanes)
+							break;
+
+						const uint32_t num_lanes = get_num_soa_writer_lanes(batch, first_lane_index);
+						writer.write_bone_rotations_soa(bone_indices + first_lane_index, num_lanes, get_soa_writer_lanes(x, group_index), get_soa_writer_lanes(y, group_index), get_soa_writer_lanes(z, group_index), get_soa_writer_lanes(w, group_index));
+					}
+					return;
+				}
+
+				Quat_32 rotations[k_num_soa_lanes];
+				decompress_and_interpolate_soa_rotations(context, batch, rotations);
+
+				for (uint32_t lane_index = 0; lane_index < batch.num_lanes; ++lane_index)
+				{
+					ACL_ENSURE(quat_is_finite(rotations[lane_index]), "Rotation is not valid!");
+					ACL_ENSURE(quat_is_normalized(rotations[lane_index]), "Rotation is not normalized!");
+					writer.write_bone_rotation(batch.lanes[lane_index].bone_index, rotations[lane_index]);
+				}
+			}
+
+			template<class OutputWriterType, class OutputFunctorType>
+			inline void write_soa_vectors(const DecompressionContext& context, const SoATrackBatch& batch, OutputWriterType& writer, OutputFunctorType output_fun)
+			{
+				if (writer.supports_soa_writes())
+				{
+					uint16_t bone_indices[k_num_soa_lanes];
+					get_soa_bone_indices(batch, bone_indices);
+
+					SoAVector_32 x;
+					SoAVector_32 y;
+					SoAVector_32 z;
+					decompress_and_interpolate_soa_vector_components(context, batch, x, y, z);
+
+					for (uint32_t group_index = 0; group_index < k_num_soa_writer_groups; ++group_index)
+					{
+						const uint32_t first_lane_index = group_index * k_num_soa_writer_lanes;
+						if (first_lane_index >= batch.num_lanes)
+							break;
+
+						const uint32_t num_lanes = get_num_soa_writer_lanes(batch, first_lane_index);
+						output_fun(writer, bone_indices + first_lane_index, num_lanes, get_soa_writer_lanes(x, group_index), get_soa_writer_lanes(y, group_index), get_soa_writer_lanes(z, group_index));
+					}
+					return;
+				}
+
+				Vector4_32 vectors[k_num_soa_lanes];
+				decompress_and_interpolate_soa_vectors(context, batch, vectors);
+
+				for (uint32_t lane_index = 0; lane_index < batch.num_lanes; ++lane_index)
+				{
+					ACL_ENSURE(vector_is_finite3(vectors[lane_index]), "Vector is not valid!");
+					output_fun(writer, batch.lanes[lane_index].bone_index, vectors[lane_index]);
+				}
+			}
+
+			template<class OutputWriterType>
+			struct TranslationOutputFunctor
+			{
+				void operator()(OutputWriterType& writer, uint32_t bone_index, const Vector4_32& translation) const { writer.write_bone_translation(bone_index, translation); }
+				void operator()(OutputWriterType& writer, const uint16_t* bone_indices, uint32_t num_lanes, const Vector4_32& x, const Vector4_32& y, const Vector4_32& z) const { writer.write_bone_translations_soa(bone_indices, num_lanes, x, y, z); }
+			};
+
+			template<class OutputWriterType>
+			struct ScaleOutputFunctor
+			{
+				void operator()(OutputWriterType& writer, uint32_t bone_index, const Vector4_32& scale) const { writer.write_bone_scale(bone_index, scale); }
+				void operator()(OutputWriterType& writer, const uint16_t* bone_indices, uint32_t num_lanes, const Vector4_32& x, const Vector4_32& y, const Vector4_32& z) const { writer.write_bone_scales_soa(bone_indices, num_lanes, x, y, z); }
+			};
+
+			//////////////////////////////////////////////////////////////////////////
+			// Decompresses a full pose when every animated track is variable. Default and constant
+			// tracks are written as we find them while animated tracks are queued and decompressed
+			// 'k_num_soa_lanes' at a time once enough of the same type are found. As such, bones are not
+			// written in order but every track of every bone is written exactly once.
+			//////////////////////////////////////////////////////////////////////////
+			template<class SettingsType, class OutputWriterType>
+			inline void decompress_pose_soa(const SettingsType& settings, const ClipHeader& header, DecompressionContext& context, OutputWriterType& writer)
+			{
+				const TranslationDecompressionSettingsAdapter<SettingsType> translation_adapter(settings);
+				const ScaleDecompressionSettingsAdapter<SettingsType> scale_adapter(settings);
+				const TranslationOutputFunctor<OutputWriterType> translation_output_fun;
+				const ScaleOutputFunctor<OutputWriterType> scale_output_fun;
+
+				const RangeReductionFlags8 clip_range_reduction = settings.get_clip_range_reduction(header.clip_range_reduction);
+				const RangeReductionFlags8 segment_range_reduction = settings.get_segment_range_reduction(header.segment_range_reduction);
+				const bool are_clip_rotations_normalized = are_any_enum_flags_set(clip_range_reduction, RangeReductionFlags8::Rotations);
+
+				SoATrackBatch rotation_batch;
+				SoATrackBatch translation_batch;
+				SoATrackBatch scale_batch;
+				initialize_soa_track_batch(rotation_batch, are_clip_rotations_normalized, are_clip_rotations_normalized, are_any_enum_flags_set(segment_range_reduction, RangeReductionFlags8::Rotations));
+				initialize_soa_track_batch(translation_batch, true, are_any_enum_flags_set(clip_range_reduction, RangeReductionFlags8::Translations), are_any_enum_flags_set(segment_range_reduction, RangeReductionFlags8::Translations));
+				initialize_soa_track_batch(scale_batch, true, are_any_enum_flags_set(clip_range_reduction, RangeReductionFlags8::Scales), are_any_enum_flags_set(segment_range_reduction, RangeReductionFlags8::Scales));
+
+				for (uint16_t bone_index = 0; bone_index < header.num_bones; ++bone_index)
+				{
+					if (is_track_default(settings, context, context.default_track_offset))
+						writer.write_bone_rotation(bone_index, quat_identity_32());
+					else if (is_track_constant(settings, context, context.constant_track_offset))
+						writer.write_bone_rotation(bone_index, decompress_constant_rotation(settings, header, context));
+					else
+					{
+						queue_soa_track(settings, context, bone_index, rotation_batch);
+						if (is_soa_track_batch_full(rotation_batch))
+						{
+							write_soa_rotations(context, rotation_batch, writer);
+							rotation_batch.num_lanes = 0;
+						}
+					}
+
+					++context.default_track_offset;
+					++context.constant_track_offset;
+
+					if (is_track_default(settings, context, context.default_track_offset))
+						writer.write_bone_translation(bone_index, translation_adapter.get_default_value());
+					else if (is_track_constant(settings, context, context.constant_track_offset))
+						writer.write_bone_translation(bone_index, decompress_constant_vector(translation_adapter, header, context));
+					else
+					{
+						queue_soa_track(settings, context, bone_index, translation_batch);
+						if (is_soa_track_batch_full(translation_batch))
+						{
+							write_soa_vectors(context, translation_batch, writer, translation_output_fun);
+							translation_batch.num_lanes = 0;
+						}
+					}
+
+					++context.default_track_offset;
+					++context.constant_track_offset;
+
+					if (header.has_scale)
+					{
+						if (is_track_default(settings, context, context.default_track_offset))
+							writer.write_bone_scale(bone_index, scale_adapter.get_default_value());
+						else if (is_track_constant(settings, context, context.constant_track_offset))
+							writer.write_bone_scale(bone_index, decompress_constant_vector(scale_adapter, header, context));
+						else
+						{
+							queue_soa_track(settings, context, bone_index, scale_batch);
+							if (is_soa_track_batch_full(scale_batch))
+							{
+								write_soa_vectors(context, scale_batch, writer, scale_output_fun);
+								scale_batch.num_lanes = 0;
+							}
+						}
+
+						++context.default_track_offset;
+						++context.constant_track_offset;
+					}
+					else
+						writer.write_bone_scale(bone_index, vector_set(1.0f));
+				}
+
+				// Flush whatever remains in our partial batches
+				if (rotation_batch.num_lanes != 0)
+					write_soa_rotations(context, rotation_batch, writer);
+
+				if (translation_batch.num_lanes != 0)
+					write_soa_vectors(context, translation_batch, writer, translation_output_fun);
+
+				if (scale_batch.num_lanes != 0)
+					write_soa_vectors(context, scale_batch, writer, scale_output_fun);
+			}
+
+			// Not std::swap, it would be shared between the runtime dispatched decoders
+			template<typename ValueType>
+			inline void swap_key_frame_values(ValueType (&values)[2])
+			{
+				const ValueType value0 = values[0];
+				values[0] = values[1];
+				values[1] = value0;
+			}
+
+			// Points the first key frame of the context to the second one and back, reading a single key frame always reads the first one
+			inline void swap_key_frames(DecompressionContext& context)
+			{
+				swap_key_frame_values(context.format_per_track_data);
+				swap_key_frame_values(context.segment_range_data);
+				swap_key_frame_values(context.animated_track_data);
+				swap_key_frame_values(context.key_frame_byte_offsets);
+				swap_key_frame_values(context.key_frame_bit_offsets);
+				swap_key_frame_values(context.key_frame_block_sample_indices);
+				swap_key_frame_values(context.key_frame_block_num_samples);
+			}
+
+			inline uint32_t find_cached_key_frame_slot(const KeyFrameCacheHeader& cache, uint32_t key_frame)
+			{
+				if (cache.cached_key_frames[0] == key_frame)
+					return 0;
+				if (cache.cached_key_frames[1] == key_frame)
+					return 1;
+				return k_invalid_key_frame;
+			}
+
+			// Where the samples of the two key frames we interpolate live in the key frame cache and which ones we unpack
+			struct KeyFrameCacheSlots
+			{
+				Vector4_32* key_frame_samples[2];
+				Vector4_32* unpacked_samples;			// When a single key frame is unpacked
+				uint32_t num_key_frames_to_unpack;
+			};
+
+			inline KeyFrameCacheSlots acquire_key_frame_cache_slots(uint32_t num_tracks, DecompressionContext& context)
+			{
+				KeyFrameCacheHeader& cache = *context.key_frame_cache;
+				Vector4_32* cache_slots = get_key_frame_cache_slots(cache);
+
+				uint32_t slot_indices[2] = { find_cached_key_frame_slot(cache, context.key_frames[0]), find_cached_key_frame_slot(cache, context.key_frames[1]) };
+
+				KeyFrameCacheSlots slots;
+				slots.unpacked_samples = nullptr;
+
+				// Sequential playback always has one of our two key frames cached already
+				if (slot_indices[0] == k_invalid_key_frame && slot_indices[1] == k_invalid_key_frame)
+				{
+					slot_indices[0] = 0;
+					slot_indices[1] = 1;
+					slots.num_key_frames_to_unpack = 2;
+				}
+				else if (slot_indices[0] == k_invalid_key_frame)
+				{
+					slot_indices[0] = slot_indices[1] ^ 1;
+					slots.unpacked_samples = cache_slots + (slot_indices[0] * num_tracks);
+					slots.num_key_frames_to_unpack = 1;
+				}
+				else if (slot_indices[1] == k_invalid_key_frame)
+				{
+					slot_indices[1] = slot_indices[0] ^ 1;
+					slots.unpacked_samples = cache_slots + (slot_indices[1] * num_tracks);
+					slots.num_key_frames_to_unpack = 1;
+
+					swap_key_frames(context);
+				}
+				else
+					slots.num_key_frames_to_unpack = 0;
+
+				slots.key_frame_samples[0] = cache_slots + (slot_indices[0] * num_tracks);
+				slots.key_frame_samples[1] = cache_slots + (slot_indices[1] * num_tracks);
+
+				cache.cached_key_frames[slot_indices[0]] = context.key_frames[0];
+				cache.cached_key_frames[slot_indices[1]] = context.key_frames[1];
+
+				return slots;
+			}
+
+			template<class SettingsType>
+			inline Quat_32 decompress_and_interpolate_cached_rotation(const SettingsType& settings, const ClipHeader& header, const KeyFrameCacheSlots& slots, uint32_t track_index, DecompressionContext& context)
+			{
+				Quat_32 rotation;
+				if (is_track_default(settings, context, context.default_track_offset))
+					rotation = quat_identity_32();
+				else if (is_track_constant(settings, context, context.constant_track_offset))
+				{
+					rotation = decompress_constant_rotation(settings, header, context);
+					ACL_ENSURE(quat_is_finite(rotation), "Rotation is not valid!");
+					ACL_ENSURE(quat_is_normalized(rotation), "Rotation is not normalized!");
+				}
+				else
+				{
+					if (slots.num_key_frames_to_unpack == 2)
+					{
+						Quat_32 rotations[2];
+						decompress_animated_rotations<2>(settings, header, context, rotations);
+						slots.key_frame_samples[0][track_index] = quat_to_vector(rotations[0]);
+						slots.key_frame_samples[1][track_index] = quat_to_vector(rotations[1]);
+					}
+					else if (slots.num_key_frames_to_unpack == 1)
+					{
+						Quat_32 unpacked_rotation;
+						decompress_animated_rotations<1>(settings, header, context, &unpacked_rotation);
+						slots.unpacked_samples[track_index] = quat_to_vector(unpacked_rotation);
+					}
+
+					rotation = quat_lerp(vector_to_quat(slots.key_frame_samples[0][track_index]), vector_to_quat(slots.key_frame_samples[1][track_index]), context.interpolation_alpha);
+					ACL_ENSURE(quat_is_finite(rotation), "Rotation is not valid!");
+					ACL_ENSURE(quat_is_normalized(rotation), "Rotation is not normalized!");
+				}
+
+				++context.default_track_offset;
+				++context.constant_track_offset;
+				return rotation;
+			}
+
+			template<class SettingsAdapterType>
+			inline Vector4_32 decompress_and_interpolate_cached_vector(const SettingsAdapterType& settings, const ClipHeader& header, const KeyFrameCacheSlots& slots, uint32_t track_index, DecompressionContext& context)
+			{
+				Vector4_32 vector;
+				if (is_track_default(settings, context, context.default_track_offset))
+					vector = settings.get_default_value();
+				else if (is_track_constant(settings, context, context.constant_track_offset))
+				{
+					vector = decompress_constant_vector(settings, header, context);
+					ACL_ENSURE(vector_is_finite3(vector), "Vector is not valid!");
+				}
+				else
+				{
+					if (slots.num_key_frames_to_unpack == 2)
+					{
+						Vector4_32 vectors[2];
+						decompress_animated_vectors<2>(settings, header, context, vectors);
+						slots.key_frame_samples[0][track_index] = vectors[0];
+						slots.key_frame_samples[1][track_index] = vectors[1];
+					}
+					else if (slots.num_key_frames_to_unpack == 1)
+						decompress_animated_vectors<1>(settings, header, context, &slots.unpacked_samples[track_index]);
+
+					vector = vector_lerp(slots.key_frame_samples[0][track_index], slots.key_frame_samples[1][track_index], context.interpolation_alpha);
+					ACL_ENSURE(vector_is_finite3(vector), "Vector is not valid!");
+				}
+
+				++context.default_track_offset;
+				++context.constant_track_offset;
+				return vector;
+			}
+
+			//////////////////////////////////////////////////////////////////////////
+			// Decompresses a full pose with the help of the key frame cache. Only the key frames
+			// that aren't cached yet are unpacked, into the cache slot that doesn't hold the other
+			// key frame we interpolate with. Every animated track is then interpolated from the cache.
+			//////////////////////////////////////////////////////////////////////////
+			template<class SettingsType, class OutputWriterType>
+			inline void decompress_pose_cached(const SettingsType& settings, const ClipHeader& header, DecompressionContext& context, OutputWriterType& writer)
+			{
+				const TranslationDecompressionSettingsAdapter<SettingsType> translation_adapter(settings);
+				const ScaleDecompressionSettingsAdapter<SettingsType> scale_adapter(settings);
+
+				const uint32_t num_tracks_per_bone = header.has_scale ? 3 : 2;
+				const uint32_t num_tracks = num_tracks_per_bone * header.num_bones;
+				ACL_ENSURE(context.key_frame_cache->slots_size >= sizeof(Vector4_32) * num_tracks * 2, "Key frame cache is too small: %u < %u", context.key_frame_cache->slots_size, uint32_t(sizeof(Vector4_32) * num_tracks * 2));
+
+				const KeyFrameCacheSlots slots = acquire_key_frame_cache_slots(num_tracks, context);
+				const bool is_second_key_frame_unpacked = slots.num_key_frames_to_unpack == 1 && slots.unpacked_samples == slots.key_frame_samples[1];
+
+				for (uint32_t bone_index = 0; bone_index < header.num_bones; ++bone_index)
+				{
+					const uint32_t track_index = bone_index * num_tracks_per_bone;
+
+					const Quat_32 rotation = decompress_and_interpolate_cached_rotation(settings, header, slots, track_index, context);
+					writer.write_bone_rotation(bone_index, rotation);
+
+					const Vector4_32 translation = decompress_and_interpolate_cached_vector(translation_adapter, header, slots, track_index + 1, context);
+					writer.write_bone_translation(bone_index, translation);
+
+					const Vector4_32 scale = header.has_scale ? decompress_and_interpolate_cached_vector(scale_adapter, header, slots, track_index + 2, context) : vector_set(1.0f);
+					writer.write_bone_scale(bone_index, scale);
+				}
+
+				// Our segment data pointers must match our segment indices for the next seek
+				if (is_second_key_frame_unpacked)
+					swap_key_frames(context);
+			}
+		}
+
+		namespace impl
+		{
+			template<class SettingsType, class OutputWriterType>
+			inline void decompress_pose(const SettingsType& settings, const CompressedClip& clip, DecompressionContext& context, float sample_time, OutputWriterType& writer)
+			{
+				static_assert(std::is_base_of<DecompressionSettings, SettingsType>::value, "SettingsType must derive from DecompressionSettings!");
+				static_assert(std::is_base_of<OutputWriter, OutputWriterType>::value, "OutputWriterType must derive from OutputWriter!");
+
+				ACL_ENSURE(clip.get_algorithm_type() == AlgorithmType8::UniformlySampled, "Invalid algorithm type [%s], expected [%s]", get_algorithm_name(clip.get_algorithm_type()), get_algorithm_name(AlgorithmType8::UniformlySampled));
+				ACL_ENSURE(clip.is_valid(false), "Clip is invalid");
+
+				const ClipHeader& header = get_clip_header(clip);
+
+				seek(settings, header, sample_time, context);
+
+				if (context.key_frame_cache != nullptr)
+				{
+					decompress_pose_cached(settings, header, context, writer);
+					return;
+				}
+
+				if (!writer.requires_ordered_writes() && is_soa_decompression_enabled(settings, header))
+				{
+					decompress_pose_soa(settings, header, context, writer);
+					return;
+				}
+
+				const TranslationDecompressionSettingsAdapter<SettingsType> translation_adapter(settings);
+				const ScaleDecompressionSettingsAdapter<SettingsType> scale_adapter(settings);
+
+				for (uint32_t bone_index = 0; bone_index < header.num_bones; ++bone_index)
+				{
+					Quat_32 rotation = decompress_and_interpolate_rotation(settings, header, context);
+					writer.write_bone_rotation(bone_index, rotation);
+
+					Vector4_32 translation = decompress_and_interpolate_vector(translation_adapter, header, context);
+					writer.write_bone_translation(bone_index, translation);
+
+					Vector4_32 scale = header.has_scale ? decompress_and_interpolate_vector(scale_adapter, header, context) : vector_set(1.0f);
+					writer.write_bone_scale(bone_index, scale);
+				}
+			}
+		}
+
+		template<class SettingsType, class OutputWriterType>
+		inline void decompress_pose(const SettingsType& settings, const CompressedClip& clip, void* opaque_context, float sample_time, OutputWriterType& writer)
+		{
+			impl::DecompressionContext context;
+			impl::load_standalone_context(opaque_context, context);
+
+			impl::decompress_pose(settings, clip, context, sample_time, writer);
+
+			impl::store_standalone_context(context, opaque_context);
+		}
+
+		namespace impl
+		{
+			template<class SettingsType, class OutputWriterType>
+			inline void decompress_and_interpolate_rotations(const SettingsType& settings, const ClipHeader& header, DecompressionContext& shared_context, DecompressionContext* contexts, DecompressionInstance<OutputWriterType>* instances, uint32_t num_instances, uint32_t bone_index)
+			{
+				const bool is_rotation_default = is_track_default(settings, shared_context, shared_context.default_track_offset);
+				if (is_rotation_default)
+				{
+					const Quat_32 rotation = quat_identity_32();
+					for (uint32_t instance_index = 0; instance_index < num_instances; ++instance_index)
+						instances[instance_index].writer->write_bone_rotation(bone_index, rotation);
+				}
+				else
+				{
+					const bool is_rotation_constant = is_track_constant(settings, shared_context, shared_context.constant_track_offset);
+					if (is_rotation_constant)
+					{
+						const Quat_32 rotation = decompress_constant_rotation(settings, header, shared_context);
+						ACL_ENSURE(quat_is_finite(rotation), "Rotation is not valid!");
+						ACL_ENSURE(quat_is_normalized(rotation), "Rotation is not normalized!");
+
+						for (uint32_t instance_index = 0; instance_index < num_instances; ++instance_index)
+							instances[instance_index].writer->write_bone_rotation(bone_index, rotation);
+					}
+					else
+					{
+						for (uint32_t instance_index = 0; instance_index < num_instances; ++instance_index)
+						{
+							DecompressionContext& context = contexts[instance_index];
+
+							Quat_32 rotations[2];
+							decompress_animated_rotations<2>(settings, header, context, rotations);
+
+							const Quat_32 rotation = quat_lerp(rotations[0], rotations[1], context.interpolation_alpha);
+							ACL_ENSURE(quat_is_finite(rotation), "Rotation is not valid!");
+							ACL_ENSURE(quat_is_normalized(rotation), "Rotation is not normalized!");
+
+							instances[instance_index].writer->write_bone_rotation(bone_index, rotation);
+						}
+					}
+				}
+
+				++shared_context.default_track_offset;
+				++shared_context.constant_track_offset;
+			}
+
+			template<class SettingsAdapterType, class OutputWriterType, class OutputFunctorType>
+			inline void decompress_and_interpolate_vectors(const SettingsAdapterType& settings, const ClipHeader& header, DecompressionContext& shared_context, DecompressionContext* contexts, DecompressionInstance<OutputWriterType>* instances, uint32_t num_instances, uint32_t bone_index, OutputFunctorType output_fun)
+			{
+				const bool is_sample_default = is_track_default(settings, shared_context, shared_context.default_track_offset);
+				if (is_sample_default)
+				{
+					const Vector4_32 value = settings.get_default_value();
+					for (uint32_t instance_index = 0; instance_index < num_instances; ++instance_index)
+						output_fun(*instances[instance_index].writer, bone_index, value);
+				}
+				else
+				{
+					const bool is_sample_constant = is_track_constant(settings, shared_context, shared_context.constant_track_offset);
+					if (is_sample_constant)
+					{
+						const Vector4_32 value = decompress_constant_vector(settings, header, shared_context);
+						ACL_ENSURE(vector_is_finite3(value), "Vector is not valid!");
+
+						for (uint32_t instance_index = 0; instance_index < num_instances; ++instance_index)
+							output_fun(*instances[instance_index].writer, bone_index, value);
+					}
+					else
+					{
+						for (uint32_t instance_index = 0; instance_index < num_instances; ++instance_index)
+						{
+							DecompressionContext& context = contexts[instance_index];
+
+							Vector4_32 vectors[2];
+							decompress_animated_vectors<2>(settings, header, context, vectors);
+
+							const Vector4_32 value = vector_lerp(vectors[0], vectors[1], context.interpolation_alpha);
+							ACL_ENSURE(vector_is_finite3(value), "Vector is not valid!");
+
+							output_fun(*instances[instance_index].writer, bone_index, value);
+						}
+					}
+				}
+
+				shared_context.default_track_offset++;
+				shared_context.constant_track_offset++;
+			}
+		}
+
+		//////////////////////////////////////////////////////////////////////////
+		// Decompresses a full pose for every instance provided, each at its own sample time.
+		// The clip header is validated once and the default and constant tracks are only
+		// walked and unpacked once for the whole batch since they do not depend on the sample time.
+		// Animated tracks are decompressed for every instance one track at a time which keeps
+		// the format dispatch and the shared clip data hot while the instances are interleaved.
+		// A single instance has nothing to share and is decompressed with 'decompress_pose'.
+		// Large batches are split into chunks of 'k_max_num_batched_instances' instances.
+		//////////////////////////////////////////////////////////////////////////
+		template<class SettingsType, class OutputWriterType>
+		inline void decompress_poses(const SettingsType& settings, const CompressedClip& clip, DecompressionInstance<OutputWriterType>* instances, uint32_t num_instances)
+		{
+			static_assert(std::is_base_of<DecompressionSettings, SettingsType>::value, "SettingsType must derive from DecompressionSettings!");
+			static_assert(std::is_base_of<OutputWriter, OutputWriterType>::value, "OutputWriterType must derive from OutputWriter!");
+
+			using namespace impl;
+
+			ACL_ENSURE(clip.get_algorithm_type() == AlgorithmType8::UniformlySampled, "Invalid algorithm type [%s], expected [%s]", get_algorithm_name(clip.get_algorithm_type()), get_algorithm_name(AlgorithmType8::UniformlySampled));
+			ACL_ENSURE(clip.is_valid(false), "Clip is invalid");
+			ACL_ENSURE(instances != nullptr || num_instances == 0, "Instances cannot be null");
+
+			if (num_instances == 0)
+				return;
+
+			if (num_instances == 1)
+			{
+				decompress_pose(settings, clip, instances[0].context, instances[0].sample_time, *instances[0].writer);
+				return;
+			}
+
+			const ClipHeader& header = get_clip_header(clip);
+
+			const TranslationDecompressionSettingsAdapter<SettingsType> translation_adapter(settings);
+			const ScaleDecompressionSettingsAdapter<SettingsType> scale_adapter(settings);
+
+			// The working contexts live on the stack, the instance state is loaded into them and stored back once we are done
+			DecompressionContext contexts[k_max_num_batched_instances];
+
+			for (uint32_t first_instance_index = 0; first_instance_index < num_instances; first_instance_index += k_max_num_batched_instances)
+			{
+				DecompressionInstance<OutputWriterType>* batch_instances = instances + first_instance_index;
+				const uint32_t num_instances_left = num_instances - first_instance_index;
+				const uint32_t num_batch_instances = num_instances_left < k_max_num_batched_instances ? num_instances_left : k_max_num_batched_instances;
+
+				for (uint32_t instance_index = 0; instance_index < num_batch_instances; ++instance_index)
+				{
+					DecompressionContext& context = contexts[instance_index];
+					load_standalone_context(batch_instances[instance_index].context, context);
+					ACL_ENSURE(context.clip->segment_headers == header.get_segment_headers(), "Decompression context wasn't initialized for this clip");
+
+					seek(settings, header, batch_instances[instance_index].sample_time, context);
+				}
+
+				// The default and constant track offsets advance identically for every instance, we only track them with the first one
+				DecompressionContext& shared_context = contexts[0];
+
+				for (uint32_t bone_index = 0; bone_index < header.num_bones; ++bone_index)
+				{
+					decompress_and_interpolate_rotations(settings, header, shared_context, contexts, batch_instances, num_batch_instances, bone_index);
+					decompress_and_interpolate_vectors(translation_adapter, header, shared_context, contexts, batch_instances, num_batch_instances, bone_index, TranslationOutputFunctor<OutputWriterType>());
+
+					if (header.has_scale)
+					{
+						decompress_and_interpolate_vectors(scale_adapter, header, shared_context, contexts, batch_instances, num_batch_instances, bone_index, ScaleOutputFunctor<OutputWriterType>());
+					}
+					else
+					{
+						const Vector4_32 scale = vector_set(1.0f);
+						for (uint32_t instance_index = 0; instance_index < num_batch_instances; ++instance_index)
+							batch_instances[instance_index].writer->write_bone_scale(bone_index, scale);
+					}
+				}
+
+				for (uint32_t instance_index = 0; instance_index < num_batch_instances; ++instance_index)
+					store_standalone_context(contexts[instance_index], batch_instances[instance_index].context);
+			}
+		}
+
+		//////////////////////////////////////////////////////////////////////////
+		// Decompresses the first 'num_bones_to_decompress' bones of a pose and writes them out.
+		// The remaining bones are neither decompressed nor written to the output writer.
+		// Bones are sorted with their parent first which makes this a good fit for LODs.
+		//////////////////////////////////////////////////////////////////////////
+		template<class SettingsType, class OutputWriterType>
+		inline void decompress_partial_pose(const SettingsType& settings, const CompressedClip& clip, void* opaque_context, float sample_time, uint16_t num_bones_to_decompress, OutputWriterType& writer)
+		{
+			static_assert(std::is_base_of<DecompressionSettings, SettingsType>::value, "SettingsType must derive from DecompressionSettings!");
+			static_assert(std::is_base_of<OutputWriter, OutputWriterType>::value, "OutputWriterType must derive from OutputWriter!");
+
+			using namespace impl;
+
+			ACL_ENSURE(clip.get_algorithm_type() == AlgorithmType8::UniformlySampled, "Invalid algorithm type [%s], expected [%s]", get_algorithm_name(clip.get_algorithm_type()), get_algorithm_name(AlgorithmType8::UniformlySampled));
+			ACL_ENSURE(clip.is_valid(false), "Clip is invalid");
 
 			const ClipHeader& header = get_clip_header(clip);
 
-			DecompressionContext& context = *safe_ptr_cast<DecompressionContext>(opaque_context);
+			DecompressionContext context;
+			load_standalone_context(opaque_context, context);
 
 			seek(settings, header, sample_time, context);
 
 			const TranslationDecompressionSettingsAdapter<SettingsType> translation_adapter(settings);
 			const ScaleDecompressionSettingsAdapter<SettingsType> scale_adapter(settings);
 
-			for (uint32_t bone_index = 0; bone_index < header.num_bones; ++bone_index)
+			const uint32_t num_bones = num_bones_to_decompress < header.num_bones ? num_bones_to_decompress : header.num_bones;
+			for (uint32_t bone_index = 0; bone_index < num_bones; ++bone_index)
 			{
 				Quat_32 rotation = decompress_and_interpolate_rotation(settings, header, context);
 				writer.write_bone_rotation(bone_index, rotation);
@@ -358,54 +1860,162 @@ namespace acl
 				Vector4_32 scale = header.has_scale ? decompress_and_interpolate_vector(scale_adapter, header, context) : vector_set(1.0f);
 				writer.write_bone_scale(bone_index, scale);
 			}
+
+			store_standalone_context(context, opaque_context);
 		}
 
-		template<class SettingsType>
-		inline void decompress_bone(const SettingsType& settings, const CompressedClip& clip, void* opaque_context, float sample_time, uint16_t sample_bone_index, Quat_32* out_rotation, Vector4_32* out_translation, Vector4_32* out_scale)
+		//////////////////////////////////////////////////////////////////////////
+		// Decompresses the bones set in the provided bone mask and writes them out.
+		// The bone mask has one bit per bone, bones that are not set are neither
+		// decompressed nor written to the output writer.
+		// Runs of masked out bones are skipped at once, in constant time if the context
+		// has a track offset index attached.
+		//////////////////////////////////////////////////////////////////////////
+		template<class SettingsType, class OutputWriterType>
+		inline void decompress_partial_pose(const SettingsType& settings, const CompressedClip& clip, void* opaque_context, float sample_time, const uint32_t* bone_mask, BitSetDescription bone_mask_desc, OutputWriterType& writer)
 		{
 			static_assert(std::is_base_of<DecompressionSettings, SettingsType>::value, "SettingsType must derive from DecompressionSettings!");
+			static_assert(std::is_base_of<OutputWriter, OutputWriterType>::value, "OutputWriterType must derive from OutputWriter!");
 
 			using namespace impl;
 
 			ACL_ENSURE(clip.get_algorithm_type() == AlgorithmType8::UniformlySampled, "Invalid algorithm type [%s], expected [%s]", get_algorithm_name(clip.get_algorithm_type()), get_algorithm_name(AlgorithmType8::UniformlySampled));
 			ACL_ENSURE(clip.is_valid(false), "Clip is invalid");
+			ACL_ENSURE(bone_mask != nullptr, "Bone mask cannot be null");
 
 			const ClipHeader& header = get_clip_header(clip);
 
-			DecompressionContext& context = *safe_ptr_cast<DecompressionContext>(opaque_context);
+			ACL_ENSURE(bone_mask_desc.get_num_bits() >= header.num_bones, "Bone mask is too small: %d < %u", bone_mask_desc.get_num_bits(), header.num_bones);
+
+			DecompressionContext context;
+			load_standalone_context(opaque_context, context);
+
+			ACL_ENSURE(context.clip->track_offset_index == nullptr || context.clip->track_offset_index->clip_hash == clip.get_hash(), "Track offset index wasn't built for this clip");
 
 			seek(settings, header, sample_time, context);
 
 			const TranslationDecompressionSettingsAdapter<SettingsType> translation_adapter(settings);
 			const ScaleDecompressionSettingsAdapter<SettingsType> scale_adapter(settings);
 
-			// TODO: Optimize this by counting the number of bits set, we can use the pop-count instruction on
-			// architectures that support it (e.g. xb1/ps4). This would entirely avoid looping here.
+			// The bone our context currently points to
+			uint32_t context_bone_index = 0;
 
 			for (uint32_t bone_index = 0; bone_index < header.num_bones; ++bone_index)
 			{
-				if (bone_index == sample_bone_index)
-					break;
+				if (!bitset_test(bone_mask, bone_mask_desc, bone_index))
+					continue;
 
-				skip_rotations_in_two_key_frames(settings, header, context);
-				skip_vectors_in_two_key_frames(translation_adapter, header, context);
+				if (bone_index != context_bone_index)
+				{
+					if (context.clip->track_offset_index != nullptr)
+						seek_to_bone(header, bone_index, context);
+					else
+						skip_bones(settings, header, bone_index - context_bone_index, context);
+				}
+
+				Quat_32 rotation = decompress_and_interpolate_rotation(settings, header, context);
+				writer.write_bone_rotation(bone_index, rotation);
 
-				if (header.has_scale)
-					skip_vectors_in_two_key_frames(scale_adapter, header, context);
+				Vector4_32 translation = decompress_and_interpolate_vector(translation_adapter, header, context);
+				writer.write_bone_translation(bone_index, translation);
+
+				Vector4_32 scale = header.has_scale ? decompress_and_interpolate_vector(scale_adapter, header, context) : vector_set(1.0f);
+				writer.write_bone_scale(bone_index, scale);
+
+				context_bone_index = bone_index + 1;
 			}
 
-			// TODO: Skip if not interested in return value
-			Quat_32 rotation = decompress_and_interpolate_rotation(settings, header, context);
-			if (out_rotation != nullptr)
-				*out_rotation = rotation;
+			store_standalone_context(context, opaque_context);
+		}
+
+		namespace impl
+		{
+			template<class SettingsType>
+			inline void decompress_bone(const SettingsType& settings, const CompressedClip& clip, DecompressionContext& context, float sample_time, uint16_t sample_bone_index, Quat_32* out_rotation, Vector4_32* out_translation, Vector4_32* out_scale)
+			{
+				static_assert(std::is_base_of<DecompressionSettings, SettingsType>::value, "SettingsType must derive from DecompressionSettings!");
+
+				ACL_ENSURE(clip.get_algorithm_type() == AlgorithmType8::UniformlySampled, "Invalid algorithm type [%s], expected [%s]", get_algorithm_name(clip.get_algorithm_type()), get_algorithm_name(AlgorithmType8::UniformlySampled));
+				ACL_ENSURE(clip.is_valid(false), "Clip is invalid");
+
+				const ClipHeader& header = get_clip_header(clip);
+
+				seek(settings, header, sample_time, context);
+
+				const TranslationDecompressionSettingsAdapter<SettingsType> translation_adapter(settings);
+				const ScaleDecompressionSettingsAdapter<SettingsType> scale_adapter(settings);
+
+				ACL_ENSURE(sample_bone_index < header.num_bones, "Invalid bone index: %u", sample_bone_index);
+
+				if (context.clip->track_offset_index != nullptr)
+				{
+					ACL_ENSURE(context.clip->track_offset_index->clip_hash == clip.get_hash(), "Track offset index wasn't built for this clip");
+
+					seek_to_bone(header, sample_bone_index, context);
+				}
+				else if (sample_bone_index != 0)
+				{
+					skip_bones(settings, header, sample_bone_index, context);
+				}
+
+				// TODO: Skip if not interested in return value
+				Quat_32 rotation = decompress_and_interpolate_rotation(settings, header, context);
+				if (out_rotation != nullptr)
+					*out_rotation = rotation;
+
+				Vector4_32 translation = decompress_and_interpolate_vector(translation_adapter, header, context);
+				if (out_translation != nullptr)
+					*out_translation = translation;
+
+				Vector4_32 scale = header.has_scale ? decompress_and_interpolate_vector(scale_adapter, header, context) : vector_set(1.0f);
+				if (out_scale != nullptr)
+					*out_scale = scale;
+			}
+		}
+
+		template<class SettingsType>
+		inline void decompress_bone(const SettingsType& settings, const CompressedClip& clip, void* opaque_context, float sample_time, uint16_t sample_bone_index, Quat_32* out_rotation, Vector4_32* out_translation, Vector4_32* out_scale)
+		{
+			impl::DecompressionContext context;
+			impl::load_standalone_context(opaque_context, context);
+
+			impl::decompress_bone(settings, clip, context, sample_time, sample_bone_index, out_rotation, out_translation, out_scale);
+
+			impl::store_standalone_context(context, opaque_context);
+		}
+
+		//////////////////////////////////////////////////////////////////////////
+		// Decompresses a full pose of an instance that plays back a clip with a shared decompression context.
+		// The shared context is only read from, the instance context tracks the playback of this instance.
+		//////////////////////////////////////////////////////////////////////////
+		template<class SettingsType, class OutputWriterType>
+		inline void decompress_pose(const SettingsType& settings, const CompressedClip& clip, const void* opaque_shared_context, void* opaque_instance_context, float sample_time, OutputWriterType& writer)
+		{
+			using namespace impl;
+
+			ACL_ENSURE(safe_ptr_cast<const ClipDecompressionContext>(opaque_shared_context)->segment_headers == get_clip_header(clip).get_segment_headers(), "Shared decompression context wasn't initialized for this clip");
+
+			DecompressionContext context;
+			load_instance_context(opaque_shared_context, opaque_instance_context, context);
+
+			decompress_pose(settings, clip, context, sample_time, writer);
+
+			store_instance_context(context, opaque_instance_context);
+		}
+
+		template<class SettingsType>
+		inline void decompress_bone(const SettingsType& settings, const CompressedClip& clip, const void* opaque_shared_context, void* opaque_instance_context, float sample_time, uint16_t sample_bone_index, Quat_32* out_rotation, Vector4_32* out_translation, Vector4_32* out_scale)
+		{
+			using namespace impl;
+
+			ACL_ENSURE(safe_ptr_cast<const ClipDecompressionContext>(opaque_shared_context)->segment_headers == get_clip_header(clip).get_segment_headers(), "Shared decompression context wasn't initialized for this clip");
+
+			DecompressionContext context;
+			load_instance_context(opaque_shared_context, opaque_instance_context, context);
 
-			Vector4_32 translation = decompress_and_interpolate_vector(translation_adapter, header, context);
-			if (out_translation != nullptr)
-				*out_translation = translation;
+			decompress_bone(settings, clip, context, sample_time, sample_bone_index, out_rotation, out_translation, out_scale);
 
-			Vector4_32 scale = header.has_scale ? decompress_and_interpolate_vector(scale_adapter, header, context) : vector_set(1.0f);
-			if (out_scale != nullptr)
-				*out_scale = scale;
+			store_instance_context(context, opaque_instance_context);
 		}
 	}
 }
@@ -0,0 +1,181 @@
+#pragma once
+
+////////////////////////////////////////////////////////////////////////////////
+// The MIT License (MIT)
+//
+// Copyright (c) 2018 Nicholas Frechette & Animation Compression Library contributors
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+////////////////////////////////////////////////////////////////////////////////
+
+#include "acl/algorithm/uniformly_sampled/decoder_dispatch_functions.h"
+#include "acl/core/algorithm_types.h"
+#include "acl/core/clip_database.h"
+#include "acl/core/compressed_clip.h"
+#include "acl/core/cpu_instruction_set.h"
+#include "acl/core/error.h"
+#include "acl/core/iallocator.h"
+#include "acl/core/memory_utils.h"
+#include "acl/math/math_types.h"
+
+#include <algorithm>
+#include <cstdint>
+
+//////////////////////////////////////////////////////////////////////////
+// Runtime dispatch of the decoder.
+//
+// The header only decoder uses the instruction set the application is compiled for.
+// When a single binary must run on a range of CPUs, the decoder can instead be compiled
+// once per instruction set and the best one supported by the CPU is selected with cpuid
+// when the decompression context is allocated.
+//
+// Each instruction set requires a translation unit that defines the matching macro
+// before including 'decoder_dispatch_impl.h' and that is compiled with the matching flags:
+//    - ACL_DECODER_DISPATCH_SSE2: -msse2 (the x64 baseline with MSVC)
+//    - ACL_DECODER_DISPATCH_SSE4: -msse4.1 (MSVC has no equivalent and uses SSE2)
+//    - ACL_DECODER_DISPATCH_AVX: -mavx or /arch:AVX
+//    - ACL_DECODER_DISPATCH_AVX2: -mavx2 or /arch:AVX2
+// These translation units live under 'sources/' and must not be compiled with the flags
+// of the application. All four must be linked in, 'cmake/ACLDecoderDispatch.cmake'
+// adds them as an object library.
+//
+// The dispatched decoder uses the default DecompressionSettings and writes
+// an array of Transform_32, it otherwise behaves like 'decompress_pose'.
+//////////////////////////////////////////////////////////////////////////
+
+namespace acl
+{
+	namespace uniformly_sampled
+	{
+		namespace impl
+		{
+			struct DispatchedDecompressionContext
+			{
+				const DecoderFunctions* functions;
+				size_t size;
+				size_t context_offset;
+			};
+
+			inline const DecoderFunctions& get_decoder_functions(CPUInstructionSet8 instruction_set)
+			{
+				switch (instruction_set)
+				{
+					case CPUInstructionSet8::SSE2:	return get_decoder_functions_sse2();
+					case CPUInstructionSet8::SSE4:	return get_decoder_functions_sse4();
+					case CPUInstructionSet8::AVX:	return get_decoder_functions_avx();
+					case CPUInstructionSet8::AVX2:	return get_decoder_functions_avx2();
+					default:
+						ACL_ENSURE(false, "Invalid instruction set for runtime dispatch: %s", get_cpu_instruction_set_name(instruction_set));
+						return get_decoder_functions_sse2();
+				}
+			}
+
+			inline void* get_decoder_context(DispatchedDecompressionContext& context)
+			{
+				return add_offset_to_ptr<void>(&context, context.context_offset);
+			}
+		}
+
+		namespace impl
+		{
+			inline DispatchedDecompressionContext* allocate_dispatched_decompression_context(IAllocator& allocator, CPUInstructionSet8 max_instruction_set)
+			{
+				const CPUInstructionSet8 cpu_instruction_set = get_cpu_instruction_set();
+				ACL_ENSURE(cpu_instruction_set != CPUInstructionSet8::Generic, "Runtime dispatch requires an x86 CPU");
+				ACL_ENSURE(max_instruction_set != CPUInstructionSet8::Generic, "Invalid instruction set for runtime dispatch: %s", get_cpu_instruction_set_name(max_instruction_set));
+
+				const CPUInstructionSet8 instruction_set = uint8_t(cpu_instruction_set) < uint8_t(max_instruction_set) ? cpu_instruction_set : max_instruction_set;
+				const DecoderFunctions& functions = get_decoder_functions(instruction_set);
+
+				const size_t alignment = std::max<size_t>(functions.context_alignment, alignof(DispatchedDecompressionContext));
+				const size_t context_offset = align_to(sizeof(DispatchedDecompressionContext), functions.context_alignment);
+				const size_t size = context_offset + functions.context_size;
+
+				DispatchedDecompressionContext* context = reinterpret_cast<DispatchedDecompressionContext*>(allocator.allocate(size, alignment));
+				context->functions = &functions;
+				context->size = size;
+				context->context_offset = context_offset;
+
+				return context;
+			}
+		}
+
+		//////////////////////////////////////////////////////////////////////////
+		// Allocates a decompression context for the best instruction set supported by the CPU.
+		// The instruction set can be capped with 'max_instruction_set', the selection is final
+		// for the lifetime of the context.
+		//////////////////////////////////////////////////////////////////////////
+		inline void* allocate_dispatched_decompression_context(IAllocator& allocator, const CompressedClip& clip, CPUInstructionSet8 max_instruction_set = CPUInstructionSet8::AVX2)
+		{
+			using namespace impl;
+
+			ACL_ENSURE(clip.get_algorithm_type() == AlgorithmType8::UniformlySampled, "Invalid algorithm type [%s], expected [%s]", get_algorithm_name(clip.get_algorithm_type()), get_algorithm_name(AlgorithmType8::UniformlySampled));
+			ACL_ENSURE(clip.is_valid(false), "Clip is invalid");
+			ACL_ENSURE(get_clip_header(clip).default_tracks_bitset_offset.is_valid(), "The clip lives in a clip database, use the database overload");
+
+			DispatchedDecompressionContext* context = allocate_dispatched_decompression_context(allocator, max_instruction_set);
+			context->functions->initialize_context(&clip, get_decoder_context(*context));
+
+			return context;
+		}
+
+		//////////////////////////////////////////////////////////////////////////
+		// Allocates a dispatched decompression context for a clip that lives in a clip database.
+		// The compressed clip to decompress is the one returned by 'ClipDatabase::get_clip'.
+		// The database must outlive the context.
+		//////////////////////////////////////////////////////////////////////////
+		inline void* allocate_dispatched_decompression_context(IAllocator& allocator, const ClipDatabase& database, uint32_t clip_index, CPUInstructionSet8 max_instruction_set = CPUInstructionSet8::AVX2)
+		{
+			using namespace impl;
+
+			ACL_ENSURE(database.is_valid(false), "Clip database is invalid");
+			ACL_ENSURE(database.get_clip(clip_index).get_algorithm_type() == AlgorithmType8::UniformlySampled, "Invalid algorithm type [%s], expected [%s]", get_algorithm_name(database.get_clip(clip_index).get_algorithm_type()), get_algorithm_name(AlgorithmType8::UniformlySampled));
+
+			DispatchedDecompressionContext* context = allocate_dispatched_decompression_context(allocator, max_instruction_set);
+			context->functions->initialize_context_from_database(&database, clip_index, get_decoder_context(*context));
+
+			return context;
+		}
+
+		inline void deallocate_dispatched_decompression_context(IAllocator& allocator, void* opaque_context)
+		{
+			using namespace impl;
+
+			DispatchedDecompressionContext* context = safe_ptr_cast<DispatchedDecompressionContext>(opaque_context);
+			allocator.deallocate(context, context->size);
+		}
+
+		// Returns the instruction set selected when the context was allocated
+		inline CPUInstructionSet8 get_dispatched_instruction_set(const void* opaque_context)
+		{
+			using namespace impl;
+
+			const DispatchedDecompressionContext* context = safe_ptr_cast<const DispatchedDecompressionContext>(opaque_context);
+			return context->functions->instruction_set;
+		}
+
+		inline void decompress_pose_dispatched(const CompressedClip& clip, void* opaque_context, float sample_time, Transform_32* out_transforms, uint16_t num_transforms)
+		{
+			using namespace impl;
+
+			DispatchedDecompressionContext& context = *safe_ptr_cast<DispatchedDecompressionContext>(opaque_context);
+			context.functions->decompress_pose(&clip, get_decoder_context(context), sample_time, out_transforms, num_transforms);
+		}
+	}
+}
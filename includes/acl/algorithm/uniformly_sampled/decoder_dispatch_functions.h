@@ -0,0 +1,64 @@
+#pragma once
+
+////////////////////////////////////////////////////////////////////////////////
+// The MIT License (MIT)
+//
+// Copyright (c) 2018 Nicholas Frechette & Animation Compression Library contributors
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+////////////////////////////////////////////////////////////////////////////////
+
+#include "acl/core/cpu_instruction_set.h"
+
+#include <cstddef>
+#include <cstdint>
+
+//////////////////////////////////////////////////////////////////////////
+// The decoder entry points compiled for a single instruction set, see 'decoder_dispatch.h'.
+//
+// Every instruction set is compiled in its own copy of the library with a distinct
+// namespace. Only fundamental types cross that boundary and this header must not
+// include any other library header since it is shared by both sides.
+//////////////////////////////////////////////////////////////////////////
+
+namespace acl
+{
+	namespace uniformly_sampled
+	{
+		struct DecoderFunctions
+		{
+			CPUInstructionSet8 instruction_set;
+
+			// Size and alignment of the decompression context
+			size_t context_size;
+			size_t context_alignment;
+
+			// 'clip' points to a 'CompressedClip', 'database' to a 'ClipDatabase', and 'out_transforms' to an array of 'Transform_32'
+			void (*initialize_context)(const void* clip, void* context);
+			void (*initialize_context_from_database)(const void* database, uint32_t clip_index, void* context);
+			void (*decompress_pose)(const void* clip, void* context, float sample_time, void* out_transforms, uint16_t num_transforms);
+		};
+
+		// Defined by the translation units that include 'decoder_dispatch_impl.h'
+		const DecoderFunctions& get_decoder_functions_sse2();
+		const DecoderFunctions& get_decoder_functions_sse4();
+		const DecoderFunctions& get_decoder_functions_avx();
+		const DecoderFunctions& get_decoder_functions_avx2();
+	}
+}
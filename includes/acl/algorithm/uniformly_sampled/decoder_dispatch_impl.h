@@ -0,0 +1,148 @@
+#pragma once
+
+////////////////////////////////////////////////////////////////////////////////
+// The MIT License (MIT)
+//
+// Copyright (c) 2018 Nicholas Frechette & Animation Compression Library contributors
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+////////////////////////////////////////////////////////////////////////////////
+
+//////////////////////////////////////////////////////////////////////////
+// Compiles the decoder for a single instruction set, see 'decoder_dispatch.h'.
+//
+// Define one of ACL_DECODER_DISPATCH_SSE2, ACL_DECODER_DISPATCH_SSE4, ACL_DECODER_DISPATCH_AVX,
+// or ACL_DECODER_DISPATCH_AVX2 and include this header in a translation unit compiled with
+// the matching flags. No other library header can be included in that translation unit.
+//
+// Inline functions are emitted in every translation unit that uses them and the linker
+// keeps a single copy. The library namespace is renamed here to keep the copies compiled
+// for each instruction set distinct, otherwise AVX code could end up being called on an
+// older CPU. Inline functions from the standard library cannot be renamed and the decoder
+// doesn't call any: only the integer constants of 'std::numeric_limits' remain and their
+// code doesn't depend on the instruction set.
+//
+// A custom ACL_ASSERT or ACL_ENSURE that refers to the 'acl' namespace will refer to the
+// renamed namespace in this translation unit.
+//////////////////////////////////////////////////////////////////////////
+
+#include "acl/algorithm/uniformly_sampled/decoder_dispatch_functions.h"
+
+#if defined(ACL_DECODER_DISPATCH_SSE2)
+	#define ACL_DECODER_DISPATCH_NAMESPACE acl_dispatch_sse2
+	#define ACL_DECODER_DISPATCH_GETTER get_decoder_functions_sse2
+	#define ACL_DECODER_DISPATCH_INSTRUCTION_SET CPUInstructionSet8::SSE2
+#elif defined(ACL_DECODER_DISPATCH_SSE4)
+	#define ACL_DECODER_DISPATCH_NAMESPACE acl_dispatch_sse4
+	#define ACL_DECODER_DISPATCH_GETTER get_decoder_functions_sse4
+	#define ACL_DECODER_DISPATCH_INSTRUCTION_SET CPUInstructionSet8::SSE4
+#elif defined(ACL_DECODER_DISPATCH_AVX)
+	#define ACL_DECODER_DISPATCH_NAMESPACE acl_dispatch_avx
+	#define ACL_DECODER_DISPATCH_GETTER get_decoder_functions_avx
+	#define ACL_DECODER_DISPATCH_INSTRUCTION_SET CPUInstructionSet8::AVX
+#elif defined(ACL_DECODER_DISPATCH_AVX2)
+	#define ACL_DECODER_DISPATCH_NAMESPACE acl_dispatch_avx2
+	#define ACL_DECODER_DISPATCH_GETTER get_decoder_functions_avx2
+	#define ACL_DECODER_DISPATCH_INSTRUCTION_SET CPUInstructionSet8::AVX2
+#else
+	#error "Define the instruction set to compile the decoder for"
+#endif
+
+#define acl ACL_DECODER_DISPATCH_NAMESPACE
+
+#include "acl/algorithm/uniformly_sampled/decoder.h"
+#include "acl/core/clip_database.h"
+#include "acl/decompression/default_output_writer.h"
+
+// The compiler flags must enable at least the requested instruction set
+#if defined(ACL_DECODER_DISPATCH_SSE2) && !defined(ACL_SSE2_INTRINSICS)
+	#error "The SSE2 decoder requires SSE2 to be enabled"
+#elif defined(ACL_DECODER_DISPATCH_SSE4) && !defined(ACL_SSE4_INTRINSICS) && !defined(_MSC_VER)
+	#error "The SSE4 decoder requires SSE4.1 to be enabled"
+#elif defined(ACL_DECODER_DISPATCH_AVX) && !defined(ACL_AVX_INTRINSICS)
+	#error "The AVX decoder requires AVX to be enabled"
+#elif defined(ACL_DECODER_DISPATCH_AVX2) && !defined(ACL_AVX2_INTRINSICS)
+	#error "The AVX2 decoder requires AVX2 to be enabled"
+#endif
+
+// And must not enable a higher one or an extension the CPU detection doesn't check for,
+// the decoder would use them on CPUs that only support the requested instruction set
+#if defined(ACL_DECODER_DISPATCH_SSE2) && (defined(__SSE3__) || defined(__AVX__) || defined(__POPCNT__) || defined(__BMI__) || defined(__LZCNT__))
+	#error "The SSE2 decoder must be compiled without SSE3 or higher"
+#elif defined(ACL_DECODER_DISPATCH_SSE4) && (defined(__SSE4_2__) || defined(__AVX__) || defined(__POPCNT__) || defined(__BMI__) || defined(__LZCNT__))
+	#error "The SSE4 decoder must be compiled without SSE4.2 or higher"
+#elif defined(ACL_DECODER_DISPATCH_AVX) && (defined(__AVX2__) || defined(__FMA__) || defined(__F16C__) || defined(__BMI__) || defined(__LZCNT__))
+	#error "The AVX decoder must be compiled without AVX2, FMA, F16C, or BMI"
+#elif defined(ACL_DECODER_DISPATCH_AVX2) && (defined(__FMA__) || defined(__AVX512F__))
+	#error "The AVX2 decoder must be compiled without FMA or AVX-512"
+#endif
+
+namespace acl
+{
+	namespace uniformly_sampled
+	{
+		namespace dispatch_impl
+		{
+			inline void initialize_context(const void* clip, void* context)
+			{
+				const CompressedClip& compressed_clip = *static_cast<const CompressedClip*>(clip);
+				impl::initialize_context(DecompressionSettings(), get_clip_header(compressed_clip), *safe_ptr_cast<impl::StandaloneDecompressionContext>(context));
+			}
+
+			inline void initialize_context_from_database(const void* database, uint32_t clip_index, void* context)
+			{
+				const ClipDatabase& clip_database = *static_cast<const ClipDatabase*>(database);
+				const ClipHeader& header = get_clip_header(clip_database.get_clip(clip_index));
+				impl::initialize_context(DecompressionSettings(), header, clip_database.get_default_tracks_bitset(clip_index), clip_database.get_constant_tracks_bitset(clip_index), clip_database.get_constant_track_data(clip_index), *safe_ptr_cast<impl::StandaloneDecompressionContext>(context));
+			}
+
+			inline void decompress_pose(const void* clip, void* context, float sample_time, void* out_transforms, uint16_t num_transforms)
+			{
+				const CompressedClip& compressed_clip = *static_cast<const CompressedClip*>(clip);
+				DefaultOutputWriter writer(static_cast<Transform_32*>(out_transforms), num_transforms);
+				uniformly_sampled::decompress_pose(DecompressionSettings(), compressed_clip, context, sample_time, writer);
+			}
+		}
+	}
+}
+
+#undef acl
+
+namespace acl
+{
+	namespace uniformly_sampled
+	{
+		const DecoderFunctions& ACL_DECODER_DISPATCH_GETTER()
+		{
+			namespace decoder = ACL_DECODER_DISPATCH_NAMESPACE::uniformly_sampled;
+
+			static const DecoderFunctions functions =
+			{
+				ACL_DECODER_DISPATCH_INSTRUCTION_SET,
+				sizeof(decoder::impl::StandaloneDecompressionContext),
+				alignof(decoder::impl::StandaloneDecompressionContext),
+				decoder::dispatch_impl::initialize_context,
+				decoder::dispatch_impl::initialize_context_from_database,
+				decoder::dispatch_impl::decompress_pose,
+			};
+
+			return functions;
+		}
+	}
+}
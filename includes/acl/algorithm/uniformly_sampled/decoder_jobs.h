@@ -0,0 +1,202 @@
+#pragma once
+
+////////////////////////////////////////////////////////////////////////////////
+// The MIT License (MIT)
+//
+// Copyright (c) 2018 Nicholas Frechette & Animation Compression Library contributors
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+////////////////////////////////////////////////////////////////////////////////
+
+#include "acl/algorithm/uniformly_sampled/decoder.h"
+#include "acl/core/compressed_clip.h"
+#include "acl/core/error.h"
+#include "acl/core/iallocator.h"
+#include "acl/core/ijob_executor.h"
+#include "acl/core/memory_utils.h"
+#include "acl/core/utils.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <functional>
+
+//////////////////////////////////////////////////////////////////////////
+// Decompresses large batches of poses, possibly from many different clips, across
+// the threads of a job executor.
+//
+// The requests are sorted by clip, segment, and key frame then split into jobs of
+// consecutive requests that play back the same clip. Each job decompresses its
+// requests together with 'decompress_poses' which keeps the clip data and the
+// segment data they share hot in the cache of the thread that runs it.
+//
+// The job executor is what schedules the jobs, bring your own with 'IJobExecutor'
+// or use the 'ThreadJobExecutor' from 'acl/core/thread_job_executor.h'.
+//////////////////////////////////////////////////////////////////////////
+
+namespace acl
+{
+	namespace uniformly_sampled
+	{
+		//////////////////////////////////////////////////////////////////////////
+		// Describes a single pose to decompress in a batch of requests.
+		// Every request must own a distinct decompression context allocated for its
+		// clip and a distinct output writer since requests can run on any thread.
+		//////////////////////////////////////////////////////////////////////////
+		template<class OutputWriterType>
+		struct DecompressionRequest
+		{
+			const CompressedClip* clip;
+			void* context;
+			float sample_time;
+			OutputWriterType* writer;
+		};
+
+		// Larger jobs share more clip data, smaller jobs balance better across threads
+		constexpr uint32_t k_default_max_num_requests_per_job = 16;
+
+		namespace impl
+		{
+			struct DecompressionRequestSortKey
+			{
+				const CompressedClip* clip;
+				uint32_t segment_index;
+				uint32_t key_frame;
+				uint32_t request_index;
+
+				bool operator<(const DecompressionRequestSortKey& other) const
+				{
+					if (clip != other.clip)
+						return std::less<const CompressedClip*>()(clip, other.clip);
+					if (segment_index != other.segment_index)
+						return segment_index < other.segment_index;
+					if (key_frame != other.key_frame)
+						return key_frame < other.key_frame;
+					return request_index < other.request_index;
+				}
+			};
+
+			struct DecompressionJob
+			{
+				const CompressedClip* clip;
+				uint32_t first_instance_index;
+				uint32_t num_instances;
+			};
+
+			template<class SettingsType, class OutputWriterType>
+			struct DecompressionJobs
+			{
+				const SettingsType* settings;
+				const DecompressionJob* jobs;
+				DecompressionInstance<OutputWriterType>* instances;
+
+				static void run_job(void* user_data, uint32_t job_index)
+				{
+					const DecompressionJobs& job_data = *safe_ptr_cast<const DecompressionJobs>(user_data);
+					const DecompressionJob& job = job_data.jobs[job_index];
+
+					decompress_poses(*job_data.settings, *job.clip, job_data.instances + job.first_instance_index, job.num_instances);
+				}
+			};
+		}
+
+		//////////////////////////////////////////////////////////////////////////
+		// Decompresses a full pose for every request provided with the jobs run by the job executor.
+		// The allocator is only used for the temporary job data and must be thread safe
+		// if requests are submitted from several threads at once.
+		// Requests are split into jobs of at most 'max_num_requests_per_job' requests.
+		// The output only depends on the requests, not on how the jobs are scheduled.
+		//////////////////////////////////////////////////////////////////////////
+		template<class SettingsType, class OutputWriterType>
+		inline void decompress_poses(IAllocator& allocator, IJobExecutor& executor, const SettingsType& settings, const DecompressionRequest<OutputWriterType>* requests, uint32_t num_requests, uint32_t max_num_requests_per_job = k_default_max_num_requests_per_job)
+		{
+			static_assert(std::is_base_of<DecompressionSettings, SettingsType>::value, "SettingsType must derive from DecompressionSettings!");
+			static_assert(std::is_base_of<OutputWriter, OutputWriterType>::value, "OutputWriterType must derive from OutputWriter!");
+
+			using namespace impl;
+
+			ACL_ENSURE(requests != nullptr || num_requests == 0, "Requests cannot be null");
+			ACL_ENSURE(max_num_requests_per_job != 0, "Jobs must contain at least one request");
+
+			if (num_requests == 0)
+				return;
+
+			DecompressionRequestSortKey* sort_keys = allocate_type_array<DecompressionRequestSortKey>(allocator, num_requests);
+			for (uint32_t request_index = 0; request_index < num_requests; ++request_index)
+			{
+				const DecompressionRequest<OutputWriterType>& request = requests[request_index];
+				ACL_ENSURE(request.clip != nullptr && request.context != nullptr && request.writer != nullptr, "Invalid decompression request: %u", request_index);
+
+				const CompressedClip& clip = *request.clip;
+				ACL_ENSURE(clip.get_algorithm_type() == AlgorithmType8::UniformlySampled, "Invalid algorithm type [%s], expected [%s]", get_algorithm_name(clip.get_algorithm_type()), get_algorithm_name(AlgorithmType8::UniformlySampled));
+
+				const ClipHeader& header = get_clip_header(clip);
+				DecompressionContext context;
+				load_standalone_context(request.context, context);
+				ACL_ENSURE(context.clip->segment_headers == header.get_segment_headers(), "Decompression context wasn't initialized for this clip");
+
+				uint32_t key_frame0;
+				uint32_t key_frame1;
+				float interpolation_alpha;
+				calculate_interpolation_keys(header.num_samples, get_clip_duration(header), request.sample_time, key_frame0, key_frame1, interpolation_alpha);
+
+				sort_keys[request_index].clip = request.clip;
+				sort_keys[request_index].segment_index = find_segment_index(header, context, key_frame0);
+				sort_keys[request_index].key_frame = key_frame0;
+				sort_keys[request_index].request_index = request_index;
+			}
+
+			std::sort(sort_keys, sort_keys + num_requests);
+
+			DecompressionInstance<OutputWriterType>* instances = allocate_type_array<DecompressionInstance<OutputWriterType>>(allocator, num_requests);
+			DecompressionJob* jobs = allocate_type_array<DecompressionJob>(allocator, num_requests);
+			uint32_t num_jobs = 0;
+
+			for (uint32_t instance_index = 0; instance_index < num_requests; ++instance_index)
+			{
+				const DecompressionRequest<OutputWriterType>& request = requests[sort_keys[instance_index].request_index];
+				instances[instance_index].context = request.context;
+				instances[instance_index].sample_time = request.sample_time;
+				instances[instance_index].writer = request.writer;
+
+				const bool is_new_job = num_jobs == 0 || jobs[num_jobs - 1].clip != request.clip || jobs[num_jobs - 1].num_instances == max_num_requests_per_job;
+				if (is_new_job)
+				{
+					jobs[num_jobs].clip = request.clip;
+					jobs[num_jobs].first_instance_index = instance_index;
+					jobs[num_jobs].num_instances = 0;
+					num_jobs++;
+				}
+
+				jobs[num_jobs - 1].num_instances++;
+			}
+
+			deallocate_type_array(allocator, sort_keys, num_requests);
+
+			DecompressionJobs<SettingsType, OutputWriterType> job_data;
+			job_data.settings = &settings;
+			job_data.jobs = jobs;
+			job_data.instances = instances;
+
+			executor.run_jobs(num_jobs, &DecompressionJobs<SettingsType, OutputWriterType>::run_job, &job_data);
+
+			deallocate_type_array(allocator, jobs, num_requests);
+			deallocate_type_array(allocator, instances, num_requests);
+		}
+	}
+}
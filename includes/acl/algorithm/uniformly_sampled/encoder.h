@@ -53,6 +53,7 @@
 
 #include <stdint.h>
 #include <cstdio>
+#include <cstring>
 
 //////////////////////////////////////////////////////////////////////////
 // Full Precision Encoder
@@ -72,8 +73,15 @@ namespace acl
 {
 	namespace uniformly_sampled
 	{
+		//////////////////////////////////////////////////////////////////////////
 		// Encoder entry point
-		inline CompressedClip* compress_clip(IAllocator& allocator, const AnimationClip& clip, const RigidSkeleton& skeleton, CompressionSettings settings, OutputStats& stats)
+		// The compressed clip is allocated with the provided allocator while every
+		// transient allocation made during compression uses the scratch allocator.
+		// A LinearAllocator is a good fit for the scratch allocator. Note that if a
+		// job executor is provided, the scratch allocator must be thread safe and
+		// compression fails otherwise: a LinearAllocator cannot be used then.
+		//////////////////////////////////////////////////////////////////////////
+		inline CompressedClip* compress_clip(IAllocator& allocator, IAllocator& scratch_allocator, const AnimationClip& clip, const RigidSkeleton& skeleton, CompressionSettings settings, OutputStats& stats)
 		{
 			using namespace impl;
 
@@ -91,19 +99,22 @@ namespace acl
 			if (ACL_TRY_ASSERT(settings_error == nullptr, "%s", settings_error))
 				return nullptr;
 
+			if (ACL_TRY_ASSERT(settings.job_executor == nullptr || scratch_allocator.is_thread_safe(), "The scratch allocator must be thread safe when a job executor is provided"))
+				return nullptr;
+
 			ClipContext raw_clip_context;
-			initialize_clip_context(allocator, clip, skeleton, raw_clip_context);
+			initialize_clip_context(scratch_allocator, clip, skeleton, raw_clip_context);
 
 			ClipContext clip_context;
-			initialize_clip_context(allocator, clip, skeleton, clip_context);
+			initialize_clip_context(scratch_allocator, clip, skeleton, clip_context);
 
-			convert_rotation_streams(allocator, clip_context, settings.rotation_format);
+			convert_rotation_streams(scratch_allocator, clip_context, settings.rotation_format);
 
 			// Extract our clip ranges now, we need it for compacting the constant streams
-			extract_clip_bone_ranges(allocator, clip_context);
+			extract_clip_bone_ranges(scratch_allocator, clip_context);
 
 			// Compact and collapse the constant streams
-			compact_constant_streams(allocator, clip_context, settings.constant_rotation_threshold, settings.constant_translation_threshold, settings.constant_scale_threshold);
+			compact_constant_streams(scratch_allocator, clip_context, settings.constant_rotation_threshold, settings.constant_translation_threshold, settings.constant_scale_threshold);
 
 			uint32_t clip_range_data_size = 0;
 			if (settings.range_reduction != RangeReductionFlags8::None)
@@ -114,7 +125,7 @@ namespace acl
 
 			if (settings.segmenting.enabled)
 			{
-				segment_streams(allocator, clip_context, settings.segmenting);
+				segment_streams(scratch_allocator, clip_context, settings.segmenting);
 
 				// If we have a single segment, disable range reduction since it won't help
 				if (clip_context.num_segments == 1)
@@ -122,12 +133,12 @@ namespace acl
 
 				if (settings.segmenting.range_reduction != RangeReductionFlags8::None)
 				{
-					extract_segment_bone_ranges(allocator, clip_context);
+					extract_segment_bone_ranges(scratch_allocator, clip_context);
 					normalize_segment_streams(clip_context, settings.range_reduction);
 				}
 			}
 
-			quantize_streams(allocator, clip_context, settings, skeleton, raw_clip_context);
+			quantize_streams(scratch_allocator, clip_context, settings, skeleton, raw_clip_context);
 
 			const uint32_t constant_data_size = get_constant_data_size(clip_context);
 
@@ -175,6 +186,9 @@ namespace acl
 
 			uint8_t* buffer = allocate_type_array_aligned<uint8_t>(allocator, buffer_size, 16);
 
+			// Zero the padding between our sections to keep the output deterministic
+			std::memset(buffer, 0, buffer_size);
+
 			CompressedClip* compressed_clip = make_compressed_clip(buffer, buffer_size, AlgorithmType8::UniformlySampled);
 
 			ClipHeader& header = get_clip_header(*compressed_clip);
@@ -186,6 +200,7 @@ namespace acl
 			header.clip_range_reduction = settings.range_reduction;
 			header.segment_range_reduction = settings.segmenting.range_reduction;
 			header.has_scale = clip_context.has_scale ? 1 : 0;
+			header.key_frame_block_size = settings.key_frame_block_size;
 			header.num_samples = num_samples;
 			header.sample_rate = clip.get_sample_rate();
 			header.segment_headers_offset = sizeof(ClipHeader);
@@ -218,7 +233,7 @@ namespace acl
 #if defined(SJSON_CPP_WRITER)
 			if (stats.logging != StatLogging::None)
 			{
-				write_stats(allocator, clip, clip_context, skeleton, *compressed_clip, settings, header, raw_clip_context, compression_time, stats,
+				write_stats(scratch_allocator, clip, clip_context, skeleton, *compressed_clip, settings, header, raw_clip_context, compression_time, stats,
 					[&](IAllocator& allocator)
 					{
 						DecompressionSettings settings;
@@ -233,14 +248,29 @@ namespace acl
 					[&](IAllocator& allocator, void* context)
 					{
 						deallocate_decompression_context(allocator, context);
+					},
+					get_track_offset_index_size(header),
+					[&](IAllocator& allocator, float sample_time, MemoryAccessRecorder& recorder)
+					{
+						const InstrumentedDecompressionSettings<> settings(recorder);
+						void* context = allocate_decompression_context(allocator, settings, *compressed_clip);
+						OutputWriter writer;
+						decompress_pose(settings, *compressed_clip, context, sample_time, writer);
+						deallocate_decompression_context(allocator, context);
 					});
 			}
 #endif
 
-			destroy_clip_context(allocator, clip_context);
-			destroy_clip_context(allocator, raw_clip_context);
+			destroy_clip_context(scratch_allocator, clip_context);
+			destroy_clip_context(scratch_allocator, raw_clip_context);
 
 			return compressed_clip;
 		}
+
+		// Encoder entry point, all allocations use the provided allocator
+		inline CompressedClip* compress_clip(IAllocator& allocator, const AnimationClip& clip, const RigidSkeleton& skeleton, CompressionSettings settings, OutputStats& stats)
+		{
+			return compress_clip(allocator, allocator, clip, skeleton, settings, stats);
+		}
 	}
 }
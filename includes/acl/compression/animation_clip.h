@@ -32,6 +32,7 @@
 #include "acl/math/transform_32.h"
 
 #include <stdint.h>
+#include <utility>
 
 namespace acl
 {
@@ -64,6 +65,31 @@ namespace acl
 			}
 		}
 
+		// Moves the provided bone tracks into the clip, there must be one per skeleton bone
+		AnimationClip(IAllocator& allocator, const RigidSkeleton& skeleton, uint32_t num_samples, uint32_t sample_rate, const String &name, float error_threshold, AnimatedBone* bones)
+			: m_allocator(allocator)
+			, m_bones()
+			, m_error_threshold(error_threshold)
+			, m_num_samples(num_samples)
+			, m_sample_rate(sample_rate)
+			, m_num_bones(skeleton.get_num_bones())
+			, m_name(allocator, name)
+		{
+			m_bones = allocate_type_array<AnimatedBone>(allocator, m_num_bones);
+
+			for (uint16_t bone_index = 0; bone_index < m_num_bones; ++bone_index)
+			{
+				AnimatedBone& bone = bones[bone_index];
+				ACL_ENSURE(bone.rotation_track.get_num_samples() == num_samples, "Invalid number of rotation samples: %u != %u", bone.rotation_track.get_num_samples(), num_samples);
+				ACL_ENSURE(bone.translation_track.get_num_samples() == num_samples, "Invalid number of translation samples: %u != %u", bone.translation_track.get_num_samples(), num_samples);
+				ACL_ENSURE(bone.scale_track.get_num_samples() == num_samples, "Invalid number of scale samples: %u != %u", bone.scale_track.get_num_samples(), num_samples);
+
+				m_bones[bone_index].rotation_track = std::move(bone.rotation_track);
+				m_bones[bone_index].translation_track = std::move(bone.translation_track);
+				m_bones[bone_index].scale_track = std::move(bone.scale_track);
+			}
+		}
+
 		~AnimationClip()
 		{
 			deallocate_type_array(m_allocator, m_bones, m_num_bones);
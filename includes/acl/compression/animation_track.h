@@ -46,7 +46,10 @@ namespace acl
 	class AnimationTrack
 	{
 	public:
-		bool is_initialized() const { return m_allocator != nullptr; }
+		bool is_initialized() const { return m_allocator != nullptr || m_sample_data != nullptr; }
+
+		// Tracks that reference external samples do not own them and cannot be modified
+		bool is_sample_data_owned() const { return m_allocator != nullptr; }
 
 		uint32_t get_num_samples() const { return m_num_samples; }
 
@@ -78,9 +81,19 @@ namespace acl
 			, m_type(type)
 		{}
 
+		AnimationTrack(const double* sample_data, uint32_t num_samples, uint32_t sample_rate, AnimationTrackType8 type)
+			: m_allocator(nullptr)
+			, m_sample_data(const_cast<double*>(sample_data))
+			, m_num_samples(num_samples)
+			, m_sample_rate(sample_rate)
+			, m_type(type)
+		{
+			ACL_ENSURE(is_aligned_to(sample_data, alignof(double)), "Sample data is not aligned");
+		}
+
 		~AnimationTrack()
 		{
-			if (is_initialized())
+			if (is_sample_data_owned())
 				deallocate_type_array(*m_allocator, m_sample_data, m_num_samples * get_animation_track_sample_size(m_type));
 		}
 
@@ -135,6 +148,11 @@ namespace acl
 			std::fill(samples, samples + num_samples, quat_identity_64());
 		}
 
+		// References the provided samples without copying them, they must outlive the track
+		AnimationRotationTrack(const double* sample_data, uint32_t num_samples, uint32_t sample_rate)
+			: AnimationTrack(sample_data, num_samples, sample_rate, AnimationTrackType8::Rotation)
+		{}
+
 		AnimationRotationTrack(AnimationRotationTrack&& other)
 			: AnimationTrack(std::forward<AnimationTrack>(other))
 		{}
@@ -148,6 +166,7 @@ namespace acl
 		VS2015_HACK_NO_INLINE void set_sample(uint32_t sample_index, const Quat_64& rotation)
 		{
 			ACL_ENSURE(is_initialized(), "Track is not initialized");
+			ACL_ENSURE(is_sample_data_owned(), "Track samples are not owned and cannot be modified");
 			ACL_ENSURE(sample_index < m_num_samples, "Invalid sample index. %u >= %u", sample_index, m_num_samples);
 			ACL_ENSURE(quat_is_finite(rotation), "Invalid rotation: [%f, %f, %f, %f]", quat_get_x(rotation), quat_get_y(rotation), quat_get_z(rotation), quat_get_w(rotation));
 			ACL_ENSURE(quat_is_normalized(rotation), "Rotation not normalized: [%f, %f, %f, %f]", quat_get_x(rotation), quat_get_y(rotation), quat_get_z(rotation), quat_get_w(rotation));
@@ -204,6 +223,11 @@ namespace acl
 			std::fill(m_sample_data, m_sample_data + (num_samples * 3), 0.0);
 		}
 
+		// References the provided samples without copying them, they must outlive the track
+		AnimationTranslationTrack(const double* sample_data, uint32_t num_samples, uint32_t sample_rate)
+			: AnimationTrack(sample_data, num_samples, sample_rate, AnimationTrackType8::Translation)
+		{}
+
 		AnimationTranslationTrack(AnimationTranslationTrack&& other)
 			: AnimationTrack(std::forward<AnimationTrack>(other))
 		{}
@@ -217,6 +241,7 @@ namespace acl
 		void set_sample(uint32_t sample_index, const Vector4_64& translation)
 		{
 			ACL_ENSURE(is_initialized(), "Track is not initialized");
+			ACL_ENSURE(is_sample_data_owned(), "Track samples are not owned and cannot be modified");
 			ACL_ENSURE(sample_index < m_num_samples, "Invalid sample index. %u >= %u", sample_index, m_num_samples);
 			ACL_ENSURE(vector_is_finite3(translation), "Invalid translation: [%f, %f, %f]", vector_get_x(translation), vector_get_y(translation), vector_get_z(translation));
 
@@ -271,6 +296,11 @@ namespace acl
 			std::fill(m_sample_data, m_sample_data + (num_samples * 3), 0.0);
 		}
 
+		// References the provided samples without copying them, they must outlive the track
+		AnimationScaleTrack(const double* sample_data, uint32_t num_samples, uint32_t sample_rate)
+			: AnimationTrack(sample_data, num_samples, sample_rate, AnimationTrackType8::Scale)
+		{}
+
 		AnimationScaleTrack(AnimationScaleTrack&& other)
 			: AnimationTrack(std::forward<AnimationTrack>(other))
 		{}
@@ -284,6 +314,7 @@ namespace acl
 		VS2015_HACK_NO_INLINE void set_sample(uint32_t sample_index, const Vector4_64& scale)
 		{
 			ACL_ENSURE(is_initialized(), "Track is not initialized");
+			ACL_ENSURE(is_sample_data_owned(), "Track samples are not owned and cannot be modified");
 			ACL_ENSURE(sample_index < m_num_samples, "Invalid sample index. %u >= %u", sample_index, m_num_samples);
 			ACL_ENSURE(vector_is_finite3(scale) && !vector_all_near_equal3(scale, vector_zero_64()), "Invalid scale: [%f, %f, %f]", vector_get_x(scale), vector_get_y(scale), vector_get_z(scale));
 
@@ -0,0 +1,309 @@
+#pragma once
+
+////////////////////////////////////////////////////////////////////////////////
+// The MIT License (MIT)
+//
+// Copyright (c) 2018 Nicholas Frechette & Animation Compression Library contributors
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+////////////////////////////////////////////////////////////////////////////////
+
+#include "acl/core/bitset.h"
+#include "acl/core/clip_database.h"
+#include "acl/core/compressed_clip.h"
+#include "acl/core/error.h"
+#include "acl/core/hash.h"
+#include "acl/core/iallocator.h"
+#include "acl/core/memory_utils.h"
+#include "acl/compression/compressed_clip_impl.h"
+#include "acl/decompression/segment_streamer.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <new>
+
+namespace acl
+{
+	inline ClipDatabase* make_clip_database(void* buffer, uint32_t size, uint32_t num_clips, uint32_t shared_data_size, uint32_t entries_offset, uint32_t clip_hash_index_offset)
+	{
+		return new(buffer) ClipDatabase(size, num_clips, shared_data_size, entries_offset, clip_hash_index_offset);
+	}
+
+	namespace impl
+	{
+		// Every clip shares its default tracks bitset, its constant tracks bitset, and its constant track data
+		constexpr uint32_t k_num_shared_blocks_per_clip = 3;
+
+		struct SharedClipBlock
+		{
+			const uint8_t* data;
+			uint32_t size;
+			uint32_t hash;
+			uint32_t shared_data_offset;
+		};
+
+		// The bitsets and the constant track data are contiguous in a compressed clip, returns where they start and end relative to the clip header
+		inline void get_shared_clip_data_range(const CompressedClip& clip, uint32_t& out_start_offset, uint32_t& out_end_offset)
+		{
+			const ClipHeader& header = get_clip_header(clip);
+
+			out_start_offset = header.default_tracks_bitset_offset;
+
+			if (header.clip_range_data_offset.is_valid())
+				out_end_offset = header.clip_range_data_offset;
+			else
+				out_end_offset = get_resident_clip_size(clip) - sizeof(CompressedClip);
+		}
+
+		inline bool is_shared_clip_block_less(const SharedClipBlock& lhs, const SharedClipBlock& rhs)
+		{
+			if (lhs.hash != rhs.hash)
+				return lhs.hash < rhs.hash;
+
+			if (lhs.size != rhs.size)
+				return lhs.size < rhs.size;
+
+			return std::memcmp(lhs.data, rhs.data, lhs.size) < 0;
+		}
+
+		inline bool is_shared_clip_block_equal(const SharedClipBlock& lhs, const SharedClipBlock& rhs)
+		{
+			return lhs.hash == rhs.hash && lhs.size == rhs.size && std::memcmp(lhs.data, rhs.data, lhs.size) == 0;
+		}
+
+		// Copies a compressed clip without its bitsets and constant track data
+		inline uint32_t write_stripped_clip(const CompressedClip& clip, uint8_t* output_buffer)
+		{
+			uint32_t shared_start_offset;
+			uint32_t shared_end_offset;
+			get_shared_clip_data_range(clip, shared_start_offset, shared_end_offset);
+
+			// Both ends are 4 byte aligned, everything that follows keeps its alignment
+			const uint32_t shared_size = shared_end_offset - shared_start_offset;
+			ACL_ENSURE(is_aligned_to(shared_size, 4), "Shared clip data must preserve the alignment");
+
+			const uint32_t stripped_size = clip.get_size() - shared_size;
+			if (output_buffer == nullptr)
+				return stripped_size;
+
+			const uint8_t* clip_buffer = safe_ptr_cast<const uint8_t>(&clip);
+			const uint32_t shared_start = sizeof(CompressedClip) + shared_start_offset;
+			std::memcpy(output_buffer, clip_buffer, shared_start);
+			std::memcpy(output_buffer + shared_start, clip_buffer + shared_start + shared_size, clip.get_size() - shared_start - shared_size);
+
+			CompressedClip* stripped_clip = make_compressed_clip(output_buffer, stripped_size, clip.get_algorithm_type());
+			ClipHeader& header = get_clip_header(*stripped_clip);
+
+			header.default_tracks_bitset_offset = InvalidPtrOffset();
+			header.constant_tracks_bitset_offset = InvalidPtrOffset();
+			header.constant_track_data_offset = InvalidPtrOffset();
+
+			if (header.clip_range_data_offset.is_valid())
+				header.clip_range_data_offset = header.clip_range_data_offset - shared_size;
+
+			SegmentHeader* segment_headers = header.get_segment_headers();
+			for (uint16_t segment_index = 0; segment_index < header.num_segments; ++segment_index)
+			{
+				SegmentHeader& segment_header = segment_headers[segment_index];
+
+				if (segment_header.format_per_track_data_offset.is_valid())
+					segment_header.format_per_track_data_offset = segment_header.format_per_track_data_offset - shared_size;
+
+				if (segment_header.range_data_offset.is_valid())
+					segment_header.range_data_offset = segment_header.range_data_offset - shared_size;
+
+				if (segment_header.track_data_offset.is_valid())
+					segment_header.track_data_offset = segment_header.track_data_offset - shared_size;
+			}
+
+			finalize_compressed_clip(*stripped_clip);
+			return stripped_size;
+		}
+	}
+
+	//////////////////////////////////////////////////////////////////////////
+	// Packs the provided compressed clips into a single clip database.
+	// Identical bitsets and constant track data blocks are stored only once.
+	// Every clip must have a unique name, the names and clips are copied.
+	// The returned buffer is 16 byte aligned and must be freed with 'allocator'.
+	//////////////////////////////////////////////////////////////////////////
+	inline ClipDatabase* build_clip_database(IAllocator& allocator, const CompressedClip* const* clips, const char* const* names, uint32_t num_clips)
+	{
+		using namespace impl;
+
+		ACL_ENSURE(clips != nullptr && names != nullptr, "Clips and names cannot be null");
+		ACL_ENSURE(num_clips != 0, "A clip database requires at least one clip");
+
+		const uint32_t num_blocks = num_clips * k_num_shared_blocks_per_clip;
+		SharedClipBlock* blocks = allocate_type_array<SharedClipBlock>(allocator, num_blocks);
+		uint32_t* sorted_indices = allocate_type_array<uint32_t>(allocator, num_blocks);
+
+		for (uint32_t clip_index = 0; clip_index < num_clips; ++clip_index)
+		{
+			const CompressedClip& clip = *clips[clip_index];
+			ACL_ENSURE(clip.is_valid(false), "Clip %u is invalid", clip_index);
+			ACL_ENSURE(clip.get_algorithm_type() == AlgorithmType8::UniformlySampled, "Clip %u has an unsupported algorithm type", clip_index);
+			ACL_ENSURE(names[clip_index] != nullptr, "Clip %u has no name", clip_index);
+
+			const ClipHeader& header = get_clip_header(clip);
+			const uint32_t num_tracks_per_bone = header.has_scale ? 3 : 2;
+			const uint32_t bitset_size = BitSetDescription::make_from_num_bits(header.num_bones * num_tracks_per_bone).get_num_bytes();
+
+			uint32_t shared_start_offset;
+			uint32_t shared_end_offset;
+			get_shared_clip_data_range(clip, shared_start_offset, shared_end_offset);
+
+			// The constant track data includes its padding, it is always zero
+			SharedClipBlock* clip_blocks = blocks + (clip_index * k_num_shared_blocks_per_clip);
+			clip_blocks[0].data = safe_ptr_cast<const uint8_t>(header.get_default_tracks_bitset());
+			clip_blocks[0].size = bitset_size;
+			clip_blocks[1].data = safe_ptr_cast<const uint8_t>(header.get_constant_tracks_bitset());
+			clip_blocks[1].size = bitset_size;
+			clip_blocks[2].data = header.get_constant_track_data();
+			clip_blocks[2].size = header.constant_track_data_offset.is_valid() ? (shared_end_offset - header.constant_track_data_offset) : 0;
+
+			for (uint32_t block_index = 0; block_index < k_num_shared_blocks_per_clip; ++block_index)
+			{
+				SharedClipBlock& block = clip_blocks[block_index];
+				block.hash = block.size != 0 ? hash32(block.data, block.size) : 0;
+				block.shared_data_offset = 0;
+			}
+		}
+
+		// Sort our blocks to find the duplicates, blocks are laid out in sorted order which keeps the output deterministic
+		for (uint32_t block_index = 0; block_index < num_blocks; ++block_index)
+			sorted_indices[block_index] = block_index;
+
+		std::sort(sorted_indices, sorted_indices + num_blocks, [&](uint32_t lhs, uint32_t rhs) { return is_shared_clip_block_less(blocks[lhs], blocks[rhs]); });
+
+		uint32_t shared_data_size = 0;
+		const SharedClipBlock* previous_unique_block = nullptr;
+		for (uint32_t sorted_index = 0; sorted_index < num_blocks; ++sorted_index)
+		{
+			SharedClipBlock& block = blocks[sorted_indices[sorted_index]];
+			if (block.size == 0)
+				continue;
+
+			if (previous_unique_block != nullptr && is_shared_clip_block_equal(*previous_unique_block, block))
+			{
+				block.shared_data_offset = previous_unique_block->shared_data_offset;
+				continue;
+			}
+
+			block.shared_data_offset = shared_data_size;
+			shared_data_size = align_to(shared_data_size + block.size, 4);
+			previous_unique_block = &block;
+		}
+
+		// Entries are sorted by name hash to find clips by name with a binary search
+		uint32_t* name_hashes = allocate_type_array<uint32_t>(allocator, num_clips);
+		uint32_t* entry_clip_indices = allocate_type_array<uint32_t>(allocator, num_clips);
+		for (uint32_t clip_index = 0; clip_index < num_clips; ++clip_index)
+		{
+			name_hashes[clip_index] = hash32(names[clip_index]);
+			entry_clip_indices[clip_index] = clip_index;
+		}
+
+		std::sort(entry_clip_indices, entry_clip_indices + num_clips, [&](uint32_t lhs, uint32_t rhs)
+			{
+				if (name_hashes[lhs] != name_hashes[rhs])
+					return name_hashes[lhs] < name_hashes[rhs];
+
+				return std::strcmp(names[lhs], names[rhs]) < 0;
+			});
+
+		uint32_t buffer_size = 0;
+		buffer_size += sizeof(ClipDatabase);
+		const uint32_t entries_offset = buffer_size;
+		buffer_size += sizeof(ClipDatabaseEntry) * num_clips;				// Entries
+		const uint32_t clip_hash_index_offset = buffer_size;
+		buffer_size += sizeof(uint32_t) * num_clips;						// Clip hash index
+		const uint32_t names_offset = buffer_size;
+		for (uint32_t clip_index = 0; clip_index < num_clips; ++clip_index)
+			buffer_size += uint32_t(std::strlen(names[clip_index])) + 1;	// Names
+		buffer_size = align_to(buffer_size, 4);								// Align shared data
+		const uint32_t shared_data_offset = buffer_size;
+		buffer_size += shared_data_size;									// Shared data
+		for (uint32_t clip_index = 0; clip_index < num_clips; ++clip_index)
+		{
+			buffer_size = align_to(buffer_size, alignof(CompressedClip));	// Align clip
+			buffer_size += write_stripped_clip(*clips[clip_index], nullptr);	// Clip
+		}
+
+		uint8_t* buffer = allocate_type_array_aligned<uint8_t>(allocator, buffer_size, alignof(ClipDatabase));
+
+		// Zero the padding between our sections to keep the output deterministic
+		std::memset(buffer, 0, buffer_size);
+
+		ClipDatabaseEntry* entries = safe_ptr_cast<ClipDatabaseEntry>(buffer + entries_offset);
+		uint32_t name_offset = names_offset;
+		uint32_t clip_offset = shared_data_offset + shared_data_size;
+
+		for (uint32_t entry_index = 0; entry_index < num_clips; ++entry_index)
+		{
+			const uint32_t clip_index = entry_clip_indices[entry_index];
+			const CompressedClip& clip = *clips[clip_index];
+			const char* name = names[clip_index];
+			const uint32_t name_size = uint32_t(std::strlen(name));
+
+			ACL_ENSURE(entry_index == 0 || std::strcmp(names[entry_clip_indices[entry_index - 1]], name) != 0, "Clip names must be unique: %s", name);
+
+			ClipDatabaseEntry& entry = entries[entry_index];
+			entry.name_hash = name_hashes[clip_index];
+			entry.clip_hash = clip.get_hash();
+			entry.name_offset = name_offset;
+			entry.name_size = name_size;
+
+			std::memcpy(buffer + name_offset, name, name_size);
+			name_offset += name_size + 1;
+
+			const SharedClipBlock* clip_blocks = blocks + (clip_index * k_num_shared_blocks_per_clip);
+			entry.default_tracks_bitset_offset = shared_data_offset + clip_blocks[0].shared_data_offset;
+			entry.constant_tracks_bitset_offset = shared_data_offset + clip_blocks[1].shared_data_offset;
+			entry.constant_track_data_offset = clip_blocks[2].size != 0 ? PtrOffset32<const uint8_t>(shared_data_offset + clip_blocks[2].shared_data_offset) : PtrOffset32<const uint8_t>(InvalidPtrOffset());
+
+			for (uint32_t block_index = 0; block_index < k_num_shared_blocks_per_clip; ++block_index)
+			{
+				const SharedClipBlock& block = clip_blocks[block_index];
+				if (block.size != 0)
+					std::memcpy(buffer + shared_data_offset + block.shared_data_offset, block.data, block.size);
+			}
+
+			clip_offset = align_to(clip_offset, alignof(CompressedClip));
+			entry.clip_offset = clip_offset;
+			clip_offset += write_stripped_clip(clip, buffer + clip_offset);
+		}
+
+		ACL_ENSURE(clip_offset == buffer_size, "Clip database size mismatch: %u != %u", clip_offset, buffer_size);
+
+		uint32_t* clip_hash_index = safe_ptr_cast<uint32_t>(buffer + clip_hash_index_offset);
+		for (uint32_t entry_index = 0; entry_index < num_clips; ++entry_index)
+			clip_hash_index[entry_index] = entry_index;
+
+		std::sort(clip_hash_index, clip_hash_index + num_clips, [&](uint32_t lhs, uint32_t rhs) { return entries[lhs].clip_hash < entries[rhs].clip_hash; });
+
+		deallocate_type_array(allocator, entry_clip_indices, num_clips);
+		deallocate_type_array(allocator, name_hashes, num_clips);
+		deallocate_type_array(allocator, sorted_indices, num_blocks);
+		deallocate_type_array(allocator, blocks, num_blocks);
+
+		return make_clip_database(buffer, buffer_size, num_clips, shared_data_size, entries_offset, clip_hash_index_offset);
+	}
+}
@@ -25,6 +25,7 @@
 ////////////////////////////////////////////////////////////////////////////////
 
 #include "acl/core/hash.h"
+#include "acl/core/ijob_executor.h"
 #include "acl/core/track_types.h"
 #include "acl/core/range_reduction_types.h"
 #include "acl/compression/skeleton_error_metric.h"
@@ -78,6 +79,9 @@ namespace acl
 		}
 	};
 
+	// Larger blocks would spread a single pose over too many cache lines
+	constexpr uint8_t k_max_key_frame_block_size = 32;
+
 	struct CompressionSettings
 	{
 		RotationFormat8 rotation_format;
@@ -88,6 +92,11 @@ namespace acl
 
 		SegmentingSettings segmenting;
 
+		// Animated data is stored in blocks of this many key frames, sorted by track within a block.
+		// A size of 1 stores whole poses one after the other. Larger blocks place the key frames
+		// a track interpolates next to each other at the cost of spreading a pose over the whole block.
+		uint8_t key_frame_block_size;
+
 		ISkeletalErrorMetric* error_metric;
 
 		// Constant thresholds are used with the track range:
@@ -97,16 +106,23 @@ namespace acl
 		float constant_translation_threshold;
 		float constant_scale_threshold;
 
+		// Optional, when provided segments are quantized in parallel with it.
+		// The allocator used to compress must then be thread safe, see 'IAllocator::is_thread_safe'.
+		// The compressed output is identical with or without it.
+		IJobExecutor* job_executor;
+
 		CompressionSettings()
 			: rotation_format(RotationFormat8::Quat_128)
 			, translation_format(VectorFormat8::Vector3_96)
 			, scale_format(VectorFormat8::Vector3_96)
 			, range_reduction(RangeReductionFlags8::None)
 			, segmenting()
+			, key_frame_block_size(1)
 			, error_metric(nullptr)
 			, constant_rotation_threshold(0.00001f)
 			, constant_translation_threshold(0.001f)
 			, constant_scale_threshold(0.00001f)
+			, job_executor(nullptr)
 		{}
 
 		uint32_t hash() const
@@ -120,6 +136,9 @@ namespace acl
 			if (segmenting.enabled)
 				hash_value = hash_combine(hash_value, segmenting.get_hash());
 
+			if (key_frame_block_size != 1)
+				hash_value = hash_combine(hash_value, hash32(key_frame_block_size));
+
 			if (error_metric != nullptr)
 				hash_value = hash_combine(hash_value, error_metric->get_hash());
 
@@ -148,12 +167,23 @@ namespace acl
 					return "This scale format requires range reduction to be enabled at the clip or segment level";
 			}
 
+			if (get_rotation_variant(rotation_format) == RotationVariant8::QuatDropLargest)
+			{
+				const bool has_clip_range_reduction = are_any_enum_flags_set(range_reduction, RangeReductionFlags8::Rotations);
+				const bool has_segment_range_reduction = segmenting.enabled && are_any_enum_flags_set(segmenting.range_reduction, RangeReductionFlags8::Rotations);
+				if (has_clip_range_reduction || has_segment_range_reduction)
+					return "This rotation format does not support range reduction";
+			}
+
 			if (segmenting.enabled && segmenting.range_reduction != RangeReductionFlags8::None)
 			{
 				if (range_reduction == RangeReductionFlags8::None)
 					return "Per segment range reduction requires per clip range reduction to be enabled";
 			}
 
+			if (key_frame_block_size == 0 || key_frame_block_size > k_max_key_frame_block_size)
+				return "key_frame_block_size must be between 1 and 32";
+
 			if (error_metric == nullptr)
 				return "error_metric cannot be NULL";
 
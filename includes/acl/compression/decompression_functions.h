@@ -30,9 +30,13 @@
 namespace acl
 {
 	class IAllocator;
+	class MemoryAccessRecorder;
 	struct Transform_32;
 
 	typedef std::function<void*(IAllocator& allocator)> AllocateDecompressionContext;
 	typedef std::function<void(IAllocator& allocator, void* context)> DeallocateDecompressionContext;
 	typedef std::function<void(void* context, float sample_time, Transform_32* out_transforms, uint16_t num_transforms)> DecompressPose;
+
+	// Decompresses a pose with a fresh context and records every compressed byte the decoder reads
+	typedef std::function<void(IAllocator& allocator, float sample_time, MemoryAccessRecorder& recorder)> RecordDecompressionMemoryAccess;
 }
@@ -26,6 +26,7 @@
 
 #include "acl/core/iallocator.h"
 #include "acl/core/error.h"
+#include "acl/math/quat_packing.h"
 #include "acl/math/vector4_32.h"
 #include "acl/compression/stream/clip_context.h"
 
@@ -52,7 +53,11 @@ namespace acl
 			ACL_ENSURE(bone_stream.translations.get_sample_size() == sizeof(Vector4_32), "Unexpected translation sample size. %u != %u", bone_stream.translations.get_sample_size(), sizeof(Vector4_32));
 			ACL_ENSURE(bone_stream.scales.get_sample_size() == sizeof(Vector4_32), "Unexpected scale sample size. %u != %u", bone_stream.scales.get_sample_size(), sizeof(Vector4_32));
 
-			if (bone_range.rotation.is_constant(rotation_threshold))
+			// The logarithm is scaled by 2/PI, scale the threshold to keep the same tolerance on the quaternion
+			const bool is_rotation_log = get_rotation_variant(bone_stream.rotations.get_rotation_format()) == RotationVariant8::QuatLog;
+			const float rotation_range_threshold = is_rotation_log ? (rotation_threshold * (2.0f / k_pi_32)) : rotation_threshold;
+
+			if (bone_range.rotation.is_constant(rotation_range_threshold))
 			{
 				RotationTrackStream constant_stream(allocator, 1, bone_stream.rotations.get_sample_size(), bone_stream.rotations.get_sample_rate(), bone_stream.rotations.get_rotation_format());
 				Vector4_32 rotation = bone_stream.rotations.get_raw_sample<Vector4_32>(0);
@@ -60,7 +65,7 @@ namespace acl
 
 				bone_stream.rotations = std::move(constant_stream);
 				bone_stream.is_rotation_constant = true;
-				bone_stream.is_rotation_default = quat_near_identity(vector_to_quat(rotation));
+				bone_stream.is_rotation_default = quat_near_identity(is_rotation_log ? quat_from_normalized_log(rotation) : vector_to_quat(rotation));
 
 				bone_range.rotation = TrackStreamRange(rotation, rotation);
 			}
@@ -27,6 +27,7 @@
 #include "acl/core/iallocator.h"
 #include "acl/core/error.h"
 #include "acl/math/quat_32.h"
+#include "acl/math/quat_packing.h"
 #include "acl/math/vector4_32.h"
 #include "acl/compression/stream/clip_context.h"
 
@@ -34,11 +35,19 @@
 
 namespace acl
 {
+	// Rotations are kept in the highest precision format of their variant until they are quantized.
+	// The largest component can only be dropped once quantized and the full quaternion is kept until then.
+	inline RotationFormat8 get_high_precision_rotation_format(RotationFormat8 format)
+	{
+		const RotationVariant8 variant = get_rotation_variant(format);
+		return variant == RotationVariant8::QuatDropLargest ? RotationFormat8::Quat_128 : get_highest_variant_precision(variant);
+	}
+
 	inline Vector4_32 convert_rotation(const Vector4_32& rotation, RotationFormat8 from, RotationFormat8 to)
 	{
 		ACL_ENSURE(from == RotationFormat8::Quat_128, "Source rotation format must be a full precision quaternion");
 
-		const RotationFormat8 high_precision_format = get_rotation_variant(to) == RotationVariant8::Quat ? RotationFormat8::Quat_128 : RotationFormat8::QuatDropW_96;
+		const RotationFormat8 high_precision_format = get_high_precision_rotation_format(to);
 		switch (high_precision_format)
 		{
 		case RotationFormat8::Quat_128:
@@ -47,6 +56,9 @@ namespace acl
 		case RotationFormat8::QuatDropW_96:
 			// Drop W, we just ensure it is positive and write it back, the W component can be ignored afterwards
 			return quat_to_vector(quat_ensure_positive_w(vector_to_quat(rotation)));
+		case RotationFormat8::QuatLog_96:
+			// Logarithm, [x,y,z] replace the quaternion and the W component is zero
+			return quat_to_normalized_log(vector_to_quat(rotation));
 		default:
 			ACL_ENSURE(false, "Invalid or unsupported rotation format: %s", get_rotation_format_name(to));
 			return rotation;
@@ -55,7 +67,7 @@ namespace acl
 
 	inline void convert_rotation_streams(IAllocator& allocator, SegmentContext& segment, RotationFormat8 rotation_format)
 	{
-		const RotationFormat8 high_precision_format = get_rotation_variant(rotation_format) == RotationVariant8::Quat ? RotationFormat8::Quat_128 : RotationFormat8::QuatDropW_96;
+		const RotationFormat8 high_precision_format = get_high_precision_rotation_format(rotation_format);
 
 		for (BoneStreams& bone_stream : segment.bone_iterator())
 		{
@@ -69,23 +81,8 @@ namespace acl
 
 			for (uint32_t sample_index = 0; sample_index < num_samples; ++sample_index)
 			{
-				Quat_32 rotation = bone_stream.rotations.get_raw_sample<Quat_32>(sample_index);
-
-				switch (high_precision_format)
-				{
-				case RotationFormat8::Quat_128:
-					// Original format, nothing to do
-					break;
-				case RotationFormat8::QuatDropW_96:
-					// Drop W, we just ensure it is positive and write it back, the W component can be ignored afterwards
-					rotation = quat_ensure_positive_w(rotation);
-					break;
-				default:
-					ACL_ENSURE(false, "Invalid or unsupported rotation format: %s", get_rotation_format_name(high_precision_format));
-					break;
-				}
-
-				converted_stream.set_raw_sample(sample_index, rotation);
+				const Vector4_32 rotation = bone_stream.rotations.get_raw_sample<Vector4_32>(sample_index);
+				converted_stream.set_raw_sample(sample_index, convert_rotation(rotation, RotationFormat8::Quat_128, high_precision_format));
 			}
 
 			bone_stream.rotations = std::move(converted_stream);
@@ -179,8 +179,15 @@ namespace acl
 				case RotationFormat8::QuatDropW_48:
 				case RotationFormat8::QuatDropW_32:
 				case RotationFormat8::QuatDropW_Variable:
+				case RotationFormat8::QuatLog_96:
+				case RotationFormat8::QuatLog_48:
+				case RotationFormat8::QuatLog_32:
+				case RotationFormat8::QuatLog_Variable:
 					ACL_ENSURE(vector_all_greater_equal3(normalized_rotation, vector_zero_32()) && vector_all_less_equal3(normalized_rotation, vector_set(1.0f)), "Invalid normalized rotation. 0.0 <= [%f, %f, %f] <= 1.0", vector_get_x(normalized_rotation), vector_get_y(normalized_rotation), vector_get_z(normalized_rotation));
 					break;
+				default:
+					ACL_ENSURE(false, "Invalid or unsupported rotation format for range reduction: %s", get_rotation_format_name(bone_stream.rotations.get_rotation_format()));
+					break;
 				}
 #endif
 
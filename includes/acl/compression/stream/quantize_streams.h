@@ -37,6 +37,7 @@
 #include "acl/compression/skeleton_error_metric.h"
 #include "acl/compression/compression_settings.h"
 
+#include <algorithm>
 #include <cstddef>
 #include <cstdint>
 
@@ -71,8 +72,22 @@ namespace acl
 
 			const BoneStreams* raw_bone_streams;
 
-			Transform_32* raw_local_pose;
-			Transform_32* lossy_local_pose;
+			// The bit rate search only ever modifies a few bones at a time. To avoid resampling
+			// identical data, we cache the local space transform of every bone at every segment sample.
+			// Raw transforms never change and lossy transforms are only resampled when the bit rate changes.
+			// Layout is [sample_index * num_bones + bone_index]
+			// When the cache would exceed 'k_max_local_pose_cache_size', the pose arrays only hold a single
+			// sample and every transform is resampled, see 'is_local_pose_cache_enabled'.
+			// Object space transforms of the ancestors are not cached, the error metric composes them
+			// from the local pose every time since 'ISkeletalErrorMetric' only takes local poses.
+			Transform_32* raw_local_pose_cache;
+			Transform_32* lossy_local_pose_cache;
+			BoneBitRate* lossy_local_pose_cache_bit_rates;
+			bool* is_raw_local_pose_cached;
+			bool* is_lossy_local_pose_cached;
+			uint32_t num_local_pose_transforms;
+			uint32_t num_cached_transforms;
+
 			BoneBitRate* bit_rate_per_bone;
 
 			QuantizationContext(IAllocator& allocator_, ClipContext& clip_, const ClipContext& raw_clip_, SegmentContext& segment_, const CompressionSettings& settings_, const RigidSkeleton& skeleton_)
@@ -97,17 +112,54 @@ namespace acl
 				segment_duration = float(num_samples - 1) / sample_rate;
 				has_scale = segment_context_has_scale(segment_);
 
-				raw_local_pose = allocate_type_array<Transform_32>(allocator, num_bones);
-				lossy_local_pose = allocate_type_array<Transform_32>(allocator, num_bones);
+				// Only the variable bit rate search samples our streams
+				const bool is_any_variable = is_rotation_format_variable(rotation_format) || is_vector_format_variable(translation_format) || is_vector_format_variable(scale_format);
+				const size_t num_segment_transforms = size_t(num_samples) * num_bones;
+				const bool use_cache = num_segment_transforms * k_local_pose_cache_transform_size <= k_max_local_pose_cache_size;
+
+				num_local_pose_transforms = is_any_variable ? uint32_t(use_cache ? num_segment_transforms : num_bones) : 0;
+				num_cached_transforms = is_any_variable && use_cache ? num_local_pose_transforms : 0;
+
+				raw_local_pose_cache = nullptr;
+				lossy_local_pose_cache = nullptr;
+				if (num_local_pose_transforms != 0)
+				{
+					raw_local_pose_cache = allocate_type_array<Transform_32>(allocator, num_local_pose_transforms);
+					lossy_local_pose_cache = allocate_type_array<Transform_32>(allocator, num_local_pose_transforms);
+				}
+
+				lossy_local_pose_cache_bit_rates = nullptr;
+				is_raw_local_pose_cached = nullptr;
+				is_lossy_local_pose_cached = nullptr;
+				if (num_cached_transforms != 0)
+				{
+					lossy_local_pose_cache_bit_rates = allocate_type_array<BoneBitRate>(allocator, num_cached_transforms);
+					is_raw_local_pose_cached = allocate_type_array<bool>(allocator, num_cached_transforms);
+					is_lossy_local_pose_cached = allocate_type_array<bool>(allocator, num_cached_transforms);
+					std::fill(is_raw_local_pose_cached, is_raw_local_pose_cached + num_cached_transforms, false);
+					std::fill(is_lossy_local_pose_cached, is_lossy_local_pose_cached + num_cached_transforms, false);
+				}
+
 				bit_rate_per_bone = allocate_type_array<BoneBitRate>(allocator, num_bones);
 			}
 
 			~QuantizationContext()
 			{
-				deallocate_type_array(allocator, raw_local_pose, num_bones);
-				deallocate_type_array(allocator, lossy_local_pose, num_bones);
+				deallocate_type_array(allocator, raw_local_pose_cache, num_local_pose_transforms);
+				deallocate_type_array(allocator, lossy_local_pose_cache, num_local_pose_transforms);
+				deallocate_type_array(allocator, lossy_local_pose_cache_bit_rates, num_cached_transforms);
+				deallocate_type_array(allocator, is_raw_local_pose_cached, num_cached_transforms);
+				deallocate_type_array(allocator, is_lossy_local_pose_cached, num_cached_transforms);
 				deallocate_type_array(allocator, bit_rate_per_bone, num_bones);
 			}
+
+			bool is_local_pose_cache_enabled() const { return num_cached_transforms != 0; }
+
+			// Every cached transform needs a raw and lossy transform, the lossy bit rate, and two flags
+			static constexpr size_t k_local_pose_cache_transform_size = (sizeof(Transform_32) * 2) + sizeof(BoneBitRate) + (sizeof(bool) * 2);
+
+			// Segments are quantized in parallel when a job executor is provided, every one of them has its own cache
+			static constexpr size_t k_max_local_pose_cache_size = 4 * 1024 * 1024;
 		};
 
 		inline void quantize_fixed_rotation_stream(IAllocator& allocator, const RotationTrackStream& raw_stream, RotationFormat8 rotation_format, bool are_rotations_normalized, RotationTrackStream& out_quantized_stream)
@@ -131,15 +183,22 @@ namespace acl
 					pack_vector4_128(quat_to_vector(rotation), quantized_ptr);
 					break;
 				case RotationFormat8::QuatDropW_96:
+				case RotationFormat8::QuatLog_96:
 					pack_vector3_96(quat_to_vector(rotation), quantized_ptr);
 					break;
 				case RotationFormat8::QuatDropW_48:
+				case RotationFormat8::QuatLog_48:
 					pack_vector3_48(quat_to_vector(rotation), are_rotations_normalized, quantized_ptr);
 					break;
 				case RotationFormat8::QuatDropW_32:
+				case RotationFormat8::QuatLog_32:
 					pack_vector3_32(quat_to_vector(rotation), 11, 11, 10, are_rotations_normalized, quantized_ptr);
 					break;
+				case RotationFormat8::Quat_32_Largest:
+					pack_quat_32_largest(rotation, quantized_ptr);
+					break;
 				case RotationFormat8::QuatDropW_Variable:
+				case RotationFormat8::QuatLog_Variable:
 				default:
 					ACL_ENSURE(false, "Invalid or unsupported rotation format: %s", get_rotation_format_name(rotation_format));
 					break;
@@ -165,20 +224,23 @@ namespace acl
 
 		inline void quantize_variable_rotation_stream(QuantizationContext& context, const RotationTrackStream& raw_clip_stream, const RotationTrackStream& raw_segment_stream, const TrackStreamRange& clip_range, uint8_t bit_rate, bool are_rotations_normalized, RotationTrackStream& out_quantized_stream)
 		{
+			const RotationFormat8 rotation_format = context.rotation_format;
+			ACL_ENSURE(is_rotation_format_variable(rotation_format), "Expected a variable rotation format: %s", get_rotation_format_name(rotation_format));
+
 			// We expect all our samples to have the same width of sizeof(Vector4_32)
 			ACL_ENSURE(raw_segment_stream.get_sample_size() == sizeof(Vector4_32), "Unexpected rotation sample size. %u != %u", raw_segment_stream.get_sample_size(), sizeof(Vector4_32));
 
 			const uint32_t num_samples = is_constant_bit_rate(bit_rate) ? 1 : raw_segment_stream.get_num_samples();
 			const uint32_t sample_size = sizeof(uint64_t) * 2;
 			const uint32_t sample_rate = raw_segment_stream.get_sample_rate();
-			RotationTrackStream quantized_stream(context.allocator, num_samples, sample_size, sample_rate, RotationFormat8::QuatDropW_Variable, bit_rate);
+			RotationTrackStream quantized_stream(context.allocator, num_samples, sample_size, sample_rate, rotation_format, bit_rate);
 
 			if (is_constant_bit_rate(bit_rate))
 			{
 				ACL_ENSURE(are_rotations_normalized, "Cannot drop a constant track if it isn't normalized");
 
 				Vector4_32 rotation = raw_clip_stream.get_raw_sample<Vector4_32>(context.segment_sample_start_index);
-				rotation = convert_rotation(rotation, RotationFormat8::Quat_128, RotationFormat8::QuatDropW_Variable);
+				rotation = convert_rotation(rotation, RotationFormat8::Quat_128, rotation_format);
 
 				const Vector4_32 normalized_rotation = normalize_sample(rotation, clip_range);
 
@@ -196,7 +258,7 @@ namespace acl
 					if (is_raw_bit_rate(bit_rate))
 					{
 						Vector4_32 rotation = raw_clip_stream.get_raw_sample<Vector4_32>(context.segment_sample_start_index + sample_index);
-						rotation = convert_rotation(rotation, RotationFormat8::Quat_128, RotationFormat8::QuatDropW_Variable);
+						rotation = convert_rotation(rotation, RotationFormat8::Quat_128, rotation_format);
 						pack_vector3_96(rotation, quantized_ptr);
 					}
 					else
@@ -221,7 +283,7 @@ namespace acl
 				return;
 
 			const BoneStreams& raw_bone_stream = context.raw_bone_streams[bone_index];
-			const RotationFormat8 highest_bit_rate = get_highest_variant_precision(RotationVariant8::QuatDropW);
+			const RotationFormat8 highest_bit_rate = get_highest_variant_precision(get_rotation_variant(context.rotation_format));
 			const TrackStreamRange invalid_range;
 			const TrackStreamRange& bone_range = context.clip.are_rotations_normalized ? context.clip.ranges[bone_index].rotation : invalid_range;
 			const bool are_rotations_normalized = context.clip.are_rotations_normalized && !bone_stream.is_rotation_constant;
@@ -467,34 +529,113 @@ namespace acl
 				quantize_variable_scale_stream(context, raw_bone_stream.scales, bone_stream.scales, bone_range, bit_rate, bone_stream.scales);
 		}
 
+		inline bool are_bit_rates_equal(const BoneBitRate& lhs, const BoneBitRate& rhs)
+		{
+			return lhs.rotation == rhs.rotation && lhs.translation == rhs.translation && lhs.scale == rhs.scale;
+		}
+
+		inline const Transform_32* sample_cached_raw_pose_hierarchical(QuantizationContext& context, uint32_t sample_index, uint16_t target_bone_index)
+		{
+			const float ref_sample_time = min(float(context.segment_sample_start_index + sample_index) / context.sample_rate, context.clip_duration);
+
+			if (!context.is_local_pose_cache_enabled())
+			{
+				Transform_32* raw_local_pose = context.raw_local_pose_cache;
+
+				uint16_t current_bone_index = target_bone_index;
+				while (current_bone_index != k_invalid_bone_index)
+				{
+					raw_local_pose[current_bone_index] = sample_stream(context.raw_bone_streams, ref_sample_time, current_bone_index);
+					current_bone_index = context.raw_bone_streams[current_bone_index].parent_bone_index;
+				}
+
+				return raw_local_pose;
+			}
+
+			const uint32_t sample_offset = sample_index * context.num_bones;
+			Transform_32* raw_local_pose = context.raw_local_pose_cache + sample_offset;
+			bool* is_cached = context.is_raw_local_pose_cached + sample_offset;
+
+			uint16_t current_bone_index = target_bone_index;
+			while (current_bone_index != k_invalid_bone_index)
+			{
+				if (!is_cached[current_bone_index])
+				{
+					raw_local_pose[current_bone_index] = sample_stream(context.raw_bone_streams, ref_sample_time, current_bone_index);
+					is_cached[current_bone_index] = true;
+				}
+
+				current_bone_index = context.raw_bone_streams[current_bone_index].parent_bone_index;
+			}
+
+			return raw_local_pose;
+		}
+
+		inline const Transform_32* sample_cached_lossy_pose_hierarchical(QuantizationContext& context, uint32_t sample_index, uint16_t target_bone_index)
+		{
+			const float sample_time = min(float(sample_index) / context.sample_rate, context.segment_duration);
+
+			if (!context.is_local_pose_cache_enabled())
+			{
+				Transform_32* lossy_local_pose = context.lossy_local_pose_cache;
+
+				uint16_t current_bone_index = target_bone_index;
+				while (current_bone_index != k_invalid_bone_index)
+				{
+					lossy_local_pose[current_bone_index] = sample_stream(context.bone_streams, context.raw_bone_streams, sample_time, current_bone_index, context.bit_rate_per_bone, context.rotation_format, context.translation_format, context.scale_format);
+					current_bone_index = context.bone_streams[current_bone_index].parent_bone_index;
+				}
+
+				return lossy_local_pose;
+			}
+
+			const uint32_t sample_offset = sample_index * context.num_bones;
+			Transform_32* lossy_local_pose = context.lossy_local_pose_cache + sample_offset;
+			BoneBitRate* cached_bit_rates = context.lossy_local_pose_cache_bit_rates + sample_offset;
+			bool* is_cached = context.is_lossy_local_pose_cached + sample_offset;
+
+			uint16_t current_bone_index = target_bone_index;
+			while (current_bone_index != k_invalid_bone_index)
+			{
+				const BoneBitRate& bone_bit_rate = context.bit_rate_per_bone[current_bone_index];
+				if (!is_cached[current_bone_index] || !are_bit_rates_equal(cached_bit_rates[current_bone_index], bone_bit_rate))
+				{
+					lossy_local_pose[current_bone_index] = sample_stream(context.bone_streams, context.raw_bone_streams, sample_time, current_bone_index, context.bit_rate_per_bone, context.rotation_format, context.translation_format, context.scale_format);
+					cached_bit_rates[current_bone_index] = bone_bit_rate;
+					is_cached[current_bone_index] = true;
+				}
+
+				current_bone_index = context.bone_streams[current_bone_index].parent_bone_index;
+			}
+
+			return lossy_local_pose;
+		}
+
 		inline float calculate_max_error_at_bit_rate(QuantizationContext& context, uint16_t target_bone_index, bool use_local_error, bool scan_whole_clip = false)
 		{
 			float max_error = 0.0f;
 
 			for (uint32_t sample_index = 0; sample_index < context.num_samples; ++sample_index)
 			{
-				// Sample our streams and calculate the error
-				const float sample_time = min(float(sample_index) / context.sample_rate, context.segment_duration);
-				const float ref_sample_time = min(float(context.segment_sample_start_index + sample_index) / context.sample_rate, context.clip_duration);
-
-				sample_streams_hierarchical(context.raw_bone_streams, context.num_bones, ref_sample_time, target_bone_index, context.raw_local_pose);
-				sample_streams_hierarchical(context.bone_streams, context.raw_bone_streams, context.num_bones, sample_time, target_bone_index, context.bit_rate_per_bone, context.rotation_format, context.translation_format, context.scale_format, context.lossy_local_pose);
+				// Sample our streams and calculate the error, only the bones with a new bit rate are resampled
+				const Transform_32* raw_local_pose = sample_cached_raw_pose_hierarchical(context, sample_index, target_bone_index);
+				const Transform_32* lossy_local_pose = sample_cached_lossy_pose_hierarchical(context, sample_index, target_bone_index);
 
 				// Constant branch
 				float error;
 				if (use_local_error)
 				{
 					if (context.has_scale)
-						error = context.error_metric.calculate_local_bone_error(context.skeleton, context.raw_local_pose, context.lossy_local_pose, target_bone_index);
+						error = context.error_metric.calculate_local_bone_error(context.skeleton, raw_local_pose, lossy_local_pose, target_bone_index);
 					else
-						error = context.error_metric.calculate_local_bone_error_no_scale(context.skeleton, context.raw_local_pose, context.lossy_local_pose, target_bone_index);
+						error = context.error_metric.calculate_local_bone_error_no_scale(context.skeleton, raw_local_pose, lossy_local_pose, target_bone_index);
 				}
 				else
 				{
 					if (context.has_scale)
-						error = context.error_metric.calculate_object_bone_error(context.skeleton, context.raw_local_pose, context.lossy_local_pose, target_bone_index);
+						error = context.error_metric.calculate_object_bone_error(context.skeleton, raw_local_pose, lossy_local_pose, target_bone_index);
 					else
-						error = context.error_metric.calculate_object_bone_error_no_scale(context.skeleton, context.raw_local_pose, context.lossy_local_pose, target_bone_index);
+						error = context.error_metric.calculate_object_bone_error_no_scale(context.skeleton, raw_local_pose, lossy_local_pose, target_bone_index);
 				}
 
 				max_error = max(max_error, error);
@@ -1150,37 +1291,73 @@ namespace acl
 		}
 	}
 
-	inline void quantize_streams(IAllocator& allocator, ClipContext& clip_context, const CompressionSettings& settings, const RigidSkeleton& skeleton, const ClipContext& raw_clip_context)
+	namespace impl
 	{
-		const bool is_rotation_variable = is_rotation_format_variable(settings.rotation_format);
-		const bool is_translation_variable = is_vector_format_variable(settings.translation_format);
-		const bool is_scale_variable = is_vector_format_variable(settings.scale_format);
-		const bool is_any_variable = is_rotation_variable || is_translation_variable || is_scale_variable;
-
-		for (SegmentContext& segment : clip_context.segment_iterator())
+		inline void quantize_segment(IAllocator& allocator, ClipContext& clip_context, SegmentContext& segment, const CompressionSettings& settings, const RigidSkeleton& skeleton, const ClipContext& raw_clip_context)
 		{
 #if ACL_DEBUG_VARIABLE_QUANTIZATION
 			printf("Quantizing segment %u...\n", segment.segment_index);
 #endif
 
+			const bool is_rotation_variable = is_rotation_format_variable(settings.rotation_format);
+			const bool is_translation_variable = is_vector_format_variable(settings.translation_format);
+			const bool is_scale_variable = is_vector_format_variable(settings.scale_format);
+			const bool is_any_variable = is_rotation_variable || is_translation_variable || is_scale_variable;
+
 			// TODO: Reuse the context if we can and just update the current segment
-			impl::QuantizationContext context(allocator, clip_context, raw_clip_context, segment, settings, skeleton);
+			QuantizationContext context(allocator, clip_context, raw_clip_context, segment, settings, skeleton);
 
 			if (is_any_variable)
 			{
-				impl::quantize_variable_streams(context);
+				quantize_variable_streams(context);
 			}
 			else
 			{
 				for (uint16_t bone_index = 0; bone_index < segment.num_bones; ++bone_index)
 				{
-					impl::quantize_fixed_rotation_stream(context, bone_index, settings.rotation_format);
-					impl::quantize_fixed_translation_stream(context, bone_index, settings.translation_format);
+					quantize_fixed_rotation_stream(context, bone_index, settings.rotation_format);
+					quantize_fixed_translation_stream(context, bone_index, settings.translation_format);
 
 					if (clip_context.has_scale)
-						impl::quantize_fixed_scale_stream(context, bone_index, settings.scale_format);
+						quantize_fixed_scale_stream(context, bone_index, settings.scale_format);
 				}
 			}
 		}
+
+		struct QuantizeSegmentJobData
+		{
+			IAllocator* allocator;
+			ClipContext* clip_context;
+			const CompressionSettings* settings;
+			const RigidSkeleton* skeleton;
+			const ClipContext* raw_clip_context;
+		};
+
+		inline void quantize_segment_job(void* user_data, uint32_t job_index)
+		{
+			const QuantizeSegmentJobData& job_data = *safe_ptr_cast<const QuantizeSegmentJobData>(user_data);
+			ClipContext& clip_context = *job_data.clip_context;
+
+			ACL_ENSURE(job_index < clip_context.num_segments, "Invalid segment index: %u", job_index);
+			quantize_segment(*job_data.allocator, clip_context, clip_context.segments[job_index], *job_data.settings, *job_data.skeleton, *job_data.raw_clip_context);
+		}
+	}
+
+	inline void quantize_streams(IAllocator& allocator, ClipContext& clip_context, const CompressionSettings& settings, const RigidSkeleton& skeleton, const ClipContext& raw_clip_context)
+	{
+		// Once the clip ranges are extracted, every segment is independent
+		if (settings.job_executor != nullptr && clip_context.num_segments > 1)
+		{
+			// Every job allocates its quantized streams with the same allocator, they must outlive the job
+			ACL_ENSURE(allocator.is_thread_safe(), "Quantizing segments in parallel requires a thread safe allocator");
+
+			impl::QuantizeSegmentJobData job_data{ &allocator, &clip_context, &settings, &skeleton, &raw_clip_context };
+			settings.job_executor->run_jobs(clip_context.num_segments, impl::quantize_segment_job, &job_data);
+		}
+		else
+		{
+			for (SegmentContext& segment : clip_context.segment_iterator())
+				impl::quantize_segment(allocator, clip_context, segment, settings, skeleton, raw_clip_context);
+		}
 	}
 }
@@ -49,12 +49,18 @@ namespace acl
 			case RotationFormat8::Quat_128:
 				return unpack_vector4_128(ptr);
 			case RotationFormat8::QuatDropW_96:
+			case RotationFormat8::QuatLog_96:
 				return unpack_vector3_96(ptr);
 			case RotationFormat8::QuatDropW_48:
+			case RotationFormat8::QuatLog_48:
 				return unpack_vector3_48(ptr, is_normalized);
 			case RotationFormat8::QuatDropW_32:
+			case RotationFormat8::QuatLog_32:
 				return unpack_vector3_32(11, 11, 10, is_normalized, ptr);
+			case RotationFormat8::Quat_32_Largest:
+				return quat_to_vector(unpack_quat_32_largest(ptr));
 			case RotationFormat8::QuatDropW_Variable:
+			case RotationFormat8::QuatLog_Variable:
 			{
 				if (is_constant_bit_rate(bit_rate))
 				{
@@ -107,12 +113,18 @@ namespace acl
 			switch (format)
 			{
 			case RotationFormat8::Quat_128:
+			case RotationFormat8::Quat_32_Largest:
 				return vector_to_quat(rotation);
 			case RotationFormat8::QuatDropW_96:
 			case RotationFormat8::QuatDropW_48:
 			case RotationFormat8::QuatDropW_32:
 			case RotationFormat8::QuatDropW_Variable:
 				return quat_from_positive_w(rotation);
+			case RotationFormat8::QuatLog_96:
+			case RotationFormat8::QuatLog_48:
+			case RotationFormat8::QuatLog_32:
+			case RotationFormat8::QuatLog_Variable:
+				return quat_from_normalized_log(rotation);
 			default:
 				ACL_ENSURE(false, "Invalid or unsupported rotation format: %s", get_rotation_format_name(format));
 				return quat_identity_32();
@@ -129,7 +141,7 @@ namespace acl
 		const RotationFormat8 format = bone_steams.rotations.get_rotation_format();
 		const uint8_t bit_rate = bone_steams.rotations.get_bit_rate();
 
-		if (format == RotationFormat8::QuatDropW_Variable && is_constant_bit_rate(bit_rate))
+		if (is_rotation_format_variable(format) && is_constant_bit_rate(bit_rate))
 			sample_index = 0;
 
 		const uint8_t* quantized_ptr = bone_steams.rotations.get_raw_sample_ptr(sample_index);
@@ -253,16 +265,23 @@ namespace acl
 		{
 		case RotationFormat8::Quat_128:
 		case RotationFormat8::QuatDropW_96:
+		case RotationFormat8::QuatLog_96:
 			packed_rotation = rotation;
 			break;
 		case RotationFormat8::QuatDropW_48:
+		case RotationFormat8::QuatLog_48:
 			pack_vector3_48(rotation, are_rotations_normalized, &raw_data[0]);
 			packed_rotation = unpack_vector3_48(&raw_data[0], are_rotations_normalized);
 			break;
 		case RotationFormat8::QuatDropW_32:
+		case RotationFormat8::QuatLog_32:
 			pack_vector3_32(rotation, 11, 11, 10, are_rotations_normalized, &raw_data[0]);
 			packed_rotation = unpack_vector3_32(11, 11, 10, are_rotations_normalized, &raw_data[0]);
 			break;
+		case RotationFormat8::Quat_32_Largest:
+			pack_quat_32_largest(vector_to_quat(rotation), &raw_data[0]);
+			packed_rotation = quat_to_vector(unpack_quat_32_largest(&raw_data[0]));
+			break;
 		default:
 			ACL_ENSURE(false, "Invalid or unsupported rotation format: %s", get_rotation_format_name(desired_format));
 			packed_rotation = vector_zero_32();
@@ -690,79 +709,84 @@ namespace acl
 		}
 	}
 
-	inline void sample_streams_hierarchical(const BoneStreams* bone_streams, uint16_t num_bones, float sample_time, uint16_t bone_index, Transform_32* out_local_pose)
+	inline Transform_32 sample_stream(const BoneStreams* bone_streams, float sample_time, uint16_t bone_index)
 	{
 		const Quat_32 default_rotation = quat_identity_32();
 		const Vector4_32 default_translation = vector_zero_32();
 		const Vector4_32 default_scale = vector_set(1.0f);
 
-		uint16_t current_bone_index = bone_index;
-		while (current_bone_index != k_invalid_bone_index)
+		const BoneStreams& bone_stream = bone_streams[bone_index];
+
+		Quat_32 rotation;
+		if (bone_stream.is_rotation_default)
+			rotation = default_rotation;
+		else if (bone_stream.is_rotation_constant)
+			rotation = get_rotation_sample(bone_stream, 0);
+		else
 		{
-			const BoneStreams& bone_stream = bone_streams[current_bone_index];
+			uint32_t num_samples = bone_stream.rotations.get_num_samples();
+			float duration = bone_stream.rotations.get_duration();
 
-			Quat_32 rotation;
-			if (bone_stream.is_rotation_default)
-				rotation = default_rotation;
-			else if (bone_stream.is_rotation_constant)
-				rotation = get_rotation_sample(bone_stream, 0);
-			else
-			{
-				uint32_t num_samples = bone_stream.rotations.get_num_samples();
-				float duration = bone_stream.rotations.get_duration();
+			uint32_t key0;
+			uint32_t key1;
+			float interpolation_alpha;
+			calculate_interpolation_keys(num_samples, duration, sample_time, key0, key1, interpolation_alpha);
 
-				uint32_t key0;
-				uint32_t key1;
-				float interpolation_alpha;
-				calculate_interpolation_keys(num_samples, duration, sample_time, key0, key1, interpolation_alpha);
+			Quat_32 sample0 = get_rotation_sample(bone_stream, key0);
+			Quat_32 sample1 = get_rotation_sample(bone_stream, key1);
+			rotation = quat_lerp(sample0, sample1, interpolation_alpha);
+		}
 
-				Quat_32 sample0 = get_rotation_sample(bone_stream, key0);
-				Quat_32 sample1 = get_rotation_sample(bone_stream, key1);
-				rotation = quat_lerp(sample0, sample1, interpolation_alpha);
-			}
+		Vector4_32 translation;
+		if (bone_stream.is_translation_default)
+			translation = default_translation;
+		else if (bone_stream.is_translation_constant)
+			translation = get_translation_sample(bone_stream, 0);
+		else
+		{
+			uint32_t num_samples = bone_stream.translations.get_num_samples();
+			float duration = bone_stream.translations.get_duration();
 
-			Vector4_32 translation;
-			if (bone_stream.is_translation_default)
-				translation = default_translation;
-			else if (bone_stream.is_translation_constant)
-				translation = get_translation_sample(bone_stream, 0);
-			else
-			{
-				uint32_t num_samples = bone_stream.translations.get_num_samples();
-				float duration = bone_stream.translations.get_duration();
+			uint32_t key0;
+			uint32_t key1;
+			float interpolation_alpha;
+			calculate_interpolation_keys(num_samples, duration, sample_time, key0, key1, interpolation_alpha);
 
-				uint32_t key0;
-				uint32_t key1;
-				float interpolation_alpha;
-				calculate_interpolation_keys(num_samples, duration, sample_time, key0, key1, interpolation_alpha);
+			Vector4_32 sample0 = get_translation_sample(bone_stream, key0);
+			Vector4_32 sample1 = get_translation_sample(bone_stream, key1);
+			translation = vector_lerp(sample0, sample1, interpolation_alpha);
+		}
 
-				Vector4_32 sample0 = get_translation_sample(bone_stream, key0);
-				Vector4_32 sample1 = get_translation_sample(bone_stream, key1);
-				translation = vector_lerp(sample0, sample1, interpolation_alpha);
-			}
+		Vector4_32 scale;
+		if (bone_stream.is_scale_default)
+			scale = default_scale;
+		else if (bone_stream.is_scale_constant)
+			scale = get_scale_sample(bone_stream, 0);
+		else
+		{
+			uint32_t num_samples = bone_stream.scales.get_num_samples();
+			float duration = bone_stream.scales.get_duration();
 
-			Vector4_32 scale;
-			if (bone_stream.is_scale_default)
-				scale = default_scale;
-			else if (bone_stream.is_scale_constant)
-				scale = get_scale_sample(bone_stream, 0);
-			else
-			{
-				uint32_t num_samples = bone_stream.scales.get_num_samples();
-				float duration = bone_stream.scales.get_duration();
+			uint32_t key0;
+			uint32_t key1;
+			float interpolation_alpha;
+			calculate_interpolation_keys(num_samples, duration, sample_time, key0, key1, interpolation_alpha);
 
-				uint32_t key0;
-				uint32_t key1;
-				float interpolation_alpha;
-				calculate_interpolation_keys(num_samples, duration, sample_time, key0, key1, interpolation_alpha);
+			Vector4_32 sample0 = get_scale_sample(bone_stream, key0);
+			Vector4_32 sample1 = get_scale_sample(bone_stream, key1);
+			scale = vector_lerp(sample0, sample1, interpolation_alpha);
+		}
 
-				Vector4_32 sample0 = get_scale_sample(bone_stream, key0);
-				Vector4_32 sample1 = get_scale_sample(bone_stream, key1);
-				scale = vector_lerp(sample0, sample1, interpolation_alpha);
-			}
+		return transform_set(rotation, translation, scale);
+	}
 
-			out_local_pose[current_bone_index] = transform_set(rotation, translation, scale);
-			current_bone_index = bone_stream.parent_bone_index;
+	inline void sample_streams_hierarchical(const BoneStreams* bone_streams, uint16_t num_bones, float sample_time, uint16_t bone_index, Transform_32* out_local_pose)
+	{
+		uint16_t current_bone_index = bone_index;
+		while (current_bone_index != k_invalid_bone_index)
+		{
+			out_local_pose[current_bone_index] = sample_stream(bone_streams, sample_time, current_bone_index);
+			current_bone_index = bone_streams[current_bone_index].parent_bone_index;
 		}
 	}
 
@@ -888,7 +912,7 @@ namespace acl
 		}
 	}
 
-	inline void sample_streams_hierarchical(const BoneStreams* bone_streams, const BoneStreams* raw_bone_steams, uint16_t num_bones, float sample_time, uint16_t bone_index, const BoneBitRate* bit_rates, RotationFormat8 rotation_format, VectorFormat8 translation_format, VectorFormat8 scale_format, Transform_32* out_local_pose)
+	inline Transform_32 sample_stream(const BoneStreams* bone_streams, const BoneStreams* raw_bone_steams, float sample_time, uint16_t bone_index, const BoneBitRate* bit_rates, RotationFormat8 rotation_format, VectorFormat8 translation_format, VectorFormat8 scale_format)
 	{
 		const bool is_rotation_variable = is_rotation_format_variable(rotation_format);
 		const bool is_translation_variable = is_vector_format_variable(translation_format);
@@ -897,118 +921,123 @@ namespace acl
 		const Vector4_32 default_translation = vector_zero_32();
 		const Vector4_32 default_scale = vector_set(1.0f);
 
-		uint16_t current_bone_index = bone_index;
-		while (current_bone_index != k_invalid_bone_index)
+		const BoneStreams& bone_stream = bone_streams[bone_index];
+		const BoneStreams& raw_bone_stream = raw_bone_steams[bone_index];
+
+		Quat_32 rotation;
+		if (bone_stream.is_rotation_default)
+			rotation = default_rotation;
+		else if (bone_stream.is_rotation_constant)
 		{
-			const BoneStreams& bone_stream = bone_streams[current_bone_index];
-			const BoneStreams& raw_bone_stream = raw_bone_steams[current_bone_index];
+			if (is_rotation_variable)
+				rotation = get_rotation_sample(bone_stream, 0);
+			else
+				rotation = get_rotation_sample(bone_stream, 0, rotation_format);
+		}
+		else
+		{
+			const uint32_t num_samples = bone_stream.rotations.get_num_samples();
+			const float duration = bone_stream.rotations.get_duration();
 
-			Quat_32 rotation;
-			if (bone_stream.is_rotation_default)
-				rotation = default_rotation;
-			else if (bone_stream.is_rotation_constant)
+			uint32_t key0;
+			uint32_t key1;
+			float interpolation_alpha;
+			calculate_interpolation_keys(num_samples, duration, sample_time, key0, key1, interpolation_alpha);
+
+			Quat_32 sample0;
+			Quat_32 sample1;
+			if (is_rotation_variable)
 			{
-				if (is_rotation_variable)
-					rotation = get_rotation_sample(bone_stream, 0);
-				else
-					rotation = get_rotation_sample(bone_stream, 0, rotation_format);
+				const uint8_t bit_rate = bit_rates[bone_index].rotation;
+
+				sample0 = get_rotation_sample(bone_stream, raw_bone_stream, key0, bit_rate);
+				sample1 = get_rotation_sample(bone_stream, raw_bone_stream, key1, bit_rate);
 			}
 			else
 			{
-				const uint32_t num_samples = bone_stream.rotations.get_num_samples();
-				const float duration = bone_stream.rotations.get_duration();
+				sample0 = get_rotation_sample(bone_stream, key0, rotation_format);
+				sample1 = get_rotation_sample(bone_stream, key1, rotation_format);
+			}
 
-				uint32_t key0;
-				uint32_t key1;
-				float interpolation_alpha;
-				calculate_interpolation_keys(num_samples, duration, sample_time, key0, key1, interpolation_alpha);
+			rotation = quat_lerp(sample0, sample1, interpolation_alpha);
+		}
 
-				Quat_32 sample0;
-				Quat_32 sample1;
-				if (is_rotation_variable)
-				{
-					const uint8_t bit_rate = bit_rates[current_bone_index].rotation;
+		Vector4_32 translation;
+		if (bone_stream.is_translation_default)
+			translation = default_translation;
+		else if (bone_stream.is_translation_constant)
+			translation = get_translation_sample(bone_stream, 0, VectorFormat8::Vector3_96);
+		else
+		{
+			const uint32_t num_samples = bone_stream.translations.get_num_samples();
+			const float duration = bone_stream.translations.get_duration();
 
-					sample0 = get_rotation_sample(bone_stream, raw_bone_stream, key0, bit_rate);
-					sample1 = get_rotation_sample(bone_stream, raw_bone_stream, key1, bit_rate);
-				}
-				else
-				{
-					sample0 = get_rotation_sample(bone_stream, key0, rotation_format);
-					sample1 = get_rotation_sample(bone_stream, key1, rotation_format);
-				}
+			uint32_t key0;
+			uint32_t key1;
+			float interpolation_alpha;
+			calculate_interpolation_keys(num_samples, duration, sample_time, key0, key1, interpolation_alpha);
 
-				rotation = quat_lerp(sample0, sample1, interpolation_alpha);
-			}
+			Vector4_32 sample0;
+			Vector4_32 sample1;
+			if (is_translation_variable)
+			{
+				const uint8_t bit_rate = bit_rates[bone_index].translation;
 
-			Vector4_32 translation;
-			if (bone_stream.is_translation_default)
-				translation = default_translation;
-			else if (bone_stream.is_translation_constant)
-				translation = get_translation_sample(bone_stream, 0, VectorFormat8::Vector3_96);
+				sample0 = get_translation_sample(bone_stream, raw_bone_stream, key0, bit_rate);
+				sample1 = get_translation_sample(bone_stream, raw_bone_stream, key1, bit_rate);
+			}
 			else
 			{
-				const uint32_t num_samples = bone_stream.translations.get_num_samples();
-				const float duration = bone_stream.translations.get_duration();
+				sample0 = get_translation_sample(bone_stream, key0, translation_format);
+				sample1 = get_translation_sample(bone_stream, key1, translation_format);
+			}
 
-				uint32_t key0;
-				uint32_t key1;
-				float interpolation_alpha;
-				calculate_interpolation_keys(num_samples, duration, sample_time, key0, key1, interpolation_alpha);
+			translation = vector_lerp(sample0, sample1, interpolation_alpha);
+		}
 
-				Vector4_32 sample0;
-				Vector4_32 sample1;
-				if (is_translation_variable)
-				{
-					const uint8_t bit_rate = bit_rates[current_bone_index].translation;
+		Vector4_32 scale;
+		if (bone_stream.is_scale_default)
+			scale = default_scale;
+		else if (bone_stream.is_scale_constant)
+			scale = get_scale_sample(bone_stream, 0, VectorFormat8::Vector3_96);
+		else
+		{
+			const uint32_t num_samples = bone_stream.scales.get_num_samples();
+			const float duration = bone_stream.scales.get_duration();
 
-					sample0 = get_translation_sample(bone_stream, raw_bone_stream, key0, bit_rate);
-					sample1 = get_translation_sample(bone_stream, raw_bone_stream, key1, bit_rate);
-				}
-				else
-				{
-					sample0 = get_translation_sample(bone_stream, key0, translation_format);
-					sample1 = get_translation_sample(bone_stream, key1, translation_format);
-				}
+			uint32_t key0;
+			uint32_t key1;
+			float interpolation_alpha;
+			calculate_interpolation_keys(num_samples, duration, sample_time, key0, key1, interpolation_alpha);
 
-				translation = vector_lerp(sample0, sample1, interpolation_alpha);
-			}
+			Vector4_32 sample0;
+			Vector4_32 sample1;
+			if (is_scale_variable)
+			{
+				const uint8_t bit_rate = bit_rates[bone_index].scale;
 
-			Vector4_32 scale;
-			if (bone_stream.is_scale_default)
-				scale = default_scale;
-			else if (bone_stream.is_scale_constant)
-				scale = get_scale_sample(bone_stream, 0, VectorFormat8::Vector3_96);
+				sample0 = get_scale_sample(bone_stream, raw_bone_stream, key0, bit_rate);
+				sample1 = get_scale_sample(bone_stream, raw_bone_stream, key1, bit_rate);
+			}
 			else
 			{
-				const uint32_t num_samples = bone_stream.scales.get_num_samples();
-				const float duration = bone_stream.scales.get_duration();
-
-				uint32_t key0;
-				uint32_t key1;
-				float interpolation_alpha;
-				calculate_interpolation_keys(num_samples, duration, sample_time, key0, key1, interpolation_alpha);
-
-				Vector4_32 sample0;
-				Vector4_32 sample1;
-				if (is_scale_variable)
-				{
-					const uint8_t bit_rate = bit_rates[current_bone_index].scale;
+				sample0 = get_scale_sample(bone_stream, key0, scale_format);
+				sample1 = get_scale_sample(bone_stream, key1, scale_format);
+			}
 
-					sample0 = get_scale_sample(bone_stream, raw_bone_stream, key0, bit_rate);
-					sample1 = get_scale_sample(bone_stream, raw_bone_stream, key1, bit_rate);
-				}
-				else
-				{
-					sample0 = get_scale_sample(bone_stream, key0, scale_format);
-					sample1 = get_scale_sample(bone_stream, key1, scale_format);
-				}
+			scale = vector_lerp(sample0, sample1, interpolation_alpha);
+		}
 
-				scale = vector_lerp(sample0, sample1, interpolation_alpha);
-			}
+		return transform_set(rotation, translation, scale);
+	}
 
-			out_local_pose[current_bone_index] = transform_set(rotation, translation, scale);
-			current_bone_index = bone_stream.parent_bone_index;
+	inline void sample_streams_hierarchical(const BoneStreams* bone_streams, const BoneStreams* raw_bone_steams, uint16_t num_bones, float sample_time, uint16_t bone_index, const BoneBitRate* bit_rates, RotationFormat8 rotation_format, VectorFormat8 translation_format, VectorFormat8 scale_format, Transform_32* out_local_pose)
+	{
+		uint16_t current_bone_index = bone_index;
+		while (current_bone_index != k_invalid_bone_index)
+		{
+			out_local_pose[current_bone_index] = sample_stream(bone_streams, raw_bone_steams, sample_time, current_bone_index, bit_rates, rotation_format, translation_format, scale_format);
+			current_bone_index = bone_streams[current_bone_index].parent_bone_index;
 		}
 	}
 
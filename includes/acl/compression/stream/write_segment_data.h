@@ -47,6 +47,7 @@ namespace acl
 			SegmentHeader& header = segment_headers[segment_index];
 
 			header.num_samples = segment.num_samples;
+			header.clip_sample_offset = segment.clip_sample_offset;
 			header.animated_pose_bit_size = segment.animated_pose_bit_size;
 			header.format_per_track_data_offset = data_offset;
 			header.range_data_offset = align_to(header.format_per_track_data_offset + format_per_track_data_size, 2);		// Aligned to 2 bytes
@@ -77,7 +78,7 @@ namespace acl
 				segment_header.range_data_offset = InvalidPtrOffset();
 
 			if (segment.animated_data_size > 0)
-				write_animated_track_data(clip_context, segment, settings.rotation_format, settings.translation_format, settings.scale_format, header.get_track_data(segment_header), segment.animated_data_size);
+				write_animated_track_data(clip_context, segment, settings.rotation_format, settings.translation_format, settings.scale_format, settings.key_frame_block_size, header.get_track_data(segment_header), segment.animated_data_size);
 			else
 				segment_header.track_data_offset = InvalidPtrOffset();
 		}
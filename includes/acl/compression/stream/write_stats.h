@@ -28,6 +28,11 @@
 #include "acl/compression/stream/clip_context.h"
 #include "acl/compression/skeleton_error_metric.h"
 #include "acl/core/memory_cache.h"
+#include "acl/decompression/key_frame_layout.h"
+#include "acl/decompression/memory_access_recorder.h"
+
+#include <algorithm>
+#include <utility>
 
 #if defined(SJSON_CPP_WRITER)
 
@@ -51,7 +56,7 @@ namespace acl
 		writer["animated_frame_size"] = double(segment.animated_data_size) / double(segment.num_samples);
 	}
 
-	inline void write_detailed_segment_stats(const SegmentContext& segment, sjson::ObjectWriter& writer)
+	inline void write_detailed_segment_stats(IAllocator& allocator, const SegmentContext& segment, const CompressedClip& compressed_clip, RecordDecompressionMemoryAccess record_memory_access, sjson::ObjectWriter& writer)
 	{
 		uint32_t bit_rate_counts[k_num_bit_rates] = {0};
 
@@ -84,6 +89,29 @@ namespace acl
 		const uint32_t num_animated_pose_cache_lines = align_to(animated_pose_byte_size, k_cache_line_byte_size) / k_cache_line_byte_size;
 		writer["decomp_touched_bytes"] = segment.clip->total_header_size + segment.total_header_size + animated_pose_byte_size;
 		writer["decomp_touched_cache_lines"] = num_clip_header_cache_lines + num_segment_header_cache_lines + num_animated_pose_cache_lines;
+
+		// The above is an estimate, we also measure what the decoder reads when it seeks to the first sample of the segment
+		MemoryAccessRecorder recorder(allocator);
+		const ClipHeader& header = get_clip_header(compressed_clip);
+		const float sample_time = float(segment.clip_sample_offset) / float(header.sample_rate);
+		record_memory_access(allocator, sample_time, recorder);
+
+		writer["decomp_measured_touched_bytes"] = recorder.calculate_num_touched_bytes();
+		writer["decomp_measured_touched_cache_lines"] = recorder.calculate_num_touched_cache_lines(k_cache_line_byte_size);
+
+		// Compare the animated data we touch on average with our key frame blocks against whole poses stored one after the other
+		uint32_t num_animated_cache_lines = 0;
+		uint32_t num_pose_major_animated_cache_lines = 0;
+		for (uint32_t sample_index = 0; sample_index < segment.num_samples; ++sample_index)
+		{
+			const uint32_t key_frame0 = segment.clip_sample_offset + sample_index;
+			const uint32_t key_frame1 = std::min<uint32_t>(key_frame0 + 1, header.num_samples - 1);
+			num_animated_cache_lines += calculate_num_animated_touched_cache_lines(compressed_clip, key_frame0, key_frame1, header.key_frame_block_size, k_cache_line_byte_size);
+			num_pose_major_animated_cache_lines += calculate_num_animated_touched_cache_lines(compressed_clip, key_frame0, key_frame1, 1, k_cache_line_byte_size);
+		}
+
+		writer["decomp_animated_touched_cache_lines"] = double(num_animated_cache_lines) / double(segment.num_samples);
+		writer["decomp_touched_cache_lines_delta"] = (double(num_animated_cache_lines) - double(num_pose_major_animated_cache_lines)) / double(segment.num_samples);
 	}
 
 	inline void write_exhaustive_segment_stats(IAllocator& allocator, const SegmentContext& segment, const ClipContext& raw_clip_context, const RigidSkeleton& skeleton, const CompressionSettings& settings, sjson::ObjectWriter& writer)
@@ -145,25 +173,45 @@ namespace acl
 
 	constexpr uint32_t k_num_decompression_timing_passes = 5;
 
-	inline void write_decompression_stats(IAllocator& allocator, const AnimationClip& clip, const OutputStats& stats, sjson::ObjectWriter& writer, const char* action_type, bool forward_order, bool measure_upper_bound,
+	enum class PlaybackDirection8 : uint8_t
+	{
+		Forward,
+		Backward,
+		Random,
+	};
+
+	inline void write_decompression_stats(IAllocator& allocator, const AnimationClip& clip, const OutputStats& stats, sjson::ObjectWriter& writer, const char* action_type, PlaybackDirection8 playback_direction, bool measure_upper_bound,
 		void* contexts[], Vector4_32* cache_flush_buffer, Transform_32* lossy_pose_transforms, AllocateDecompressionContext allocate_context, DecompressPose decompress_pose, DeallocateDecompressionContext deallocate_context)
 	{
 		int32_t num_samples = static_cast<int32_t>(clip.get_num_samples());
 		double duration = clip.get_duration();
 		uint16_t num_bones = clip.get_num_bones();
 
-		writer[action_type] = [&](sjson::ObjectWriter& writer)
+		int32_t* sample_indices = allocate_type_array<int32_t>(allocator, num_samples);
+		for (int32_t sample_index = 0; sample_index < num_samples; ++sample_index)
+			sample_indices[sample_index] = playback_direction == PlaybackDirection8::Backward ? (num_samples - sample_index - 1) : sample_index;
+
+		if (playback_direction == PlaybackDirection8::Random)
 		{
-			int32_t initial_sample_index = forward_order ? 0 : num_samples - 1;
-			int32_t sample_index_sentinel = forward_order ? num_samples : -1;
-			int32_t delta_sample_index = forward_order ? 1 : -1;
+			// Shuffle with a fixed seed to keep the results reproducible
+			uint32_t seed = 0x9E3779B9;
+			for (int32_t sample_index = num_samples - 1; sample_index > 0; --sample_index)
+			{
+				seed = seed * 1664525 + 1013904223;
+				const int32_t swap_index = static_cast<int32_t>((seed >> 8) % static_cast<uint32_t>(sample_index + 1));
+				std::swap(sample_indices[sample_index], sample_indices[swap_index]);
+			}
+		}
 
+		writer[action_type] = [&](sjson::ObjectWriter& writer)
+		{
 			double clip_max, clip_min, clip_total = 0;
 
 			writer["data"] = [&](sjson::ArrayWriter& writer)
 			{
-				for (int32_t sample_index = initial_sample_index; sample_index != sample_index_sentinel; sample_index += delta_sample_index)
+				for (int32_t playback_index = 0; playback_index < num_samples; ++playback_index)
 				{
+					const int32_t sample_index = sample_indices[playback_index];
 					float sample_time = static_cast<float>(duration * sample_index / (num_samples - 1));
 
 					double decompression_time = 0;
@@ -192,10 +240,10 @@ namespace acl
 					if (are_any_enum_flags_set(stats.logging, StatLogging::ExhaustiveDecompression))
 						writer.push(decompression_time);
 
-					if (sample_index == initial_sample_index || decompression_time > clip_max)
+					if (playback_index == 0 || decompression_time > clip_max)
 						clip_max = decompression_time;
 
-					if (sample_index == initial_sample_index || decompression_time < clip_min)
+					if (playback_index == 0 || decompression_time < clip_min)
 						clip_min = decompression_time;
 
 					clip_total += decompression_time;
@@ -206,6 +254,8 @@ namespace acl
 			writer["avg_decompression_time"] = clip_total / static_cast<double>(num_samples);
 			writer["min_decompression_time"] = clip_min;
 		};
+
+		deallocate_type_array(allocator, sample_indices, num_samples);
 	}
 
 	inline void write_decompression_stats(IAllocator& allocator, const AnimationClip& clip, const OutputStats& stats, sjson::ObjectWriter& writer, AllocateDecompressionContext allocate_context, DecompressPose decompress_pose, DeallocateDecompressionContext deallocate_context)
@@ -222,9 +272,10 @@ namespace acl
 
 		writer["decompression_time_per_sample"] = [&](sjson::ObjectWriter& writer)
 		{
-			write_decompression_stats(allocator, clip, stats, writer, "forward_playback", true, false, contexts, cache_flush_buffer, lossy_pose_transforms, allocate_context, decompress_pose, deallocate_context);
-			write_decompression_stats(allocator, clip, stats, writer, "backward_playback", false, false, contexts, cache_flush_buffer, lossy_pose_transforms, allocate_context, decompress_pose, deallocate_context);
-			write_decompression_stats(allocator, clip, stats, writer, "initial_seek", true, true, contexts, cache_flush_buffer, lossy_pose_transforms, allocate_context, decompress_pose, deallocate_context);
+			write_decompression_stats(allocator, clip, stats, writer, "forward_playback", PlaybackDirection8::Forward, false, contexts, cache_flush_buffer, lossy_pose_transforms, allocate_context, decompress_pose, deallocate_context);
+			write_decompression_stats(allocator, clip, stats, writer, "backward_playback", PlaybackDirection8::Backward, false, contexts, cache_flush_buffer, lossy_pose_transforms, allocate_context, decompress_pose, deallocate_context);
+			write_decompression_stats(allocator, clip, stats, writer, "random_playback", PlaybackDirection8::Random, false, contexts, cache_flush_buffer, lossy_pose_transforms, allocate_context, decompress_pose, deallocate_context);
+			write_decompression_stats(allocator, clip, stats, writer, "initial_seek", PlaybackDirection8::Forward, true, contexts, cache_flush_buffer, lossy_pose_transforms, allocate_context, decompress_pose, deallocate_context);
 		};
 
 		for (uint32_t pass_index = 0; pass_index < k_num_decompression_timing_passes; ++pass_index)
@@ -236,7 +287,8 @@ namespace acl
 
 	inline void write_stats(IAllocator& allocator, const AnimationClip& clip, const ClipContext& clip_context, const RigidSkeleton& skeleton,
 		const CompressedClip& compressed_clip, const CompressionSettings& settings, const ClipHeader& header, const ClipContext& raw_clip_context, const ScopeProfiler& compression_time,
-		OutputStats& stats, AllocateDecompressionContext allocate_context, DecompressPose decompress_pose, DeallocateDecompressionContext deallocate_context)
+		OutputStats& stats, AllocateDecompressionContext allocate_context, DecompressPose decompress_pose, DeallocateDecompressionContext deallocate_context,
+		uint32_t track_offset_index_size, RecordDecompressionMemoryAccess record_memory_access)
 	{
 		uint32_t raw_size = clip.get_raw_size();
 		uint32_t compressed_size = compressed_clip.get_size();
@@ -258,6 +310,7 @@ namespace acl
 		writer["clip_name"] = clip.get_name().c_str();
 		writer["raw_size"] = raw_size;
 		writer["compressed_size"] = compressed_size;
+		writer["track_offset_index_size"] = track_offset_index_size;
 		writer["compression_ratio"] = compression_ratio;
 		writer["max_error"] = error.error;
 		writer["worst_bone"] = error.index;
@@ -270,6 +323,7 @@ namespace acl
 		writer["translation_format"] = get_vector_format_name(settings.translation_format);
 		writer["scale_format"] = get_vector_format_name(settings.scale_format);
 		writer["range_reduction"] = get_range_reduction_name(settings.range_reduction);
+		writer["key_frame_block_size"] = settings.key_frame_block_size;
 		writer["has_scale"] = clip_context.has_scale;
 		writer["error_metric"] = settings.error_metric->get_name();
 
@@ -351,7 +405,7 @@ namespace acl
 
 					if (are_all_enum_flags_set(stats.logging, StatLogging::Detailed))
 					{
-						write_detailed_segment_stats(segment, writer);
+						write_detailed_segment_stats(allocator, segment, compressed_clip, record_memory_access, writer);
 					}
 
 					if (are_all_enum_flags_set(stats.logging, StatLogging::Exhaustive))
@@ -32,6 +32,7 @@
 #include "acl/math/vector4_32.h"
 #include "acl/compression/stream/clip_context.h"
 
+#include <algorithm>
 #include <cstdint>
 
 namespace acl
@@ -227,9 +228,10 @@ namespace acl
 		}
 	}
 
-	inline void write_animated_track_data(const ClipContext& clip_context, const SegmentContext& segment, RotationFormat8 rotation_format, VectorFormat8 translation_format, VectorFormat8 scale_format, uint8_t* animated_track_data, uint32_t animated_data_size)
+	inline void write_animated_track_data(const ClipContext& clip_context, const SegmentContext& segment, RotationFormat8 rotation_format, VectorFormat8 translation_format, VectorFormat8 scale_format, uint32_t key_frame_block_size, uint8_t* animated_track_data, uint32_t animated_data_size)
 	{
 		ACL_ENSURE(animated_track_data != nullptr, "'animated_track_data' cannot be null!");
+		ACL_ENSURE(key_frame_block_size != 0, "'key_frame_block_size' cannot be 0!");
 
 		uint8_t* animated_track_data_begin = animated_track_data;
 
@@ -245,20 +247,32 @@ namespace acl
 
 		uint64_t bit_offset = 0;
 
-		// Data is sorted first by time, second by bone.
-		// This ensures that all bones are contiguous in memory when we sample a particular time.
-		for (uint32_t sample_index = 0; sample_index < segment.num_samples; ++sample_index)
+		// Data is sorted first by block of key frames, second by bone, and third by time within the block.
+		// With blocks of a single key frame, all bones are contiguous in memory when we sample a particular time.
+		// With larger blocks, the key frames we interpolate are contiguous for each track.
+		for (uint32_t block_sample_index = 0; block_sample_index < segment.num_samples; block_sample_index += key_frame_block_size)
 		{
+			const uint32_t block_end_sample_index = std::min<uint32_t>(block_sample_index + key_frame_block_size, segment.num_samples);
+
 			for (const BoneStreams& bone_stream : segment.bone_iterator())
 			{
 				if (bone_stream.is_rotation_animated() && !is_constant_bit_rate(bone_stream.rotations.get_bit_rate()))
-					write_animated_track_data(bone_stream.rotations, sample_index, has_mixed_packing, animated_track_data_begin, animated_track_data, bit_offset);
+				{
+					for (uint32_t sample_index = block_sample_index; sample_index < block_end_sample_index; ++sample_index)
+						write_animated_track_data(bone_stream.rotations, sample_index, has_mixed_packing, animated_track_data_begin, animated_track_data, bit_offset);
+				}
 
 				if (bone_stream.is_translation_animated() && !is_constant_bit_rate(bone_stream.translations.get_bit_rate()))
-					write_animated_track_data(bone_stream.translations, sample_index, has_mixed_packing, animated_track_data_begin, animated_track_data, bit_offset);
+				{
+					for (uint32_t sample_index = block_sample_index; sample_index < block_end_sample_index; ++sample_index)
+						write_animated_track_data(bone_stream.translations, sample_index, has_mixed_packing, animated_track_data_begin, animated_track_data, bit_offset);
+				}
 
 				if (clip_context.has_scale && bone_stream.is_scale_animated() && !is_constant_bit_rate(bone_stream.scales.get_bit_rate()))
-					write_animated_track_data(bone_stream.scales, sample_index, has_mixed_packing, animated_track_data_begin, animated_track_data, bit_offset);
+				{
+					for (uint32_t sample_index = block_sample_index; sample_index < block_end_sample_index; ++sample_index)
+						write_animated_track_data(bone_stream.scales, sample_index, has_mixed_packing, animated_track_data_begin, animated_track_data, bit_offset);
+				}
 
 				ACL_ENSURE(animated_track_data <= animated_track_data_end, "Invalid animated track data offset. Wrote too much data.");
 			}
@@ -35,7 +35,7 @@ namespace acl
 	{
 		switch (type)
 		{
-			case AlgorithmType8::UniformlySampled:		return 1;
+			case AlgorithmType8::UniformlySampled:		return 3;
 			//case AlgorithmType8::LinearKeyReduction:	return 0;
 			//case AlgorithmType8::SplineKeyReduction:	return 0;
 			default:									return 0xFFFF;
@@ -149,6 +149,16 @@ namespace acl
 #endif
 		}
 
+		virtual bool is_thread_safe() const override
+		{
+#if defined(ACL_ALLOCATOR_TRACK_ALL_ALLOCATIONS)
+			// The debug allocation map isn't synchronized
+			return false;
+#else
+			return true;
+#endif
+		}
+
 #if defined(ACL_ALLOCATOR_TRACK_NUM_ALLOCATIONS)
 		int32_t get_allocation_count() const { return m_allocation_count.load(std::memory_order_relaxed); }
 #endif
@@ -83,19 +83,25 @@ namespace acl
 		return (bitset[offset] & mask) != 0;
 	}
 
+	// Counts the bits set in a single bit set word, with the pop-count instruction when the compiler exposes it
+	inline uint32_t count_set_bits(uint32_t value)
+	{
+#if defined(__GNUC__) || defined(__clang__)
+		return uint32_t(__builtin_popcount(value));
+#else
+		value = value - ((value >> 1) & 0x55555555);
+		value = (value & 0x33333333) + ((value >> 2) & 0x33333333);
+		return (((value + (value >> 4)) & 0x0F0F0F0F) * 0x01010101) >> 24;
+#endif
+	}
+
 	inline int32_t bitset_count_set_bits(const uint32_t* bitset, BitSetDescription desc)
 	{
 		const int32_t size = desc.get_size();
 
-		// TODO: Use popcount instruction if available
 		int32_t num_set_bits = 0;
 		for (int32_t offset = 0; offset < size; ++offset)
-		{
-			uint32_t value = bitset[offset];
-			value = value - ((value >> 1) & 0x55555555);
-			value = (value & 0x33333333) + ((value >> 2) & 0x33333333);
-			num_set_bits += (((value + (value >> 4)) & 0x0F0F0F0F) * 0x01010101) >> 24;
-		}
+			num_set_bits += count_set_bits(bitset[offset]);
 
 		return num_set_bits;
 	}
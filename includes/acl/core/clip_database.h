@@ -0,0 +1,219 @@
+#pragma once
+
+////////////////////////////////////////////////////////////////////////////////
+// The MIT License (MIT)
+//
+// Copyright (c) 2018 Nicholas Frechette & Animation Compression Library contributors
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+////////////////////////////////////////////////////////////////////////////////
+
+#include "acl/core/compressed_clip.h"
+#include "acl/core/hash.h"
+#include "acl/core/memory_utils.h"
+#include "acl/core/ptr_offset.h"
+
+#include <cstdint>
+#include <cstring>
+
+//////////////////////////////////////////////////////////////////////////
+// Compressed clip database
+//
+// Packs many compressed clips into a single contiguous and relocatable buffer
+// that can be written to disk as is and memory mapped back. Clips compressed
+// for the same rig often have identical bitsets and constant track data, these
+// are stored once and shared by every clip that uses them. The clips stored
+// in the database do not contain this data anymore and they must be
+// decompressed with a context allocated for their database entry.
+//
+// Data format:
+//    ClipDatabase
+//    ClipDatabaseEntry[num_clips]			// Sorted by name hash
+//    uint32_t clip_hash_index[num_clips]	// Entry indices sorted by clip hash
+//    Names, null terminated
+//    Shared data, every block is 4 byte aligned: bitsets and constant track data
+//    Compressed clips, every clip is 16 byte aligned
+//////////////////////////////////////////////////////////////////////////
+
+namespace acl
+{
+	constexpr uint32_t k_invalid_clip_index = 0xFFFFFFFF;
+
+	struct ClipDatabaseEntry
+	{
+		uint32_t					name_hash;
+		uint32_t					clip_hash;							// Hash of the compressed clip before it was added to the database
+
+		// Offsets are relative to the start of the database
+		PtrOffset32<const char>		name_offset;
+		uint32_t					name_size;							// Without the null terminator
+		PtrOffset32<const CompressedClip>	clip_offset;
+		PtrOffset32<const uint32_t>	default_tracks_bitset_offset;
+		PtrOffset32<const uint32_t>	constant_tracks_bitset_offset;
+		PtrOffset32<const uint8_t>	constant_track_data_offset;			// Invalid if the clip has no constant tracks
+	};
+
+	class alignas(16) ClipDatabase
+	{
+	public:
+		uint32_t get_size() const { return m_size; }
+		uint32_t get_hash() const { return m_hash; }
+		uint32_t get_num_clips() const { return m_num_clips; }
+
+		// Size in bytes of the bitsets and constant track data shared between the clips
+		uint32_t get_shared_data_size() const { return m_shared_data_size; }
+
+		bool is_valid(bool check_hash) const
+		{
+			if (!is_aligned_to(this, alignof(ClipDatabase)))
+				return false;
+
+			if (m_tag != k_clip_database_tag)
+				return false;
+
+			if (m_version != k_clip_database_version)
+				return false;
+
+			if (check_hash)
+			{
+				const uint32_t hash = hash32(safe_ptr_cast<const uint8_t>(this) + k_hash_skip_size, m_size - k_hash_skip_size);
+				if (hash != m_hash)
+					return false;
+			}
+
+			return true;
+		}
+
+		const ClipDatabaseEntry& get_entry(uint32_t clip_index) const
+		{
+			ACL_ENSURE(clip_index < m_num_clips, "Invalid clip index: %u >= %u", clip_index, m_num_clips);
+			return m_entries_offset.add_to(this)[clip_index];
+		}
+
+		const CompressedClip& get_clip(uint32_t clip_index) const { return *get_entry(clip_index).clip_offset.add_to(this); }
+		const char* get_clip_name(uint32_t clip_index) const { return get_entry(clip_index).name_offset.add_to(this); }
+
+		const uint32_t* get_default_tracks_bitset(uint32_t clip_index) const { return get_entry(clip_index).default_tracks_bitset_offset.add_to(this); }
+		const uint32_t* get_constant_tracks_bitset(uint32_t clip_index) const { return get_entry(clip_index).constant_tracks_bitset_offset.add_to(this); }
+		const uint8_t* get_constant_track_data(uint32_t clip_index) const { return get_entry(clip_index).constant_track_data_offset.safe_add_to(this); }
+
+		// Returns the index of the clip with the provided name or k_invalid_clip_index if it isn't found
+		uint32_t find_clip(const char* name) const
+		{
+			const uint32_t name_hash = hash32(name);
+			const size_t name_size = std::strlen(name);
+			const ClipDatabaseEntry* entries = m_entries_offset.add_to(this);
+
+			// Find the first entry with our name hash, more than one can match if we have a collision
+			uint32_t first_clip_index = 0;
+			uint32_t num_clips_left = m_num_clips;
+			while (num_clips_left > 0)
+			{
+				const uint32_t half_num_clips = num_clips_left / 2;
+				const uint32_t middle_clip_index = first_clip_index + half_num_clips;
+
+				if (entries[middle_clip_index].name_hash < name_hash)
+				{
+					first_clip_index = middle_clip_index + 1;
+					num_clips_left -= half_num_clips + 1;
+				}
+				else
+					num_clips_left = half_num_clips;
+			}
+
+			for (uint32_t clip_index = first_clip_index; clip_index < m_num_clips && entries[clip_index].name_hash == name_hash; ++clip_index)
+			{
+				const ClipDatabaseEntry& entry = entries[clip_index];
+				if (entry.name_size == name_size && std::memcmp(entry.name_offset.add_to(this), name, name_size) == 0)
+					return clip_index;
+			}
+
+			return k_invalid_clip_index;
+		}
+
+		// Returns the index of the clip with the provided compressed clip hash or k_invalid_clip_index if it isn't found
+		uint32_t find_clip_by_hash(uint32_t clip_hash) const
+		{
+			const ClipDatabaseEntry* entries = m_entries_offset.add_to(this);
+			const uint32_t* clip_hash_index = m_clip_hash_index_offset.add_to(this);
+
+			uint32_t first_index = 0;
+			uint32_t num_indices_left = m_num_clips;
+			while (num_indices_left > 0)
+			{
+				const uint32_t half_num_indices = num_indices_left / 2;
+				const uint32_t middle_index = first_index + half_num_indices;
+
+				if (entries[clip_hash_index[middle_index]].clip_hash < clip_hash)
+				{
+					first_index = middle_index + 1;
+					num_indices_left -= half_num_indices + 1;
+				}
+				else
+					num_indices_left = half_num_indices;
+			}
+
+			if (first_index < m_num_clips && entries[clip_hash_index[first_index]].clip_hash == clip_hash)
+				return clip_hash_index[first_index];
+
+			return k_invalid_clip_index;
+		}
+
+	private:
+		static constexpr uint32_t k_clip_database_tag = 0xac10db10;
+		static constexpr uint16_t k_clip_database_version = 1;
+		static constexpr uint32_t k_hash_skip_size = sizeof(uint32_t) + sizeof(uint32_t);	// m_size + m_hash
+
+		ClipDatabase(uint32_t size, uint32_t num_clips, uint32_t shared_data_size, uint32_t entries_offset, uint32_t clip_hash_index_offset)
+			: m_size(size)
+			, m_hash(0)
+			, m_tag(k_clip_database_tag)
+			, m_version(k_clip_database_version)
+			, m_padding(0)
+			, m_num_clips(num_clips)
+			, m_shared_data_size(shared_data_size)
+			, m_entries_offset(entries_offset)
+			, m_clip_hash_index_offset(clip_hash_index_offset)
+		{
+			(void)m_padding;	// Avoid unused warning
+
+			// Everything that follows must be written before we are constructed
+			m_hash = hash32(safe_ptr_cast<const uint8_t>(this) + k_hash_skip_size, size - k_hash_skip_size);
+		}
+
+		// 32 byte header, the rest of the data follows in memory
+		uint32_t							m_size;
+		uint32_t							m_hash;
+
+		// Everything starting here is included in the hash
+		uint32_t							m_tag;
+		uint16_t							m_version;
+		uint16_t							m_padding;
+
+		uint32_t							m_num_clips;
+		uint32_t							m_shared_data_size;
+		PtrOffset32<ClipDatabaseEntry>		m_entries_offset;
+		PtrOffset32<uint32_t>				m_clip_hash_index_offset;
+
+		friend ClipDatabase* make_clip_database(void* buffer, uint32_t size, uint32_t num_clips, uint32_t shared_data_size, uint32_t entries_offset, uint32_t clip_hash_index_offset);
+	};
+
+	static_assert(alignof(ClipDatabase) == 16, "Invalid alignment for ClipDatabase");
+	static_assert(sizeof(ClipDatabase) == 32, "Invalid size for ClipDatabase");
+}
@@ -40,6 +40,7 @@ namespace acl
 	public:
 		AlgorithmType8 get_algorithm_type() const { return m_type; }
 		uint32_t get_size() const { return m_size; }
+		uint32_t get_hash() const { return m_hash; }
 
 		bool is_valid(bool check_hash) const
 		{
@@ -99,6 +100,7 @@ namespace acl
 	struct SegmentHeader
 	{
 		uint32_t				num_samples;
+		uint32_t				clip_sample_offset;							// Index of the first sample of this segment in the clip
 		uint32_t				animated_pose_bit_size;						// TODO: Calculate from bitsets and formats?
 
 																			// TODO: Only need one offset, calculate the others from the information we have?
@@ -121,6 +123,9 @@ namespace acl
 
 		uint8_t					has_scale;
 
+		// Animated data is stored in blocks of this many key frames, sorted by track within a block
+		uint8_t					key_frame_block_size;
+
 		uint32_t				num_samples;
 		uint32_t				sample_rate;								// TODO: Store duration as float instead
 
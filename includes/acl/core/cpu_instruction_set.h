@@ -0,0 +1,146 @@
+#pragma once
+
+////////////////////////////////////////////////////////////////////////////////
+// The MIT License (MIT)
+//
+// Copyright (c) 2018 Nicholas Frechette & Animation Compression Library contributors
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+////////////////////////////////////////////////////////////////////////////////
+
+#include <cstdint>
+
+#if defined(_M_IX86) || defined(_M_X64) || defined(__i386__) || defined(__x86_64__)
+	#define ACL_X86_CPU
+
+	#if defined(_MSC_VER)
+		#include <intrin.h>
+	#else
+		#include <cpuid.h>
+	#endif
+#endif
+
+namespace acl
+{
+	//////////////////////////////////////////////////////////////////////////
+	// The instruction sets the decompression code can be specialized for.
+	// Values are ordered, every instruction set includes the ones before it.
+	//////////////////////////////////////////////////////////////////////////
+	enum class CPUInstructionSet8 : uint8_t
+	{
+		Generic			= 0,	// Not an x86 CPU, no specialized code is available
+		SSE2			= 1,
+		SSE4			= 2,	// SSE3, SSSE3, and SSE4.1
+		AVX				= 3,
+		AVX2			= 4,
+	};
+
+	//////////////////////////////////////////////////////////////////////////
+
+	// TODO: constexpr
+	inline const char* get_cpu_instruction_set_name(CPUInstructionSet8 instruction_set)
+	{
+		switch (instruction_set)
+		{
+			case CPUInstructionSet8::Generic:	return "Generic";
+			case CPUInstructionSet8::SSE2:		return "SSE2";
+			case CPUInstructionSet8::SSE4:		return "SSE4";
+			case CPUInstructionSet8::AVX:		return "AVX";
+			case CPUInstructionSet8::AVX2:		return "AVX2";
+			default:							return "<Invalid>";
+		}
+	}
+
+	namespace impl
+	{
+#if defined(ACL_X86_CPU)
+		inline void cpuid(uint32_t leaf, uint32_t sub_leaf, uint32_t out_registers[4])
+		{
+	#if defined(_MSC_VER)
+			int registers[4];
+			__cpuidex(registers, int(leaf), int(sub_leaf));
+			for (int register_index = 0; register_index < 4; ++register_index)
+				out_registers[register_index] = uint32_t(registers[register_index]);
+	#else
+			__cpuid_count(leaf, sub_leaf, out_registers[0], out_registers[1], out_registers[2], out_registers[3]);
+	#endif
+		}
+
+		// Reads the XCR0 register, only valid when the OS reports it with the OSXSAVE feature bit
+		inline uint64_t read_xcr0()
+		{
+	#if defined(_MSC_VER)
+			return _xgetbv(0);
+	#else
+			// Encoded manually to avoid requiring -mxsave
+			uint32_t eax;
+			uint32_t edx;
+			__asm__ volatile(".byte 0x0f, 0x01, 0xd0" : "=a"(eax), "=d"(edx) : "c"(0));
+			return (uint64_t(edx) << 32) | eax;
+	#endif
+		}
+#endif
+	}
+
+	//////////////////////////////////////////////////////////////////////////
+	// Queries the CPU with cpuid and returns the most capable instruction set
+	// it supports, also taking into account whether the OS preserves the AVX registers.
+	//////////////////////////////////////////////////////////////////////////
+	inline CPUInstructionSet8 get_cpu_instruction_set()
+	{
+#if defined(ACL_X86_CPU)
+		uint32_t registers[4];
+		impl::cpuid(0, 0, registers);
+		const uint32_t max_leaf = registers[0];
+		if (max_leaf < 1)
+			return CPUInstructionSet8::SSE2;
+
+		impl::cpuid(1, 0, registers);
+		const uint32_t features_ecx = registers[2];
+		const uint32_t features_edx = registers[3];
+
+		const bool has_sse2 = (features_edx & (1 << 26)) != 0;
+		const bool has_sse3 = (features_ecx & (1 << 0)) != 0;
+		const bool has_ssse3 = (features_ecx & (1 << 9)) != 0;
+		const bool has_sse41 = (features_ecx & (1 << 19)) != 0;
+		const bool has_osxsave = (features_ecx & (1 << 27)) != 0;
+		const bool has_avx = (features_ecx & (1 << 28)) != 0;
+
+		if (!has_sse2)
+			return CPUInstructionSet8::Generic;
+
+		if (!has_sse3 || !has_ssse3 || !has_sse41)
+			return CPUInstructionSet8::SSE2;
+
+		// The OS must save the XMM and YMM registers on context switches for AVX to be usable
+		if (!has_osxsave || !has_avx || (impl::read_xcr0() & 0x6) != 0x6)
+			return CPUInstructionSet8::SSE4;
+
+		if (max_leaf < 7)
+			return CPUInstructionSet8::AVX;
+
+		impl::cpuid(7, 0, registers);
+		const bool has_avx2 = (registers[1] & (1 << 5)) != 0;
+
+		return has_avx2 ? CPUInstructionSet8::AVX2 : CPUInstructionSet8::AVX;
+#else
+		return CPUInstructionSet8::Generic;
+#endif
+	}
+}
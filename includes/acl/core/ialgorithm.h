@@ -48,6 +48,7 @@ namespace acl
 		virtual void deallocate_decompression_context(IAllocator& allocator, void* context) = 0;
 
 		virtual void decompress_pose(const CompressedClip& clip, void* context, float sample_time, Transform_32* out_transforms, uint16_t num_transforms) = 0;
+		virtual void decompress_poses(const CompressedClip& clip, void** contexts, const float* sample_times, Transform_32** out_transforms, uint16_t num_transforms, uint32_t num_instances) = 0;
 		virtual void decompress_bone(const CompressedClip& clip, void* context, float sample_time, uint16_t sample_bone_index, Quat_32* out_rotation, Vector4_32* out_translation, Vector4_32* out_scale) = 0;
 
 		virtual const CompressionSettings& get_compression_settings() const = 0;
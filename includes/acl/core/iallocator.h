@@ -55,6 +55,9 @@ namespace acl
 
 		virtual void* allocate(size_t size, size_t alignment = k_default_alignment) = 0;
 		virtual void deallocate(void* ptr, size_t size) = 0;
+
+		// Whether 'allocate' and 'deallocate' can safely be called from multiple threads at the same time
+		virtual bool is_thread_safe() const { return false; }
 	};
 
 	//////////////////////////////////////////////////////////////////////////
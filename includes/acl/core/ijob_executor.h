@@ -0,0 +1,56 @@
+#pragma once
+
+////////////////////////////////////////////////////////////////////////////////
+// The MIT License (MIT)
+//
+// Copyright (c) 2018 Nicholas Frechette & Animation Compression Library contributors
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+////////////////////////////////////////////////////////////////////////////////
+
+#include <cstdint>
+
+namespace acl
+{
+	// Called once for every job, 'user_data' is the value handed to 'IJobExecutor::run_jobs'
+	typedef void (*JobFunction)(void* user_data, uint32_t job_index);
+
+	//////////////////////////////////////////////////////////////////////////
+	// An interface to execute independent jobs in parallel on whatever threads
+	// the host application provides. ACL only creates threads of its own when
+	// the caller hands it a 'ThreadJobExecutor' (see core/thread_job_executor.h).
+	//
+	// Jobs can run in any order and on any thread but 'run_jobs' must not return
+	// until every job has completed. Everything ACL does within a job only
+	// touches data owned by that job which keeps the output deterministic
+	// regardless of how the jobs are scheduled.
+	//////////////////////////////////////////////////////////////////////////
+	class IJobExecutor
+	{
+	public:
+		IJobExecutor() {}
+		virtual ~IJobExecutor() {}
+
+		IJobExecutor(const IJobExecutor&) = delete;
+		IJobExecutor& operator=(const IJobExecutor&) = delete;
+
+		// Calls 'function' once for every job index in [0, num_jobs) and waits for all of them to complete
+		virtual void run_jobs(uint32_t num_jobs, JobFunction function, void* user_data) = 0;
+	};
+}
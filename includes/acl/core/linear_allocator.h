@@ -0,0 +1,179 @@
+#pragma once
+
+////////////////////////////////////////////////////////////////////////////////
+// The MIT License (MIT)
+//
+// Copyright (c) 2018 Nicholas Frechette & Animation Compression Library contributors
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+////////////////////////////////////////////////////////////////////////////////
+
+#include "acl/core/iallocator.h"
+#include "acl/core/error.h"
+#include "acl/core/memory_utils.h"
+
+#include <algorithm>
+#include <cstdint>
+
+namespace acl
+{
+	//////////////////////////////////////////////////////////////////////////
+	// A linear allocator carves its allocations out of large pages obtained
+	// from a backing allocator. Deallocations are free: memory is only
+	// reclaimed when the most recent allocation is released or once every
+	// live allocation has been released, at which point the allocator rewinds
+	// and keeps its last page for future allocations.
+	//
+	// This is well suited for transient allocations that all die together
+	// like the scratch memory needed by the compression pipeline.
+	// The allocator is NOT thread safe.
+	//////////////////////////////////////////////////////////////////////////
+	class LinearAllocator final : public IAllocator
+	{
+	public:
+		static constexpr size_t k_default_page_size = 64 * 1024;
+
+		explicit LinearAllocator(IAllocator& backing_allocator, size_t page_size = k_default_page_size)
+			: IAllocator()
+			, m_backing_allocator(backing_allocator)
+			, m_page_size(page_size)
+			, m_current_page(nullptr)
+			, m_current_ptr(nullptr)
+			, m_current_page_end(nullptr)
+			, m_allocation_count(0)
+			, m_num_pages(0)
+		{
+			ACL_ENSURE(page_size > get_page_header_size(), "Page size is too small: %u", page_size);
+		}
+
+		virtual ~LinearAllocator()
+		{
+			ACL_ENSURE(m_allocation_count == 0, "The number of allocations and deallocations does not match");
+
+			release_pages(nullptr);
+		}
+
+		LinearAllocator(const LinearAllocator&) = delete;
+		LinearAllocator& operator=(const LinearAllocator&) = delete;
+
+		virtual void* allocate(size_t size, size_t alignment = k_default_alignment) override
+		{
+			ACL_ASSERT(alignment != 0 && (alignment & (alignment - 1)) == 0, "Invalid alignment: %u. Expected a power of two", alignment);
+
+			uint8_t* ptr = m_current_page != nullptr ? align_to(m_current_ptr, alignment) : nullptr;
+			if (ptr == nullptr || ptr > m_current_page_end || size_t(m_current_page_end - ptr) < size)
+			{
+				allocate_page(size + alignment);
+				ptr = align_to(m_current_ptr, alignment);
+			}
+
+			m_current_ptr = ptr + size;
+			m_allocation_count++;
+			return ptr;
+		}
+
+		virtual void deallocate(void* ptr, size_t size) override
+		{
+			if (ptr == nullptr)
+				return;
+
+			ACL_ENSURE(m_allocation_count > 0, "The number of allocations and deallocations does not match");
+			m_allocation_count--;
+
+			if (m_allocation_count == 0)
+			{
+				// Everything is dead, keep our most recent page and release the others
+				release_pages(m_current_page);
+				m_current_ptr = get_page_data(m_current_page);
+			}
+			else if (static_cast<uint8_t*>(ptr) + size == m_current_ptr)
+			{
+				// The most recent allocation can be reclaimed right away
+				m_current_ptr = static_cast<uint8_t*>(ptr);
+			}
+		}
+
+		IAllocator& get_backing_allocator() const { return m_backing_allocator; }
+		size_t get_page_size() const { return m_page_size; }
+		uint32_t get_allocation_count() const { return m_allocation_count; }
+		uint32_t get_num_pages() const { return m_num_pages; }
+
+	private:
+		struct PageHeader
+		{
+			PageHeader*	previous_page;
+			size_t		size;
+		};
+
+		static constexpr size_t get_page_header_size() { return (sizeof(PageHeader) + k_default_alignment - 1) & ~(k_default_alignment - 1); }
+		static uint8_t* get_page_data(PageHeader* page) { return reinterpret_cast<uint8_t*>(page) + get_page_header_size(); }
+
+		void allocate_page(size_t min_data_size)
+		{
+			// Large allocations get a dedicated page
+			const size_t page_size = std::max<size_t>(m_page_size, get_page_header_size() + min_data_size);
+
+			PageHeader* page = static_cast<PageHeader*>(m_backing_allocator.allocate(page_size, k_default_alignment));
+			ACL_ENSURE(page != nullptr, "Failed to allocate a page of %u bytes", page_size);
+
+			page->previous_page = m_current_page;
+			page->size = page_size;
+
+			m_current_page = page;
+			m_current_ptr = get_page_data(page);
+			m_current_page_end = reinterpret_cast<uint8_t*>(page) + page_size;
+			m_num_pages++;
+		}
+
+		void release_pages(PageHeader* page_to_keep)
+		{
+			PageHeader* page = m_current_page;
+			while (page != nullptr)
+			{
+				PageHeader* previous_page = page->previous_page;
+				if (page != page_to_keep)
+				{
+					m_backing_allocator.deallocate(page, page->size);
+					m_num_pages--;
+				}
+
+				page = previous_page;
+			}
+
+			m_current_page = page_to_keep;
+			if (page_to_keep != nullptr)
+				page_to_keep->previous_page = nullptr;
+			else
+			{
+				m_current_ptr = nullptr;
+				m_current_page_end = nullptr;
+			}
+		}
+
+		IAllocator&		m_backing_allocator;
+		size_t			m_page_size;
+
+		PageHeader*		m_current_page;
+		uint8_t*		m_current_ptr;
+		uint8_t*		m_current_page_end;
+
+		uint32_t		m_allocation_count;
+		uint32_t		m_num_pages;
+	};
+}
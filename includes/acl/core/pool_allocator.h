@@ -0,0 +1,166 @@
+#pragma once
+
+////////////////////////////////////////////////////////////////////////////////
+// The MIT License (MIT)
+//
+// Copyright (c) 2018 Nicholas Frechette & Animation Compression Library contributors
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include "acl/core/iallocator.h"
+#include "acl/core/error.h"
+#include "acl/core/memory_utils.h"
+
+#include <algorithm>
+#include <cstdint>
+
+namespace acl
+{
+	//////////////////////////////////////////////////////////////////////////
+	// A pool allocator hands out blocks of a single size carved out of large
+	// pages obtained from a backing allocator. Released blocks are kept in a
+	// free list and reused by the next allocations, pages are only returned
+	// to the backing allocator when the pool is destroyed.
+	//
+	// This is well suited for many small objects with the same size that are
+	// created and destroyed often like per instance decompression contexts.
+	// Blocks are tightly packed which keeps them dense in memory.
+	// The allocator is NOT thread safe.
+	//////////////////////////////////////////////////////////////////////////
+	class PoolAllocator final : public IAllocator
+	{
+	public:
+		static constexpr uint32_t k_default_num_blocks_per_page = 1024;
+
+		PoolAllocator(IAllocator& backing_allocator, size_t block_size, size_t block_alignment, uint32_t num_blocks_per_page = k_default_num_blocks_per_page)
+			: IAllocator()
+			, m_backing_allocator(backing_allocator)
+			, m_block_size(align_to(std::max(block_size, sizeof(FreeBlock)), std::max(block_alignment, alignof(FreeBlock))))
+			, m_block_alignment(std::max(block_alignment, alignof(FreeBlock)))
+			, m_num_blocks_per_page(num_blocks_per_page)
+			, m_current_page(nullptr)
+			, m_free_blocks(nullptr)
+			, m_allocation_count(0)
+			, m_num_pages(0)
+		{
+			ACL_ENSURE(block_size != 0, "Block size cannot be zero");
+			ACL_ENSURE(block_alignment != 0 && (block_alignment & (block_alignment - 1)) == 0, "Invalid alignment: %u. Expected a power of two", block_alignment);
+			ACL_ENSURE(num_blocks_per_page != 0, "A page must hold at least one block");
+		}
+
+		virtual ~PoolAllocator()
+		{
+			ACL_ENSURE(m_allocation_count == 0, "The number of allocations and deallocations does not match");
+
+			PageHeader* page = m_current_page;
+			while (page != nullptr)
+			{
+				PageHeader* previous_page = page->previous_page;
+				m_backing_allocator.deallocate(page, get_page_size());
+				page = previous_page;
+			}
+		}
+
+		PoolAllocator(const PoolAllocator&) = delete;
+		PoolAllocator& operator=(const PoolAllocator&) = delete;
+
+		virtual void* allocate(size_t size, size_t alignment = k_default_alignment) override
+		{
+			ACL_ENSURE(size <= m_block_size, "Allocation size is larger than the block size: %u > %u", size, m_block_size);
+			ACL_ENSURE(alignment <= m_block_alignment, "Allocation alignment is larger than the block alignment: %u > %u", alignment, m_block_alignment);
+
+			if (m_free_blocks == nullptr)
+				allocate_page();
+
+			FreeBlock* block = m_free_blocks;
+			m_free_blocks = block->next_block;
+			m_allocation_count++;
+			return block;
+		}
+
+		virtual void deallocate(void* ptr, size_t size) override
+		{
+			if (ptr == nullptr)
+				return;
+
+			ACL_ENSURE(m_allocation_count > 0, "The number of allocations and deallocations does not match");
+			ACL_ENSURE(size <= m_block_size, "Allocation size is larger than the block size: %u > %u", size, m_block_size);
+			m_allocation_count--;
+
+			FreeBlock* block = static_cast<FreeBlock*>(ptr);
+			block->next_block = m_free_blocks;
+			m_free_blocks = block;
+		}
+
+		IAllocator& get_backing_allocator() const { return m_backing_allocator; }
+		size_t get_block_size() const { return m_block_size; }
+		uint32_t get_num_blocks_per_page() const { return m_num_blocks_per_page; }
+		uint32_t get_allocation_count() const { return m_allocation_count; }
+		uint32_t get_num_pages() const { return m_num_pages; }
+
+		// The number of bytes obtained from the backing allocator
+		size_t get_reserved_size() const { return size_t(m_num_pages) * get_page_size(); }
+
+	private:
+		struct PageHeader
+		{
+			PageHeader*	previous_page;
+		};
+
+		struct FreeBlock
+		{
+			FreeBlock*	next_block;
+		};
+
+		size_t get_page_header_size() const { return align_to(sizeof(PageHeader), m_block_alignment); }
+		size_t get_page_size() const { return get_page_header_size() + (m_block_size * m_num_blocks_per_page); }
+
+		void allocate_page()
+		{
+			const size_t page_size = get_page_size();
+
+			PageHeader* page = static_cast<PageHeader*>(m_backing_allocator.allocate(page_size, m_block_alignment));
+			ACL_ENSURE(page != nullptr, "Failed to allocate a page of %u bytes", page_size);
+
+			page->previous_page = m_current_page;
+			m_current_page = page;
+			m_num_pages++;
+
+			// Thread the new blocks in order so that consecutive allocations are contiguous in memory
+			uint8_t* page_data = reinterpret_cast<uint8_t*>(page) + get_page_header_size();
+			for (uint32_t block_index = m_num_blocks_per_page; block_index != 0; --block_index)
+			{
+				FreeBlock* block = reinterpret_cast<FreeBlock*>(page_data + (m_block_size * (block_index - 1)));
+				block->next_block = m_free_blocks;
+				m_free_blocks = block;
+			}
+		}
+
+		IAllocator&		m_backing_allocator;
+		size_t			m_block_size;
+		size_t			m_block_alignment;
+		uint32_t		m_num_blocks_per_page;
+
+		PageHeader*		m_current_page;
+		FreeBlock*		m_free_blocks;
+
+		uint32_t		m_allocation_count;
+		uint32_t		m_num_pages;
+	};
+}
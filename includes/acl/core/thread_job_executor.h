@@ -0,0 +1,257 @@
+#pragma once
+
+////////////////////////////////////////////////////////////////////////////////
+// The MIT License (MIT)
+//
+// Copyright (c) 2018 Nicholas Frechette & Animation Compression Library contributors
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+////////////////////////////////////////////////////////////////////////////////
+
+#include "acl/core/error.h"
+#include "acl/core/ijob_executor.h"
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace acl
+{
+	//////////////////////////////////////////////////////////////////////////
+	// A job executor backed by a pool of std::thread workers, for tests and tools
+	// or hosts that do not have a job system of their own. Including this header
+	// is opt-in, ACL itself only ever talks to the 'IJobExecutor' interface.
+	//
+	// Every call to 'run_jobs' splits the job indices into one contiguous range per
+	// worker, the calling thread being one of them. Workers run the jobs of their
+	// own range front to back and once it is empty, they steal the back half of
+	// the largest range left. Neighboring job indices thus tend to run on the same
+	// thread while uneven jobs still balance out across the workers.
+	//
+	// Jobs must not call 'run_jobs' on the executor that runs them.
+	//////////////////////////////////////////////////////////////////////////
+	class ThreadJobExecutor final : public IJobExecutor
+	{
+	public:
+		explicit ThreadJobExecutor(uint32_t num_threads = std::thread::hardware_concurrency())
+			: m_num_threads(num_threads != 0 ? num_threads : 1)
+			, m_queues(new JobQueue[m_num_threads])
+			, m_threads()
+			, m_lock()
+			, m_start_condition()
+			, m_done_condition()
+			, m_function(nullptr)
+			, m_user_data(nullptr)
+			, m_generation(0)
+			, m_num_busy_workers(0)
+			, m_num_jobs_run(0)
+			, m_num_jobs_stolen(0)
+			, m_is_shutting_down(false)
+		{
+			// The calling thread is the first worker
+			m_threads.reserve(m_num_threads - 1);
+			for (uint32_t worker_index = 1; worker_index < m_num_threads; ++worker_index)
+				m_threads.emplace_back([this, worker_index]() { worker_main(worker_index); });
+		}
+
+		virtual ~ThreadJobExecutor() override
+		{
+			{
+				std::lock_guard<std::mutex> lock(m_lock);
+				m_is_shutting_down = true;
+			}
+
+			m_start_condition.notify_all();
+
+			for (std::thread& thread : m_threads)
+				thread.join();
+		}
+
+		virtual void run_jobs(uint32_t num_jobs, JobFunction function, void* user_data) override
+		{
+			ACL_ENSURE(function != nullptr, "Job function cannot be null");
+
+			if (num_jobs == 0)
+				return;
+
+			for (uint32_t worker_index = 0; worker_index < m_num_threads; ++worker_index)
+			{
+				JobQueue& queue = m_queues[worker_index];
+				std::lock_guard<std::mutex> lock(queue.lock);
+				queue.first_job_index = uint32_t((uint64_t(num_jobs) * worker_index) / m_num_threads);
+				queue.end_job_index = uint32_t((uint64_t(num_jobs) * (worker_index + 1)) / m_num_threads);
+			}
+
+			{
+				std::lock_guard<std::mutex> lock(m_lock);
+				m_function = function;
+				m_user_data = user_data;
+				m_num_busy_workers = m_num_threads - 1;
+				m_generation++;
+			}
+
+			m_start_condition.notify_all();
+
+			run_worker(0);
+
+			std::unique_lock<std::mutex> lock(m_lock);
+			m_done_condition.wait(lock, [this]() { return m_num_busy_workers == 0; });
+			m_function = nullptr;
+			m_user_data = nullptr;
+			m_num_jobs_run += num_jobs;
+		}
+
+		uint32_t get_num_threads() const { return m_num_threads; }
+
+		// Number of jobs that ran since the executor was created
+		uint32_t get_num_jobs_run() const { return m_num_jobs_run.load(); }
+
+		// Number of jobs that ran on another worker than the one they were first handed to, since the executor was created
+		uint32_t get_num_jobs_stolen() const { return m_num_jobs_stolen.load(); }
+
+	private:
+		struct JobQueue
+		{
+			std::mutex lock;
+			uint32_t first_job_index = 0;
+			uint32_t end_job_index = 0;
+		};
+
+		void worker_main(uint32_t worker_index)
+		{
+			uint64_t generation = 0;
+
+			while (true)
+			{
+				{
+					std::unique_lock<std::mutex> lock(m_lock);
+					m_start_condition.wait(lock, [this, generation]() { return m_is_shutting_down || m_generation != generation; });
+
+					if (m_is_shutting_down)
+						return;
+
+					generation = m_generation;
+				}
+
+				run_worker(worker_index);
+
+				bool is_last_worker;
+				{
+					std::lock_guard<std::mutex> lock(m_lock);
+					is_last_worker = --m_num_busy_workers == 0;
+				}
+
+				if (is_last_worker)
+					m_done_condition.notify_one();
+			}
+		}
+
+		void run_worker(uint32_t worker_index)
+		{
+			JobQueue& queue = m_queues[worker_index];
+
+			while (true)
+			{
+				uint32_t job_index;
+				bool has_job;
+				{
+					std::lock_guard<std::mutex> lock(queue.lock);
+					has_job = queue.first_job_index < queue.end_job_index;
+					job_index = queue.first_job_index;
+					if (has_job)
+						queue.first_job_index++;
+				}
+
+				if (has_job)
+					m_function(m_user_data, job_index);
+				else if (!steal_jobs(worker_index))
+					return;
+			}
+		}
+
+		bool steal_jobs(uint32_t thief_index)
+		{
+			while (true)
+			{
+				// Pick the largest range left, ranges only shrink while jobs run so this is only a hint
+				uint32_t victim_index = thief_index;
+				uint32_t victim_num_jobs = 0;
+				for (uint32_t worker_index = 0; worker_index < m_num_threads; ++worker_index)
+				{
+					if (worker_index == thief_index)
+						continue;
+
+					JobQueue& queue = m_queues[worker_index];
+					std::lock_guard<std::mutex> lock(queue.lock);
+					const uint32_t num_jobs = queue.end_job_index - queue.first_job_index;
+					if (num_jobs > victim_num_jobs)
+					{
+						victim_index = worker_index;
+						victim_num_jobs = num_jobs;
+					}
+				}
+
+				if (victim_num_jobs == 0)
+					return false;
+
+				uint32_t first_stolen_job_index;
+				uint32_t end_stolen_job_index;
+				{
+					JobQueue& victim_queue = m_queues[victim_index];
+					std::lock_guard<std::mutex> lock(victim_queue.lock);
+					const uint32_t num_jobs = victim_queue.end_job_index - victim_queue.first_job_index;
+					if (num_jobs == 0)
+						continue;	// Drained in the mean time, look again
+
+					end_stolen_job_index = victim_queue.end_job_index;
+					first_stolen_job_index = end_stolen_job_index - ((num_jobs + 1) / 2);
+					victim_queue.end_job_index = first_stolen_job_index;
+				}
+
+				m_num_jobs_stolen += end_stolen_job_index - first_stolen_job_index;
+
+				JobQueue& thief_queue = m_queues[thief_index];
+				std::lock_guard<std::mutex> lock(thief_queue.lock);
+				thief_queue.first_job_index = first_stolen_job_index;
+				thief_queue.end_job_index = end_stolen_job_index;
+				return true;
+			}
+		}
+
+		uint32_t							m_num_threads;
+		std::unique_ptr<JobQueue[]>			m_queues;
+		std::vector<std::thread>			m_threads;
+
+		std::mutex							m_lock;
+		std::condition_variable				m_start_condition;
+		std::condition_variable				m_done_condition;
+
+		JobFunction							m_function;
+		void*								m_user_data;
+		uint64_t							m_generation;
+		uint32_t							m_num_busy_workers;
+		std::atomic<uint32_t>				m_num_jobs_run;
+		std::atomic<uint32_t>				m_num_jobs_stolen;
+		bool								m_is_shutting_down;
+	};
+}
@@ -39,12 +39,11 @@ namespace acl
 		QuatDropW_48				= 2,	// Quantized quaternion, [x,y,z] stored with [16,16,16] bits (w is dropped)
 		QuatDropW_32				= 3,	// Quantized quaternion, [x,y,z] stored with [11,11,10] bits (w is dropped)
 		QuatDropW_Variable			= 4,	// Quantized quaternion, [x,y,z] stored with [N,N,N] bits (w is dropped, same number of bits per component)
-		// TODO: Implement these
-		//Quat_32_Largest,		// Quantized quaternion, [?,?,?] stored with [10,10,10] bits (largest component is dropped, component index stored on 2 bits)
-		//QuatLog_96,			// Full precision quaternion logarithm, [x,y,z] stored with float 32
-		//QuatLog_48,			// Quantized quaternion logarithm, [x,y,z] stored with [16,16,16] bits
-		//QuatLog_32,			// Quantized quaternion logarithm, [x,y,z] stored with [11,11,10] bits
-		//QuatLog_Variable,		// Quantized quaternion logarithm, [x,y,z] stored with [N,N,N] bits (same number of bits per component)
+		Quat_32_Largest				= 5,	// Quantized quaternion, [?,?,?] stored with [10,10,10] bits (largest component is dropped, component index stored on 2 bits)
+		QuatLog_96					= 6,	// Full precision quaternion logarithm, [x,y,z] stored with float 32
+		QuatLog_48					= 7,	// Quantized quaternion logarithm, [x,y,z] stored with [16,16,16] bits
+		QuatLog_32					= 8,	// Quantized quaternion logarithm, [x,y,z] stored with [11,11,10] bits
+		QuatLog_Variable			= 9,	// Quantized quaternion logarithm, [x,y,z] stored with [N,N,N] bits (same number of bits per component)
 	};
 
 	// BE CAREFUL WHEN CHANGING VALUES IN THIS ENUM
@@ -79,8 +78,8 @@ namespace acl
 	{
 		Quat,
 		QuatDropW,
-		//QuatDropLargest,
-		//QuatLog,
+		QuatDropLargest,
+		QuatLog,
 	};
 
 	enum class TimeSeriesType8 : uint8_t
@@ -135,6 +134,11 @@ namespace acl
 		case RotationFormat8::QuatDropW_48:			return "Quat Drop W 48";
 		case RotationFormat8::QuatDropW_32:			return "Quat Drop W 32";
 		case RotationFormat8::QuatDropW_Variable:	return "Quat Drop W Variable";
+		case RotationFormat8::Quat_32_Largest:		return "Quat 32 Largest";
+		case RotationFormat8::QuatLog_96:			return "Quat Log 96";
+		case RotationFormat8::QuatLog_48:			return "Quat Log 48";
+		case RotationFormat8::QuatLog_32:			return "Quat Log 32";
+		case RotationFormat8::QuatLog_Variable:		return "Quat Log Variable";
 		default:									return "<Invalid>";
 		}
 	}
@@ -176,6 +180,41 @@ namespace acl
 			return true;
 		}
 
+		const char* quat_32_largest_format = "Quat_32_Largest";
+		if (std::strncmp(format, quat_32_largest_format, std::strlen(quat_32_largest_format)) == 0)
+		{
+			out_format = RotationFormat8::Quat_32_Largest;
+			return true;
+		}
+
+		const char* quatlog_96_format = "QuatLog_96";
+		if (std::strncmp(format, quatlog_96_format, std::strlen(quatlog_96_format)) == 0)
+		{
+			out_format = RotationFormat8::QuatLog_96;
+			return true;
+		}
+
+		const char* quatlog_48_format = "QuatLog_48";
+		if (std::strncmp(format, quatlog_48_format, std::strlen(quatlog_48_format)) == 0)
+		{
+			out_format = RotationFormat8::QuatLog_48;
+			return true;
+		}
+
+		const char* quatlog_32_format = "QuatLog_32";
+		if (std::strncmp(format, quatlog_32_format, std::strlen(quatlog_32_format)) == 0)
+		{
+			out_format = RotationFormat8::QuatLog_32;
+			return true;
+		}
+
+		const char* quatlog_variable_format = "QuatLog_Variable";
+		if (std::strncmp(format, quatlog_variable_format, std::strlen(quatlog_variable_format)) == 0)
+		{
+			out_format = RotationFormat8::QuatLog_Variable;
+			return true;
+		}
+
 		return false;
 	}
 
@@ -237,6 +276,13 @@ namespace acl
 		case RotationFormat8::QuatDropW_32:
 		case RotationFormat8::QuatDropW_Variable:
 			return RotationVariant8::QuatDropW;
+		case RotationFormat8::Quat_32_Largest:
+			return RotationVariant8::QuatDropLargest;
+		case RotationFormat8::QuatLog_96:
+		case RotationFormat8::QuatLog_48:
+		case RotationFormat8::QuatLog_32:
+		case RotationFormat8::QuatLog_Variable:
+			return RotationVariant8::QuatLog;
 		default:
 			ACL_ENSURE(false, "Invalid or unsupported rotation format: %s", get_rotation_format_name(rotation_format));
 			return RotationVariant8::Quat;
@@ -250,6 +296,8 @@ namespace acl
 		{
 		case RotationVariant8::Quat:			return RotationFormat8::Quat_128;
 		case RotationVariant8::QuatDropW:		return RotationFormat8::QuatDropW_32;
+		case RotationVariant8::QuatDropLargest:	return RotationFormat8::Quat_32_Largest;
+		case RotationVariant8::QuatLog:			return RotationFormat8::QuatLog_32;
 		default:
 			ACL_ENSURE(false, "Invalid or unsupported rotation format: %u", (uint32_t)variant);
 			return RotationFormat8::Quat_128;
@@ -263,6 +311,8 @@ namespace acl
 		{
 		case RotationVariant8::Quat:			return RotationFormat8::Quat_128;
 		case RotationVariant8::QuatDropW:		return RotationFormat8::QuatDropW_96;
+		case RotationVariant8::QuatDropLargest:	return RotationFormat8::Quat_32_Largest;
+		case RotationVariant8::QuatLog:			return RotationFormat8::QuatLog_96;
 		default:
 			ACL_ENSURE(false, "Invalid or unsupported rotation format: %u", (uint32_t)variant);
 			return RotationFormat8::Quat_128;
@@ -278,8 +328,13 @@ namespace acl
 		case RotationFormat8::QuatDropW_96:
 		case RotationFormat8::QuatDropW_48:
 		case RotationFormat8::QuatDropW_32:
+		case RotationFormat8::Quat_32_Largest:
+		case RotationFormat8::QuatLog_96:
+		case RotationFormat8::QuatLog_48:
+		case RotationFormat8::QuatLog_32:
 			return false;
 		case RotationFormat8::QuatDropW_Variable:
+		case RotationFormat8::QuatLog_Variable:
 			return true;
 		default:
 			ACL_ENSURE(false, "Invalid or unsupported rotation format: %s", get_rotation_format_name(rotation_format));
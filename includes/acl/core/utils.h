@@ -44,7 +44,7 @@ namespace acl
 		FloatType sample_rate = duration == FloatType(0.0) ? FloatType(0.0) : floor((FloatType(num_samples - 1) / duration) + FloatType(0.5));
 		FloatType sample_key = sample_time * sample_rate;
 		uint32_t key_frame0 = uint32_t(floor(sample_key));
-		uint32_t key_frame1 = std::min(key_frame0 + 1, num_samples - 1);
+		uint32_t key_frame1 = (num_samples - 1) < (key_frame0 + 1) ? (num_samples - 1) : (key_frame0 + 1);
 		FloatType interpolation_alpha = sample_key - FloatType(key_frame0);
 		ACL_ENSURE(key_frame0 >= 0 && key_frame0 <= key_frame1 && key_frame1 < num_samples, "Invalid key frames: 0 <= %u <= %u < %u", key_frame0, key_frame1, num_samples);
 		ACL_ENSURE(interpolation_alpha >= FloatType(0.0) && interpolation_alpha <= FloatType(1.0), "Invalid interpolation alpha: 0.0 <= %f <= 1.0", interpolation_alpha);
@@ -0,0 +1,169 @@
+#pragma once
+
+////////////////////////////////////////////////////////////////////////////////
+// The MIT License (MIT)
+//
+// Copyright (c) 2018 Nicholas Frechette & Animation Compression Library contributors
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include "acl/core/error.h"
+#include "acl/decompression/output_writer.h"
+#include "acl/math/math_types.h"
+#include "acl/math/quat_32.h"
+#include "acl/math/vector4_32.h"
+
+#include <stdint.h>
+
+namespace acl
+{
+	//////////////////////////////////////////////////////////////////////////
+	// Blending layers decompressed with the writers below avoids decompressing every
+	// layer into a temporary pose first. A blend goes like this:
+	//    - 'blend_pose_reset' clears the destination pose
+	//    - every layer is decompressed with a 'BlendOutputWriter' and its weight
+	//    - 'blend_pose_finalize' normalizes the destination pose once
+	//    - additive layers are then applied with an 'AdditiveBlendOutputWriter'
+	//////////////////////////////////////////////////////////////////////////
+
+	// Clears a pose before layers are accumulated into it
+	inline void blend_pose_reset(Transform_32* transforms, uint16_t num_transforms)
+	{
+		ACL_ENSURE(transforms != nullptr, "Transforms array cannot be null");
+
+		const Transform_32 zero = { vector_to_quat(vector_zero_32()), vector_zero_32(), vector_zero_32() };
+		for (uint16_t bone_index = 0; bone_index < num_transforms; ++bone_index)
+			transforms[bone_index] = zero;
+	}
+
+	// Normalizes the rotations of an accumulated pose and rescales its translations and scales when the weights do not sum to one
+	inline void blend_pose_finalize(Transform_32* transforms, uint16_t num_transforms, float total_weight)
+	{
+		ACL_ENSURE(transforms != nullptr, "Transforms array cannot be null");
+		ACL_ENSURE(total_weight > 0.0f, "Total blend weight must be positive: %f", total_weight);
+
+		const bool is_normalized = scalar_near_equal(total_weight, 1.0f, 0.00001f);
+		const float inv_total_weight = 1.0f / total_weight;
+
+		for (uint16_t bone_index = 0; bone_index < num_transforms; ++bone_index)
+		{
+			Transform_32& transform = transforms[bone_index];
+			transform.rotation = quat_normalize(transform.rotation);
+
+			if (!is_normalized)
+			{
+				transform.translation = vector_mul(transform.translation, inv_total_weight);
+				transform.scale = vector_mul(transform.scale, inv_total_weight);
+			}
+		}
+	}
+
+	//////////////////////////////////////////////////////////////////////////
+	// Accumulates a weighted pose into a destination pose as it is decompressed.
+	// Rotations are flipped into the hemisphere of what was accumulated so far to
+	// blend along the shortest path. See above for how to blend layers.
+	//////////////////////////////////////////////////////////////////////////
+	struct BlendOutputWriter : public OutputWriter
+	{
+		BlendOutputWriter(Transform_32* transforms, uint16_t num_transforms, float weight)
+			: m_transforms(transforms)
+			, m_weight(weight)
+			, m_num_transforms(num_transforms)
+		{
+			ACL_ENSURE(transforms != nullptr, "Transforms array cannot be null");
+			ACL_ENSURE(num_transforms != 0, "Transforms array cannot be empty");
+			ACL_ENSURE(weight >= 0.0f, "Blend weight cannot be negative: %f", weight);
+		}
+
+		constexpr bool requires_ordered_writes() const { return false; }
+
+		void write_bone_rotation(uint32_t bone_index, const acl::Quat_32& rotation)
+		{
+			ACL_ENSURE(bone_index < m_num_transforms, "Invalid bone index. %u >= %u", bone_index, m_num_transforms);
+
+			const Vector4_32 accumulated_rotation = quat_to_vector(m_transforms[bone_index].rotation);
+			const Vector4_32 rotation_vector = quat_to_vector(rotation);
+			const float weight = vector_dot(accumulated_rotation, rotation_vector) >= 0.0f ? m_weight : -m_weight;
+			m_transforms[bone_index].rotation = vector_to_quat(vector_add(accumulated_rotation, vector_mul(rotation_vector, weight)));
+		}
+
+		void write_bone_translation(uint32_t bone_index, const acl::Vector4_32& translation)
+		{
+			ACL_ENSURE(bone_index < m_num_transforms, "Invalid bone index. %u >= %u", bone_index, m_num_transforms);
+			m_transforms[bone_index].translation = vector_add(m_transforms[bone_index].translation, vector_mul(translation, m_weight));
+		}
+
+		void write_bone_scale(uint32_t bone_index, const acl::Vector4_32& scale)
+		{
+			ACL_ENSURE(bone_index < m_num_transforms, "Invalid bone index. %u >= %u", bone_index, m_num_transforms);
+			m_transforms[bone_index].scale = vector_add(m_transforms[bone_index].scale, vector_mul(scale, m_weight));
+		}
+
+		Transform_32* m_transforms;
+		float m_weight;
+		uint16_t m_num_transforms;
+	};
+
+	//////////////////////////////////////////////////////////////////////////
+	// Applies a weighted additive pose on top of a finalized destination pose as it is decompressed.
+	// The additive rotation is applied before the base rotation like 'quat_mul(additive, base)',
+	// translations are added and scales are multiplied. The weight fades the additive pose
+	// in from the identity: a weight of zero leaves the destination pose untouched.
+	//////////////////////////////////////////////////////////////////////////
+	struct AdditiveBlendOutputWriter : public OutputWriter
+	{
+		AdditiveBlendOutputWriter(Transform_32* transforms, uint16_t num_transforms, float weight)
+			: m_transforms(transforms)
+			, m_weight(weight)
+			, m_num_transforms(num_transforms)
+		{
+			ACL_ENSURE(transforms != nullptr, "Transforms array cannot be null");
+			ACL_ENSURE(num_transforms != 0, "Transforms array cannot be empty");
+			ACL_ENSURE(weight >= 0.0f && weight <= 1.0f, "Additive blend weight must be between 0.0 and 1.0: %f", weight);
+		}
+
+		constexpr bool requires_ordered_writes() const { return false; }
+
+		void write_bone_rotation(uint32_t bone_index, const acl::Quat_32& rotation)
+		{
+			ACL_ENSURE(bone_index < m_num_transforms, "Invalid bone index. %u >= %u", bone_index, m_num_transforms);
+
+			const Quat_32 weighted_rotation = quat_lerp(quat_identity_32(), rotation, m_weight);
+			m_transforms[bone_index].rotation = quat_mul(weighted_rotation, m_transforms[bone_index].rotation);
+		}
+
+		void write_bone_translation(uint32_t bone_index, const acl::Vector4_32& translation)
+		{
+			ACL_ENSURE(bone_index < m_num_transforms, "Invalid bone index. %u >= %u", bone_index, m_num_transforms);
+			m_transforms[bone_index].translation = vector_add(m_transforms[bone_index].translation, vector_mul(translation, m_weight));
+		}
+
+		void write_bone_scale(uint32_t bone_index, const acl::Vector4_32& scale)
+		{
+			ACL_ENSURE(bone_index < m_num_transforms, "Invalid bone index. %u >= %u", bone_index, m_num_transforms);
+
+			const Vector4_32 weighted_scale = vector_lerp(vector_set(1.0f), scale, m_weight);
+			m_transforms[bone_index].scale = vector_mul(m_transforms[bone_index].scale, weighted_scale);
+		}
+
+		Transform_32* m_transforms;
+		float m_weight;
+		uint16_t m_num_transforms;
+	};
+}
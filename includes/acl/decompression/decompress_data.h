@@ -24,17 +24,154 @@
 // SOFTWARE.
 ////////////////////////////////////////////////////////////////////////////////
 
+#include "acl/decompression/memory_access_recorder.h"
+
 namespace acl
 {
+	//////////////////////////////////////////////////////////////////////////
+	// When the decompression settings record memory accesses, every read of the compressed
+	// data goes through these helpers. Otherwise, the recording is stripped entirely.
+	//////////////////////////////////////////////////////////////////////////
+
+	template<class SettingsType, class DecompressionContext>
+	inline bool is_track_default(const SettingsType& settings, const DecompressionContext& context, uint32_t track_offset)
+	{
+		if (settings.is_memory_access_recorded())
+			settings.record_memory_access(CompressedDataSection8::DefaultTracksBitset, context.clip->default_tracks_bitset + (track_offset / 32), sizeof(uint32_t));
+
+		return bitset_test(context.clip->default_tracks_bitset, context.clip->bitset_desc, track_offset);
+	}
+
+	template<class SettingsType, class DecompressionContext>
+	inline bool is_track_constant(const SettingsType& settings, const DecompressionContext& context, uint32_t track_offset)
+	{
+		if (settings.is_memory_access_recorded())
+			settings.record_memory_access(CompressedDataSection8::ConstantTracksBitset, context.clip->constant_tracks_bitset + (track_offset / 32), sizeof(uint32_t));
+
+		return bitset_test(context.clip->constant_tracks_bitset, context.clip->bitset_desc, track_offset);
+	}
+
+	// The animated data offsets before a track is read, what the track read is found from how far they moved
+	template<size_t num_key_frames>
+	struct AnimatedTrackOffsets
+	{
+		template<class DecompressionContext>
+		explicit AnimatedTrackOffsets(const DecompressionContext& context)
+			: clip_range_data_offset(context.clip_range_data_offset)
+			, format_per_track_data_offset(context.format_per_track_data_offset)
+			, segment_range_data_offset(context.segment_range_data_offset)
+		{
+			for (size_t i = 0; i < num_key_frames; ++i)
+			{
+				key_frame_byte_offsets[i] = context.key_frame_byte_offsets[i];
+				key_frame_bit_offsets[i] = context.key_frame_bit_offsets[i];
+			}
+		}
+
+		uint32_t clip_range_data_offset;
+		uint32_t format_per_track_data_offset;
+		uint32_t segment_range_data_offset;
+		uint32_t key_frame_byte_offsets[num_key_frames];
+		int32_t key_frame_bit_offsets[num_key_frames];
+	};
+
+	// A variable bit rate sample found while visiting the key frames, they are unpacked together afterwards
+	struct VariableVector3Sample
+	{
+		const uint8_t* vector_data;
+		int32_t bit_offset;
+		uint8_t num_bits;		// Zero when the sample isn't variable
+	};
+
+	template<size_t num_key_frames>
+	inline void unpack_variable_vector3_samples(const VariableVector3Sample (&samples)[num_key_frames], bool is_unsigned, Vector4_32* out_vectors)
+	{
+		for (size_t i = 0; i < num_key_frames; ++i)
+		{
+			if (samples[i].num_bits != 0)
+				out_vectors[i] = unpack_vector3_n(samples[i].num_bits, samples[i].num_bits, samples[i].num_bits, is_unsigned, samples[i].vector_data, samples[i].bit_offset);
+		}
+	}
+
+	// When we interpolate, both key frames are usually variable and we can unpack them at the same time
+	inline void unpack_variable_vector3_samples(const VariableVector3Sample (&samples)[2], bool is_unsigned, Vector4_32* out_vectors)
+	{
+		if (samples[0].num_bits != 0 && samples[1].num_bits != 0)
+			unpack_vector3_n_x2(samples[0].num_bits, samples[0].vector_data, samples[0].bit_offset, samples[1].num_bits, samples[1].vector_data, samples[1].bit_offset, is_unsigned, out_vectors[0], out_vectors[1]);
+		else
+		{
+			for (size_t i = 0; i < 2; ++i)
+			{
+				if (samples[i].num_bits != 0)
+					out_vectors[i] = unpack_vector3_n(samples[i].num_bits, samples[i].num_bits, samples[i].num_bits, is_unsigned, samples[i].vector_data, samples[i].bit_offset);
+			}
+		}
+	}
+
+	// Skipped tracks only read their variable bit rates
+	template<size_t num_key_frames, class SettingsType, class DecompressionContext>
+	inline void record_animated_track_reads(const SettingsType& settings, const DecompressionContext& context, const AnimatedTrackOffsets<num_key_frames>& start_offsets, bool is_track_skipped)
+	{
+		if (!settings.is_memory_access_recorded())
+			return;
+
+		if (!is_track_skipped)
+			settings.record_memory_access(CompressedDataSection8::ClipRangeData, context.clip->clip_range_data + start_offsets.clip_range_data_offset, context.clip_range_data_offset - start_offsets.clip_range_data_offset);
+
+		for (size_t i = 0; i < num_key_frames; ++i)
+		{
+			settings.record_memory_access(CompressedDataSection8::FormatPerTrackData, context.format_per_track_data[i] + start_offsets.format_per_track_data_offset, context.format_per_track_data_offset - start_offsets.format_per_track_data_offset);
+
+			if (is_track_skipped)
+				continue;
+
+			settings.record_memory_access(CompressedDataSection8::SegmentRangeData, context.segment_range_data[i] + start_offsets.segment_range_data_offset, context.segment_range_data_offset - start_offsets.segment_range_data_offset);
+
+			// Variable formats advance the bit offsets, fixed width formats the byte offsets, and mixed packing advances both.
+			// The offsets skip over the whole block of key frames of the track, we only read one sample from it.
+			const uint32_t block_sample_index = context.key_frame_block_sample_indices[i];
+			const uint32_t block_num_samples = context.key_frame_block_num_samples[i];
+			if (context.key_frame_bit_offsets[i] != start_offsets.key_frame_bit_offsets[i])
+			{
+				const uint32_t num_sample_bits = uint32_t(context.key_frame_bit_offsets[i] - start_offsets.key_frame_bit_offsets[i]) / block_num_samples;
+				const uint32_t sample_bit_offset = uint32_t(start_offsets.key_frame_bit_offsets[i]) + (block_sample_index * num_sample_bits);
+				const uint32_t first_byte_offset = sample_bit_offset / 8;
+				const uint32_t end_byte_offset = (sample_bit_offset + num_sample_bits + 7) / 8;
+				settings.record_memory_access(CompressedDataSection8::AnimatedTrackData, context.animated_track_data[i] + first_byte_offset, end_byte_offset - first_byte_offset);
+			}
+			else
+			{
+				const uint32_t sample_size = (context.key_frame_byte_offsets[i] - start_offsets.key_frame_byte_offsets[i]) / block_num_samples;
+				settings.record_memory_access(CompressedDataSection8::AnimatedTrackData, context.animated_track_data[i] + start_offsets.key_frame_byte_offsets[i] + (block_sample_index * sample_size), sample_size);
+			}
+		}
+	}
+
+	template<class SettingsType>
+	inline bool is_rotation_format_variable_supported(const SettingsType& settings, RotationFormat8 rotation_format)
+	{
+		return (rotation_format == RotationFormat8::QuatDropW_Variable && settings.is_rotation_format_supported(RotationFormat8::QuatDropW_Variable))
+			|| (rotation_format == RotationFormat8::QuatLog_Variable && settings.is_rotation_format_supported(RotationFormat8::QuatLog_Variable));
+	}
+
+	template<class SettingsType>
+	inline bool is_rotation_format_log_supported(const SettingsType& settings, RotationFormat8 rotation_format)
+	{
+		return (rotation_format == RotationFormat8::QuatLog_96 && settings.is_rotation_format_supported(RotationFormat8::QuatLog_96))
+			|| (rotation_format == RotationFormat8::QuatLog_48 && settings.is_rotation_format_supported(RotationFormat8::QuatLog_48))
+			|| (rotation_format == RotationFormat8::QuatLog_32 && settings.is_rotation_format_supported(RotationFormat8::QuatLog_32))
+			|| (rotation_format == RotationFormat8::QuatLog_Variable && settings.is_rotation_format_supported(RotationFormat8::QuatLog_Variable));
+	}
+
 	template<size_t num_key_frames, class SettingsType, class DecompressionContext>
 	inline void skip_rotations(const SettingsType& settings, const ClipHeader& header, DecompressionContext& context)
 	{
-		bool is_rotation_default = bitset_test(context.default_tracks_bitset, context.bitset_desc, context.default_track_offset);
+		bool is_rotation_default = is_track_default(settings, context, context.default_track_offset);
 		if (!is_rotation_default)
 		{
 			const RotationFormat8 rotation_format = settings.get_rotation_format(header.rotation_format);
 
-			bool is_rotation_constant = bitset_test(context.constant_tracks_bitset, context.bitset_desc, context.constant_track_offset);
+			bool is_rotation_constant = is_track_constant(settings, context, context.constant_track_offset);
 			if (is_rotation_constant)
 			{
 				const RotationFormat8 packed_format = is_rotation_format_variable(rotation_format) ? get_highest_variant_precision(get_rotation_variant(rotation_format)) : rotation_format;
@@ -42,6 +179,8 @@ namespace acl
 			}
 			else
 			{
+				const AnimatedTrackOffsets<num_key_frames> start_offsets(context);
+
 				if (is_rotation_format_variable(rotation_format))
 				{
 					for (size_t i = 0; i < num_key_frames; ++i)
@@ -49,12 +188,12 @@ namespace acl
 						uint8_t bit_rate = context.format_per_track_data[i][context.format_per_track_data_offset];
 						uint8_t num_bits_at_bit_rate = get_num_bits_at_bit_rate(bit_rate) * 3;	// 3 components
 
-						if (settings.supports_mixed_packing() && context.has_mixed_packing)
+						if (settings.supports_mixed_packing() && context.clip->has_mixed_packing)
 							num_bits_at_bit_rate = align_to(num_bits_at_bit_rate, k_mixed_packing_alignment_num_bits);
 
-						context.key_frame_bit_offsets[i] += num_bits_at_bit_rate;
+						context.key_frame_bit_offsets[i] += context.key_frame_block_num_samples[i] * num_bits_at_bit_rate;
 
-						if (settings.supports_mixed_packing() && context.has_mixed_packing)
+						if (settings.supports_mixed_packing() && context.clip->has_mixed_packing)
 							context.key_frame_byte_offsets[i] = context.key_frame_bit_offsets[i] / 8;
 					}
 
@@ -66,20 +205,22 @@ namespace acl
 
 					for (size_t i = 0; i < num_key_frames; ++i)
 					{
-						context.key_frame_byte_offsets[i] += rotation_size;
+						context.key_frame_byte_offsets[i] += context.key_frame_block_num_samples[i] * rotation_size;
 
-						if (settings.supports_mixed_packing() && context.has_mixed_packing)
+						if (settings.supports_mixed_packing() && context.clip->has_mixed_packing)
 							context.key_frame_bit_offsets[i] = context.key_frame_byte_offsets[i] * 8;
 					}
 				}
 
 				const RangeReductionFlags8 clip_range_reduction = settings.get_clip_range_reduction(header.clip_range_reduction);
 				if (are_any_enum_flags_set(clip_range_reduction, RangeReductionFlags8::Rotations))
-					context.clip_range_data_offset += context.num_rotation_components * sizeof(float) * 2;
+					context.clip_range_data_offset += context.clip->num_rotation_components * sizeof(float) * 2;
 
 				const RangeReductionFlags8 segment_range_reduction = settings.get_segment_range_reduction(header.segment_range_reduction);
 				if (are_any_enum_flags_set(segment_range_reduction, RangeReductionFlags8::Rotations))
-					context.segment_range_data_offset += context.num_rotation_components * k_segment_range_reduction_num_bytes_per_component * 2;
+					context.segment_range_data_offset += context.clip->num_rotation_components * k_segment_range_reduction_num_bytes_per_component * 2;
+
+				record_animated_track_reads(settings, context, start_offsets, true);
 			}
 		}
 
@@ -99,10 +240,10 @@ namespace acl
 	template<size_t num_key_frames, class SettingsAdapterType, class DecompressionContext>
 	inline void skip_vectors(const SettingsAdapterType& settings, const ClipHeader& header, DecompressionContext& context)
 	{
-		const bool is_sample_default = bitset_test(context.default_tracks_bitset, context.bitset_desc, context.default_track_offset);
+		const bool is_sample_default = is_track_default(settings, context, context.default_track_offset);
 		if (!is_sample_default)
 		{
-			const bool is_sample_constant = bitset_test(context.constant_tracks_bitset, context.bitset_desc, context.constant_track_offset);
+			const bool is_sample_constant = is_track_constant(settings, context, context.constant_track_offset);
 			if (is_sample_constant)
 			{
 				// Constant Vector3 tracks store the remaining sample with full precision
@@ -110,6 +251,7 @@ namespace acl
 			}
 			else
 			{
+				const AnimatedTrackOffsets<num_key_frames> start_offsets(context);
 				const VectorFormat8 format = settings.get_vector_format(header);
 
 				if (is_vector_format_variable(format))
@@ -119,12 +261,12 @@ namespace acl
 						uint8_t bit_rate = context.format_per_track_data[i][context.format_per_track_data_offset];
 						uint8_t num_bits_at_bit_rate = get_num_bits_at_bit_rate(bit_rate) * 3;	// 3 components
 
-						if (settings.supports_mixed_packing() && context.has_mixed_packing)
+						if (settings.supports_mixed_packing() && context.clip->has_mixed_packing)
 							num_bits_at_bit_rate = align_to(num_bits_at_bit_rate, k_mixed_packing_alignment_num_bits);
 
-						context.key_frame_bit_offsets[i] += num_bits_at_bit_rate;
+						context.key_frame_bit_offsets[i] += context.key_frame_block_num_samples[i] * num_bits_at_bit_rate;
 
-						if (settings.supports_mixed_packing() && context.has_mixed_packing)
+						if (settings.supports_mixed_packing() && context.clip->has_mixed_packing)
 							context.key_frame_byte_offsets[i] = context.key_frame_bit_offsets[i] / 8;
 					}
 
@@ -136,9 +278,9 @@ namespace acl
 
 					for (size_t i = 0; i < num_key_frames; ++i)
 					{
-						context.key_frame_byte_offsets[i] += sample_size;
+						context.key_frame_byte_offsets[i] += context.key_frame_block_num_samples[i] * sample_size;
 
-						if (settings.supports_mixed_packing() && context.has_mixed_packing)
+						if (settings.supports_mixed_packing() && context.clip->has_mixed_packing)
 							context.key_frame_bit_offsets[i] = context.key_frame_byte_offsets[i] * 8;
 					}
 				}
@@ -152,6 +294,8 @@ namespace acl
 				const RangeReductionFlags8 segment_range_reduction = settings.get_segment_range_reduction(header.segment_range_reduction);
 				if (are_any_enum_flags_set(segment_range_reduction, range_reduction_flag))
 					context.segment_range_data_offset += 3 * k_segment_range_reduction_num_bytes_per_component * 2;
+
+				record_animated_track_reads(settings, context, start_offsets, true);
 			}
 		}
 
@@ -168,191 +312,242 @@ namespace acl
 	template<class SettingsAdapterType, class DecompressionContext>
 	inline void skip_vectors_in_four_key_frames(const SettingsAdapterType& settings, const ClipHeader& header, DecompressionContext& context) { skip_vectors<4>(settings, header, context); }
 
-	template<size_t num_key_frames, class SettingsType, class DecompressionContext>
-	inline void decompress_rotations(const SettingsType& settings, const ClipHeader& header, DecompressionContext& context, Quat_32* out_rotations, TimeSeriesType8& out_time_series_type)
+	template<class SettingsType, class DecompressionContext>
+	inline Quat_32 decompress_constant_rotation(const SettingsType& settings, const ClipHeader& header, DecompressionContext& context)
 	{
-		bool is_rotation_default = bitset_test(context.default_tracks_bitset, context.bitset_desc, context.default_track_offset);
-		if (is_rotation_default)
+		const RotationFormat8 rotation_format = settings.get_rotation_format(header.rotation_format);
+		const RotationFormat8 packed_format = is_rotation_format_variable(rotation_format) ? get_highest_variant_precision(get_rotation_variant(rotation_format)) : rotation_format;
+
+		if (settings.is_memory_access_recorded())
+			settings.record_memory_access(CompressedDataSection8::ConstantTrackData, context.clip->constant_track_data + context.constant_track_data_offset, get_packed_rotation_size(packed_format));
+
+		Quat_32 rotation;
+
+		if (packed_format == RotationFormat8::Quat_128 && settings.is_rotation_format_supported(RotationFormat8::Quat_128))
+			rotation = unpack_quat_128(context.clip->constant_track_data + context.constant_track_data_offset);
+		else if (packed_format == RotationFormat8::QuatDropW_96 && settings.is_rotation_format_supported(RotationFormat8::QuatDropW_96))
+			rotation = unpack_quat_96(context.clip->constant_track_data + context.constant_track_data_offset);
+		else if (packed_format == RotationFormat8::QuatDropW_48 && settings.is_rotation_format_supported(RotationFormat8::QuatDropW_48))
+			rotation = unpack_quat_48(context.clip->constant_track_data + context.constant_track_data_offset);
+		else if (packed_format == RotationFormat8::QuatDropW_32 && settings.is_rotation_format_supported(RotationFormat8::QuatDropW_32))
+			rotation = unpack_quat_32(context.clip->constant_track_data + context.constant_track_data_offset);
+		else if (packed_format == RotationFormat8::Quat_32_Largest && settings.is_rotation_format_supported(RotationFormat8::Quat_32_Largest))
+			rotation = unpack_quat_32_largest(context.clip->constant_track_data + context.constant_track_data_offset);
+		else if (packed_format == RotationFormat8::QuatLog_96 && settings.is_rotation_format_supported(RotationFormat8::QuatLog_96))
+			rotation = unpack_quat_log_96(context.clip->constant_track_data + context.constant_track_data_offset);
+		else if (packed_format == RotationFormat8::QuatLog_48 && settings.is_rotation_format_supported(RotationFormat8::QuatLog_48))
+			rotation = unpack_quat_log_48(context.clip->constant_track_data + context.constant_track_data_offset);
+		else if (packed_format == RotationFormat8::QuatLog_32 && settings.is_rotation_format_supported(RotationFormat8::QuatLog_32))
+			rotation = unpack_quat_log_32(context.clip->constant_track_data + context.constant_track_data_offset);
+		else
 		{
-			out_rotations[0] = quat_identity_32();
-			out_time_series_type = TimeSeriesType8::ConstantDefault;
+			ACL_ENSURE(false, "Unrecognized rotation format");
+			rotation = quat_identity_32();
 		}
-		else
+
+		context.constant_track_data_offset += get_packed_rotation_size(packed_format);
+		return rotation;
+	}
+
+	// Only the animated data offsets are read and advanced, the default and constant track offsets are left untouched
+	template<size_t num_key_frames, class SettingsType, class DecompressionContext>
+	inline void decompress_animated_rotations(const SettingsType& settings, const ClipHeader& header, DecompressionContext& context, Quat_32* out_rotations)
+	{
+		const RotationFormat8 rotation_format = settings.get_rotation_format(header.rotation_format);
+		const RangeReductionFlags8 clip_range_reduction = settings.get_clip_range_reduction(header.clip_range_reduction);
+		const RangeReductionFlags8 segment_range_reduction = settings.get_segment_range_reduction(header.segment_range_reduction);
+		const bool are_clip_rotations_normalized = are_any_enum_flags_set(clip_range_reduction, RangeReductionFlags8::Rotations);
+		const bool are_segment_rotations_normalized = are_any_enum_flags_set(segment_range_reduction, RangeReductionFlags8::Rotations);
+
+		const AnimatedTrackOffsets<num_key_frames> start_offsets(context);
+
+		Vector4_32 rotations[num_key_frames];
+		bool ignore_clip_range[num_key_frames] = { false };
+		bool ignore_segment_range[num_key_frames] = { false };
+
+		if (is_rotation_format_variable_supported(settings, rotation_format))
 		{
-			const RotationFormat8 rotation_format = settings.get_rotation_format(header.rotation_format);
+			VariableVector3Sample variable_samples[num_key_frames] = {};
 
-			bool is_rotation_constant = bitset_test(context.constant_tracks_bitset, context.bitset_desc, context.constant_track_offset);
-			if (is_rotation_constant)
+			for (size_t i = 0; i < num_key_frames; ++i)
 			{
-				const RotationFormat8 packed_format = is_rotation_format_variable(rotation_format) ? get_highest_variant_precision(get_rotation_variant(rotation_format)) : rotation_format;
+				uint8_t bit_rate = context.format_per_track_data[i][context.format_per_track_data_offset];
+				uint8_t num_bits_at_bit_rate = get_num_bits_at_bit_rate(bit_rate);
 
-				Quat_32 rotation;
+				uint8_t num_bits_read = num_bits_at_bit_rate * 3;
 
-				if (packed_format == RotationFormat8::Quat_128 && settings.is_rotation_format_supported(RotationFormat8::Quat_128))
-					rotation = unpack_quat_128(context.constant_track_data + context.constant_track_data_offset);
-				else if (packed_format == RotationFormat8::QuatDropW_96 && settings.is_rotation_format_supported(RotationFormat8::QuatDropW_96))
-					rotation = unpack_quat_96(context.constant_track_data + context.constant_track_data_offset);
-				else if (packed_format == RotationFormat8::QuatDropW_48 && settings.is_rotation_format_supported(RotationFormat8::QuatDropW_48))
-					rotation = unpack_quat_48(context.constant_track_data + context.constant_track_data_offset);
-				else if (packed_format == RotationFormat8::QuatDropW_32 && settings.is_rotation_format_supported(RotationFormat8::QuatDropW_32))
-					rotation = unpack_quat_32(context.constant_track_data + context.constant_track_data_offset);
-				else
+				if (settings.supports_mixed_packing() && context.clip->has_mixed_packing)
+					num_bits_read = align_to(num_bits_read, k_mixed_packing_alignment_num_bits);
+
+				const int32_t sample_bit_offset = context.key_frame_bit_offsets[i] + int32_t(context.key_frame_block_sample_indices[i] * num_bits_read);
+
+				if (is_constant_bit_rate(bit_rate))
+				{
+					rotations[i] = unpack_vector3_48(context.segment_range_data[i] + context.segment_range_data_offset, true);
+					ignore_segment_range[i] = true;
+				}
+				else if (is_raw_bit_rate(bit_rate))
 				{
-					ACL_ENSURE(false, "Unrecognized rotation format");
-					rotation = quat_identity_32();
+					rotations[i] = unpack_vector3_96(context.animated_track_data[i], sample_bit_offset);
+					ignore_clip_range[i] = true;
+					ignore_segment_range[i] = true;
 				}
+				else
+					variable_samples[i] = VariableVector3Sample{ context.animated_track_data[i], sample_bit_offset, num_bits_at_bit_rate };
 
-				out_rotations[0] = rotation;
-				out_time_series_type = TimeSeriesType8::Constant;
+				context.key_frame_bit_offsets[i] += context.key_frame_block_num_samples[i] * num_bits_read;
 
-				context.constant_track_data_offset += get_packed_rotation_size(packed_format);
+				if (settings.supports_mixed_packing() && context.clip->has_mixed_packing)
+					context.key_frame_byte_offsets[i] = context.key_frame_bit_offsets[i] / 8;
 			}
-			else
+
+			unpack_variable_vector3_samples(variable_samples, are_clip_rotations_normalized, rotations);
+
+			++context.format_per_track_data_offset;
+		}
+		else
+		{
+			const uint32_t rotation_size = get_packed_rotation_size(rotation_format);
+
+			const uint8_t* samples[num_key_frames];
+			for (size_t i = 0; i < num_key_frames; ++i)
+				samples[i] = context.animated_track_data[i] + context.key_frame_byte_offsets[i] + (context.key_frame_block_sample_indices[i] * rotation_size);
+
+			if (rotation_format == RotationFormat8::Quat_128 && settings.is_rotation_format_supported(RotationFormat8::Quat_128))
 			{
-				const RangeReductionFlags8 clip_range_reduction = settings.get_clip_range_reduction(header.clip_range_reduction);
-				const RangeReductionFlags8 segment_range_reduction = settings.get_segment_range_reduction(header.segment_range_reduction);
-				const bool are_clip_rotations_normalized = are_any_enum_flags_set(clip_range_reduction, RangeReductionFlags8::Rotations);
-				const bool are_segment_rotations_normalized = are_any_enum_flags_set(segment_range_reduction, RangeReductionFlags8::Rotations);
+				for (size_t i = 0; i < num_key_frames; ++i)
+					rotations[i] = unpack_vector4_128(samples[i]);
+			}
+			else if ((rotation_format == RotationFormat8::QuatDropW_96 && settings.is_rotation_format_supported(RotationFormat8::QuatDropW_96))
+				|| (rotation_format == RotationFormat8::QuatLog_96 && settings.is_rotation_format_supported(RotationFormat8::QuatLog_96)))
+			{
+				for (size_t i = 0; i < num_key_frames; ++i)
+					rotations[i] = unpack_vector3_96(samples[i]);
+			}
+			else if ((rotation_format == RotationFormat8::QuatDropW_48 && settings.is_rotation_format_supported(RotationFormat8::QuatDropW_48))
+				|| (rotation_format == RotationFormat8::QuatLog_48 && settings.is_rotation_format_supported(RotationFormat8::QuatLog_48)))
+			{
+				for (size_t i = 0; i < num_key_frames; ++i)
+					rotations[i] = unpack_vector3_48(samples[i], are_clip_rotations_normalized);
+			}
+			else if ((rotation_format == RotationFormat8::QuatDropW_32 && settings.is_rotation_format_supported(RotationFormat8::QuatDropW_32))
+				|| (rotation_format == RotationFormat8::QuatLog_32 && settings.is_rotation_format_supported(RotationFormat8::QuatLog_32)))
+			{
+				for (size_t i = 0; i < num_key_frames; ++i)
+					rotations[i] = unpack_vector3_32(11, 11, 10, are_clip_rotations_normalized, samples[i]);
+			}
+			else if (rotation_format == RotationFormat8::Quat_32_Largest && settings.is_rotation_format_supported(RotationFormat8::Quat_32_Largest))
+			{
+				// Range reduction isn't supported, the full quaternion is unpacked
+				for (size_t i = 0; i < num_key_frames; ++i)
+					rotations[i] = quat_to_vector(unpack_quat_32_largest(samples[i]));
+			}
 
-				Vector4_32 rotations[num_key_frames];
-				bool ignore_clip_range[num_key_frames] = { false };
-				bool ignore_segment_range[num_key_frames] = { false };
+			for (size_t i = 0; i < num_key_frames; ++i)
+			{
+				context.key_frame_byte_offsets[i] += context.key_frame_block_num_samples[i] * rotation_size;
 
-				if (rotation_format == RotationFormat8::QuatDropW_Variable && settings.is_rotation_format_supported(RotationFormat8::QuatDropW_Variable))
+				if (settings.supports_mixed_packing() && context.clip->has_mixed_packing)
+					context.key_frame_bit_offsets[i] = context.key_frame_byte_offsets[i] * 8;
+			}
+		}
+
+		if (are_segment_rotations_normalized)
+		{
+			if (is_rotation_format_variable_supported(settings, rotation_format))
+			{
+				for (size_t i = 0; i < num_key_frames; ++i)
 				{
-					for (size_t i = 0; i < num_key_frames; ++i)
+					if (!ignore_segment_range[i])
 					{
-						uint8_t bit_rate = context.format_per_track_data[i][context.format_per_track_data_offset];
-						uint8_t num_bits_at_bit_rate = get_num_bits_at_bit_rate(bit_rate);
-
-						if (is_constant_bit_rate(bit_rate))
-						{
-							rotations[i] = unpack_vector3_48(context.segment_range_data[i] + context.segment_range_data_offset, true);
-							ignore_segment_range[i] = true;
-						}
-						else if (is_raw_bit_rate(bit_rate))
-						{
-							rotations[i] = unpack_vector3_96(context.animated_track_data[i], context.key_frame_bit_offsets[i]);
-							ignore_clip_range[i] = true;
-							ignore_segment_range[i] = true;
-						}
-						else
-							rotations[i] = unpack_vector3_n(num_bits_at_bit_rate, num_bits_at_bit_rate, num_bits_at_bit_rate, are_clip_rotations_normalized, context.animated_track_data[i], context.key_frame_bit_offsets[i]);
-
-						uint8_t num_bits_read = num_bits_at_bit_rate * 3;
-
-						if (settings.supports_mixed_packing() && context.has_mixed_packing)
-							num_bits_read = align_to(num_bits_read, k_mixed_packing_alignment_num_bits);
-
-						context.key_frame_bit_offsets[i] += num_bits_read;
-
-						if (settings.supports_mixed_packing() && context.has_mixed_packing)
-							context.key_frame_byte_offsets[i] = context.key_frame_bit_offsets[i] / 8;
-					}
+						const Vector4_32 segment_range_min = unpack_vector3_24(context.segment_range_data[i] + context.segment_range_data_offset, true);
+						const Vector4_32 segment_range_extent = unpack_vector3_24(context.segment_range_data[i] + context.segment_range_data_offset + (context.clip->num_rotation_components * sizeof(uint8_t)), true);
 
-					++context.format_per_track_data_offset;
+						rotations[i] = vector_mul_add(rotations[i], segment_range_extent, segment_range_min);
+					}
 				}
-				else
+			}
+			else
+			{
+				if (rotation_format == RotationFormat8::Quat_128 && settings.is_rotation_format_supported(RotationFormat8::Quat_128))
 				{
-					if (rotation_format == RotationFormat8::Quat_128 && settings.is_rotation_format_supported(RotationFormat8::Quat_128))
-					{
-						for (size_t i = 0; i < num_key_frames; ++i)
-							rotations[i] = unpack_vector4_128(context.animated_track_data[i] + context.key_frame_byte_offsets[i]);
-					}
-					else if (rotation_format == RotationFormat8::QuatDropW_96 && settings.is_rotation_format_supported(RotationFormat8::QuatDropW_96))
-					{
-						for (size_t i = 0; i < num_key_frames; ++i)
-							rotations[i] = unpack_vector3_96(context.animated_track_data[i] + context.key_frame_byte_offsets[i]);
-					}
-					else if (rotation_format == RotationFormat8::QuatDropW_48 && settings.is_rotation_format_supported(RotationFormat8::QuatDropW_48))
-					{
-						for (size_t i = 0; i < num_key_frames; ++i)
-							rotations[i] = unpack_vector3_48(context.animated_track_data[i] + context.key_frame_byte_offsets[i], are_clip_rotations_normalized);
-					}
-					else if (rotation_format == RotationFormat8::QuatDropW_32 && settings.is_rotation_format_supported(RotationFormat8::QuatDropW_32))
-					{
-						for (size_t i = 0; i < num_key_frames; ++i)
-							rotations[i] = unpack_vector3_32(11, 11, 10, are_clip_rotations_normalized, context.animated_track_data[i] + context.key_frame_byte_offsets[i]);
-					}
-
-					const uint32_t rotation_size = get_packed_rotation_size(rotation_format);
-
 					for (size_t i = 0; i < num_key_frames; ++i)
 					{
-						context.key_frame_byte_offsets[i] += rotation_size;
+						const Vector4_32 segment_range_min = unpack_vector4_32(context.segment_range_data[i] + context.segment_range_data_offset, true);
+						const Vector4_32 segment_range_extent = unpack_vector4_32(context.segment_range_data[i] + context.segment_range_data_offset + (context.clip->num_rotation_components * sizeof(uint8_t)), true);
 
-						if (settings.supports_mixed_packing() && context.has_mixed_packing)
-							context.key_frame_bit_offsets[i] = context.key_frame_byte_offsets[i] * 8;
+						rotations[i] = vector_mul_add(rotations[i], segment_range_extent, segment_range_min);
 					}
 				}
-
-				if (are_segment_rotations_normalized)
+				else
 				{
-					if (rotation_format == RotationFormat8::QuatDropW_Variable && settings.is_rotation_format_supported(RotationFormat8::QuatDropW_Variable))
-					{
-						for (size_t i = 0; i < num_key_frames; ++i)
-						{
-							if (!ignore_segment_range[i])
-							{
-								const Vector4_32 segment_range_min = unpack_vector3_24(context.segment_range_data[i] + context.segment_range_data_offset, true);
-								const Vector4_32 segment_range_extent = unpack_vector3_24(context.segment_range_data[i] + context.segment_range_data_offset + (context.num_rotation_components * sizeof(uint8_t)), true);
-
-								rotations[i] = vector_mul_add(rotations[i], segment_range_extent, segment_range_min);
-							}
-						}
-					}
-					else
+					for (size_t i = 0; i < num_key_frames; ++i)
 					{
-						if (rotation_format == RotationFormat8::Quat_128 && settings.is_rotation_format_supported(RotationFormat8::Quat_128))
-						{
-							for (size_t i = 0; i < num_key_frames; ++i)
-							{
-								const Vector4_32 segment_range_min = unpack_vector4_32(context.segment_range_data[i] + context.segment_range_data_offset, true);
-								const Vector4_32 segment_range_extent = unpack_vector4_32(context.segment_range_data[i] + context.segment_range_data_offset + (context.num_rotation_components * sizeof(uint8_t)), true);
-
-								rotations[i] = vector_mul_add(rotations[i], segment_range_extent, segment_range_min);
-							}
-						}
-						else
-						{
-							for (size_t i = 0; i < num_key_frames; ++i)
-							{
-								const Vector4_32 segment_range_min = unpack_vector3_24(context.segment_range_data[i] + context.segment_range_data_offset, true);
-								const Vector4_32 segment_range_extent = unpack_vector3_24(context.segment_range_data[i] + context.segment_range_data_offset + (context.num_rotation_components * sizeof(uint8_t)), true);
-
-								rotations[i] = vector_mul_add(rotations[i], segment_range_extent, segment_range_min);
-							}
-						}
-					}
+						const Vector4_32 segment_range_min = unpack_vector3_24(context.segment_range_data[i] + context.segment_range_data_offset, true);
+						const Vector4_32 segment_range_extent = unpack_vector3_24(context.segment_range_data[i] + context.segment_range_data_offset + (context.clip->num_rotation_components * sizeof(uint8_t)), true);
 
-					context.segment_range_data_offset += context.num_rotation_components * k_segment_range_reduction_num_bytes_per_component * 2;
+						rotations[i] = vector_mul_add(rotations[i], segment_range_extent, segment_range_min);
+					}
 				}
+			}
 
-				if (are_clip_rotations_normalized)
-				{
-					const Vector4_32 clip_range_min = vector_unaligned_load_32(context.clip_range_data + context.clip_range_data_offset);
-					const Vector4_32 clip_range_extent = vector_unaligned_load_32(context.clip_range_data + context.clip_range_data_offset + (context.num_rotation_components * sizeof(float)));
+			context.segment_range_data_offset += context.clip->num_rotation_components * k_segment_range_reduction_num_bytes_per_component * 2;
+		}
 
-					for (size_t i = 0; i < num_key_frames; ++i)
-					{
-						if (!ignore_clip_range[i])
-							rotations[i] = vector_mul_add(rotations[i], clip_range_extent, clip_range_min);
-					}
+		if (are_clip_rotations_normalized)
+		{
+			const Vector4_32 clip_range_min = vector_unaligned_load_32(context.clip->clip_range_data + context.clip_range_data_offset);
+			const Vector4_32 clip_range_extent = vector_unaligned_load_32(context.clip->clip_range_data + context.clip_range_data_offset + (context.clip->num_rotation_components * sizeof(float)));
 
-					context.clip_range_data_offset += context.num_rotation_components * sizeof(float) * 2;
-				}
+			for (size_t i = 0; i < num_key_frames; ++i)
+			{
+				if (!ignore_clip_range[i])
+					rotations[i] = vector_mul_add(rotations[i], clip_range_extent, clip_range_min);
+			}
 
-				if (rotation_format == RotationFormat8::Quat_128 && settings.is_rotation_format_supported(RotationFormat8::Quat_128))
-				{
-					for (size_t i = 0; i < num_key_frames; ++i)
-						out_rotations[i] = vector_to_quat(rotations[i]);
-				}
-				else
-				{
-					for (size_t i = 0; i < num_key_frames; ++i)
-						out_rotations[i] = quat_from_positive_w(rotations[i]);
-				}
+			context.clip_range_data_offset += context.clip->num_rotation_components * sizeof(float) * 2;
+		}
 
+		record_animated_track_reads(settings, context, start_offsets, false);
+
+		if ((rotation_format == RotationFormat8::Quat_128 && settings.is_rotation_format_supported(RotationFormat8::Quat_128))
+			|| (rotation_format == RotationFormat8::Quat_32_Largest && settings.is_rotation_format_supported(RotationFormat8::Quat_32_Largest)))
+		{
+			for (size_t i = 0; i < num_key_frames; ++i)
+				out_rotations[i] = vector_to_quat(rotations[i]);
+		}
+		else if (is_rotation_format_log_supported(settings, rotation_format))
+		{
+			for (size_t i = 0; i < num_key_frames; ++i)
+				out_rotations[i] = quat_from_normalized_log(rotations[i]);
+		}
+		else
+		{
+			for (size_t i = 0; i < num_key_frames; ++i)
+				out_rotations[i] = quat_from_positive_w(rotations[i]);
+		}
+	}
+
+	template<size_t num_key_frames, class SettingsType, class DecompressionContext>
+	inline void decompress_rotations(const SettingsType& settings, const ClipHeader& header, DecompressionContext& context, Quat_32* out_rotations, TimeSeriesType8& out_time_series_type)
+	{
+		bool is_rotation_default = is_track_default(settings, context, context.default_track_offset);
+		if (is_rotation_default)
+		{
+			out_rotations[0] = quat_identity_32();
+			out_time_series_type = TimeSeriesType8::ConstantDefault;
+		}
+		else
+		{
+			bool is_rotation_constant = is_track_constant(settings, context, context.constant_track_offset);
+			if (is_rotation_constant)
+			{
+				out_rotations[0] = decompress_constant_rotation(settings, header, context);
+				out_time_series_type = TimeSeriesType8::Constant;
+			}
+			else
+			{
+				decompress_animated_rotations<num_key_frames>(settings, header, context, out_rotations);
 				out_time_series_type = TimeSeriesType8::Varying;
 			}
 		}
@@ -370,128 +565,158 @@ namespace acl
 	template<class SettingsType, class DecompressionContext>
 	inline void decompress_rotations_in_four_key_frames(const SettingsType& settings, const ClipHeader& header, DecompressionContext& context, Quat_32* out_rotations, TimeSeriesType8& out_time_series_type) { decompress_rotations<4>(settings, header, context, out_rotations, out_time_series_type); }
 
+	template<class SettingsAdapterType, class DecompressionContext>
+	inline Vector4_32 decompress_constant_vector(const SettingsAdapterType& settings, const ClipHeader& header, DecompressionContext& context)
+	{
+		if (settings.is_memory_access_recorded())
+			settings.record_memory_access(CompressedDataSection8::ConstantTrackData, context.clip->constant_track_data + context.constant_track_data_offset, get_packed_vector_size(VectorFormat8::Vector3_96));
+
+		// Constant Vector3 tracks store the remaining sample with full precision
+		const Vector4_32 value = unpack_vector3_96(context.clip->constant_track_data + context.constant_track_data_offset);
+
+		context.constant_track_data_offset += get_packed_vector_size(VectorFormat8::Vector3_96);
+		return value;
+	}
+
+	// Only the animated data offsets are read and advanced, the default and constant track offsets are left untouched
 	template<size_t num_key_frames, class SettingsAdapterType, class DecompressionContext>
-	inline void decompress_vectors(const SettingsAdapterType& settings, const ClipHeader& header, DecompressionContext& context, Vector4_32* out_vectors, TimeSeriesType8& out_time_series_type)
+	inline void decompress_animated_vectors(const SettingsAdapterType& settings, const ClipHeader& header, DecompressionContext& context, Vector4_32* out_vectors)
 	{
-		const bool is_sample_default = bitset_test(context.default_tracks_bitset, context.bitset_desc, context.default_track_offset);
-		if (is_sample_default)
-		{
-			out_vectors[0] = settings.get_default_value();
-			out_time_series_type = TimeSeriesType8::ConstantDefault;
-		}
-		else
+		const VectorFormat8 format = settings.get_vector_format(header);
+		const RangeReductionFlags8 clip_range_reduction = settings.get_clip_range_reduction(header.clip_range_reduction);
+		const RangeReductionFlags8 segment_range_reduction = settings.get_segment_range_reduction(header.segment_range_reduction);
+
+		const AnimatedTrackOffsets<num_key_frames> start_offsets(context);
+
+		bool ignore_clip_range[num_key_frames] = { false };
+		bool ignore_segment_range[num_key_frames] = { false };
+
+		if (format == VectorFormat8::Vector3_Variable && settings.is_vector_format_supported(VectorFormat8::Vector3_Variable))
 		{
-			const bool is_sample_constant = bitset_test(context.constant_tracks_bitset, context.bitset_desc, context.constant_track_offset);
-			if (is_sample_constant)
-			{
-				// Constant translation tracks store the remaining sample with full precision
-				out_vectors[0] = unpack_vector3_96(context.constant_track_data + context.constant_track_data_offset);
-				out_time_series_type = TimeSeriesType8::Constant;
+			VariableVector3Sample variable_samples[num_key_frames] = {};
 
-				context.constant_track_data_offset += get_packed_vector_size(VectorFormat8::Vector3_96);
-			}
-			else
+			for (size_t i = 0; i < num_key_frames; ++i)
 			{
-				const VectorFormat8 format = settings.get_vector_format(header);
-				const RangeReductionFlags8 clip_range_reduction = settings.get_clip_range_reduction(header.clip_range_reduction);
-				const RangeReductionFlags8 segment_range_reduction = settings.get_segment_range_reduction(header.segment_range_reduction);
+				uint8_t bit_rate = context.format_per_track_data[i][context.format_per_track_data_offset];
+				uint8_t num_bits_at_bit_rate = get_num_bits_at_bit_rate(bit_rate);
 
-				bool ignore_clip_range[num_key_frames] = { false };
-				bool ignore_segment_range[num_key_frames] = { false };
+				uint8_t num_bits_read = num_bits_at_bit_rate * 3;
+				if (settings.supports_mixed_packing() && context.clip->has_mixed_packing)
+					num_bits_read = align_to(num_bits_read, k_mixed_packing_alignment_num_bits);
 
-				if (format == VectorFormat8::Vector3_Variable && settings.is_vector_format_supported(VectorFormat8::Vector3_Variable))
-				{
-					for (size_t i = 0; i < num_key_frames; ++i)
-					{
-						uint8_t bit_rate = context.format_per_track_data[i][context.format_per_track_data_offset];
-						uint8_t num_bits_at_bit_rate = get_num_bits_at_bit_rate(bit_rate);
-
-						if (is_constant_bit_rate(bit_rate))
-						{
-							out_vectors[i] = unpack_vector3_48(context.segment_range_data[i] + context.segment_range_data_offset, true);
-							ignore_segment_range[i] = true;
-						}
-						else if (is_raw_bit_rate(bit_rate))
-						{
-							out_vectors[i] = unpack_vector3_96(context.animated_track_data[i], context.key_frame_bit_offsets[i]);
-							ignore_clip_range[i] = true;
-							ignore_segment_range[i] = true;
-						}
-						else
-							out_vectors[i] = unpack_vector3_n(num_bits_at_bit_rate, num_bits_at_bit_rate, num_bits_at_bit_rate, true, context.animated_track_data[i], context.key_frame_bit_offsets[i]);
-
-						uint8_t num_bits_read = num_bits_at_bit_rate * 3;
-						if (settings.supports_mixed_packing() && context.has_mixed_packing)
-							num_bits_read = align_to(num_bits_read, k_mixed_packing_alignment_num_bits);
-
-						context.key_frame_bit_offsets[i] += num_bits_read;
-
-						if (settings.supports_mixed_packing() && context.has_mixed_packing)
-							context.key_frame_byte_offsets[i] = context.key_frame_bit_offsets[i] / 8;
-					}
+				const int32_t sample_bit_offset = context.key_frame_bit_offsets[i] + int32_t(context.key_frame_block_sample_indices[i] * num_bits_read);
 
-					++context.format_per_track_data_offset;
+				if (is_constant_bit_rate(bit_rate))
+				{
+					out_vectors[i] = unpack_vector3_48(context.segment_range_data[i] + context.segment_range_data_offset, true);
+					ignore_segment_range[i] = true;
 				}
-				else
+				else if (is_raw_bit_rate(bit_rate))
 				{
-					if (format == VectorFormat8::Vector3_96 && settings.is_vector_format_supported(VectorFormat8::Vector3_96))
-					{
-						for (size_t i = 0; i < num_key_frames; ++i)
-							out_vectors[i] = unpack_vector3_96(context.animated_track_data[i] + context.key_frame_byte_offsets[i]);
-					}
-					else if (format == VectorFormat8::Vector3_48 && settings.is_vector_format_supported(VectorFormat8::Vector3_48))
-					{
-						for (size_t i = 0; i < num_key_frames; ++i)
-							out_vectors[i] = unpack_vector3_48(context.animated_track_data[i] + context.key_frame_byte_offsets[i], true);
-					}
-					else if (format == VectorFormat8::Vector3_32 && settings.is_vector_format_supported(VectorFormat8::Vector3_32))
-					{
-						for (size_t i = 0; i < num_key_frames; ++i)
-							out_vectors[i] = unpack_vector3_32(11, 11, 10, true, context.animated_track_data[i] + context.key_frame_byte_offsets[i]);
-					}
+					out_vectors[i] = unpack_vector3_96(context.animated_track_data[i], sample_bit_offset);
+					ignore_clip_range[i] = true;
+					ignore_segment_range[i] = true;
+				}
+				else
+					variable_samples[i] = VariableVector3Sample{ context.animated_track_data[i], sample_bit_offset, num_bits_at_bit_rate };
 
-					const uint32_t sample_size = get_packed_vector_size(format);
+				context.key_frame_bit_offsets[i] += context.key_frame_block_num_samples[i] * num_bits_read;
 
-					for (size_t i = 0; i < num_key_frames; ++i)
-					{
-						context.key_frame_byte_offsets[i] += sample_size;
+				if (settings.supports_mixed_packing() && context.clip->has_mixed_packing)
+					context.key_frame_byte_offsets[i] = context.key_frame_bit_offsets[i] / 8;
+			}
 
-						if (settings.supports_mixed_packing() && context.has_mixed_packing)
-							context.key_frame_bit_offsets[i] = context.key_frame_byte_offsets[i] * 8;
-					}
-				}
+			unpack_variable_vector3_samples(variable_samples, true, out_vectors);
 
-				const RangeReductionFlags8 range_reduction_flag = settings.get_range_reduction_flag();
-				if (are_any_enum_flags_set(segment_range_reduction, range_reduction_flag))
-				{
-					for (size_t i = 0; i < num_key_frames; ++i)
-					{
-						if (format != VectorFormat8::Vector3_Variable || !settings.is_vector_format_supported(VectorFormat8::Vector3_Variable) || !ignore_segment_range[i])
-						{
-							const Vector4_32 segment_range_min = unpack_vector3_24(context.segment_range_data[i] + context.segment_range_data_offset, true);
-							const Vector4_32 segment_range_extent = unpack_vector3_24(context.segment_range_data[i] + context.segment_range_data_offset + (3 * sizeof(uint8_t)), true);
+			++context.format_per_track_data_offset;
+		}
+		else
+		{
+			const uint32_t sample_size = get_packed_vector_size(format);
 
-							out_vectors[i] = vector_mul_add(out_vectors[i], segment_range_extent, segment_range_min);
-						}
-					}
+			const uint8_t* samples[num_key_frames];
+			for (size_t i = 0; i < num_key_frames; ++i)
+				samples[i] = context.animated_track_data[i] + context.key_frame_byte_offsets[i] + (context.key_frame_block_sample_indices[i] * sample_size);
 
-					context.segment_range_data_offset += 3 * k_segment_range_reduction_num_bytes_per_component * 2;
-				}
+			if (format == VectorFormat8::Vector3_96 && settings.is_vector_format_supported(VectorFormat8::Vector3_96))
+			{
+				for (size_t i = 0; i < num_key_frames; ++i)
+					out_vectors[i] = unpack_vector3_96(samples[i]);
+			}
+			else if (format == VectorFormat8::Vector3_48 && settings.is_vector_format_supported(VectorFormat8::Vector3_48))
+			{
+				for (size_t i = 0; i < num_key_frames; ++i)
+					out_vectors[i] = unpack_vector3_48(samples[i], true);
+			}
+			else if (format == VectorFormat8::Vector3_32 && settings.is_vector_format_supported(VectorFormat8::Vector3_32))
+			{
+				for (size_t i = 0; i < num_key_frames; ++i)
+					out_vectors[i] = unpack_vector3_32(11, 11, 10, true, samples[i]);
+			}
 
-				if (are_any_enum_flags_set(clip_range_reduction, range_reduction_flag))
-				{
-					Vector4_32 clip_range_min = unpack_vector3_96(context.clip_range_data + context.clip_range_data_offset);
-					Vector4_32 clip_range_extent = unpack_vector3_96(context.clip_range_data + context.clip_range_data_offset + (3 * sizeof(float)));
+			for (size_t i = 0; i < num_key_frames; ++i)
+			{
+				context.key_frame_byte_offsets[i] += context.key_frame_block_num_samples[i] * sample_size;
 
-					for (size_t i = 0; i < num_key_frames; ++i)
-					{
-						if (!ignore_clip_range[i])
-							out_vectors[i] = vector_mul_add(out_vectors[i], clip_range_extent, clip_range_min);
-					}
+				if (settings.supports_mixed_packing() && context.clip->has_mixed_packing)
+					context.key_frame_bit_offsets[i] = context.key_frame_byte_offsets[i] * 8;
+			}
+		}
 
-					context.clip_range_data_offset += k_clip_range_reduction_vector3_range_size;
+		const RangeReductionFlags8 range_reduction_flag = settings.get_range_reduction_flag();
+		if (are_any_enum_flags_set(segment_range_reduction, range_reduction_flag))
+		{
+			for (size_t i = 0; i < num_key_frames; ++i)
+			{
+				if (format != VectorFormat8::Vector3_Variable || !settings.is_vector_format_supported(VectorFormat8::Vector3_Variable) || !ignore_segment_range[i])
+				{
+					const Vector4_32 segment_range_min = unpack_vector3_24(context.segment_range_data[i] + context.segment_range_data_offset, true);
+					const Vector4_32 segment_range_extent = unpack_vector3_24(context.segment_range_data[i] + context.segment_range_data_offset + (3 * sizeof(uint8_t)), true);
+
+					out_vectors[i] = vector_mul_add(out_vectors[i], segment_range_extent, segment_range_min);
 				}
+			}
+
+			context.segment_range_data_offset += 3 * k_segment_range_reduction_num_bytes_per_component * 2;
+		}
+
+		if (are_any_enum_flags_set(clip_range_reduction, range_reduction_flag))
+		{
+			Vector4_32 clip_range_min = unpack_vector3_96(context.clip->clip_range_data + context.clip_range_data_offset);
+			Vector4_32 clip_range_extent = unpack_vector3_96(context.clip->clip_range_data + context.clip_range_data_offset + (3 * sizeof(float)));
+
+			for (size_t i = 0; i < num_key_frames; ++i)
+			{
+				if (!ignore_clip_range[i])
+					out_vectors[i] = vector_mul_add(out_vectors[i], clip_range_extent, clip_range_min);
+			}
+
+			context.clip_range_data_offset += k_clip_range_reduction_vector3_range_size;
+		}
 
+		record_animated_track_reads(settings, context, start_offsets, false);
+	}
+
+	template<size_t num_key_frames, class SettingsAdapterType, class DecompressionContext>
+	inline void decompress_vectors(const SettingsAdapterType& settings, const ClipHeader& header, DecompressionContext& context, Vector4_32* out_vectors, TimeSeriesType8& out_time_series_type)
+	{
+		const bool is_sample_default = is_track_default(settings, context, context.default_track_offset);
+		if (is_sample_default)
+		{
+			out_vectors[0] = settings.get_default_value();
+			out_time_series_type = TimeSeriesType8::ConstantDefault;
+		}
+		else
+		{
+			const bool is_sample_constant = is_track_constant(settings, context, context.constant_track_offset);
+			if (is_sample_constant)
+			{
+				out_vectors[0] = decompress_constant_vector(settings, header, context);
+				out_time_series_type = TimeSeriesType8::Constant;
+			}
+			else
+			{
+				decompress_animated_vectors<num_key_frames>(settings, header, context, out_vectors);
 				out_time_series_type = TimeSeriesType8::Varying;
 			}
 		}
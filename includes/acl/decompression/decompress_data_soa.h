@@ -0,0 +1,493 @@
+#pragma once
+
+////////////////////////////////////////////////////////////////////////////////
+// The MIT License (MIT)
+//
+// Copyright (c) 2017 Nicholas Frechette & Animation Compression Library contributors
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+////////////////////////////////////////////////////////////////////////////////
+
+#include "acl/core/memory_utils.h"
+#include "acl/core/range_reduction_types.h"
+#include "acl/core/track_types.h"
+#include "acl/decompression/decompress_data.h"
+#include "acl/math/quat_32.h"
+#include "acl/math/vector4_32.h"
+#include "acl/math/vector4_packing.h"
+
+#include <cstdint>
+
+//////////////////////////////////////////////////////////////////////////
+// Structure of arrays decompression of variable bit rate tracks.
+//
+// The scalar path unpacks, range reduces, and interpolates one track at a time
+// with every 3 component sample padded in a SIMD register. Here animated tracks
+// are queued in a batch as we walk the bitsets and once a batch is full, every
+// component of every track is processed at once: one register holds the X
+// component of every track, another holds Y, etc. Each lane only loads the 64 bits
+// that hold its sample and with AVX2, its 3 components are extracted at once with
+// variable shifts. Normalization and range reduction are folded in a single scale
+// and offset per lane as it is gathered, the lanes are then transposed once per key
+// frame and everything that follows (W reconstruction, interpolation, normalization)
+// is done in bulk without horizontal operations.
+//
+// Batches hold 4 tracks with SSE and NEON and 8 tracks with AVX. Output writers
+// always receive the components of 4 tracks at a time.
+//
+// The results are close to but not bit identical with the scalar path, rotations
+// are normalized with a reciprocal square root estimate. This is why the path is
+// opt-in through 'DecompressionSettings::supports_soa_decompression'.
+//////////////////////////////////////////////////////////////////////////
+
+namespace acl
+{
+#if defined(ACL_AVX_INTRINSICS)
+	// The number of tracks processed together, one per SIMD lane
+	constexpr uint32_t k_num_soa_lanes = 8;
+
+	// A single component of every track in a batch
+	using SoAVector_32 = __m256;
+#else
+	// The number of tracks processed together, one per SIMD lane
+	constexpr uint32_t k_num_soa_lanes = 4;
+
+	// A single component of every track in a batch
+	using SoAVector_32 = Vector4_32;
+#endif
+
+	// Output writers receive the components of this many tracks at a time, wider batches are written in groups
+	constexpr uint32_t k_num_soa_writer_lanes = 4;
+	constexpr uint32_t k_num_soa_writer_groups = k_num_soa_lanes / k_num_soa_writer_lanes;
+
+	// Returns the lanes of a batch component that make up a group of 'k_num_soa_writer_lanes' lanes
+	inline Vector4_32 get_soa_writer_lanes(const SoAVector_32& input, uint32_t group_index)
+	{
+#if defined(ACL_AVX_INTRINSICS)
+		return group_index == 0 ? _mm256_castps256_ps128(input) : _mm256_extractf128_ps(input, 1);
+#else
+		(void)group_index;
+		return input;
+#endif
+	}
+
+	// An animated track queued for decompression, everything needed to decompress it is
+	// captured when it is queued since the context offsets keep moving afterwards.
+	struct SoATrackLane
+	{
+		const uint8_t* segment_range_data[2];
+		const uint8_t* clip_range_data;
+		int32_t key_frame_bit_offsets[2];
+		uint8_t bit_rates[2];
+		uint16_t bone_index;
+	};
+
+	// A batch of animated tracks of the same type
+	struct SoATrackBatch
+	{
+		SoATrackLane lanes[k_num_soa_lanes];
+		uint32_t num_lanes;
+
+		bool is_unsigned;
+		bool are_clip_ranges_normalized;
+		bool are_segment_ranges_normalized;
+	};
+
+	inline void initialize_soa_track_batch(SoATrackBatch& batch, bool is_unsigned, bool are_clip_ranges_normalized, bool are_segment_ranges_normalized)
+	{
+		batch.num_lanes = 0;
+		batch.is_unsigned = is_unsigned;
+		batch.are_clip_ranges_normalized = are_clip_ranges_normalized;
+		batch.are_segment_ranges_normalized = are_segment_ranges_normalized;
+	}
+
+	inline bool is_soa_track_batch_full(const SoATrackBatch& batch) { return batch.num_lanes == k_num_soa_lanes; }
+
+	// Queues the current animated variable bit rate track in the batch and skips over it.
+	// Only the animated data offsets are read and advanced, the default and constant track offsets are left untouched.
+	template<class SettingsType, class DecompressionContext>
+	inline void queue_soa_track(const SettingsType& settings, DecompressionContext& context, uint16_t bone_index, SoATrackBatch& batch)
+	{
+		ACL_ASSERT(!is_soa_track_batch_full(batch), "SoA track batch is full");
+
+		const AnimatedTrackOffsets<2> start_offsets(context);
+
+		SoATrackLane& lane = batch.lanes[batch.num_lanes++];
+		lane.bone_index = bone_index;
+		lane.clip_range_data = context.clip->clip_range_data + context.clip_range_data_offset;
+
+		for (size_t i = 0; i < 2; ++i)
+		{
+			const uint8_t bit_rate = context.format_per_track_data[i][context.format_per_track_data_offset];
+			lane.bit_rates[i] = bit_rate;
+			lane.segment_range_data[i] = context.segment_range_data[i] + context.segment_range_data_offset;
+
+			uint8_t num_bits_read = get_num_bits_at_bit_rate(bit_rate) * 3;	// 3 components
+
+			if (settings.supports_mixed_packing() && context.clip->has_mixed_packing)
+				num_bits_read = align_to(num_bits_read, k_mixed_packing_alignment_num_bits);
+
+			lane.key_frame_bit_offsets[i] = context.key_frame_bit_offsets[i] + int32_t(context.key_frame_block_sample_indices[i] * num_bits_read);
+			context.key_frame_bit_offsets[i] += context.key_frame_block_num_samples[i] * num_bits_read;
+
+			if (settings.supports_mixed_packing() && context.clip->has_mixed_packing)
+				context.key_frame_byte_offsets[i] = context.key_frame_bit_offsets[i] / 8;
+		}
+
+		++context.format_per_track_data_offset;
+
+		// Variable rotations drop W, every variable track has 3 components
+		if (batch.are_clip_ranges_normalized)
+			context.clip_range_data_offset += k_clip_range_reduction_vector3_range_size;
+
+		if (batch.are_segment_ranges_normalized)
+			context.segment_range_data_offset += 3 * k_segment_range_reduction_num_bytes_per_component * 2;
+
+		// The lane reads everything we skipped over once its batch is decompressed
+		record_animated_track_reads(settings, context, start_offsets, false);
+	}
+
+	namespace impl
+	{
+		// The same operations as their 'vector_*' counterparts, on every lane of a batch
+#if defined(ACL_AVX_INTRINSICS)
+		inline SoAVector_32 soa_set(float value) { return _mm256_set1_ps(value); }
+		inline SoAVector_32 soa_add(const SoAVector_32& lhs, const SoAVector_32& rhs) { return _mm256_add_ps(lhs, rhs); }
+		inline SoAVector_32 soa_sub(const SoAVector_32& lhs, const SoAVector_32& rhs) { return _mm256_sub_ps(lhs, rhs); }
+		inline SoAVector_32 soa_mul(const SoAVector_32& lhs, const SoAVector_32& rhs) { return _mm256_mul_ps(lhs, rhs); }
+		inline SoAVector_32 soa_sqrt(const SoAVector_32& input) { return _mm256_sqrt_ps(input); }
+		inline SoAVector_32 soa_abs(const SoAVector_32& input) { return _mm256_max_ps(_mm256_sub_ps(_mm256_setzero_ps(), input), input); }
+
+		inline SoAVector_32 soa_sqrt_reciprocal(const SoAVector_32& input)
+		{
+			// Perform two passes of Newton-Raphson iteration on the hardware estimate
+			const __m256 half = _mm256_set1_ps(0.5f);
+			const __m256 input_half = _mm256_mul_ps(input, half);
+			const __m256 x0 = _mm256_rsqrt_ps(input);
+
+			__m256 x1 = _mm256_mul_ps(x0, x0);
+			x1 = _mm256_sub_ps(half, _mm256_mul_ps(input_half, x1));
+			x1 = _mm256_add_ps(_mm256_mul_ps(x0, x1), x0);
+
+			__m256 x2 = _mm256_mul_ps(x1, x1);
+			x2 = _mm256_sub_ps(half, _mm256_mul_ps(input_half, x2));
+			return _mm256_add_ps(_mm256_mul_ps(x1, x2), x1);
+		}
+
+		// 1.0 where the input is positive or zero, -1.0 otherwise
+		inline SoAVector_32 soa_sign_bias(const SoAVector_32& input)
+		{
+			return _mm256_blendv_ps(_mm256_set1_ps(-1.0f), _mm256_set1_ps(1.0f), _mm256_cmp_ps(input, _mm256_setzero_ps(), _CMP_GE_OQ));
+		}
+#else
+		inline SoAVector_32 soa_set(float value) { return vector_set(value); }
+		inline SoAVector_32 soa_add(const SoAVector_32& lhs, const SoAVector_32& rhs) { return vector_add(lhs, rhs); }
+		inline SoAVector_32 soa_sub(const SoAVector_32& lhs, const SoAVector_32& rhs) { return vector_sub(lhs, rhs); }
+		inline SoAVector_32 soa_mul(const SoAVector_32& lhs, const SoAVector_32& rhs) { return vector_mul(lhs, rhs); }
+		inline SoAVector_32 soa_sqrt(const SoAVector_32& input) { return vector_sqrt(input); }
+		inline SoAVector_32 soa_abs(const SoAVector_32& input) { return vector_abs(input); }
+		inline SoAVector_32 soa_sqrt_reciprocal(const SoAVector_32& input) { return vector_sqrt_reciprocal(input); }
+
+		// 1.0 where the input is positive or zero, -1.0 otherwise
+		inline SoAVector_32 soa_sign_bias(const SoAVector_32& input)
+		{
+			return vector_blend(vector_greater_equal(input, vector_zero_32()), vector_set(1.0f), vector_set(-1.0f));
+		}
+#endif
+
+		inline SoAVector_32 soa_lerp(const SoAVector_32& start, const SoAVector_32& end, const SoAVector_32& alpha) { return soa_add(start, soa_mul(soa_sub(end, start), alpha)); }
+
+		// Transposes 4 values with one value per register into 4 registers with one component per register, and back
+		inline void transpose_soa_lanes(Vector4_32& inout_0, Vector4_32& inout_1, Vector4_32& inout_2, Vector4_32& inout_3)
+		{
+#if defined(ACL_SSE2_INTRINSICS)
+			_MM_TRANSPOSE4_PS(inout_0, inout_1, inout_2, inout_3);
+#elif defined(ACL_ARM_NEON_INTRINSICS)
+			const float32x4x2_t lanes01 = vtrnq_f32(inout_0, inout_1);
+			const float32x4x2_t lanes23 = vtrnq_f32(inout_2, inout_3);
+			inout_0 = vcombine_f32(vget_low_f32(lanes01.val[0]), vget_low_f32(lanes23.val[0]));
+			inout_1 = vcombine_f32(vget_low_f32(lanes01.val[1]), vget_low_f32(lanes23.val[1]));
+			inout_2 = vcombine_f32(vget_high_f32(lanes01.val[0]), vget_high_f32(lanes23.val[0]));
+			inout_3 = vcombine_f32(vget_high_f32(lanes01.val[1]), vget_high_f32(lanes23.val[1]));
+#else
+			const Vector4_32 value0 = inout_0;
+			const Vector4_32 value1 = inout_1;
+			const Vector4_32 value2 = inout_2;
+			const Vector4_32 value3 = inout_3;
+			inout_0 = vector_set(vector_get_x(value0), vector_get_x(value1), vector_get_x(value2), vector_get_x(value3));
+			inout_1 = vector_set(vector_get_y(value0), vector_get_y(value1), vector_get_y(value2), vector_get_y(value3));
+			inout_2 = vector_set(vector_get_z(value0), vector_get_z(value1), vector_get_z(value2), vector_get_z(value3));
+			inout_3 = vector_set(vector_get_w(value0), vector_get_w(value1), vector_get_w(value2), vector_get_w(value3));
+#endif
+		}
+
+		// Transposes one value per lane into one register per component of every lane of the batch
+		inline void transpose_soa_inputs(const Vector4_32* inputs, SoAVector_32& out_0, SoAVector_32& out_1, SoAVector_32& out_2, SoAVector_32& out_3)
+		{
+#if defined(ACL_AVX_INTRINSICS)
+			// Both groups of 4 lanes are transposed at once, one per 128 bit half
+			const __m256 lanes04 = _mm256_insertf128_ps(_mm256_castps128_ps256(inputs[0]), inputs[4], 1);
+			const __m256 lanes15 = _mm256_insertf128_ps(_mm256_castps128_ps256(inputs[1]), inputs[5], 1);
+			const __m256 lanes26 = _mm256_insertf128_ps(_mm256_castps128_ps256(inputs[2]), inputs[6], 1);
+			const __m256 lanes37 = _mm256_insertf128_ps(_mm256_castps128_ps256(inputs[3]), inputs[7], 1);
+
+			const __m256 xy01 = _mm256_unpacklo_ps(lanes04, lanes15);
+			const __m256 xy23 = _mm256_unpacklo_ps(lanes26, lanes37);
+			const __m256 zw01 = _mm256_unpackhi_ps(lanes04, lanes15);
+			const __m256 zw23 = _mm256_unpackhi_ps(lanes26, lanes37);
+
+			out_0 = _mm256_shuffle_ps(xy01, xy23, _MM_SHUFFLE(1, 0, 1, 0));
+			out_1 = _mm256_shuffle_ps(xy01, xy23, _MM_SHUFFLE(3, 2, 3, 2));
+			out_2 = _mm256_shuffle_ps(zw01, zw23, _MM_SHUFFLE(1, 0, 1, 0));
+			out_3 = _mm256_shuffle_ps(zw01, zw23, _MM_SHUFFLE(3, 2, 3, 2));
+#else
+			out_0 = inputs[0];
+			out_1 = inputs[1];
+			out_2 = inputs[2];
+			out_3 = inputs[3];
+			transpose_soa_lanes(out_0, out_1, out_2, out_3);
+#endif
+		}
+
+		// The components of a sample as extracted from the 64 bits that start at its first byte, as loaded from memory (big-endian)
+		inline Vector4_32 unpack_soa_lane_sample(uint64_t sample_word, uint32_t bit_offset, uint32_t num_bits)
+		{
+#if defined(ACL_AVX2_INTRINSICS)
+			// Every component is extracted at once, one per 64 bit lane
+			const __m256i sample_u64 = _mm256_set1_epi64x(int64_t(byte_swap(sample_word)));
+			const __m256i num_bits_u64 = _mm256_set1_epi64x(num_bits);
+			const __m256i shift_left = _mm256_add_epi64(_mm256_set1_epi64x(bit_offset), _mm256_mul_epu32(num_bits_u64, _mm256_setr_epi64x(0, 1, 2, 0)));
+			const __m256i shift_right = _mm256_sub_epi64(_mm256_set1_epi64x(64), num_bits_u64);
+			const __m256i components_u64 = _mm256_srlv_epi64(_mm256_sllv_epi64(sample_u64, shift_left), shift_right);
+			const __m256i components_u32 = _mm256_permutevar8x32_epi32(components_u64, _mm256_setr_epi32(0, 2, 4, 6, 0, 2, 4, 6));
+			return _mm_cvtepi32_ps(_mm256_castsi256_si128(components_u32));
+#else
+			const uint32_t shift_right = 64 - num_bits;
+			const uint64_t sample_u64 = byte_swap(sample_word) << bit_offset;
+
+			const uint32_t x32 = uint32_t(sample_u64 >> shift_right);
+			const uint32_t y32 = uint32_t((sample_u64 << num_bits) >> shift_right);
+			const uint32_t z32 = uint32_t((sample_u64 << (num_bits * 2)) >> shift_right);
+			return vector_set(safe_to_float(x32), safe_to_float(y32), safe_to_float(z32), 0.0f);
+#endif
+		}
+
+		// Unpacks and range reduces a single key frame for every track in the batch, the output is in SoA form
+		template<class DecompressionContext>
+		inline void unpack_soa_key_frame(const DecompressionContext& context, const SoATrackBatch& batch, size_t key_frame_index, SoAVector_32& out_x, SoAVector_32& out_y, SoAVector_32& out_z)
+		{
+			// Normalization and range reduction are folded in a single scale and offset per lane: output = (sample * scale) + offset.
+			// Raw samples are stored in the offset and extract zero, as do padding lanes.
+			const Vector4_32 zero = vector_zero_32();
+			const Vector4_32 segment_range_max_value = vector_set(255.0f);
+
+			Vector4_32 values[k_num_soa_lanes];
+
+			const uint8_t* animated_track_data = context.animated_track_data[key_frame_index];
+
+			for (uint32_t lane_index = 0; lane_index < k_num_soa_lanes; ++lane_index)
+			{
+				Vector4_32 sample = zero;
+				Vector4_32 scale = zero;
+				Vector4_32 offset = zero;
+				bool ignore_clip_range = true;
+				bool ignore_segment_range = true;
+
+				if (lane_index < batch.num_lanes)
+				{
+					const SoATrackLane& lane = batch.lanes[lane_index];
+					const uint8_t bit_rate = lane.bit_rates[key_frame_index];
+
+					if (is_constant_bit_rate(bit_rate))
+					{
+						// Extracted like 16 bit components stored in memory
+						const uint16_t* sample_u16 = safe_ptr_cast<const uint16_t>(lane.segment_range_data[key_frame_index]);
+						const uint64_t sample_word = (uint64_t(sample_u16[0]) << 48) | (uint64_t(sample_u16[1]) << 32) | (uint64_t(sample_u16[2]) << 16);
+						sample = unpack_soa_lane_sample(byte_swap(sample_word), 0, 16);
+						scale = vector_set(1.0f / 65535.0f);
+						ignore_clip_range = false;
+					}
+					else if (is_raw_bit_rate(bit_rate))
+					{
+						offset = unpack_vector3_96(animated_track_data, lane.key_frame_bit_offsets[key_frame_index]);
+					}
+					else
+					{
+						// With at most 19 bits per component and 7 bits of offset, a sample always fits in the 64 bits that start at its first byte
+						const uint8_t num_bits_at_bit_rate = get_num_bits_at_bit_rate(bit_rate);
+						const int32_t bit_offset = lane.key_frame_bit_offsets[key_frame_index];
+						const uint64_t sample_word = unaligned_load<uint64_t>(animated_track_data + (bit_offset / 8));
+						sample = unpack_soa_lane_sample(sample_word, uint32_t(bit_offset % 8), num_bits_at_bit_rate);
+
+						// Only quantized samples can be signed, constant and raw samples are stored as is
+						const float max_value = safe_to_float((1 << num_bits_at_bit_rate) - 1);
+						if (batch.is_unsigned)
+							scale = vector_set(1.0f / max_value);
+						else
+						{
+							scale = vector_set(2.0f / max_value);
+							offset = vector_set(-1.0f);
+						}
+
+						ignore_clip_range = false;
+						ignore_segment_range = false;
+					}
+				}
+
+				if (batch.are_segment_ranges_normalized && !ignore_segment_range)
+				{
+					const uint8_t* segment_range_data = batch.lanes[lane_index].segment_range_data[key_frame_index];
+					const Vector4_32 range_min = vector_div(vector_set(safe_to_float(segment_range_data[0]), safe_to_float(segment_range_data[1]), safe_to_float(segment_range_data[2]), 0.0f), segment_range_max_value);
+					const Vector4_32 range_extent = vector_div(vector_set(safe_to_float(segment_range_data[3]), safe_to_float(segment_range_data[4]), safe_to_float(segment_range_data[5]), 0.0f), segment_range_max_value);
+					scale = vector_mul(scale, range_extent);
+					offset = vector_mul_add(offset, range_extent, range_min);
+				}
+
+				if (batch.are_clip_ranges_normalized && !ignore_clip_range)
+				{
+					// The 4th component of the min is the first component of the extent, it ends up unused
+					const uint8_t* clip_range_data = batch.lanes[lane_index].clip_range_data;
+					const Vector4_32 range_min = vector_unaligned_load_32(clip_range_data);
+					const Vector4_32 range_extent = vector_unaligned_load3_32(clip_range_data + sizeof(float) * 3);
+					scale = vector_mul(scale, range_extent);
+					offset = vector_mul_add(offset, range_extent, range_min);
+				}
+
+				values[lane_index] = vector_mul_add(sample, scale, offset);
+			}
+
+			SoAVector_32 unused;
+			transpose_soa_inputs(values, out_x, out_y, out_z, unused);
+		}
+
+		// Same as 'quat_from_positive_w' for every lane at once
+		inline SoAVector_32 quat_soa_positive_w(const SoAVector_32& x, const SoAVector_32& y, const SoAVector_32& z)
+		{
+			const SoAVector_32 w_squared = soa_sub(soa_sub(soa_sub(soa_set(1.0f), soa_mul(x, x)), soa_mul(y, y)), soa_mul(z, z));
+			return soa_sqrt(soa_abs(w_squared));
+		}
+	}
+
+	// Decompresses and interpolates every rotation in the batch, each output register holds one component of every lane
+	template<class DecompressionContext>
+	inline void decompress_and_interpolate_soa_rotation_components(const DecompressionContext& context, const SoATrackBatch& batch, SoAVector_32& out_x, SoAVector_32& out_y, SoAVector_32& out_z, SoAVector_32& out_w)
+	{
+		using namespace impl;
+
+		SoAVector_32 x0;
+		SoAVector_32 y0;
+		SoAVector_32 z0;
+		unpack_soa_key_frame(context, batch, 0, x0, y0, z0);
+		const SoAVector_32 w0 = quat_soa_positive_w(x0, y0, z0);
+
+		SoAVector_32 x1;
+		SoAVector_32 y1;
+		SoAVector_32 z1;
+		unpack_soa_key_frame(context, batch, 1, x1, y1, z1);
+		const SoAVector_32 w1 = quat_soa_positive_w(x1, y1, z1);
+
+		// Same as 'quat_lerp', to ensure we take the shortest path, we apply a bias if the dot product is negative
+		const SoAVector_32 dot = soa_add(soa_add(soa_add(soa_mul(x0, x1), soa_mul(y0, y1)), soa_mul(z0, z1)), soa_mul(w0, w1));
+		const SoAVector_32 bias = soa_sign_bias(dot);
+		const SoAVector_32 alpha = soa_set(context.interpolation_alpha);
+
+		const SoAVector_32 x = soa_lerp(x0, soa_mul(x1, bias), alpha);
+		const SoAVector_32 y = soa_lerp(y0, soa_mul(y1, bias), alpha);
+		const SoAVector_32 z = soa_lerp(z0, soa_mul(z1, bias), alpha);
+		const SoAVector_32 w = soa_lerp(w0, soa_mul(w1, bias), alpha);
+
+		const SoAVector_32 length_squared = soa_add(soa_add(soa_add(soa_mul(x, x), soa_mul(y, y)), soa_mul(z, z)), soa_mul(w, w));
+		const SoAVector_32 inv_length = soa_sqrt_reciprocal(length_squared);
+
+		out_x = soa_mul(x, inv_length);
+		out_y = soa_mul(y, inv_length);
+		out_z = soa_mul(z, inv_length);
+		out_w = soa_mul(w, inv_length);
+	}
+
+	// Decompresses and interpolates every rotation in the batch, 'out_rotations' must hold 'k_num_soa_lanes' entries
+	template<class DecompressionContext>
+	inline void decompress_and_interpolate_soa_rotations(const DecompressionContext& context, const SoATrackBatch& batch, Quat_32* out_rotations)
+	{
+		static_assert(k_num_soa_writer_lanes == 4, "Transposing assumes 4 lanes");
+
+		SoAVector_32 x;
+		SoAVector_32 y;
+		SoAVector_32 z;
+		SoAVector_32 w;
+		decompress_and_interpolate_soa_rotation_components(context, batch, x, y, z, w);
+
+		for (uint32_t group_index = 0; group_index < k_num_soa_writer_groups; ++group_index)
+		{
+			const uint32_t first_lane_index = group_index * k_num_soa_writer_lanes;
+
+			Vector4_32 rotations[k_num_soa_writer_lanes] = { get_soa_writer_lanes(x, group_index), get_soa_writer_lanes(y, group_index), get_soa_writer_lanes(z, group_index), get_soa_writer_lanes(w, group_index) };
+			impl::transpose_soa_lanes(rotations[0], rotations[1], rotations[2], rotations[3]);
+
+			for (uint32_t lane_index = 0; lane_index < k_num_soa_writer_lanes; ++lane_index)
+				out_rotations[first_lane_index + lane_index] = vector_to_quat(rotations[lane_index]);
+		}
+	}
+
+	// Decompresses and interpolates every vector in the batch, each output register holds one component of every lane
+	template<class DecompressionContext>
+	inline void decompress_and_interpolate_soa_vector_components(const DecompressionContext& context, const SoATrackBatch& batch, SoAVector_32& out_x, SoAVector_32& out_y, SoAVector_32& out_z)
+	{
+		using namespace impl;
+
+		SoAVector_32 x0;
+		SoAVector_32 y0;
+		SoAVector_32 z0;
+		unpack_soa_key_frame(context, batch, 0, x0, y0, z0);
+
+		SoAVector_32 x1;
+		SoAVector_32 y1;
+		SoAVector_32 z1;
+		unpack_soa_key_frame(context, batch, 1, x1, y1, z1);
+
+		const SoAVector_32 alpha = soa_set(context.interpolation_alpha);
+		out_x = soa_lerp(x0, x1, alpha);
+		out_y = soa_lerp(y0, y1, alpha);
+		out_z = soa_lerp(z0, z1, alpha);
+	}
+
+	// Decompresses and interpolates every vector in the batch, 'out_vectors' must hold 'k_num_soa_lanes' entries
+	template<class DecompressionContext>
+	inline void decompress_and_interpolate_soa_vectors(const DecompressionContext& context, const SoATrackBatch& batch, Vector4_32* out_vectors)
+	{
+		static_assert(k_num_soa_writer_lanes == 4, "Transposing assumes 4 lanes");
+
+		SoAVector_32 x;
+		SoAVector_32 y;
+		SoAVector_32 z;
+		decompress_and_interpolate_soa_vector_components(context, batch, x, y, z);
+
+		for (uint32_t group_index = 0; group_index < k_num_soa_writer_groups; ++group_index)
+		{
+			const uint32_t first_lane_index = group_index * k_num_soa_writer_lanes;
+
+			Vector4_32* vectors = out_vectors + first_lane_index;
+			vectors[0] = get_soa_writer_lanes(x, group_index);
+			vectors[1] = get_soa_writer_lanes(y, group_index);
+			vectors[2] = get_soa_writer_lanes(z, group_index);
+			vectors[3] = vector_zero_32();
+			impl::transpose_soa_lanes(vectors[0], vectors[1], vectors[2], vectors[3]);
+		}
+	}
+}
@@ -41,6 +41,9 @@ namespace acl
 			ACL_ENSURE(num_transforms != 0, "Transforms array cannot be empty");
 		}
 
+		// Every value is stored at its bone index, the order they are written in does not matter
+		constexpr bool requires_ordered_writes() const { return false; }
+
 		void write_bone_rotation(uint32_t bone_index, const acl::Quat_32& rotation)
 		{
 			ACL_ENSURE(bone_index < m_num_transforms, "Invalid bone index. %u >= %u", bone_index, m_num_transforms);
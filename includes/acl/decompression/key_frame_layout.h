@@ -0,0 +1,185 @@
+#pragma once
+
+////////////////////////////////////////////////////////////////////////////////
+// The MIT License (MIT)
+//
+// Copyright (c) 2018 Nicholas Frechette & Animation Compression Library contributors
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+////////////////////////////////////////////////////////////////////////////////
+
+#include "acl/core/bitset.h"
+#include "acl/core/compressed_clip.h"
+#include "acl/core/error.h"
+#include "acl/core/track_types.h"
+#include "acl/math/quat_packing.h"
+#include "acl/math/vector4_packing.h"
+
+#include <algorithm>
+#include <cstdint>
+
+namespace acl
+{
+	namespace impl
+	{
+		// Calls the provided function with the size in bits of one sample of every animated track of a segment, in the order they are stored
+		template<class TrackFunction>
+		inline void for_each_animated_track_sample_size(const ClipHeader& header, const SegmentHeader& segment_header, TrackFunction track_function)
+		{
+			const bool is_rotation_variable = is_rotation_format_variable(header.rotation_format);
+			const bool is_translation_variable = is_vector_format_variable(header.translation_format);
+			const bool is_scale_variable = is_vector_format_variable(header.scale_format);
+			const bool is_every_format_variable = is_rotation_variable && is_translation_variable && is_scale_variable;
+			const bool is_any_format_variable = is_rotation_variable || is_translation_variable || is_scale_variable;
+			const bool has_mixed_packing = !is_every_format_variable && is_any_format_variable;
+
+			const uint32_t num_tracks_per_bone = header.has_scale ? 3 : 2;
+			const BitSetDescription bitset_desc = BitSetDescription::make_from_num_bits(header.num_bones * num_tracks_per_bone);
+			const uint32_t* default_tracks_bitset = header.get_default_tracks_bitset();
+			const uint32_t* constant_tracks_bitset = header.get_constant_tracks_bitset();
+			const uint8_t* format_per_track_data = header.get_format_per_track_data(segment_header);
+
+			const uint32_t num_tracks = header.num_bones * num_tracks_per_bone;
+			for (uint32_t track_index = 0; track_index < num_tracks; ++track_index)
+			{
+				if (bitset_test(default_tracks_bitset, bitset_desc, track_index) || bitset_test(constant_tracks_bitset, bitset_desc, track_index))
+					continue;
+
+				const uint32_t track_type = track_index % num_tracks_per_bone;
+				const VectorFormat8 vector_format = track_type == 1 ? header.translation_format : header.scale_format;
+				const bool is_variable = track_type == 0 ? is_rotation_variable : is_vector_format_variable(vector_format);
+
+				uint32_t num_sample_bits;
+				if (is_variable)
+				{
+					num_sample_bits = get_num_bits_at_bit_rate(*format_per_track_data++) * 3;	// 3 components
+
+					if (has_mixed_packing)
+						num_sample_bits = align_to(num_sample_bits, k_mixed_packing_alignment_num_bits);
+				}
+				else
+					num_sample_bits = (track_type == 0 ? get_packed_rotation_size(header.rotation_format) : get_packed_vector_size(vector_format)) * 8;
+
+				track_function(num_sample_bits);
+			}
+		}
+
+		inline uint16_t find_key_frame_segment_index(const ClipHeader& header, uint32_t key_frame)
+		{
+			const SegmentHeader* segment_headers = header.get_segment_headers();
+
+			uint16_t segment_index = 0;
+			while (segment_index + 1 < header.num_segments && segment_headers[segment_index + 1].clip_sample_offset <= key_frame)
+				segment_index++;
+
+			return segment_index;
+		}
+	}
+
+	//////////////////////////////////////////////////////////////////////////
+	// Returns how many cache lines of animated data we touch when we interpolate two key frames if the
+	// clip was stored with the provided key frame block size. Blocks only change the order of the
+	// animated samples within a segment, the size of the data stays the same which lets us compare
+	// any block size against the one the clip uses. Every segment of the clip must be resident.
+	inline uint32_t calculate_num_animated_touched_cache_lines(const CompressedClip& clip, uint32_t key_frame0, uint32_t key_frame1, uint32_t key_frame_block_size, uint32_t cache_line_size = 64)
+	{
+		ACL_ENSURE(key_frame_block_size != 0, "Key frame block size cannot be 0");
+		ACL_ENSURE(cache_line_size != 0 && (cache_line_size & (cache_line_size - 1)) == 0, "Cache line size must be a power of two: %u", cache_line_size);
+
+		const ClipHeader& header = get_clip_header(clip);
+		const SegmentHeader* segment_headers = header.get_segment_headers();
+
+		const uint32_t key_frames[2] = { key_frame0, key_frame1 };
+		const SegmentHeader* key_frame_segment_headers[2];
+		const uint8_t* animated_track_data[2];
+		uint32_t block_bit_offsets[2];
+		uint32_t block_sample_indices[2];
+		uint32_t block_num_samples[2];
+
+		for (uint32_t key_frame_index = 0; key_frame_index < 2; ++key_frame_index)
+		{
+			const SegmentHeader& segment_header = segment_headers[impl::find_key_frame_segment_index(header, key_frames[key_frame_index])];
+			const uint32_t segment_key_frame = key_frames[key_frame_index] - segment_header.clip_sample_offset;
+			const uint32_t block_sample_index = segment_key_frame % key_frame_block_size;
+			const uint32_t block_key_frame = segment_key_frame - block_sample_index;
+
+			key_frame_segment_headers[key_frame_index] = &segment_header;
+			animated_track_data[key_frame_index] = header.get_track_data(segment_header);
+			block_bit_offsets[key_frame_index] = block_key_frame * segment_header.animated_pose_bit_size;
+			block_sample_indices[key_frame_index] = block_sample_index;
+			block_num_samples[key_frame_index] = std::min(key_frame_block_size, segment_header.num_samples - block_key_frame);
+		}
+
+		// Samples are visited in increasing address order, we only need to remember the last cache line touched
+		const uintptr_t cache_line_mask = ~uintptr_t(cache_line_size - 1);
+		uintptr_t last_cache_line = 0;
+		uint32_t num_touched_cache_lines = 0;
+
+		auto touch_sample = [&](uint32_t key_frame_index, uint32_t track_bit_offset, uint32_t num_sample_bits)
+		{
+			if (num_sample_bits == 0)
+				return;
+
+			const uint32_t sample_bit_offset = track_bit_offset + (block_sample_indices[key_frame_index] * num_sample_bits);
+			const uint8_t* sample_data = animated_track_data[key_frame_index] + (sample_bit_offset / 8);
+			uintptr_t first_cache_line = reinterpret_cast<uintptr_t>(sample_data) & cache_line_mask;
+			const uintptr_t end_cache_line = reinterpret_cast<uintptr_t>(animated_track_data[key_frame_index] + ((sample_bit_offset + num_sample_bits - 1) / 8)) & cache_line_mask;
+
+			if (num_touched_cache_lines != 0)
+			{
+				ACL_ASSERT(end_cache_line >= last_cache_line, "Samples must be visited in increasing address order");
+				first_cache_line = std::max<uintptr_t>(first_cache_line, last_cache_line + cache_line_size);
+			}
+
+			if (first_cache_line <= end_cache_line)
+			{
+				num_touched_cache_lines += uint32_t((end_cache_line - first_cache_line) / cache_line_size) + 1;
+				last_cache_line = end_cache_line;
+			}
+		};
+
+		const bool is_same_block = key_frame_segment_headers[0] == key_frame_segment_headers[1] && block_bit_offsets[0] == block_bit_offsets[1];
+		if (is_same_block)
+		{
+			// Both samples of a track are read before we move on to the next track
+			uint32_t track_bit_offset = block_bit_offsets[0];
+			impl::for_each_animated_track_sample_size(header, *key_frame_segment_headers[0], [&](uint32_t num_sample_bits)
+			{
+				touch_sample(0, track_bit_offset, num_sample_bits);
+				touch_sample(1, track_bit_offset, num_sample_bits);
+				track_bit_offset += block_num_samples[0] * num_sample_bits;
+			});
+		}
+		else
+		{
+			// The second block always follows the first in memory
+			for (uint32_t key_frame_index = 0; key_frame_index < 2; ++key_frame_index)
+			{
+				uint32_t track_bit_offset = block_bit_offsets[key_frame_index];
+				impl::for_each_animated_track_sample_size(header, *key_frame_segment_headers[key_frame_index], [&](uint32_t num_sample_bits)
+				{
+					touch_sample(key_frame_index, track_bit_offset, num_sample_bits);
+					track_bit_offset += block_num_samples[key_frame_index] * num_sample_bits;
+				});
+			}
+		}
+
+		return num_touched_cache_lines;
+	}
+}
@@ -0,0 +1,218 @@
+#pragma once
+
+////////////////////////////////////////////////////////////////////////////////
+// The MIT License (MIT)
+//
+// Copyright (c) 2018 Nicholas Frechette & Animation Compression Library contributors
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+////////////////////////////////////////////////////////////////////////////////
+
+#include "acl/core/error.h"
+#include "acl/core/iallocator.h"
+
+#include <algorithm>
+#include <cstdint>
+
+namespace acl
+{
+	// The sections of a compressed clip the decoder reads from
+	enum class CompressedDataSection8 : uint8_t
+	{
+		ClipHeader,
+		SegmentHeaders,
+		DefaultTracksBitset,
+		ConstantTracksBitset,
+		ConstantTrackData,
+		ClipRangeData,
+		FormatPerTrackData,
+		SegmentRangeData,
+		AnimatedTrackData,
+
+		Count,
+	};
+
+	// TODO: constexpr
+	inline const char* get_compressed_data_section_name(CompressedDataSection8 section)
+	{
+		switch (section)
+		{
+		case CompressedDataSection8::ClipHeader:				return "clip header";
+		case CompressedDataSection8::SegmentHeaders:			return "segment headers";
+		case CompressedDataSection8::DefaultTracksBitset:		return "default tracks bitset";
+		case CompressedDataSection8::ConstantTracksBitset:		return "constant tracks bitset";
+		case CompressedDataSection8::ConstantTrackData:			return "constant track data";
+		case CompressedDataSection8::ClipRangeData:				return "clip range data";
+		case CompressedDataSection8::FormatPerTrackData:		return "format per track data";
+		case CompressedDataSection8::SegmentRangeData:			return "segment range data";
+		case CompressedDataSection8::AnimatedTrackData:			return "animated track data";
+		default:												return "<Invalid>";
+		}
+	}
+
+	// A contiguous range of compressed data read by the decoder
+	struct MemoryAccess
+	{
+		uintptr_t					address;
+		uint32_t					size;
+		CompressedDataSection8		section;
+	};
+
+	//////////////////////////////////////////////////////////////////////////
+	// Records every range of compressed data the decoder reads, in the order it reads them.
+	// Decompress with settings that forward their reads here (e.g. 'uniformly_sampled::InstrumentedDecompressionSettings')
+	// and call 'reset' between decompression calls to inspect them one at a time.
+	//
+	// Only the data needed to decompress is recorded, not how the CPU loads it: unpacking a
+	// few bits at a time can load a few more bytes around them than what is recorded here.
+	// Recording is meant for analysis and is much slower than decompressing.
+	//////////////////////////////////////////////////////////////////////////
+	class MemoryAccessRecorder
+	{
+	public:
+		explicit MemoryAccessRecorder(IAllocator& allocator)
+			: m_allocator(allocator)
+			, m_accesses(nullptr)
+			, m_num_accesses(0)
+			, m_max_num_accesses(0)
+		{}
+
+		~MemoryAccessRecorder()
+		{
+			deallocate_type_array(m_allocator, m_accesses, m_max_num_accesses);
+		}
+
+		MemoryAccessRecorder(const MemoryAccessRecorder&) = delete;
+		MemoryAccessRecorder& operator=(const MemoryAccessRecorder&) = delete;
+
+		void reset() { m_num_accesses = 0; }
+
+		void record(CompressedDataSection8 section, const void* data, uint32_t size)
+		{
+			if (size == 0)
+				return;
+
+			if (m_num_accesses == m_max_num_accesses)
+			{
+				const uint32_t max_num_accesses = std::max<uint32_t>(m_max_num_accesses * 2, 256);
+				MemoryAccess* accesses = allocate_type_array<MemoryAccess>(m_allocator, max_num_accesses);
+				std::copy(m_accesses, m_accesses + m_num_accesses, accesses);
+
+				deallocate_type_array(m_allocator, m_accesses, m_max_num_accesses);
+				m_accesses = accesses;
+				m_max_num_accesses = max_num_accesses;
+			}
+
+			MemoryAccess& access = m_accesses[m_num_accesses++];
+			access.address = reinterpret_cast<uintptr_t>(data);
+			access.size = size;
+			access.section = section;
+		}
+
+		// The accesses in the order they were made
+		const MemoryAccess* get_accesses() const { return m_accesses; }
+		uint32_t get_num_accesses() const { return m_num_accesses; }
+
+		// The number of bytes read from a section, bytes read more than once are counted every time
+		uint32_t get_num_read_bytes(CompressedDataSection8 section) const
+		{
+			uint32_t num_read_bytes = 0;
+			for (uint32_t access_index = 0; access_index < m_num_accesses; ++access_index)
+			{
+				if (m_accesses[access_index].section == section)
+					num_read_bytes += m_accesses[access_index].size;
+			}
+			return num_read_bytes;
+		}
+
+		// The number of distinct bytes read
+		uint32_t calculate_num_touched_bytes() const
+		{
+			if (m_num_accesses == 0)
+				return 0;
+
+			MemoryAccess* accesses = allocate_type_array<MemoryAccess>(m_allocator, m_num_accesses);
+			std::copy(m_accesses, m_accesses + m_num_accesses, accesses);
+			std::sort(accesses, accesses + m_num_accesses, [](const MemoryAccess& lhs, const MemoryAccess& rhs) { return lhs.address < rhs.address; });
+
+			// Merge the overlapping ranges
+			uint32_t num_touched_bytes = 0;
+			uintptr_t range_start = accesses[0].address;
+			uintptr_t range_end = range_start + accesses[0].size;
+			for (uint32_t access_index = 1; access_index < m_num_accesses; ++access_index)
+			{
+				const MemoryAccess& access = accesses[access_index];
+				if (access.address > range_end)
+				{
+					num_touched_bytes += uint32_t(range_end - range_start);
+					range_start = access.address;
+				}
+
+				range_end = std::max<uintptr_t>(range_end, access.address + access.size);
+			}
+
+			num_touched_bytes += uint32_t(range_end - range_start);
+
+			deallocate_type_array(m_allocator, accesses, m_num_accesses);
+			return num_touched_bytes;
+		}
+
+		// Writes the distinct cache lines read in the order they were first touched and returns how many there are.
+		// The output can be null to only count them.
+		uint32_t calculate_touched_cache_lines(uint32_t cache_line_size, uintptr_t* out_cache_lines, uint32_t max_num_cache_lines) const
+		{
+			ACL_ENSURE(cache_line_size != 0 && (cache_line_size & (cache_line_size - 1)) == 0, "Cache line size must be a power of two: %u", cache_line_size);
+
+			uint32_t max_num_touched_cache_lines = 0;
+			for (uint32_t access_index = 0; access_index < m_num_accesses; ++access_index)
+				max_num_touched_cache_lines += ((m_accesses[access_index].size - 1) / cache_line_size) + 2;
+
+			uintptr_t* cache_lines = allocate_type_array<uintptr_t>(m_allocator, std::max<uint32_t>(max_num_touched_cache_lines, 1));
+			uint32_t num_touched_cache_lines = 0;
+
+			const uintptr_t cache_line_mask = ~uintptr_t(cache_line_size - 1);
+			for (uint32_t access_index = 0; access_index < m_num_accesses; ++access_index)
+			{
+				const MemoryAccess& access = m_accesses[access_index];
+				const uintptr_t first_cache_line = access.address & cache_line_mask;
+				const uintptr_t last_cache_line = (access.address + access.size - 1) & cache_line_mask;
+
+				for (uintptr_t cache_line = first_cache_line; cache_line <= last_cache_line; cache_line += cache_line_size)
+				{
+					if (std::find(cache_lines, cache_lines + num_touched_cache_lines, cache_line) == cache_lines + num_touched_cache_lines)
+						cache_lines[num_touched_cache_lines++] = cache_line;
+				}
+			}
+
+			if (out_cache_lines != nullptr)
+				std::copy(cache_lines, cache_lines + std::min(num_touched_cache_lines, max_num_cache_lines), out_cache_lines);
+
+			deallocate_type_array(m_allocator, cache_lines, std::max<uint32_t>(max_num_touched_cache_lines, 1));
+			return num_touched_cache_lines;
+		}
+
+		uint32_t calculate_num_touched_cache_lines(uint32_t cache_line_size = 64) const { return calculate_touched_cache_lines(cache_line_size, nullptr, 0); }
+
+	private:
+		IAllocator&			m_allocator;
+		MemoryAccess*		m_accesses;
+		uint32_t			m_num_accesses;
+		uint32_t			m_max_num_accesses;
+	};
+}
@@ -0,0 +1,146 @@
+#pragma once
+
+////////////////////////////////////////////////////////////////////////////////
+// The MIT License (MIT)
+//
+// Copyright (c) 2017 Nicholas Frechette & Animation Compression Library contributors
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include "acl/core/error.h"
+#include "acl/decompression/output_writer.h"
+#include "acl/math/affine_matrix_32.h"
+#include "acl/math/math_types.h"
+#include "acl/math/transform_32.h"
+
+#include <stdint.h>
+
+namespace acl
+{
+	// The parent index of a root bone, it matches 'k_invalid_bone_index' of a 'RigidSkeleton'
+	constexpr uint16_t k_root_bone_parent_index = 0xFFFF;
+
+	//////////////////////////////////////////////////////////////////////////
+	// Writes a pose in object space as it is decompressed. Bones are decompressed in
+	// index order and are sorted parent first, each bone is thus combined with its parent
+	// as soon as it is written while its parent is still hot in the cache. This saves
+	// a second pass over the pose to convert it from local space.
+	//
+	// The parent indices have one entry per bone, root bones use 'k_root_bone_parent_index'.
+	// With partial poses, the parents of every decompressed bone must be decompressed as well.
+	// Transforms do not properly combine non-uniform scale, use 'ObjectSpaceMatrixOutputWriter' if it is present.
+	//////////////////////////////////////////////////////////////////////////
+	struct ObjectSpaceOutputWriter : public OutputWriter
+	{
+		ObjectSpaceOutputWriter(Transform_32* transforms, const uint16_t* parent_indices, uint16_t num_transforms)
+			: m_transforms(transforms)
+			, m_parent_indices(parent_indices)
+			, m_num_transforms(num_transforms)
+		{
+			ACL_ENSURE(transforms != nullptr, "Transforms array cannot be null");
+			ACL_ENSURE(parent_indices != nullptr, "Parent indices array cannot be null");
+			ACL_ENSURE(num_transforms != 0, "Transforms array cannot be empty");
+		}
+
+		// The rotation and translation are held until the scale completes the bone
+		void write_bone_rotation(uint32_t bone_index, const acl::Quat_32& rotation)
+		{
+			m_rotation = rotation;
+		}
+
+		void write_bone_translation(uint32_t bone_index, const acl::Vector4_32& translation)
+		{
+			m_translation = translation;
+		}
+
+		void write_bone_scale(uint32_t bone_index, const acl::Vector4_32& scale)
+		{
+			ACL_ENSURE(bone_index < m_num_transforms, "Invalid bone index. %u >= %u", bone_index, m_num_transforms);
+
+			const Transform_32 local_transform = transform_set(m_rotation, m_translation, scale);
+
+			const uint16_t parent_index = m_parent_indices[bone_index];
+			if (parent_index == k_root_bone_parent_index)
+				m_transforms[bone_index] = local_transform;
+			else
+			{
+				ACL_ENSURE(parent_index < bone_index, "Bones must be sorted parent first");
+				m_transforms[bone_index] = transform_mul(local_transform, m_transforms[parent_index]);
+			}
+		}
+
+		Transform_32* m_transforms;
+		const uint16_t* m_parent_indices;
+		uint16_t m_num_transforms;
+
+		Quat_32 m_rotation;
+		Vector4_32 m_translation;
+	};
+
+	//////////////////////////////////////////////////////////////////////////
+	// Writes a pose in object space as affine matrices as it is decompressed.
+	// See 'ObjectSpaceOutputWriter' for details.
+	//////////////////////////////////////////////////////////////////////////
+	struct ObjectSpaceMatrixOutputWriter : public OutputWriter
+	{
+		ObjectSpaceMatrixOutputWriter(AffineMatrix_32* matrices, const uint16_t* parent_indices, uint16_t num_matrices)
+			: m_matrices(matrices)
+			, m_parent_indices(parent_indices)
+			, m_num_matrices(num_matrices)
+		{
+			ACL_ENSURE(matrices != nullptr, "Matrices array cannot be null");
+			ACL_ENSURE(parent_indices != nullptr, "Parent indices array cannot be null");
+			ACL_ENSURE(num_matrices != 0, "Matrices array cannot be empty");
+		}
+
+		// The rotation and translation are held until the scale completes the bone
+		void write_bone_rotation(uint32_t bone_index, const acl::Quat_32& rotation)
+		{
+			m_rotation = rotation;
+		}
+
+		void write_bone_translation(uint32_t bone_index, const acl::Vector4_32& translation)
+		{
+			m_translation = translation;
+		}
+
+		void write_bone_scale(uint32_t bone_index, const acl::Vector4_32& scale)
+		{
+			ACL_ENSURE(bone_index < m_num_matrices, "Invalid bone index. %u >= %u", bone_index, m_num_matrices);
+
+			const AffineMatrix_32 local_matrix = matrix_set(m_rotation, m_translation, scale);
+
+			const uint16_t parent_index = m_parent_indices[bone_index];
+			if (parent_index == k_root_bone_parent_index)
+				m_matrices[bone_index] = local_matrix;
+			else
+			{
+				ACL_ENSURE(parent_index < bone_index, "Bones must be sorted parent first");
+				m_matrices[bone_index] = matrix_mul(local_matrix, m_matrices[parent_index]);
+			}
+		}
+
+		AffineMatrix_32* m_matrices;
+		const uint16_t* m_parent_indices;
+		uint16_t m_num_matrices;
+
+		Quat_32 m_rotation;
+		Vector4_32 m_translation;
+	};
+}
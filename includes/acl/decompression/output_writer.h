@@ -47,5 +47,31 @@ namespace acl
 		void write_bone_scale(uint32_t bone_index, const Vector4_32& scale)
 		{
 		}
+
+		//////////////////////////////////////////////////////////////////////////
+		// Whether bones must be written in bone index order, each with its rotation, translation,
+		// and scale written in that order before the next bone is. This is the default, writers that
+		// only store each value at its bone index can opt out to allow decoding paths that write
+		// bones out of order, e.g. the structure of arrays path.
+		constexpr bool requires_ordered_writes() const { return true; }
+
+		//////////////////////////////////////////////////////////////////////////
+		// Optional structure of arrays output. When supported, animated variable tracks decompressed
+		// 4 at a time are handed over without being transposed: each register holds one component
+		// of up to 4 bones, lane N belonging to 'bone_indices[N]'. Only the first 'num_lanes' lanes are valid.
+		// Other tracks are still written one at a time with the functions above.
+		constexpr bool supports_soa_writes() const { return false; }
+
+		void write_bone_rotations_soa(const uint16_t* bone_indices, uint32_t num_lanes, const Vector4_32& x, const Vector4_32& y, const Vector4_32& z, const Vector4_32& w)
+		{
+		}
+
+		void write_bone_translations_soa(const uint16_t* bone_indices, uint32_t num_lanes, const Vector4_32& x, const Vector4_32& y, const Vector4_32& z)
+		{
+		}
+
+		void write_bone_scales_soa(const uint16_t* bone_indices, uint32_t num_lanes, const Vector4_32& x, const Vector4_32& y, const Vector4_32& z)
+		{
+		}
 	};
 }
@@ -0,0 +1,109 @@
+#pragma once
+
+////////////////////////////////////////////////////////////////////////////////
+// The MIT License (MIT)
+//
+// Copyright (c) 2018 Nicholas Frechette & Animation Compression Library contributors
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+////////////////////////////////////////////////////////////////////////////////
+
+#include "acl/core/compressed_clip.h"
+
+#include <cstdint>
+
+namespace acl
+{
+	//////////////////////////////////////////////////////////////////////////
+	// An interface to provide the segment data of a streamed compressed clip.
+	//
+	// A streamed clip only keeps the part of the compressed clip returned by
+	// 'get_resident_clip_size' in memory: the clip header, the segment headers,
+	// the bitsets, the constant track data, and the clip range data. Every segment
+	// stores its own data contiguously (format per track, range, and animated data)
+	// and it can be loaded on its own from anywhere the host application likes.
+	//////////////////////////////////////////////////////////////////////////
+	class ISegmentStreamer
+	{
+	public:
+		ISegmentStreamer() {}
+		virtual ~ISegmentStreamer() {}
+
+		ISegmentStreamer(const ISegmentStreamer&) = delete;
+		ISegmentStreamer& operator=(const ISegmentStreamer&) = delete;
+
+		// Returns the data of the requested segment, it must be resident and remain valid until
+		// the decompression context moves to another segment or the streamer is detached.
+		// If the segment isn't resident yet, the streamer must load it before returning.
+		virtual const uint8_t* get_segment_data(uint16_t segment_index) = 0;
+
+		// Hints that the requested segment will be needed soon and that it should start loading.
+		// The decompression context calls this when it enters a segment with the next segment
+		// in the direction playback is heading.
+		virtual void prefetch_segment(uint16_t segment_index) { (void)segment_index; }
+	};
+
+	namespace impl
+	{
+		// Returns the offset of the segment data relative to the clip header, it is invalid when the segment has no data
+		inline PtrOffset32<uint8_t> get_segment_data_header_offset(const SegmentHeader& segment_header)
+		{
+			// Data within a segment is always laid out in this order
+			if (segment_header.format_per_track_data_offset.is_valid())
+				return segment_header.format_per_track_data_offset;
+
+			if (segment_header.range_data_offset.is_valid())
+				return segment_header.range_data_offset;
+
+			return segment_header.track_data_offset;
+		}
+	}
+
+	//////////////////////////////////////////////////////////////////////////
+	// Returns the offset in bytes of the data of a segment relative to the start of the compressed clip
+	inline uint32_t get_segment_data_offset(const CompressedClip& clip, uint16_t segment_index)
+	{
+		const ClipHeader& header = get_clip_header(clip);
+		ACL_ENSURE(segment_index < header.num_segments, "Invalid segment index: %u >= %u", segment_index, header.num_segments);
+
+		// Segments without data only happen when nothing is animated, they all start at the end of the clip
+		const PtrOffset32<uint8_t> segment_data_offset = impl::get_segment_data_header_offset(header.get_segment_headers()[segment_index]);
+		return segment_data_offset.is_valid() ? uint32_t(sizeof(CompressedClip) + segment_data_offset) : clip.get_size();
+	}
+
+	//////////////////////////////////////////////////////////////////////////
+	// Returns the size in bytes of the data of a segment, including any padding that follows it
+	inline uint32_t get_segment_data_size(const CompressedClip& clip, uint16_t segment_index)
+	{
+		const ClipHeader& header = get_clip_header(clip);
+		const uint32_t segment_data_offset = get_segment_data_offset(clip, segment_index);
+		const uint32_t next_segment_data_offset = (segment_index + 1) < header.num_segments ? get_segment_data_offset(clip, uint16_t(segment_index + 1)) : clip.get_size();
+
+		return next_segment_data_offset - segment_data_offset;
+	}
+
+	//////////////////////////////////////////////////////////////////////////
+	// Returns the size in bytes of the compressed clip data that must remain resident when
+	// segments are streamed. It is always a prefix of the compressed clip buffer and it
+	// is followed by the data of every segment in order.
+	inline uint32_t get_resident_clip_size(const CompressedClip& clip)
+	{
+		return get_clip_header(clip).num_segments != 0 ? get_segment_data_offset(clip, 0) : clip.get_size();
+	}
+}
@@ -0,0 +1,221 @@
+#pragma once
+
+////////////////////////////////////////////////////////////////////////////////
+// The MIT License (MIT)
+//
+// Copyright (c) 2018 Nicholas Frechette & Animation Compression Library contributors
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+////////////////////////////////////////////////////////////////////////////////
+
+#include "acl/core/error.h"
+#include "acl/core/memory_utils.h"
+#include "acl/decompression/output_writer.h"
+#include "acl/math/math_types.h"
+#include "acl/math/quat_32.h"
+#include "acl/math/vector4_32.h"
+
+#include <stdint.h>
+
+namespace acl
+{
+	//////////////////////////////////////////////////////////////////////////
+	// A group of 'NumLanes' consecutive bones stored as a structure of arrays: every
+	// component of every track has its own array with one entry per bone in the group.
+	// Bone N lives in group N / NumLanes at lane N % NumLanes. A pose is a contiguous
+	// array of groups, see 'get_num_soa_transform_groups'. Lanes past the last bone are padding.
+	//////////////////////////////////////////////////////////////////////////
+	template<uint32_t NumLanes = 4>
+	struct alignas(16) SoATransformGroup
+	{
+		static_assert(NumLanes == 4 || NumLanes == 8, "SoA transform groups hold 4 or 8 bones");
+
+		static constexpr uint32_t k_num_lanes = NumLanes;
+
+		float rotation_x[NumLanes];
+		float rotation_y[NumLanes];
+		float rotation_z[NumLanes];
+		float rotation_w[NumLanes];
+
+		float translation_x[NumLanes];
+		float translation_y[NumLanes];
+		float translation_z[NumLanes];
+
+		float scale_x[NumLanes];
+		float scale_y[NumLanes];
+		float scale_z[NumLanes];
+	};
+
+	// Returns the number of groups required to hold a pose with the specified number of bones
+	template<uint32_t NumLanes>
+	constexpr uint32_t get_num_soa_transform_groups(uint16_t num_bones)
+	{
+		return (uint32_t(num_bones) + NumLanes - 1) / NumLanes;
+	}
+
+	// Reads back the transform of a single bone from a pose buffer
+	template<uint32_t NumLanes>
+	inline Transform_32 get_soa_transform(const SoATransformGroup<NumLanes>* groups, uint16_t bone_index)
+	{
+		const SoATransformGroup<NumLanes>& group = groups[bone_index / NumLanes];
+		const uint32_t lane_index = bone_index % NumLanes;
+
+		const Quat_32 rotation = quat_set(group.rotation_x[lane_index], group.rotation_y[lane_index], group.rotation_z[lane_index], group.rotation_w[lane_index]);
+		const Vector4_32 translation = vector_set(group.translation_x[lane_index], group.translation_y[lane_index], group.translation_z[lane_index]);
+		const Vector4_32 scale = vector_set(group.scale_x[lane_index], group.scale_y[lane_index], group.scale_z[lane_index]);
+		return transform_set(rotation, translation, scale);
+	}
+
+	//////////////////////////////////////////////////////////////////////////
+	// Writes a pose directly into SoA transform groups. Tracks decompressed 4 at a time
+	// by the SoA decoder path are stored with one aligned write per component when
+	// their bones are consecutive and start on a 4 lane boundary, the common case when most
+	// tracks are animated. Everything else is written one lane at a time.
+	// The SoA decoder path is only used with settings that opt into it, see
+	// 'DecompressionSettings::supports_soa_decompression'.
+	//////////////////////////////////////////////////////////////////////////
+	template<uint32_t NumLanes = 4>
+	struct SoAOutputWriter : public OutputWriter
+	{
+		SoAOutputWriter(SoATransformGroup<NumLanes>* groups, uint16_t num_transforms)
+			: m_groups(groups)
+			, m_num_transforms(num_transforms)
+		{
+			ACL_ENSURE(groups != nullptr, "Transform groups array cannot be null");
+			ACL_ENSURE(is_aligned_to(groups, alignof(SoATransformGroup<NumLanes>)), "Transform groups array is not aligned");
+			ACL_ENSURE(num_transforms != 0, "Transform groups array cannot be empty");
+		}
+
+		void write_bone_rotation(uint32_t bone_index, const acl::Quat_32& rotation)
+		{
+			ACL_ENSURE(bone_index < m_num_transforms, "Invalid bone index. %u >= %u", bone_index, m_num_transforms);
+			SoATransformGroup<NumLanes>& group = m_groups[bone_index / NumLanes];
+			const uint32_t lane_index = bone_index % NumLanes;
+			group.rotation_x[lane_index] = quat_get_x(rotation);
+			group.rotation_y[lane_index] = quat_get_y(rotation);
+			group.rotation_z[lane_index] = quat_get_z(rotation);
+			group.rotation_w[lane_index] = quat_get_w(rotation);
+		}
+
+		void write_bone_translation(uint32_t bone_index, const acl::Vector4_32& translation)
+		{
+			ACL_ENSURE(bone_index < m_num_transforms, "Invalid bone index. %u >= %u", bone_index, m_num_transforms);
+			SoATransformGroup<NumLanes>& group = m_groups[bone_index / NumLanes];
+			const uint32_t lane_index = bone_index % NumLanes;
+			group.translation_x[lane_index] = vector_get_x(translation);
+			group.translation_y[lane_index] = vector_get_y(translation);
+			group.translation_z[lane_index] = vector_get_z(translation);
+		}
+
+		void write_bone_scale(uint32_t bone_index, const acl::Vector4_32& scale)
+		{
+			ACL_ENSURE(bone_index < m_num_transforms, "Invalid bone index. %u >= %u", bone_index, m_num_transforms);
+			SoATransformGroup<NumLanes>& group = m_groups[bone_index / NumLanes];
+			const uint32_t lane_index = bone_index % NumLanes;
+			group.scale_x[lane_index] = vector_get_x(scale);
+			group.scale_y[lane_index] = vector_get_y(scale);
+			group.scale_z[lane_index] = vector_get_z(scale);
+		}
+
+		constexpr bool requires_ordered_writes() const { return false; }
+		constexpr bool supports_soa_writes() const { return true; }
+
+		void write_bone_rotations_soa(const uint16_t* bone_indices, uint32_t num_lanes, const Vector4_32& x, const Vector4_32& y, const Vector4_32& z, const Vector4_32& w)
+		{
+			if (are_lanes_contiguous(bone_indices, num_lanes))
+			{
+				SoATransformGroup<NumLanes>& group = m_groups[bone_indices[0] / NumLanes];
+				const uint32_t lane_index = bone_indices[0] % NumLanes;
+				vector_aligned_write(x, &group.rotation_x[lane_index]);
+				vector_aligned_write(y, &group.rotation_y[lane_index]);
+				vector_aligned_write(z, &group.rotation_z[lane_index]);
+				vector_aligned_write(w, &group.rotation_w[lane_index]);
+				return;
+			}
+
+			alignas(16) float x_lanes[4];
+			alignas(16) float y_lanes[4];
+			alignas(16) float z_lanes[4];
+			alignas(16) float w_lanes[4];
+			vector_aligned_write(x, &x_lanes[0]);
+			vector_aligned_write(y, &y_lanes[0]);
+			vector_aligned_write(z, &z_lanes[0]);
+			vector_aligned_write(w, &w_lanes[0]);
+
+			for (uint32_t lane_index = 0; lane_index < num_lanes; ++lane_index)
+				write_bone_rotation(bone_indices[lane_index], quat_set(x_lanes[lane_index], y_lanes[lane_index], z_lanes[lane_index], w_lanes[lane_index]));
+		}
+
+		void write_bone_translations_soa(const uint16_t* bone_indices, uint32_t num_lanes, const Vector4_32& x, const Vector4_32& y, const Vector4_32& z)
+		{
+			if (are_lanes_contiguous(bone_indices, num_lanes))
+			{
+				SoATransformGroup<NumLanes>& group = m_groups[bone_indices[0] / NumLanes];
+				const uint32_t lane_index = bone_indices[0] % NumLanes;
+				vector_aligned_write(x, &group.translation_x[lane_index]);
+				vector_aligned_write(y, &group.translation_y[lane_index]);
+				vector_aligned_write(z, &group.translation_z[lane_index]);
+				return;
+			}
+
+			scatter_vectors(bone_indices, num_lanes, x, y, z, &SoAOutputWriter::write_bone_translation);
+		}
+
+		void write_bone_scales_soa(const uint16_t* bone_indices, uint32_t num_lanes, const Vector4_32& x, const Vector4_32& y, const Vector4_32& z)
+		{
+			if (are_lanes_contiguous(bone_indices, num_lanes))
+			{
+				SoATransformGroup<NumLanes>& group = m_groups[bone_indices[0] / NumLanes];
+				const uint32_t lane_index = bone_indices[0] % NumLanes;
+				vector_aligned_write(x, &group.scale_x[lane_index]);
+				vector_aligned_write(y, &group.scale_y[lane_index]);
+				vector_aligned_write(z, &group.scale_z[lane_index]);
+				return;
+			}
+
+			scatter_vectors(bone_indices, num_lanes, x, y, z, &SoAOutputWriter::write_bone_scale);
+		}
+
+		// A full batch of 4 consecutive bones starting on a 4 lane boundary maps to a single aligned write per component
+		bool are_lanes_contiguous(const uint16_t* bone_indices, uint32_t num_lanes) const
+		{
+			if (num_lanes != 4 || (bone_indices[0] % 4) != 0)
+				return false;
+
+			ACL_ENSURE(uint32_t(bone_indices[0]) + 3 < m_num_transforms, "Invalid bone index. %u >= %u", uint32_t(bone_indices[0]) + 3, m_num_transforms);
+			return bone_indices[1] == bone_indices[0] + 1 && bone_indices[2] == bone_indices[0] + 2 && bone_indices[3] == bone_indices[0] + 3;
+		}
+
+		void scatter_vectors(const uint16_t* bone_indices, uint32_t num_lanes, const Vector4_32& x, const Vector4_32& y, const Vector4_32& z, void (SoAOutputWriter::*write_fun)(uint32_t, const Vector4_32&))
+		{
+			alignas(16) float x_lanes[4];
+			alignas(16) float y_lanes[4];
+			alignas(16) float z_lanes[4];
+			vector_aligned_write(x, &x_lanes[0]);
+			vector_aligned_write(y, &y_lanes[0]);
+			vector_aligned_write(z, &z_lanes[0]);
+
+			for (uint32_t lane_index = 0; lane_index < num_lanes; ++lane_index)
+				(this->*write_fun)(bone_indices[lane_index], vector_set(x_lanes[lane_index], y_lanes[lane_index], z_lanes[lane_index]));
+		}
+
+		SoATransformGroup<NumLanes>* m_groups;
+		uint16_t m_num_transforms;
+	};
+}
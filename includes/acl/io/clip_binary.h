@@ -0,0 +1,127 @@
+#pragma once
+
+////////////////////////////////////////////////////////////////////////////////
+// The MIT License (MIT)
+//
+// Copyright (c) 2018 Nicholas Frechette & Animation Compression Library contributors
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+////////////////////////////////////////////////////////////////////////////////
+
+#include "acl/core/ptr_offset.h"
+
+#include <cstdint>
+#include <cstring>
+
+//////////////////////////////////////////////////////////////////////////
+// Binary raw clip format
+//
+// A memory mappable alternative to the SJSON ACL clip format meant to load
+// large clips quickly. Every value is stored with full 64 bit precision in
+// native endianness and track samples are aligned so that they can be used
+// in place without being copied or converted.
+//
+// Data format:
+//    ClipBinaryHeader
+//    ClipBinaryBone[num_bones]
+//    Track samples, each track is 16 byte aligned:
+//       for each bone: rotations (4 doubles per sample), translations (3), scales (3)
+//    Names, null terminated: clip name followed by every bone name
+//////////////////////////////////////////////////////////////////////////
+
+namespace acl
+{
+	constexpr uint32_t k_clip_binary_tag = 0x424C4341;	// 'ACLB'
+	constexpr uint32_t k_clip_binary_version = 1;
+	constexpr size_t k_clip_binary_alignment = 16;
+
+	struct ClipBinaryBone
+	{
+		double						bind_rotation[4];
+		double						bind_translation[3];
+		double						bind_scale[3];
+		double						vertex_distance;
+
+		// Offsets are relative to the start of the header
+		PtrOffset32<const char>		name_offset;
+		uint32_t					name_size;				// Without the null terminator
+		PtrOffset32<const double>	rotations_offset;
+		PtrOffset32<const double>	translations_offset;
+		PtrOffset32<const double>	scales_offset;
+		uint16_t					parent_index;
+		uint16_t					padding;
+	};
+
+	struct ClipBinaryHeader
+	{
+		uint32_t					tag;
+		uint32_t					version;
+		uint32_t					size;					// Total size including the header
+
+		uint32_t					num_samples;
+		uint32_t					sample_rate;
+		float						error_threshold;
+		uint16_t					num_bones;
+		uint16_t					padding;
+
+		// Offsets are relative to the start of the header
+		PtrOffset32<const char>		name_offset;
+		uint32_t					name_size;				// Without the null terminator
+		PtrOffset32<const ClipBinaryBone>	bones_offset;
+	};
+
+	enum class ClipBinaryError : uint8_t
+	{
+		None,
+		InvalidBuffer,
+		InvalidTag,
+		UnsupportedVersion,
+		InvalidSize,
+		InvalidOffset,
+		InvalidParentBone,
+		InvalidNumBones,
+	};
+
+	inline const char* get_clip_binary_error_description(ClipBinaryError error)
+	{
+		switch (error)
+		{
+		case ClipBinaryError::None:					return "No error";
+		case ClipBinaryError::InvalidBuffer:		return "The buffer is NULL or not aligned to 16 bytes";
+		case ClipBinaryError::InvalidTag:			return "The buffer does not contain a binary ACL clip";
+		case ClipBinaryError::UnsupportedVersion:	return "This library does not support this version of binary ACL clip";
+		case ClipBinaryError::InvalidSize:			return "The buffer is smaller than the size of the binary ACL clip";
+		case ClipBinaryError::InvalidOffset:		return "The binary ACL clip contains an offset out of bounds";
+		case ClipBinaryError::InvalidParentBone:	return "Bones must be sorted parent first";
+		case ClipBinaryError::InvalidNumBones:		return "The skeleton does not have the same number of bones as the binary ACL clip";
+		default:									return "<Invalid>";
+		}
+	}
+
+	// Returns true if the buffer starts with a binary ACL clip header
+	inline bool is_clip_binary(const void* buffer, size_t buffer_size)
+	{
+		if (buffer == nullptr || buffer_size < sizeof(uint32_t))
+			return false;
+
+		uint32_t tag;
+		std::memcpy(&tag, buffer, sizeof(uint32_t));
+		return tag == k_clip_binary_tag;
+	}
+}
@@ -0,0 +1,189 @@
+#pragma once
+
+////////////////////////////////////////////////////////////////////////////////
+// The MIT License (MIT)
+//
+// Copyright (c) 2018 Nicholas Frechette & Animation Compression Library contributors
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+////////////////////////////////////////////////////////////////////////////////
+
+#include "acl/io/clip_binary.h"
+#include "acl/compression/animation_clip.h"
+#include "acl/compression/skeleton.h"
+#include "acl/core/iallocator.h"
+#include "acl/core/memory_utils.h"
+#include "acl/core/string.h"
+#include "acl/core/unique_ptr.h"
+
+#include <cstdint>
+
+namespace acl
+{
+	//////////////////////////////////////////////////////////////////////////
+	// Reads a binary ACL clip from memory, typically a memory mapped file.
+	// The clip tracks reference the samples in place: the buffer must outlive
+	// the clip and the clip cannot be modified.
+	//////////////////////////////////////////////////////////////////////////
+	class ClipBinaryReader
+	{
+	public:
+		ClipBinaryReader(IAllocator& allocator, const void* buffer, size_t buffer_size)
+			: m_allocator(allocator)
+			, m_buffer(static_cast<const uint8_t*>(buffer))
+			, m_buffer_size(buffer_size)
+			, m_error(ClipBinaryError::None)
+		{
+		}
+
+		bool read(std::unique_ptr<RigidSkeleton, Deleter<RigidSkeleton>>& skeleton)
+		{
+			if (!validate())
+				return false;
+
+			const ClipBinaryHeader& header = get_header();
+			const ClipBinaryBone* binary_bones = header.bones_offset.add_to(m_buffer);
+
+			RigidBone* bones = allocate_type_array<RigidBone>(m_allocator, header.num_bones);
+
+			for (uint16_t bone_index = 0; bone_index < header.num_bones; ++bone_index)
+			{
+				const ClipBinaryBone& binary_bone = binary_bones[bone_index];
+				RigidBone& bone = bones[bone_index];
+
+				bone.name = String(m_allocator, binary_bone.name_offset.add_to(m_buffer), binary_bone.name_size);
+				bone.parent_index = binary_bone.parent_index;
+				bone.vertex_distance = binary_bone.vertex_distance;
+				bone.bind_transform.rotation = quat_unaligned_load(&binary_bone.bind_rotation[0]);
+				bone.bind_transform.translation = vector_unaligned_load3(&binary_bone.bind_translation[0]);
+				bone.bind_transform.scale = vector_unaligned_load3(&binary_bone.bind_scale[0]);
+			}
+
+			skeleton = make_unique<RigidSkeleton>(m_allocator, m_allocator, bones, header.num_bones);
+			deallocate_type_array(m_allocator, bones, header.num_bones);
+
+			return true;
+		}
+
+		bool read(std::unique_ptr<AnimationClip, Deleter<AnimationClip>>& clip, const RigidSkeleton& skeleton)
+		{
+			if (!validate())
+				return false;
+
+			const ClipBinaryHeader& header = get_header();
+			if (skeleton.get_num_bones() != header.num_bones)
+			{
+				m_error = ClipBinaryError::InvalidNumBones;
+				return false;
+			}
+
+			const ClipBinaryBone* binary_bones = header.bones_offset.add_to(m_buffer);
+
+			AnimatedBone* bones = allocate_type_array<AnimatedBone>(m_allocator, header.num_bones);
+
+			for (uint16_t bone_index = 0; bone_index < header.num_bones; ++bone_index)
+			{
+				const ClipBinaryBone& binary_bone = binary_bones[bone_index];
+				AnimatedBone& bone = bones[bone_index];
+
+				bone.rotation_track = AnimationRotationTrack(binary_bone.rotations_offset.add_to(m_buffer), header.num_samples, header.sample_rate);
+				bone.translation_track = AnimationTranslationTrack(binary_bone.translations_offset.add_to(m_buffer), header.num_samples, header.sample_rate);
+				bone.scale_track = AnimationScaleTrack(binary_bone.scales_offset.add_to(m_buffer), header.num_samples, header.sample_rate);
+			}
+
+			const String name(m_allocator, header.name_offset.add_to(m_buffer), header.name_size);
+			clip = make_unique<AnimationClip>(m_allocator, m_allocator, skeleton, header.num_samples, header.sample_rate, name, header.error_threshold, bones);
+			deallocate_type_array(m_allocator, bones, header.num_bones);
+
+			return true;
+		}
+
+		ClipBinaryError get_error() const { return m_error; }
+
+	private:
+		IAllocator& m_allocator;
+		const uint8_t* m_buffer;
+		size_t m_buffer_size;
+		ClipBinaryError m_error;
+
+		const ClipBinaryHeader& get_header() const { return *safe_ptr_cast<const ClipBinaryHeader>(m_buffer); }
+
+		bool is_range_valid(uint32_t offset, uint64_t size, size_t alignment) const
+		{
+			return is_aligned_to(offset, alignment) && (uint64_t(offset) + size) <= get_header().size;
+		}
+
+		bool is_name_valid(const PtrOffset32<const char>& offset, uint32_t name_size) const
+		{
+			// Names must be null terminated
+			return is_range_valid(offset, uint64_t(name_size) + 1, 1) && offset.add_to(m_buffer)[name_size] == '\0';
+		}
+
+		bool validate()
+		{
+			m_error = ClipBinaryError::None;
+
+			if (m_buffer == nullptr || !is_aligned_to(m_buffer, k_clip_binary_alignment))
+				m_error = ClipBinaryError::InvalidBuffer;
+			else if (m_buffer_size < sizeof(ClipBinaryHeader))
+				m_error = ClipBinaryError::InvalidSize;
+			else if (!is_clip_binary(m_buffer, m_buffer_size))
+				m_error = ClipBinaryError::InvalidTag;
+			else if (get_header().version != k_clip_binary_version)
+				m_error = ClipBinaryError::UnsupportedVersion;
+			else if (get_header().size > m_buffer_size || get_header().size < sizeof(ClipBinaryHeader))
+				m_error = ClipBinaryError::InvalidSize;
+
+			if (m_error != ClipBinaryError::None)
+				return false;
+
+			const ClipBinaryHeader& header = get_header();
+			if (!is_range_valid(header.bones_offset, uint64_t(sizeof(ClipBinaryBone)) * header.num_bones, alignof(ClipBinaryBone)) || !is_name_valid(header.name_offset, header.name_size))
+			{
+				m_error = ClipBinaryError::InvalidOffset;
+				return false;
+			}
+
+			const uint64_t num_samples = header.num_samples;
+			const ClipBinaryBone* binary_bones = header.bones_offset.add_to(m_buffer);
+			for (uint16_t bone_index = 0; bone_index < header.num_bones; ++bone_index)
+			{
+				const ClipBinaryBone& bone = binary_bones[bone_index];
+
+				const bool are_offsets_valid = is_range_valid(bone.rotations_offset, sizeof(double) * 4 * num_samples, k_clip_binary_alignment)
+					&& is_range_valid(bone.translations_offset, sizeof(double) * 3 * num_samples, k_clip_binary_alignment)
+					&& is_range_valid(bone.scales_offset, sizeof(double) * 3 * num_samples, k_clip_binary_alignment)
+					&& is_name_valid(bone.name_offset, bone.name_size);
+				if (!are_offsets_valid)
+				{
+					m_error = ClipBinaryError::InvalidOffset;
+					return false;
+				}
+
+				if (bone.parent_index != k_invalid_bone_index && bone.parent_index >= bone_index)
+				{
+					m_error = ClipBinaryError::InvalidParentBone;
+					return false;
+				}
+			}
+
+			return true;
+		}
+	};
+}
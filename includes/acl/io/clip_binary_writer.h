@@ -0,0 +1,191 @@
+#pragma once
+
+////////////////////////////////////////////////////////////////////////////////
+// The MIT License (MIT)
+//
+// Copyright (c) 2018 Nicholas Frechette & Animation Compression Library contributors
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+////////////////////////////////////////////////////////////////////////////////
+
+#include "acl/io/clip_binary.h"
+#include "acl/compression/animation_clip.h"
+#include "acl/compression/skeleton.h"
+#include "acl/core/iallocator.h"
+#include "acl/core/error.h"
+#include "acl/core/memory_utils.h"
+
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+
+namespace acl
+{
+	namespace impl
+	{
+		// Calculates the layout of the binary clip, the bones are optional
+		inline uint32_t calculate_clip_binary_layout(const RigidSkeleton& skeleton, const AnimationClip& clip, ClipBinaryHeader& out_header, ClipBinaryBone* out_bones)
+		{
+			const uint16_t num_bones = skeleton.get_num_bones();
+			const uint32_t num_samples = clip.get_num_samples();
+
+			size_t buffer_size = 0;
+			buffer_size += sizeof(ClipBinaryHeader);
+			buffer_size = align_to(buffer_size, alignof(ClipBinaryBone));
+			out_header.bones_offset = buffer_size;
+			buffer_size += sizeof(ClipBinaryBone) * num_bones;
+
+			for (uint16_t bone_index = 0; bone_index < num_bones; ++bone_index)
+			{
+				const size_t rotations_offset = align_to(buffer_size, k_clip_binary_alignment);
+				const size_t translations_offset = align_to(rotations_offset + sizeof(double) * 4 * num_samples, k_clip_binary_alignment);
+				const size_t scales_offset = align_to(translations_offset + sizeof(double) * 3 * num_samples, k_clip_binary_alignment);
+				buffer_size = scales_offset + sizeof(double) * 3 * num_samples;
+
+				if (out_bones != nullptr)
+				{
+					out_bones[bone_index].rotations_offset = rotations_offset;
+					out_bones[bone_index].translations_offset = translations_offset;
+					out_bones[bone_index].scales_offset = scales_offset;
+				}
+			}
+
+			out_header.name_offset = buffer_size;
+			out_header.name_size = safe_static_cast<uint32_t>(clip.get_name().size());
+			buffer_size += out_header.name_size + 1;
+
+			for (uint16_t bone_index = 0; bone_index < num_bones; ++bone_index)
+			{
+				const uint32_t name_size = safe_static_cast<uint32_t>(skeleton.get_bone(bone_index).name.size());
+
+				if (out_bones != nullptr)
+				{
+					out_bones[bone_index].name_offset = buffer_size;
+					out_bones[bone_index].name_size = name_size;
+				}
+
+				buffer_size += name_size + 1;
+			}
+
+			buffer_size = align_to(buffer_size, k_clip_binary_alignment);
+
+			out_header.tag = k_clip_binary_tag;
+			out_header.version = k_clip_binary_version;
+			out_header.size = safe_static_cast<uint32_t>(buffer_size);
+			out_header.num_samples = num_samples;
+			out_header.sample_rate = clip.get_sample_rate();
+			out_header.error_threshold = clip.get_error_threshold();
+			out_header.num_bones = num_bones;
+			out_header.padding = 0;
+
+			return out_header.size;
+		}
+	}
+
+	// Returns the number of bytes required to write the clip in the binary format
+	inline uint32_t get_acl_clip_binary_size(const RigidSkeleton& skeleton, const AnimationClip& clip)
+	{
+		ClipBinaryHeader header;
+		return impl::calculate_clip_binary_layout(skeleton, clip, header, nullptr);
+	}
+
+	// Writes the clip in the binary format into the provided buffer which must be 16 byte aligned
+	inline bool write_acl_clip_binary(const RigidSkeleton& skeleton, const AnimationClip& clip, void* buffer, size_t buffer_size)
+	{
+		if (ACL_TRY_ASSERT(buffer != nullptr && is_aligned_to(buffer, k_clip_binary_alignment), "'buffer' must be non-NULL and aligned to %u bytes", k_clip_binary_alignment))
+			return false;
+
+		if (ACL_TRY_ASSERT(skeleton.get_num_bones() == clip.get_num_bones(), "The skeleton and the clip bone count do not match: %u != %u", skeleton.get_num_bones(), clip.get_num_bones()))
+			return false;
+
+		const uint32_t clip_size = get_acl_clip_binary_size(skeleton, clip);
+		if (ACL_TRY_ASSERT(buffer_size >= clip_size, "'buffer' is too small: %u < %u", buffer_size, clip_size))
+			return false;
+
+		// Zero everything to keep the padding deterministic
+		std::memset(buffer, 0, clip_size);
+
+		uint8_t* clip_data = static_cast<uint8_t*>(buffer);
+		ClipBinaryHeader& header = *safe_ptr_cast<ClipBinaryHeader>(clip_data);
+		ClipBinaryBone* bones = add_offset_to_ptr<ClipBinaryBone>(clip_data, align_to(sizeof(ClipBinaryHeader), alignof(ClipBinaryBone)));
+
+		impl::calculate_clip_binary_layout(skeleton, clip, header, bones);
+		ACL_ASSERT(header.size == clip_size, "Unexpected binary clip size: %u != %u", header.size, clip_size);
+
+		const uint32_t num_samples = clip.get_num_samples();
+		for (uint16_t bone_index = 0; bone_index < header.num_bones; ++bone_index)
+		{
+			const RigidBone& rigid_bone = skeleton.get_bone(bone_index);
+			const AnimatedBone& animated_bone = clip.get_animated_bone(bone_index);
+			ClipBinaryBone& bone = bones[bone_index];
+
+			vector_unaligned_write(quat_to_vector(rigid_bone.bind_transform.rotation), &bone.bind_rotation[0]);
+			vector_unaligned_write3(rigid_bone.bind_transform.translation, &bone.bind_translation[0]);
+			vector_unaligned_write3(rigid_bone.bind_transform.scale, &bone.bind_scale[0]);
+			bone.vertex_distance = rigid_bone.vertex_distance;
+			bone.parent_index = rigid_bone.parent_index;
+
+			double* rotations = add_offset_to_ptr<double>(clip_data, uint32_t(bone.rotations_offset));
+			double* translations = add_offset_to_ptr<double>(clip_data, uint32_t(bone.translations_offset));
+			double* scales = add_offset_to_ptr<double>(clip_data, uint32_t(bone.scales_offset));
+
+			for (uint32_t sample_index = 0; sample_index < num_samples; ++sample_index)
+			{
+				vector_unaligned_write(quat_to_vector(animated_bone.rotation_track.get_sample(sample_index)), rotations + (sample_index * 4));
+				vector_unaligned_write3(animated_bone.translation_track.get_sample(sample_index), translations + (sample_index * 3));
+				vector_unaligned_write3(animated_bone.scale_track.get_sample(sample_index), scales + (sample_index * 3));
+			}
+
+			std::memcpy(add_offset_to_ptr<char>(clip_data, uint32_t(bone.name_offset)), rigid_bone.name.c_str(), bone.name_size);
+		}
+
+		std::memcpy(add_offset_to_ptr<char>(clip_data, uint32_t(header.name_offset)), clip.get_name().c_str(), header.name_size);
+
+		return true;
+	}
+
+	// Writes the clip in the binary format to the provided file
+	inline bool write_acl_clip_binary(IAllocator& allocator, const RigidSkeleton& skeleton, const AnimationClip& clip, const char* filename)
+	{
+		if (ACL_TRY_ASSERT(filename != nullptr, "'filename' cannot be NULL!"))
+			return false;
+
+		std::FILE* file = nullptr;
+#ifdef _WIN32
+		fopen_s(&file, filename, "wb");
+#else
+		file = fopen(filename, "wb");
+#endif
+
+		if (ACL_TRY_ASSERT(file != nullptr, "Failed to open binary ACL file for writing: %s", filename))
+			return false;
+
+		const uint32_t clip_size = get_acl_clip_binary_size(skeleton, clip);
+		uint8_t* buffer = allocate_type_array_aligned<uint8_t>(allocator, clip_size, k_clip_binary_alignment);
+
+		bool success = write_acl_clip_binary(skeleton, clip, buffer, clip_size);
+		if (success)
+			success = std::fwrite(buffer, 1, clip_size, file) == clip_size;
+
+		success = std::fclose(file) == 0 && success;
+
+		deallocate_type_array(allocator, buffer, clip_size);
+		return success;
+	}
+}
@@ -26,6 +26,14 @@
 
 //#define ACL_NO_INTRINSICS
 
+#if defined(__AVX2__) && !defined(ACL_NO_INTRINSICS)
+	#define ACL_AVX2_INTRINSICS
+	#define ACL_AVX_INTRINSICS
+	#define ACL_SSE4_INTRINSICS
+	#define ACL_SSE3_INTRINSICS
+	#define ACL_SSE2_INTRINSICS
+#endif
+
 #if defined(__AVX__) && !defined(ACL_NO_INTRINSICS)
 	#define ACL_AVX_INTRINSICS
 	#define ACL_SSE4_INTRINSICS
@@ -51,9 +59,14 @@
 #if !defined(ACL_SSE2_INTRINSICS) && !defined(ACL_NO_INTRINSICS)
 	#if defined(_M_IX86) || defined(_M_X64)
 		#define ACL_SSE2_INTRINSICS
-	//#elif defined(_M_ARM) || defined(_M_ARM64)
-		// TODO: Implement ARM NEON
-		//#define ACL_ARM_NEON_INTRINSICS
+	#elif defined(__ARM_NEON) || defined(__ARM_NEON__) || defined(_M_ARM) || defined(_M_ARM64)
+		// Results only match SSE2 when floating point contraction is disabled (e.g. -ffp-contract=off)
+		#define ACL_ARM_NEON_INTRINSICS
+
+		// AArch64 adds a true division, square root, and a few horizontal and lane operations
+		#if defined(__aarch64__) || defined(_M_ARM64)
+			#define ACL_ARM_NEON64_INTRINSICS
+		#endif
 	#else
 		#define ACL_NO_INTRINSICS
 	#endif
@@ -76,4 +89,12 @@
 	#include <immintrin.h>
 #endif
 
+#if defined(ACL_ARM_NEON_INTRINSICS)
+	#if defined(_M_ARM64)
+		#include <arm64_neon.h>
+	#else
+		#include <arm_neon.h>
+	#endif
+#endif
+
 #include "acl/math/math_types.h"
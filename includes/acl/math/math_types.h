@@ -46,6 +46,11 @@ namespace acl
 		__m128d zw;
 	};
 #else
+#if defined(ACL_ARM_NEON_INTRINSICS)
+	typedef float32x4_t Quat_32;
+	typedef float32x4_t Vector4_32;
+#endif
+
 	namespace math_impl
 	{
 		union Converter
@@ -78,6 +83,7 @@ namespace acl
 		}
 	}
 
+#if !defined(ACL_ARM_NEON_INTRINSICS)
 	struct Quat_32
 	{
 		float x;
@@ -93,6 +99,7 @@ namespace acl
 		float z;
 		float w;
 	};
+#endif
 
 	struct Quat_64
 	{
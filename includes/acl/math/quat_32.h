@@ -39,6 +39,9 @@ namespace acl
 	{
 #if defined(ACL_SSE2_INTRINSICS)
 		return Quat_32(_mm_set_ps(w, z, y, x));
+#elif defined(ACL_ARM_NEON_INTRINSICS)
+		const float data[4] = { x, y, z, w };
+		return vld1q_f32(&data[0]);
 #else
 		return Quat_32{ x, y, z, w };
 #endif
@@ -57,7 +60,7 @@ namespace acl
 
 	inline Quat_32 vector_to_quat(const Vector4_32& input)
 	{
-#if defined(ACL_SSE2_INTRINSICS)
+#if defined(ACL_SSE2_INTRINSICS) || defined(ACL_ARM_NEON_INTRINSICS)
 		return input;
 #else
 		return Quat_32{ input.x, input.y, input.z, input.w };
@@ -68,6 +71,8 @@ namespace acl
 	{
 #if defined(ACL_SSE2_INTRINSICS)
 		return _mm_shuffle_ps(_mm_cvtpd_ps(input.xy), _mm_cvtpd_ps(input.zw), _MM_SHUFFLE(1, 0, 1, 0));
+#elif defined(ACL_ARM_NEON_INTRINSICS)
+		return quat_set(float(input.x), float(input.y), float(input.z), float(input.w));
 #else
 		return Quat_32{ float(input.x), float(input.y), float(input.z), float(input.w) };
 #endif
@@ -77,6 +82,8 @@ namespace acl
 	{
 #if defined(ACL_SSE2_INTRINSICS)
 		return _mm_cvtss_f32(input);
+#elif defined(ACL_ARM_NEON_INTRINSICS)
+		return vgetq_lane_f32(input, 0);
 #else
 		return input.x;
 #endif
@@ -86,6 +93,8 @@ namespace acl
 	{
 #if defined(ACL_SSE2_INTRINSICS)
 		return _mm_cvtss_f32(_mm_shuffle_ps(input, input, _MM_SHUFFLE(1, 1, 1, 1)));
+#elif defined(ACL_ARM_NEON_INTRINSICS)
+		return vgetq_lane_f32(input, 1);
 #else
 		return input.y;
 #endif
@@ -95,6 +104,8 @@ namespace acl
 	{
 #if defined(ACL_SSE2_INTRINSICS)
 		return _mm_cvtss_f32(_mm_shuffle_ps(input, input, _MM_SHUFFLE(2, 2, 2, 2)));
+#elif defined(ACL_ARM_NEON_INTRINSICS)
+		return vgetq_lane_f32(input, 2);
 #else
 		return input.z;
 #endif
@@ -104,6 +115,8 @@ namespace acl
 	{
 #if defined(ACL_SSE2_INTRINSICS)
 		return _mm_cvtss_f32(_mm_shuffle_ps(input, input, _MM_SHUFFLE(3, 3, 3, 3)));
+#elif defined(ACL_ARM_NEON_INTRINSICS)
+		return vgetq_lane_f32(input, 3);
 #else
 		return input.w;
 #endif
@@ -179,6 +192,34 @@ namespace acl
 		Q2Y = _mm_add_ps(Q2Y, Q2Z);
 		vResult = _mm_add_ps(vResult, Q2Y);
 		return vResult;
+#elif defined(ACL_ARM_NEON_INTRINSICS)
+		// Same operation order as SSE2 to keep the results identical across platforms
+		const float32x4_t control_wzyx = vector_set(1.0f, -1.0f, 1.0f, -1.0f);
+		const float32x4_t control_zwxy = vector_set(1.0f, 1.0f, -1.0f, -1.0f);
+		const float32x4_t control_yxwz = vector_set(-1.0f, 1.0f, 1.0f, -1.0f);
+
+		const float32x2_t rhs_xy = vget_low_f32(rhs);
+		const float32x2_t rhs_zw = vget_high_f32(rhs);
+
+		// Retire Q1 and perform Q1*Q2W
+		float32x4_t result = vmulq_lane_f32(lhs, rhs_zw, 1);
+
+		// Mul by Q1WZYX and flip the signs on y and z
+		float32x4_t lhs_shuffle = vrev64q_f32(lhs);
+		lhs_shuffle = vcombine_f32(vget_high_f32(lhs_shuffle), vget_low_f32(lhs_shuffle));
+		const float32x4_t q2x = vmulq_f32(vmulq_lane_f32(lhs_shuffle, rhs_xy, 0), control_wzyx);
+
+		// Mul by Q1ZWXY and flip the signs on z and w
+		lhs_shuffle = vrev64q_f32(lhs_shuffle);
+		const float32x4_t q2y = vmulq_f32(vmulq_lane_f32(lhs_shuffle, rhs_xy, 1), control_zwxy);
+
+		// Mul by Q1YXWZ and flip the signs on x and w
+		lhs_shuffle = vrev64q_f32(lhs_shuffle);
+		lhs_shuffle = vcombine_f32(vget_high_f32(lhs_shuffle), vget_low_f32(lhs_shuffle));
+		const float32x4_t q2z = vmulq_f32(vmulq_lane_f32(lhs_shuffle, rhs_zw, 0), control_yxwz);
+
+		result = vaddq_f32(result, q2x);
+		return vaddq_f32(result, vaddq_f32(q2y, q2z));
 #else
 		float lhs_x = quat_get_x(lhs);
 		float lhs_y = quat_get_y(lhs);
@@ -261,6 +302,30 @@ namespace acl
 		return quat_set(vector_get_x(input), vector_get_y(input), vector_get_z(input), w);
 	}
 
+	// Returns the logarithm of a normalized quaternion: [x, y, z] = axis * (angle / 2) and W is 0
+	inline Vector4_32 quat_log(const Quat_32& input)
+	{
+		const float sin_half_angle = vector_length3(quat_to_vector(input));
+		const float half_angle = atan2(sin_half_angle, quat_get_w(input));
+
+		// Near the identity the axis is undefined and half_angle / sin(half_angle) tends towards 1.0
+		const float scale = sin_half_angle >= 1.0e-8f ? (half_angle / sin_half_angle) : 1.0f;
+		return vector_set(quat_get_x(input) * scale, quat_get_y(input) * scale, quat_get_z(input) * scale, 0.0f);
+	}
+
+	// Returns the normalized quaternion whose logarithm is [x, y, z], the W component is ignored
+	inline Quat_32 quat_exp(const Vector4_32& input)
+	{
+		const float half_angle = vector_length3(input);
+
+		float sin_half_angle;
+		float cos_half_angle;
+		sincos(half_angle, sin_half_angle, cos_half_angle);
+
+		const float scale = half_angle >= 1.0e-8f ? (sin_half_angle / half_angle) : 1.0f;
+		return quat_set(vector_get_x(input) * scale, vector_get_y(input) * scale, vector_get_z(input) * scale, cos_half_angle);
+	}
+
 	//////////////////////////////////////////////////////////////////////////
 	// Conversion to/from axis/angle/euler
 
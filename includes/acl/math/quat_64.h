@@ -67,6 +67,8 @@ namespace acl
 	{
 #if defined(ACL_SSE2_INTRINSICS)
 		return Quat_64{ _mm_cvtps_pd(input), _mm_cvtps_pd(_mm_shuffle_ps(input, input, _MM_SHUFFLE(3, 2, 3, 2))) };
+#elif defined(ACL_ARM_NEON_INTRINSICS)
+		return Quat_64{ double(vgetq_lane_f32(input, 0)), double(vgetq_lane_f32(input, 1)), double(vgetq_lane_f32(input, 2)), double(vgetq_lane_f32(input, 3)) };
 #else
 		return Quat_64{ double(input.x), double(input.y), double(input.z), double(input.w) };
 #endif
@@ -205,6 +207,30 @@ namespace acl
 		return quat_set(vector_get_x(input), vector_get_y(input), vector_get_z(input), w);
 	}
 
+	// Returns the logarithm of a normalized quaternion: [x, y, z] = axis * (angle / 2) and W is 0
+	inline Vector4_64 quat_log(const Quat_64& input)
+	{
+		const double sin_half_angle = vector_length3(quat_to_vector(input));
+		const double half_angle = atan2(sin_half_angle, quat_get_w(input));
+
+		// Near the identity the axis is undefined and half_angle / sin(half_angle) tends towards 1.0
+		const double scale = sin_half_angle >= 1.0e-8 ? (half_angle / sin_half_angle) : 1.0;
+		return vector_set(quat_get_x(input) * scale, quat_get_y(input) * scale, quat_get_z(input) * scale, 0.0);
+	}
+
+	// Returns the normalized quaternion whose logarithm is [x, y, z], the W component is ignored
+	inline Quat_64 quat_exp(const Vector4_64& input)
+	{
+		const double half_angle = vector_length3(input);
+
+		double sin_half_angle;
+		double cos_half_angle;
+		sincos(half_angle, sin_half_angle, cos_half_angle);
+
+		const double scale = half_angle >= 1.0e-8 ? (sin_half_angle / half_angle) : 1.0;
+		return quat_set(vector_get_x(input) * scale, vector_get_y(input) * scale, vector_get_z(input) * scale, cos_half_angle);
+	}
+
 	//////////////////////////////////////////////////////////////////////////
 	// Conversion to/from axis/angle/euler
 
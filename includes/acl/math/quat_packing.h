@@ -82,6 +82,114 @@ namespace acl
 		return quat_from_positive_w(rotation_xyz);
 	}
 
+	// The largest component is dropped and made positive, its index is stored in the top 2 bits.
+	// The remaining components lie in [-1/sqrt(2), 1/sqrt(2)] and are stored with 10 bits each.
+	inline void pack_quat_32_largest(const Quat_32& rotation, uint8_t* out_rotation_data)
+	{
+		const float components[4] = { quat_get_x(rotation), quat_get_y(rotation), quat_get_z(rotation), quat_get_w(rotation) };
+
+		uint32_t largest_index = 0;
+		for (uint32_t component_index = 1; component_index < 4; ++component_index)
+		{
+			if (abs(components[component_index]) > abs(components[largest_index]))
+				largest_index = component_index;
+		}
+
+		// q and -q represent the same rotation, flip it to make the dropped component positive
+		const float sign = components[largest_index] >= 0.0f ? 1.0f : -1.0f;
+		const float scale = sign * 1.41421356f;
+
+		uint32_t rotation_u32 = largest_index << 30;
+		uint32_t shift = 20;
+		for (uint32_t component_index = 0; component_index < 4; ++component_index)
+		{
+			if (component_index == largest_index)
+				continue;
+
+			const float component = clamp(components[component_index] * scale, -1.0f, 1.0f);
+			rotation_u32 |= pack_scalar_signed(component, 10) << shift;
+			shift -= 10;
+		}
+
+		// Written 2 bytes at a time to ensure safe alignment
+		uint16_t* data = safe_ptr_cast<uint16_t>(out_rotation_data);
+		data[0] = safe_static_cast<uint16_t>(rotation_u32 >> 16);
+		data[1] = safe_static_cast<uint16_t>(rotation_u32 & 0xFFFF);
+	}
+
+	inline Quat_32 unpack_quat_32_largest(const uint8_t* data_ptr)
+	{
+		// Read 2 bytes at a time to ensure safe alignment
+		const uint16_t* data_ptr_u16 = safe_ptr_cast<const uint16_t>(data_ptr);
+		const uint32_t rotation_u32 = (safe_static_cast<uint32_t>(data_ptr_u16[0]) << 16) | safe_static_cast<uint32_t>(data_ptr_u16[1]);
+
+		const uint32_t largest_index = rotation_u32 >> 30;
+		const float scale = 0.707106781f;
+
+		const float a = unpack_scalar_signed((rotation_u32 >> 20) & 0x3FF, 10) * scale;
+		const float b = unpack_scalar_signed((rotation_u32 >> 10) & 0x3FF, 10) * scale;
+		const float c = unpack_scalar_signed(rotation_u32 & 0x3FF, 10) * scale;
+
+		// Same operation order as quat_from_positive_w, the absolute value guards against rounding
+		const float largest = sqrt(abs(((1.0f - a * a) - b * b) - c * c));
+
+		switch (largest_index)
+		{
+		case 0:		return quat_set(largest, a, b, c);
+		case 1:		return quat_set(a, largest, b, c);
+		case 2:		return quat_set(a, b, largest, c);
+		default:	return quat_set(a, b, c, largest);
+		}
+	}
+
+	//////////////////////////////////////////////////////////////////////////
+	// The quaternion logarithm formats store the logarithm of the rotation with a positive W
+	// scaled by 2/PI, its length is then at most 1.0 and every component lies in [-1.0, 1.0]
+	// like with the drop W formats. Near W = 0, the rotation is more accurate than with drop W.
+
+	inline Vector4_32 quat_to_normalized_log(const Quat_32& rotation)
+	{
+		const Vector4_32 normalized_log = vector_mul(quat_log(quat_ensure_positive_w(rotation)), 2.0f / k_pi_32);
+
+		// Guard against rounding pushing a component past 1.0
+		return vector_min(vector_max(normalized_log, vector_set(-1.0f)), vector_set(1.0f));
+	}
+
+	inline Quat_32 quat_from_normalized_log(const Vector4_32& normalized_log)
+	{
+		return quat_exp(vector_mul(normalized_log, k_pi_32 * 0.5f));
+	}
+
+	inline void pack_quat_log_96(const Quat_32& rotation, uint8_t* out_rotation_data)
+	{
+		pack_vector3_96(quat_to_normalized_log(rotation), out_rotation_data);
+	}
+
+	inline Quat_32 unpack_quat_log_96(const uint8_t* data_ptr)
+	{
+		return quat_from_normalized_log(unpack_vector3_96(data_ptr));
+	}
+
+	inline void pack_quat_log_48(const Quat_32& rotation, uint8_t* out_rotation_data)
+	{
+		pack_vector3_48(quat_to_normalized_log(rotation), false, out_rotation_data);
+	}
+
+	inline Quat_32 unpack_quat_log_48(const uint8_t* data_ptr)
+	{
+		return quat_from_normalized_log(unpack_vector3_48(data_ptr, false));
+	}
+
+	inline void pack_quat_log_32(const Quat_32& rotation, uint8_t* out_rotation_data)
+	{
+		pack_vector3_32(quat_to_normalized_log(rotation), 11, 11, 10, false, out_rotation_data);
+	}
+
+	inline Quat_32 unpack_quat_log_32(const uint8_t* data_ptr)
+	{
+		return quat_from_normalized_log(unpack_vector3_32(11, 11, 10, false, data_ptr));
+	}
+
 	//////////////////////////////////////////////////////////////////////////
 
 	// TODO: constexpr
@@ -93,7 +201,12 @@ namespace acl
 		case RotationFormat8::QuatDropW_96:	return sizeof(float) * 3;
 		case RotationFormat8::QuatDropW_48:	return sizeof(uint16_t) * 3;
 		case RotationFormat8::QuatDropW_32:	return sizeof(uint32_t);
+		case RotationFormat8::Quat_32_Largest:	return sizeof(uint32_t);
+		case RotationFormat8::QuatLog_96:	return sizeof(float) * 3;
+		case RotationFormat8::QuatLog_48:	return sizeof(uint16_t) * 3;
+		case RotationFormat8::QuatLog_32:	return sizeof(uint32_t);
 		case RotationFormat8::QuatDropW_Variable:
+		case RotationFormat8::QuatLog_Variable:
 		default:
 			ACL_ENSURE(false, "Invalid or unsupported rotation format: %s", get_rotation_format_name(format));
 			return 0;
@@ -110,7 +223,13 @@ namespace acl
 		case RotationFormat8::QuatDropW_48:
 		case RotationFormat8::QuatDropW_32:
 		case RotationFormat8::QuatDropW_Variable:
+		case RotationFormat8::QuatLog_96:
+		case RotationFormat8::QuatLog_48:
+		case RotationFormat8::QuatLog_32:
+		case RotationFormat8::QuatLog_Variable:
 			return sizeof(float) * 6;
+		case RotationFormat8::Quat_32_Largest:
+			// The dropped component changes from sample to sample, it cannot be range reduced
 		default:
 			ACL_ENSURE(false, "Invalid or unsupported rotation format: %s", get_rotation_format_name(format));
 			return 0;
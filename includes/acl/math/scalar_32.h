@@ -26,32 +26,38 @@
 
 #include "acl/math/math.h"
 
-#include <algorithm>
 #include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <math.h>
 
 namespace acl
 {
 	// TODO: Get a higher precision number
 	constexpr float k_pi_32 = 3.141592654f;
 
+	// The C library functions are used instead of their std overloads: those are inline functions and the
+	// runtime dispatched decoder could end up calling a copy compiled for another instruction set
+
 	inline float floor(float input)
 	{
-		return std::floor(input);
+		return ::floorf(input);
 	}
 
 	inline float ceil(float input)
 	{
-		return std::ceil(input);
+		return ::ceilf(input);
 	}
 
 	inline float clamp(float input, float min, float max)
 	{
-		return std::min(std::max(input, min), max);
+		const float clamped_min = input < min ? min : input;
+		return max < clamped_min ? max : clamped_min;
 	}
 
 	inline float abs(float input)
 	{
-		return std::fabs(input);
+		return ::fabsf(input);
 	}
 
 	inline float sqrt(float input)
@@ -59,7 +65,7 @@ namespace acl
 #if defined(ACL_SSE2_INTRINSICS)
 		return _mm_cvtss_f32(_mm_sqrt_ss(_mm_set_ps1(input)));
 #else
-		return std::sqrt(input);
+		return ::sqrtf(input);
 #endif
 	}
 
@@ -83,6 +89,18 @@ namespace acl
 		x2 = _mm_add_ss(_mm_mul_ss(x1, x2), x1);
 
 		return _mm_cvtss_f32(x2);
+#elif defined(ACL_ARM_NEON_INTRINSICS)
+		// Perform two passes of Newton-Raphson iteration on the hardware estimate
+		float32x2_t input_v = vdup_n_f32(input);
+		float32x2_t x0 = vrsqrte_f32(input_v);
+
+		// First iteration
+		float32x2_t x1 = vmul_f32(x0, vrsqrts_f32(vmul_f32(input_v, x0), x0));
+
+		// Second iteration
+		float32x2_t x2 = vmul_f32(x1, vrsqrts_f32(vmul_f32(input_v, x1), x1));
+
+		return vget_lane_f32(x2, 0);
 #else
 		return 1.0f / sqrt(input);
 #endif
@@ -102,6 +120,18 @@ namespace acl
 		__m128 x2 = _mm_sub_ss(_mm_add_ss(x1, x1), _mm_mul_ss(input_v, _mm_mul_ss(x1, x1)));
 
 		return _mm_cvtss_f32(x2);
+#elif defined(ACL_ARM_NEON_INTRINSICS)
+		// Perform two passes of Newton-Raphson iteration on the hardware estimate
+		float32x2_t input_v = vdup_n_f32(input);
+		float32x2_t x0 = vrecpe_f32(input_v);
+
+		// First iteration
+		float32x2_t x1 = vmul_f32(x0, vrecps_f32(x0, input_v));
+
+		// Second iteration
+		float32x2_t x2 = vmul_f32(x1, vrecps_f32(x1, input_v));
+
+		return vget_lane_f32(x2, 0);
 #else
 		return 1.0f / input;
 #endif
@@ -109,12 +139,12 @@ namespace acl
 
 	inline float sin(float angle)
 	{
-		return std::sin(angle);
+		return ::sinf(angle);
 	}
 
 	inline float cos(float angle)
 	{
-		return std::cos(angle);
+		return ::cosf(angle);
 	}
 
 	inline void sincos(float angle, float& out_sin, float& out_cos)
@@ -125,22 +155,22 @@ namespace acl
 
 	inline float acos(float value)
 	{
-		return std::acos(value);
+		return ::acosf(value);
 	}
 
 	inline float atan2(float left, float right)
 	{
-		return std::atan2(left, right);
+		return ::atan2f(left, right);
 	}
 
 	inline float min(float left, float right)
 	{
-		return std::min(left, right);
+		return right < left ? right : left;
 	}
 
 	inline float max(float left, float right)
 	{
-		return std::max(left, right);
+		return left < right ? right : left;
 	}
 
 	constexpr float deg2rad(float deg)
@@ -155,7 +185,10 @@ namespace acl
 
 	inline bool is_finite(float input)
 	{
-		return std::isfinite(input);
+		// Infinities and NaNs have every exponent bit set
+		uint32_t input_bits;
+		std::memcpy(&input_bits, &input, sizeof(float));
+		return (input_bits & 0x7F800000) != 0x7F800000;
 	}
 
 	inline float symmetric_round(float input)
@@ -38,6 +38,9 @@ namespace acl
 	{
 #if defined(ACL_SSE2_INTRINSICS)
 		return Vector4_32(_mm_set_ps(w, z, y, x));
+#elif defined(ACL_ARM_NEON_INTRINSICS)
+		const float data[4] = { x, y, z, w };
+		return vld1q_f32(&data[0]);
 #else
 		return Vector4_32{ x, y, z, w };
 #endif
@@ -47,6 +50,9 @@ namespace acl
 	{
 #if defined(ACL_SSE2_INTRINSICS)
 		return Vector4_32(_mm_set_ps(0.0f, z, y, x));
+#elif defined(ACL_ARM_NEON_INTRINSICS)
+		const float data[4] = { x, y, z, 0.0f };
+		return vld1q_f32(&data[0]);
 #else
 		return Vector4_32{ x, y, z, 0.0f };
 #endif
@@ -56,6 +62,8 @@ namespace acl
 	{
 #if defined(ACL_SSE2_INTRINSICS)
 		return Vector4_32(_mm_set_ps1(xyzw));
+#elif defined(ACL_ARM_NEON_INTRINSICS)
+		return vdupq_n_f32(xyzw);
 #else
 		return Vector4_32{ xyzw, xyzw, xyzw, xyzw };
 #endif
@@ -94,7 +102,7 @@ namespace acl
 
 	inline Vector4_32 quat_to_vector(const Quat_32& input)
 	{
-#if defined(ACL_SSE2_INTRINSICS)
+#if defined(ACL_SSE2_INTRINSICS) || defined(ACL_ARM_NEON_INTRINSICS)
 		return input;
 #else
 		return Vector4_32{ input.x, input.y, input.z, input.w };
@@ -105,6 +113,8 @@ namespace acl
 	{
 #if defined(ACL_SSE2_INTRINSICS)
 		return _mm_shuffle_ps(_mm_cvtpd_ps(input.xy), _mm_cvtpd_ps(input.zw), _MM_SHUFFLE(1, 0, 1, 0));
+#elif defined(ACL_ARM_NEON_INTRINSICS)
+		return vector_set(float(input.x), float(input.y), float(input.z), float(input.w));
 #else
 		return Vector4_32{ float(input.x), float(input.y), float(input.z), float(input.w) };
 #endif
@@ -114,6 +124,8 @@ namespace acl
 	{
 #if defined(ACL_SSE2_INTRINSICS)
 		return _mm_cvtss_f32(input);
+#elif defined(ACL_ARM_NEON_INTRINSICS)
+		return vgetq_lane_f32(input, 0);
 #else
 		return input.x;
 #endif
@@ -123,6 +135,8 @@ namespace acl
 	{
 #if defined(ACL_SSE2_INTRINSICS)
 		return _mm_cvtss_f32(_mm_shuffle_ps(input, input, _MM_SHUFFLE(1, 1, 1, 1)));
+#elif defined(ACL_ARM_NEON_INTRINSICS)
+		return vgetq_lane_f32(input, 1);
 #else
 		return input.y;
 #endif
@@ -132,6 +146,8 @@ namespace acl
 	{
 #if defined(ACL_SSE2_INTRINSICS)
 		return _mm_cvtss_f32(_mm_shuffle_ps(input, input, _MM_SHUFFLE(2, 2, 2, 2)));
+#elif defined(ACL_ARM_NEON_INTRINSICS)
+		return vgetq_lane_f32(input, 2);
 #else
 		return input.z;
 #endif
@@ -141,6 +157,8 @@ namespace acl
 	{
 #if defined(ACL_SSE2_INTRINSICS)
 		return _mm_cvtss_f32(_mm_shuffle_ps(input, input, _MM_SHUFFLE(3, 3, 3, 3)));
+#elif defined(ACL_ARM_NEON_INTRINSICS)
+		return vgetq_lane_f32(input, 3);
 #else
 		return input.w;
 #endif
@@ -205,6 +223,22 @@ namespace acl
 		output[2] = vector_get_z(input);
 	}
 
+	// Writes all 4 components with a single store, 'output' must be aligned to 16 bytes
+	inline void vector_aligned_write(const Vector4_32& input, float* output)
+	{
+		ACL_ASSERT(is_aligned_to(output, 16), "Invalid alignment");
+#if defined(ACL_SSE2_INTRINSICS)
+		_mm_store_ps(output, input);
+#elif defined(ACL_ARM_NEON_INTRINSICS)
+		vst1q_f32(output, input);
+#else
+		output[0] = vector_get_x(input);
+		output[1] = vector_get_y(input);
+		output[2] = vector_get_z(input);
+		output[3] = vector_get_w(input);
+#endif
+	}
+
 	inline void vector_unaligned_write(const Vector4_32& input, uint8_t* output)
 	{
 		memcpy(output, &input, sizeof(Vector4_32));
@@ -222,6 +256,8 @@ namespace acl
 	{
 #if defined(ACL_SSE2_INTRINSICS)
 		return _mm_add_ps(lhs, rhs);
+#elif defined(ACL_ARM_NEON_INTRINSICS)
+		return vaddq_f32(lhs, rhs);
 #else
 		return vector_set(lhs.x + rhs.x, lhs.y + rhs.y, lhs.z + rhs.z, lhs.w + rhs.w);
 #endif
@@ -231,6 +267,8 @@ namespace acl
 	{
 #if defined(ACL_SSE2_INTRINSICS)
 		return _mm_sub_ps(lhs, rhs);
+#elif defined(ACL_ARM_NEON_INTRINSICS)
+		return vsubq_f32(lhs, rhs);
 #else
 		return vector_set(lhs.x - rhs.x, lhs.y - rhs.y, lhs.z - rhs.z, lhs.w - rhs.w);
 #endif
@@ -240,6 +278,8 @@ namespace acl
 	{
 #if defined(ACL_SSE2_INTRINSICS)
 		return _mm_mul_ps(lhs, rhs);
+#elif defined(ACL_ARM_NEON_INTRINSICS)
+		return vmulq_f32(lhs, rhs);
 #else
 		return vector_set(lhs.x * rhs.x, lhs.y * rhs.y, lhs.z * rhs.z, lhs.w * rhs.w);
 #endif
@@ -254,6 +294,12 @@ namespace acl
 	{
 #if defined(ACL_SSE2_INTRINSICS)
 		return _mm_div_ps(lhs, rhs);
+#elif defined(ACL_ARM_NEON64_INTRINSICS)
+		return vdivq_f32(lhs, rhs);
+#elif defined(ACL_ARM_NEON_INTRINSICS)
+		// ARMv7 has no vector division and the reciprocal estimate isn't exact, range normalization
+		// requires an exact result to remain within [0.0 .. 1.0] so we divide each lane instead
+		return vector_set(vector_get_x(lhs) / vector_get_x(rhs), vector_get_y(lhs) / vector_get_y(rhs), vector_get_z(lhs) / vector_get_z(rhs), vector_get_w(lhs) / vector_get_w(rhs));
 #else
 		return vector_set(lhs.x / rhs.x, lhs.y / rhs.y, lhs.z / rhs.z, lhs.w / rhs.w);
 #endif
@@ -263,6 +309,8 @@ namespace acl
 	{
 #if defined(ACL_SSE2_INTRINSICS)
 		return _mm_max_ps(lhs, rhs);
+#elif defined(ACL_ARM_NEON_INTRINSICS)
+		return vmaxq_f32(lhs, rhs);
 #else
 		return vector_set(max(lhs.x, rhs.x), max(lhs.y, rhs.y), max(lhs.z, rhs.z), max(lhs.w, rhs.w));
 #endif
@@ -272,6 +320,8 @@ namespace acl
 	{
 #if defined(ACL_SSE2_INTRINSICS)
 		return _mm_min_ps(lhs, rhs);
+#elif defined(ACL_ARM_NEON_INTRINSICS)
+		return vminq_f32(lhs, rhs);
 #else
 		return vector_set(min(lhs.x, rhs.x), min(lhs.y, rhs.y), min(lhs.z, rhs.z), min(lhs.w, rhs.w));
 #endif
@@ -281,6 +331,8 @@ namespace acl
 	{
 #if defined(ACL_SSE2_INTRINSICS)
 		return vector_max(vector_sub(_mm_setzero_ps(), input), input);
+#elif defined(ACL_ARM_NEON_INTRINSICS)
+		return vabsq_f32(input);
 #else
 		return vector_set(abs(input.x), abs(input.y), abs(input.z), abs(input.w));
 #endif
@@ -288,7 +340,11 @@ namespace acl
 
 	inline Vector4_32 vector_neg(const Vector4_32& input)
 	{
+#if defined(ACL_ARM_NEON_INTRINSICS)
+		return vnegq_f32(input);
+#else
 		return vector_mul(input, -1.0f);
+#endif
 	}
 
 	inline Vector4_32 vector_reciprocal(const Vector4_32& input)
@@ -303,12 +359,71 @@ namespace acl
 		// Second iteration
 		__m128 x2 = _mm_sub_ps(_mm_add_ps(x1, x1), _mm_mul_ps(input, _mm_mul_ps(x1, x1)));
 
+		return x2;
+#elif defined(ACL_ARM_NEON_INTRINSICS)
+		// Perform two passes of Newton-Raphson iteration on the hardware estimate
+		float32x4_t x0 = vrecpeq_f32(input);
+
+		// First iteration
+		float32x4_t x1 = vmulq_f32(x0, vrecpsq_f32(x0, input));
+
+		// Second iteration
+		float32x4_t x2 = vmulq_f32(x1, vrecpsq_f32(x1, input));
+
 		return x2;
 #else
 		return vector_div(vector_set(1.0f), input);
 #endif
 	}
 
+	inline Vector4_32 vector_sqrt(const Vector4_32& input)
+	{
+#if defined(ACL_SSE2_INTRINSICS)
+		return _mm_sqrt_ps(input);
+#elif defined(ACL_ARM_NEON64_INTRINSICS)
+		return vsqrtq_f32(input);
+#elif defined(ACL_ARM_NEON_INTRINSICS)
+		return vector_set(sqrt(vector_get_x(input)), sqrt(vector_get_y(input)), sqrt(vector_get_z(input)), sqrt(vector_get_w(input)));
+#else
+		return vector_set(sqrt(input.x), sqrt(input.y), sqrt(input.z), sqrt(input.w));
+#endif
+	}
+
+	inline Vector4_32 vector_sqrt_reciprocal(const Vector4_32& input)
+	{
+#if defined(ACL_SSE2_INTRINSICS)
+		// Perform two passes of Newton-Raphson iteration on the hardware estimate
+		__m128 half = _mm_set_ps1(0.5f);
+		__m128 input_half_v = _mm_mul_ps(input, half);
+		__m128 x0 = _mm_rsqrt_ps(input);
+
+		// First iteration
+		__m128 x1 = _mm_mul_ps(x0, x0);
+		x1 = _mm_sub_ps(half, _mm_mul_ps(input_half_v, x1));
+		x1 = _mm_add_ps(_mm_mul_ps(x0, x1), x0);
+
+		// Second iteration
+		__m128 x2 = _mm_mul_ps(x1, x1);
+		x2 = _mm_sub_ps(half, _mm_mul_ps(input_half_v, x2));
+		x2 = _mm_add_ps(_mm_mul_ps(x1, x2), x1);
+
+		return x2;
+#elif defined(ACL_ARM_NEON_INTRINSICS)
+		// Perform two passes of Newton-Raphson iteration on the hardware estimate
+		float32x4_t x0 = vrsqrteq_f32(input);
+
+		// First iteration
+		float32x4_t x1 = vmulq_f32(x0, vrsqrtsq_f32(vmulq_f32(input, x0), x0));
+
+		// Second iteration
+		float32x4_t x2 = vmulq_f32(x1, vrsqrtsq_f32(vmulq_f32(input, x1), x1));
+
+		return x2;
+#else
+		return vector_set(sqrt_reciprocal(input.x), sqrt_reciprocal(input.y), sqrt_reciprocal(input.z), sqrt_reciprocal(input.w));
+#endif
+	}
+
 	inline Vector4_32 vector_cross3(const Vector4_32& lhs, const Vector4_32& rhs)
 	{
 		return vector_set(vector_get_y(lhs) * vector_get_z(rhs) - vector_get_z(lhs) * vector_get_y(rhs),
@@ -328,6 +443,12 @@ namespace acl
 		__m128 y2w2_0_0_0 = _mm_shuffle_ps(x2z2_y2w2_0_0, x2z2_y2w2_0_0, _MM_SHUFFLE(0, 0, 0, 1));
 		__m128 x2y2z2w2_0_0_0 = _mm_add_ps(x2z2_y2w2_0_0, y2w2_0_0_0);
 		return _mm_cvtss_f32(x2y2z2w2_0_0_0);
+#elif defined(ACL_ARM_NEON_INTRINSICS)
+		// Same summation order as SSE2 to keep the results identical across platforms
+		float32x4_t x2_y2_z2_w2 = vmulq_f32(lhs, rhs);
+		float32x2_t x2z2_y2w2 = vadd_f32(vget_low_f32(x2_y2_z2_w2), vget_high_f32(x2_y2_z2_w2));
+		float32x2_t x2y2z2w2 = vpadd_f32(x2z2_y2w2, x2z2_y2w2);
+		return vget_lane_f32(x2y2z2w2, 0);
 #else
 		return (vector_get_x(lhs) * vector_get_x(rhs)) + (vector_get_y(lhs) * vector_get_y(rhs)) + (vector_get_z(lhs) * vector_get_z(rhs)) + (vector_get_w(lhs) * vector_get_w(rhs));
 #endif
@@ -345,6 +466,12 @@ namespace acl
 		__m128 z2_0_0_0 = _mm_shuffle_ps(x2_y2_z2_w2, x2_y2_z2_w2, _MM_SHUFFLE(0, 0, 0, 2));
 		__m128 x2y2z2_0_0_0 = _mm_add_ss(x2y2_0_0_0, z2_0_0_0);
 		return _mm_cvtss_f32(x2y2z2_0_0_0);
+#elif defined(ACL_ARM_NEON_INTRINSICS)
+		float32x4_t x2_y2_z2_w2 = vmulq_f32(lhs, rhs);
+		float32x2_t x2_y2 = vget_low_f32(x2_y2_z2_w2);
+		float32x2_t x2y2_x2y2 = vpadd_f32(x2_y2, x2_y2);
+		float32x2_t x2y2z2_x2y2w2 = vadd_f32(x2y2_x2y2, vget_high_f32(x2_y2_z2_w2));
+		return vget_lane_f32(x2y2z2_x2y2w2, 0);
 #else
 		return (vector_get_x(lhs) * vector_get_x(rhs)) + (vector_get_y(lhs) * vector_get_y(rhs)) + (vector_get_z(lhs) * vector_get_z(rhs));
 #endif
@@ -408,22 +535,53 @@ namespace acl
 	// output = (input * scale) + offset
 	inline Vector4_32 vector_mul_add(const Vector4_32& input, const Vector4_32& scale, const Vector4_32& offset)
 	{
+#if defined(ACL_ARM_NEON_INTRINSICS)
+		// Kept as a separate multiplication and addition to round like SSE2, this requires -ffp-contract=off
+		// or GCC and Clang are free to contract it into a fused 'fmla'
+		return vaddq_f32(vmulq_f32(input, scale), offset);
+#else
 		return vector_add(vector_mul(input, scale), offset);
+#endif
 	}
 
 	// output = offset - (input * scale)
 	inline Vector4_32 vector_neg_mul_sub(const Vector4_32& input, const Vector4_32& scale, const Vector4_32& offset)
 	{
+#if defined(ACL_ARM_NEON_INTRINSICS)
+		// Kept as a separate multiplication and subtraction to round like SSE2, 'vmlsq_f32' is free to fuse them on ARM64
+		return vsubq_f32(offset, vmulq_f32(input, scale));
+#else
 		return vector_sub(offset, vector_mul(input, scale));
+#endif
 	}
 
 	//////////////////////////////////////////////////////////////////////////
 	// Comparisons and masking
 
+#if defined(ACL_ARM_NEON_INTRINSICS)
+	namespace math_impl
+	{
+		// Gathers the top bit of every lane into the low 4 bits, equivalent to _mm_movemask_ps
+		inline uint32_t get_neon_movemask(uint32x4_t mask)
+		{
+			const int32_t shifts[4] = { 0, 1, 2, 3 };
+			const uint32x4_t lane_bits = vshlq_u32(vshrq_n_u32(mask, 31), vld1q_s32(&shifts[0]));
+#if defined(ACL_ARM_NEON64_INTRINSICS)
+			return vaddvq_u32(lane_bits);
+#else
+			const uint32x2_t pair_bits = vorr_u32(vget_low_u32(lane_bits), vget_high_u32(lane_bits));
+			return vget_lane_u32(vpadd_u32(pair_bits, pair_bits), 0);
+#endif
+		}
+	}
+#endif
+
 	inline Vector4_32 vector_less_than(const Vector4_32& lhs, const Vector4_32& rhs)
 	{
 #if defined(ACL_SSE2_INTRINSICS)
 		return _mm_cmplt_ps(lhs, rhs);
+#elif defined(ACL_ARM_NEON_INTRINSICS)
+		return vreinterpretq_f32_u32(vcltq_f32(lhs, rhs));
 #else
 		return Vector4_32{ math_impl::get_mask_value(lhs.x < rhs.x), math_impl::get_mask_value(lhs.y < rhs.y), math_impl::get_mask_value(lhs.z < rhs.z), math_impl::get_mask_value(lhs.w < rhs.w) };
 #endif
@@ -433,6 +591,8 @@ namespace acl
 	{
 #if defined(ACL_SSE2_INTRINSICS)
 		return _mm_cmpge_ps(lhs, rhs);
+#elif defined(ACL_ARM_NEON_INTRINSICS)
+		return vreinterpretq_f32_u32(vcgeq_f32(lhs, rhs));
 #else
 		return Vector4_32{ math_impl::get_mask_value(lhs.x >= rhs.x), math_impl::get_mask_value(lhs.y >= rhs.y), math_impl::get_mask_value(lhs.z >= rhs.z), math_impl::get_mask_value(lhs.w >= rhs.w) };
 #endif
@@ -442,6 +602,8 @@ namespace acl
 	{
 #if defined(ACL_SSE2_INTRINSICS)
 		return _mm_movemask_ps(_mm_cmplt_ps(lhs, rhs)) == 0xF;
+#elif defined(ACL_ARM_NEON_INTRINSICS)
+		return math_impl::get_neon_movemask(vcltq_f32(lhs, rhs)) == 0xF;
 #else
 		return lhs.x < rhs.x && lhs.y < rhs.y && lhs.z < rhs.z && lhs.w < rhs.w;
 #endif
@@ -451,6 +613,8 @@ namespace acl
 	{
 #if defined(ACL_SSE2_INTRINSICS)
 		return (_mm_movemask_ps(_mm_cmplt_ps(lhs, rhs)) & 0x7) == 0x7;
+#elif defined(ACL_ARM_NEON_INTRINSICS)
+		return (math_impl::get_neon_movemask(vcltq_f32(lhs, rhs)) & 0x7) == 0x7;
 #else
 		return lhs.x < rhs.x && lhs.y < rhs.y && lhs.z < rhs.z;
 #endif
@@ -460,6 +624,8 @@ namespace acl
 	{
 #if defined(ACL_SSE2_INTRINSICS)
 		return _mm_movemask_ps(_mm_cmplt_ps(lhs, rhs)) != 0;
+#elif defined(ACL_ARM_NEON_INTRINSICS)
+		return math_impl::get_neon_movemask(vcltq_f32(lhs, rhs)) != 0;
 #else
 		return lhs.x < rhs.x || lhs.y < rhs.y || lhs.z < rhs.z || lhs.w < rhs.w;
 #endif
@@ -469,6 +635,8 @@ namespace acl
 	{
 #if defined(ACL_SSE2_INTRINSICS)
 		return (_mm_movemask_ps(_mm_cmplt_ps(lhs, rhs)) & 0x7) != 0;
+#elif defined(ACL_ARM_NEON_INTRINSICS)
+		return (math_impl::get_neon_movemask(vcltq_f32(lhs, rhs)) & 0x7) != 0;
 #else
 		return lhs.x < rhs.x || lhs.y < rhs.y || lhs.z < rhs.z;
 #endif
@@ -478,6 +646,8 @@ namespace acl
 	{
 #if defined(ACL_SSE2_INTRINSICS)
 		return _mm_movemask_ps(_mm_cmple_ps(lhs, rhs)) == 0xF;
+#elif defined(ACL_ARM_NEON_INTRINSICS)
+		return math_impl::get_neon_movemask(vcleq_f32(lhs, rhs)) == 0xF;
 #else
 		return lhs.x <= rhs.x && lhs.y <= rhs.y && lhs.z <= rhs.z && lhs.w <= rhs.w;
 #endif
@@ -487,6 +657,8 @@ namespace acl
 	{
 #if defined(ACL_SSE2_INTRINSICS)
 		return (_mm_movemask_ps(_mm_cmple_ps(lhs, rhs)) & 0x7) == 0x7;
+#elif defined(ACL_ARM_NEON_INTRINSICS)
+		return (math_impl::get_neon_movemask(vcleq_f32(lhs, rhs)) & 0x7) == 0x7;
 #else
 		return lhs.x <= rhs.x && lhs.y <= rhs.y && lhs.z <= rhs.z;
 #endif
@@ -496,6 +668,8 @@ namespace acl
 	{
 #if defined(ACL_SSE2_INTRINSICS)
 		return _mm_movemask_ps(_mm_cmple_ps(lhs, rhs)) != 0;
+#elif defined(ACL_ARM_NEON_INTRINSICS)
+		return math_impl::get_neon_movemask(vcleq_f32(lhs, rhs)) != 0;
 #else
 		return lhs.x <= rhs.x || lhs.y <= rhs.y || lhs.z <= rhs.z || lhs.w <= rhs.w;
 #endif
@@ -505,6 +679,8 @@ namespace acl
 	{
 #if defined(ACL_SSE2_INTRINSICS)
 		return (_mm_movemask_ps(_mm_cmple_ps(lhs, rhs)) & 0x7) != 0;
+#elif defined(ACL_ARM_NEON_INTRINSICS)
+		return (math_impl::get_neon_movemask(vcleq_f32(lhs, rhs)) & 0x7) != 0;
 #else
 		return lhs.x <= rhs.x || lhs.y <= rhs.y || lhs.z <= rhs.z;
 #endif
@@ -514,6 +690,8 @@ namespace acl
 	{
 #if defined(ACL_SSE2_INTRINSICS)
 		return _mm_movemask_ps(_mm_cmpge_ps(lhs, rhs)) == 0xF;
+#elif defined(ACL_ARM_NEON_INTRINSICS)
+		return math_impl::get_neon_movemask(vcgeq_f32(lhs, rhs)) == 0xF;
 #else
 		return lhs.x >= rhs.x && lhs.y >= rhs.y && lhs.z >= rhs.z && lhs.w >= rhs.w;
 #endif
@@ -523,6 +701,8 @@ namespace acl
 	{
 #if defined(ACL_SSE2_INTRINSICS)
 		return (_mm_movemask_ps(_mm_cmpge_ps(lhs, rhs)) & 0x7) == 0x7;
+#elif defined(ACL_ARM_NEON_INTRINSICS)
+		return (math_impl::get_neon_movemask(vcgeq_f32(lhs, rhs)) & 0x7) == 0x7;
 #else
 		return lhs.x >= rhs.x && lhs.y >= rhs.y && lhs.z >= rhs.z;
 #endif
@@ -532,6 +712,8 @@ namespace acl
 	{
 #if defined(ACL_SSE2_INTRINSICS)
 		return _mm_movemask_ps(_mm_cmpge_ps(lhs, rhs)) != 0;
+#elif defined(ACL_ARM_NEON_INTRINSICS)
+		return math_impl::get_neon_movemask(vcgeq_f32(lhs, rhs)) != 0;
 #else
 		return lhs.x >= rhs.x || lhs.y >= rhs.y || lhs.z >= rhs.z || lhs.w >= rhs.w;
 #endif
@@ -541,6 +723,8 @@ namespace acl
 	{
 #if defined(ACL_SSE2_INTRINSICS)
 		return (_mm_movemask_ps(_mm_cmpge_ps(lhs, rhs)) & 0x7) != 0;
+#elif defined(ACL_ARM_NEON_INTRINSICS)
+		return (math_impl::get_neon_movemask(vcgeq_f32(lhs, rhs)) & 0x7) != 0;
 #else
 		return lhs.x >= rhs.x || lhs.y >= rhs.y || lhs.z >= rhs.z;
 #endif
@@ -583,6 +767,8 @@ namespace acl
 	{
 #if defined(ACL_SSE2_INTRINSICS)
 		return _mm_or_ps(_mm_andnot_ps(mask, if_false), _mm_and_ps(if_true, mask));
+#elif defined(ACL_ARM_NEON_INTRINSICS)
+		return vbslq_f32(vreinterpretq_u32_f32(mask), if_true, if_false);
 #else
 		return Vector4_32{ math_impl::select(mask.x, if_true.x, if_false.x), math_impl::select(mask.y, if_true.y, if_false.y), math_impl::select(mask.z, if_true.z, if_false.z), math_impl::select(mask.w, if_true.w, if_false.w) };
 #endif
@@ -636,6 +822,8 @@ namespace acl
 			// Low words from both inputs are interleaved
 #if defined(ACL_SSE2_INTRINSICS)
 			return _mm_unpacklo_ps(input0, input1);
+#elif defined(ACL_ARM_NEON_INTRINSICS)
+			return vzipq_f32(input0, input1).val[0];
 #else
 			return vector_set(vector_get_component(input0, comp0), vector_get_component(input1, comp1), vector_get_component(input0, comp2), vector_get_component(input1, comp3));
 #endif
@@ -646,6 +834,8 @@ namespace acl
 			// Low words from both inputs are interleaved
 #if defined(ACL_SSE2_INTRINSICS)
 			return _mm_unpacklo_ps(input1, input0);
+#elif defined(ACL_ARM_NEON_INTRINSICS)
+			return vzipq_f32(input1, input0).val[0];
 #else
 			return vector_set(vector_get_component(input1, comp0), vector_get_component(input0, comp1), vector_get_component(input1, comp2), vector_get_component(input0, comp3));
 #endif
@@ -656,6 +846,8 @@ namespace acl
 			// High words from both inputs are interleaved
 #if defined(ACL_SSE2_INTRINSICS)
 			return _mm_unpackhi_ps(input0, input1);
+#elif defined(ACL_ARM_NEON_INTRINSICS)
+			return vzipq_f32(input0, input1).val[1];
 #else
 			return vector_set(vector_get_component(input0, comp0), vector_get_component(input1, comp1), vector_get_component(input0, comp2), vector_get_component(input1, comp3));
 #endif
@@ -666,6 +858,8 @@ namespace acl
 			// High words from both inputs are interleaved
 #if defined(ACL_SSE2_INTRINSICS)
 			return _mm_unpackhi_ps(input1, input0);
+#elif defined(ACL_ARM_NEON_INTRINSICS)
+			return vzipq_f32(input1, input0).val[1];
 #else
 			return vector_set(vector_get_component(input1, comp0), vector_get_component(input0, comp1), vector_get_component(input1, comp2), vector_get_component(input0, comp3));
 #endif
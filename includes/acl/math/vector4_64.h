@@ -106,6 +106,8 @@ namespace acl
 	{
 #if defined(ACL_SSE2_INTRINSICS)
 		return Vector4_64{ _mm_cvtps_pd(input), _mm_cvtps_pd(_mm_shuffle_ps(input, input, _MM_SHUFFLE(3, 2, 3, 2))) };
+#elif defined(ACL_ARM_NEON_INTRINSICS)
+		return Vector4_64{ double(vgetq_lane_f32(input, 0)), double(vgetq_lane_f32(input, 1)), double(vgetq_lane_f32(input, 2)), double(vgetq_lane_f32(input, 3)) };
 #else
 		return Vector4_64{ double(input.x), double(input.y), double(input.z), double(input.w) };
 #endif
@@ -298,6 +300,16 @@ namespace acl
 		return vector_div(vector_set(1.0), input);
 	}
 
+	inline Vector4_64 vector_sqrt(const Vector4_64& input)
+	{
+		return vector_set(sqrt(vector_get_x(input)), sqrt(vector_get_y(input)), sqrt(vector_get_z(input)), sqrt(vector_get_w(input)));
+	}
+
+	inline Vector4_64 vector_sqrt_reciprocal(const Vector4_64& input)
+	{
+		return vector_div(vector_set(1.0), vector_sqrt(input));
+	}
+
 	inline Vector4_64 vector_cross3(const Vector4_64& lhs, const Vector4_64& rhs)
 	{
 		return vector_set(vector_get_y(lhs) * vector_get_z(rhs) - vector_get_z(lhs) * vector_get_y(rhs),
@@ -245,9 +245,55 @@ namespace acl
 		return vector_set(x, y, z);
 	}
 
+#if defined(ACL_AVX2_INTRINSICS)
+	namespace math_impl
+	{
+		// Loads the 64 bits that start at the byte holding each component, in XYZ order with W zeroed
+		inline __m256i load_vector3_n_u64(const uint8_t* vector_data, int32_t x_bit_offset, int32_t y_bit_offset, int32_t z_bit_offset)
+		{
+			const uint64_t x64 = unaligned_load<uint64_t>(vector_data + (x_bit_offset / 8));
+			const uint64_t y64 = unaligned_load<uint64_t>(vector_data + (y_bit_offset / 8));
+			const uint64_t z64 = unaligned_load<uint64_t>(vector_data + (z_bit_offset / 8));
+			return _mm256_set_epi64x(0, int64_t(z64), int64_t(y64), int64_t(x64));
+		}
+
+		// Extracts every component in place, they are never split over two 64 bit words since
+		// each component has its own load and we have at most 7 bits of offset within the first byte.
+		// The W shift is 64 which clears it.
+		inline __m256i extract_vector3_n_u64(__m256i vector_u64, int32_t x_bit_offset, int32_t y_bit_offset, int32_t z_bit_offset, uint8_t XBits, uint8_t YBits, uint8_t ZBits)
+		{
+			const __m256i byte_swap_mask = _mm256_setr_epi8(7, 6, 5, 4, 3, 2, 1, 0, 15, 14, 13, 12, 11, 10, 9, 8, 7, 6, 5, 4, 3, 2, 1, 0, 15, 14, 13, 12, 11, 10, 9, 8);
+			const __m256i shift_left = _mm256_set_epi64x(0, z_bit_offset % 8, y_bit_offset % 8, x_bit_offset % 8);
+			const __m256i shift_right = _mm256_set_epi64x(64, 64 - ZBits, 64 - YBits, 64 - XBits);
+
+			vector_u64 = _mm256_shuffle_epi8(vector_u64, byte_swap_mask);
+			vector_u64 = _mm256_sllv_epi64(vector_u64, shift_left);
+			return _mm256_srlv_epi64(vector_u64, shift_right);
+		}
+	}
+#endif
+
 	// Assumes the 'vector_data' is in big-endian order
 	inline Vector4_32 unpack_vector3_n(uint8_t XBits, uint8_t YBits, uint8_t ZBits, bool is_unsigned, const uint8_t* vector_data, int32_t bit_offset)
 	{
+#if defined(ACL_AVX2_INTRINSICS)
+		const int32_t y_bit_offset = bit_offset + XBits;
+		const int32_t z_bit_offset = y_bit_offset + YBits;
+
+		__m256i vector_u64 = math_impl::load_vector3_n_u64(vector_data, bit_offset, y_bit_offset, z_bit_offset);
+		vector_u64 = math_impl::extract_vector3_n_u64(vector_u64, bit_offset, y_bit_offset, z_bit_offset, XBits, YBits, ZBits);
+
+		// Every component fits in 32 bits, keep the low half of each lane
+		const __m128i vector_u32 = _mm256_castsi256_si128(_mm256_permutevar8x32_epi32(vector_u64, _mm256_setr_epi32(0, 2, 4, 6, 0, 2, 4, 6)));
+
+		// Same operations as 'unpack_scalar_unsigned' and 'unpack_scalar_signed' to keep the results identical
+		const __m128 max_value = _mm_set_ps(1.0f, safe_to_float((1 << ZBits) - 1), safe_to_float((1 << YBits) - 1), safe_to_float((1 << XBits) - 1));
+		__m128 value = _mm_div_ps(_mm_cvtepi32_ps(vector_u32), max_value);
+		if (!is_unsigned)
+			value = _mm_sub_ps(_mm_mul_ps(value, _mm_set_ps1(2.0f)), _mm_set_ps1(1.0f));
+
+		return _mm_blend_ps(value, _mm_setzero_ps(), 0x8);
+#else
 		uint8_t num_bits_to_read = XBits + YBits + ZBits;
 
 		int32_t byte_offset = bit_offset / 8;
@@ -278,6 +324,44 @@ namespace acl
 		const float y = is_unsigned ? unpack_scalar_unsigned(y32, YBits) : unpack_scalar_signed(y32, YBits);
 		const float z = is_unsigned ? unpack_scalar_unsigned(z32, ZBits) : unpack_scalar_signed(z32, ZBits);
 		return vector_set(x, y, z);
+#endif
+	}
+
+	// Unpacks two variable bit rate samples at once, each with its own number of bits per component and bit offset.
+	// Assumes the data is in big-endian order
+	inline void unpack_vector3_n_x2(uint8_t num_bits0, const uint8_t* vector_data0, int32_t bit_offset0, uint8_t num_bits1, const uint8_t* vector_data1, int32_t bit_offset1, bool is_unsigned, Vector4_32& out_vector0, Vector4_32& out_vector1)
+	{
+#if defined(ACL_AVX2_INTRINSICS)
+		const int32_t y_bit_offset0 = bit_offset0 + num_bits0;
+		const int32_t z_bit_offset0 = y_bit_offset0 + num_bits0;
+		const int32_t y_bit_offset1 = bit_offset1 + num_bits1;
+		const int32_t z_bit_offset1 = y_bit_offset1 + num_bits1;
+
+		__m256i vector0_u64 = math_impl::load_vector3_n_u64(vector_data0, bit_offset0, y_bit_offset0, z_bit_offset0);
+		__m256i vector1_u64 = math_impl::load_vector3_n_u64(vector_data1, bit_offset1, y_bit_offset1, z_bit_offset1);
+		vector0_u64 = math_impl::extract_vector3_n_u64(vector0_u64, bit_offset0, y_bit_offset0, z_bit_offset0, num_bits0, num_bits0, num_bits0);
+		vector1_u64 = math_impl::extract_vector3_n_u64(vector1_u64, bit_offset1, y_bit_offset1, z_bit_offset1, num_bits1, num_bits1, num_bits1);
+
+		// Interleave the low half of every lane as [x0 x1 y0 y1 z0 z1 w0 w1] and then reorder as [x0 y0 z0 w0 x1 y1 z1 w1]
+		const __m256i interleaved_u32 = _mm256_blend_epi32(vector0_u64, _mm256_slli_epi64(vector1_u64, 32), 0xAA);
+		const __m256i vectors_u32 = _mm256_permutevar8x32_epi32(interleaved_u32, _mm256_setr_epi32(0, 2, 4, 6, 1, 3, 5, 7));
+
+		// Same operations as 'unpack_scalar_unsigned' and 'unpack_scalar_signed' to keep the results identical
+		const float max_value0 = safe_to_float((1 << num_bits0) - 1);
+		const float max_value1 = safe_to_float((1 << num_bits1) - 1);
+		const __m256 max_values = _mm256_setr_ps(max_value0, max_value0, max_value0, 1.0f, max_value1, max_value1, max_value1, 1.0f);
+		__m256 values = _mm256_div_ps(_mm256_cvtepi32_ps(vectors_u32), max_values);
+		if (!is_unsigned)
+			values = _mm256_sub_ps(_mm256_mul_ps(values, _mm256_set1_ps(2.0f)), _mm256_set1_ps(1.0f));
+
+		values = _mm256_blend_ps(values, _mm256_setzero_ps(), 0x88);
+
+		out_vector0 = _mm256_castps256_ps128(values);
+		out_vector1 = _mm256_extractf128_ps(values, 1);
+#else
+		out_vector0 = unpack_vector3_n(num_bits0, num_bits0, num_bits0, is_unsigned, vector_data0, bit_offset0);
+		out_vector1 = unpack_vector3_n(num_bits1, num_bits1, num_bits1, is_unsigned, vector_data1, bit_offset1);
+#endif
 	}
 
 	//////////////////////////////////////////////////////////////////////////
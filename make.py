@@ -18,6 +18,7 @@ def parse_argv():
 	options['unit_test'] = False
 	options['regression_test'] = False
 	options['use_avx'] = False
+	options['use_avx2'] = False
 	options['compiler'] = None
 	options['config'] = 'Release'
 	options['cpu'] = 'x64'
@@ -42,6 +43,10 @@ def parse_argv():
 		if value == '-avx':
 			options['use_avx'] = True
 
+		if value == '-avx2':
+			options['use_avx'] = True
+			options['use_avx2'] = True
+
 		# TODO: Refactor to use the form: -compiler=vs2015
 		if value == '-vs2015':
 			options['compiler'] = 'vs2015'
@@ -84,6 +89,9 @@ def parse_argv():
 		if value == '-x64':
 			options['cpu'] = 'x64'
 
+		if value == '-arm64':
+			options['cpu'] = 'arm64'
+
 	# Sanitize and validate our options
 	if options['compiler'] == 'android':
 		options['cpu'] = 'armv7-a'
@@ -100,8 +108,21 @@ def parse_argv():
 			print('Unit tests cannot run from the command line on Android')
 			sys.exit(1)
 
+	if options['cpu'] == 'arm64':
+		if not platform.system() == 'Linux':
+			print('ARM64 is only supported on Linux')
+			sys.exit(1)
+
+		if options['use_avx']:
+			print('AVX is not supported on ARM64')
+			sys.exit(1)
+
 	return options
 
+def is_cross_compiling_arm64(options):
+	# On a non ARM64 host we cross compile and run the executables under qemu user mode emulation
+	return options['cpu'] == 'arm64' and not platform.machine() in ['aarch64', 'arm64']
+
 def get_cmake_exes():
 	if platform.system() == 'Windows':
 		return ('cmake.exe', 'ctest.exe')
@@ -168,7 +189,10 @@ def do_generate_solution(cmake_exe, build_dir, cmake_script_dir, options):
 	if not platform.system() == 'Windows':
 		extra_switches.append('-DCPU_INSTRUCTION_SET:STRING={}'.format(cpu))
 
-	if options['use_avx']:
+	if options['use_avx2']:
+		print('Enabling AVX2 usage')
+		extra_switches.append('-DUSE_AVX2_INSTRUCTIONS:BOOL=true')
+	elif options['use_avx']:
 		print('Enabling AVX usage')
 		extra_switches.append('-DUSE_AVX_INSTRUCTIONS:BOOL=true')
 
@@ -180,6 +204,9 @@ def do_generate_solution(cmake_exe, build_dir, cmake_script_dir, options):
 		if options['regression_test']:
 			extra_switches.append('-DREGRESSION_TESTING:BOOL=true')
 
+	if is_cross_compiling_arm64(options):
+		extra_switches.append('-DCMAKE_TOOLCHAIN_FILE={}'.format(os.path.join(cmake_script_dir, 'Toolchain-Linux-ARM64.cmake')))
+
 	# Generate IDE solution
 	print('Generating build files ...')
 	cmake_cmd = '"{}" .. -DCMAKE_INSTALL_PREFIX="{}" {}'.format(cmake_exe, build_dir, ' '.join(extra_switches))
@@ -371,6 +398,8 @@ def do_regression_tests(ctest_exe, test_data_dir, options):
 		failure_lock = threading.Lock()
 		for clip_filename in regression_clips:
 			cmd = '{} -acl="{}" -test -config="{}"'.format(compressor_exe_path, clip_filename, config_filename)
+			if is_cross_compiling_arm64(options):
+				cmd = 'qemu-aarch64 -L /usr/aarch64-linux-gnu {}'.format(cmd)
 			if platform.system() == 'Windows':
 				cmd = cmd.replace('/', '\\')
 
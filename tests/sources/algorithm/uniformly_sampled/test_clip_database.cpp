@@ -0,0 +1,195 @@
+////////////////////////////////////////////////////////////////////////////////
+// The MIT License (MIT)
+//
+// Copyright (c) 2018 Nicholas Frechette & Animation Compression Library contributors
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+////////////////////////////////////////////////////////////////////////////////
+
+#include <catch.hpp>
+
+#include "../../error_exceptions.h"
+#include "test_clip_utils.h"
+
+#include <acl/algorithm/uniformly_sampled/decoder.h>
+#include <acl/algorithm/uniformly_sampled/decoder_dispatch.h>
+#include <acl/compression/clip_database_builder.h>
+#include <acl/core/ansi_allocator.h>
+#include <acl/core/clip_database.h>
+#include <acl/core/pool_allocator.h>
+#include <acl/decompression/default_output_writer.h>
+
+#include <cstring>
+#include <vector>
+
+using namespace acl;
+using namespace acl::test_utils;
+using namespace acl::uniformly_sampled;
+
+TEST_CASE("clip database", "[algorithm][uniformly_sampled]")
+{
+	ANSIAllocator allocator;
+
+	constexpr uint16_t k_num_bones = 9;
+
+	SkeletonPtr skeleton = make_test_skeleton(allocator, k_num_bones);
+	SkeletonPtr small_skeleton = make_test_skeleton(allocator, 5);
+
+	// Clips authored on the same rig share their bitsets and constant track data
+	AnimationClipPtr clips[] =
+	{
+		make_test_clip(allocator, *skeleton, 31),
+		make_test_clip(allocator, *skeleton, 45),
+		make_test_clip(allocator, *skeleton, 60),
+		make_test_clip(allocator, *small_skeleton, 20),
+	};
+	const RigidSkeleton* clip_skeletons[] = { skeleton.get(), skeleton.get(), skeleton.get(), small_skeleton.get() };
+	const char* names[] = { "walk", "run", "idle", "small_walk", "variable_walk" };
+
+	std::vector<CompressedClipPtr> compressed_clips;
+	compressed_clips.push_back(compress_test_clip(allocator, *clips[0], *clip_skeletons[0], make_fixed_compression_settings()));
+	compressed_clips.push_back(compress_test_clip(allocator, *clips[1], *clip_skeletons[1], make_fixed_compression_settings()));
+	compressed_clips.push_back(compress_test_clip(allocator, *clips[2], *clip_skeletons[2], make_fixed_compression_settings()));
+	compressed_clips.push_back(compress_test_clip(allocator, *clips[3], *clip_skeletons[3], make_fixed_compression_settings()));
+	compressed_clips.push_back(compress_test_clip(allocator, *clips[0], *clip_skeletons[0], make_variable_compression_settings()));
+
+	const uint32_t num_clips = uint32_t(compressed_clips.size());
+	std::vector<const CompressedClip*> compressed_clip_ptrs;
+	for (const CompressedClipPtr& compressed_clip : compressed_clips)
+		compressed_clip_ptrs.push_back(compressed_clip.get());
+
+	ClipDatabase* built_database = build_clip_database(allocator, compressed_clip_ptrs.data(), names, num_clips);
+	REQUIRE(built_database != nullptr);
+	REQUIRE(built_database->is_valid(true));
+	REQUIRE(built_database->get_num_clips() == num_clips);
+
+	// The database is relocatable, use a copy as if it had been loaded from disk
+	const uint32_t database_size = built_database->get_size();
+	uint8_t* database_buffer = allocate_type_array_aligned<uint8_t>(allocator, database_size, alignof(ClipDatabase));
+	std::memcpy(database_buffer, built_database, database_size);
+	allocator.deallocate(built_database, database_size);
+
+	const ClipDatabase& database = *safe_ptr_cast<const ClipDatabase>(database_buffer);
+	REQUIRE(database.is_valid(true));
+
+	// Every clip on the same rig uses the same shared data
+	const uint32_t walk_index = database.find_clip("walk");
+	const uint32_t run_index = database.find_clip("run");
+	const uint32_t idle_index = database.find_clip("idle");
+	REQUIRE(walk_index != k_invalid_clip_index);
+	REQUIRE(run_index != k_invalid_clip_index);
+	REQUIRE(idle_index != k_invalid_clip_index);
+	REQUIRE(database.get_default_tracks_bitset(walk_index) == database.get_default_tracks_bitset(run_index));
+	REQUIRE(database.get_default_tracks_bitset(walk_index) == database.get_default_tracks_bitset(idle_index));
+	REQUIRE(database.get_constant_tracks_bitset(walk_index) == database.get_constant_tracks_bitset(run_index));
+	REQUIRE(database.get_constant_track_data(walk_index) == database.get_constant_track_data(idle_index));
+
+	// Each clip only keeps its animated data, we must store less shared data than what we removed
+	uint32_t total_stripped_size = 0;
+	for (uint32_t clip_index = 0; clip_index < num_clips; ++clip_index)
+		total_stripped_size += compressed_clips[clip_index]->get_size() - database.get_clip(database.find_clip(names[clip_index])).get_size();
+	REQUIRE(database.get_shared_data_size() < total_stripped_size);
+
+	REQUIRE(database.find_clip("jump") == k_invalid_clip_index);
+	REQUIRE(database.find_clip("walk_") == k_invalid_clip_index);
+
+	DecompressionSettings settings;
+
+	for (uint32_t clip_index = 0; clip_index < num_clips; ++clip_index)
+	{
+		const CompressedClip& compressed_clip = *compressed_clips[clip_index];
+		const AnimationClip& clip = *clips[clip_index % 4];
+		const uint16_t num_bones = clip.get_num_bones();
+
+		const uint32_t database_clip_index = database.find_clip(names[clip_index]);
+		REQUIRE(database_clip_index != k_invalid_clip_index);
+		REQUIRE(database.find_clip_by_hash(compressed_clip.get_hash()) == database_clip_index);
+		REQUIRE(std::strcmp(database.get_clip_name(database_clip_index), names[clip_index]) == 0);
+
+		const CompressedClip& database_clip = database.get_clip(database_clip_index);
+		REQUIRE(database_clip.is_valid(true));
+		REQUIRE(database_clip.get_size() < compressed_clip.get_size());
+
+		// The clip doesn't contain its bitsets and constant track data anymore, only the database overloads can find them
+		REQUIRE_THROWS(allocate_decompression_context(allocator, settings, database_clip));
+		REQUIRE_THROWS(allocate_shared_decompression_context(allocator, settings, database_clip));
+		REQUIRE_THROWS(allocate_track_offset_index(allocator, settings, database_clip));
+
+		void* reference_context = allocate_decompression_context(allocator, settings, compressed_clip);
+		void* database_context = allocate_decompression_context(allocator, settings, database, database_clip_index);
+
+		void* shared_context = allocate_shared_decompression_context(allocator, settings, database, database_clip_index);
+		PoolAllocator pool_allocator(allocator, get_instance_decompression_context_size(), get_instance_decompression_context_alignment());
+		void* instance_context = allocate_instance_decompression_context(pool_allocator);
+
+#if defined(ACL_TEST_DECODER_DISPATCH)
+		REQUIRE_THROWS(allocate_dispatched_decompression_context(allocator, database_clip));
+		void* dispatched_context = allocate_dispatched_decompression_context(allocator, database, database_clip_index);
+#endif
+
+		TrackOffsetIndex* index = allocate_track_offset_index(allocator, settings, database, database_clip_index);
+		set_track_offset_index(database_context, index);
+
+		std::vector<Transform_32> reference_transforms(num_bones);
+		std::vector<Transform_32> database_transforms(num_bones);
+		DefaultOutputWriter reference_writer(reference_transforms.data(), num_bones);
+		DefaultOutputWriter database_writer(database_transforms.data(), num_bones);
+
+		const float clip_duration = clip.get_duration();
+		const uint32_t num_sample_times = clip.get_num_samples() * 2;
+		for (uint32_t sample_index = 0; sample_index < num_sample_times; ++sample_index)
+		{
+			const float sample_time = clip_duration * float(sample_index) / float(num_sample_times - 1);
+
+			decompress_pose(settings, compressed_clip, reference_context, sample_time, reference_writer);
+			decompress_pose(settings, database_clip, database_context, sample_time, database_writer);
+
+			require_pose_near_equal(database_transforms.data(), reference_transforms.data(), num_bones);
+
+			decompress_pose(settings, database_clip, shared_context, instance_context, sample_time, database_writer);
+			require_pose_near_equal(database_transforms.data(), reference_transforms.data(), num_bones);
+
+#if defined(ACL_TEST_DECODER_DISPATCH)
+			decompress_pose_dispatched(database_clip, dispatched_context, sample_time, database_transforms.data(), num_bones);
+			require_pose_near_equal(database_transforms.data(), reference_transforms.data(), num_bones);
+#endif
+
+			const uint16_t sample_bone_index = uint16_t(sample_index % num_bones);
+			Quat_32 rotation;
+			Vector4_32 translation;
+			Vector4_32 scale;
+			decompress_bone(settings, database_clip, database_context, sample_time, sample_bone_index, &rotation, &translation, &scale);
+
+			REQUIRE(quat_near_equal(rotation, reference_transforms[sample_bone_index].rotation));
+			REQUIRE(vector_all_near_equal3(translation, reference_transforms[sample_bone_index].translation));
+			REQUIRE(vector_all_near_equal3(scale, reference_transforms[sample_bone_index].scale));
+		}
+
+#if defined(ACL_TEST_DECODER_DISPATCH)
+		deallocate_dispatched_decompression_context(allocator, dispatched_context);
+#endif
+		deallocate_instance_decompression_context(pool_allocator, instance_context);
+		deallocate_shared_decompression_context(allocator, shared_context);
+		deallocate_track_offset_index(allocator, index);
+		deallocate_decompression_context(allocator, database_context);
+		deallocate_decompression_context(allocator, reference_context);
+	}
+
+	deallocate_type_array(allocator, database_buffer, database_size);
+}
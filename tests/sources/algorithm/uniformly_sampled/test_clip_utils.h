@@ -0,0 +1,259 @@
+#pragma once
+
+////////////////////////////////////////////////////////////////////////////////
+// The MIT License (MIT)
+//
+// Copyright (c) 2017 Nicholas Frechette & Animation Compression Library contributors
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+////////////////////////////////////////////////////////////////////////////////
+
+#include <catch.hpp>
+
+#include "../../error_exceptions.h"
+#include <acl/algorithm/uniformly_sampled/decoder.h>
+#include <acl/algorithm/uniformly_sampled/encoder.h>
+#include <acl/compression/skeleton_error_metric.h>
+#include <acl/core/unique_ptr.h>
+#include <acl/decompression/default_output_writer.h>
+
+#include <cmath>
+#include <memory>
+#include <vector>
+
+// Shared by the uniformly sampled tests to build and compress small synthetic clips
+namespace acl
+{
+	namespace test_utils
+	{
+		using SkeletonPtr = std::unique_ptr<RigidSkeleton, Deleter<RigidSkeleton>>;
+		using AnimationClipPtr = std::unique_ptr<AnimationClip, Deleter<AnimationClip>>;
+
+		struct CompressedClipDeleter
+		{
+			void operator()(CompressedClip* compressed_clip) const { allocator->deallocate(compressed_clip, compressed_clip->get_size()); }
+			IAllocator* allocator;
+		};
+
+		using CompressedClipPtr = std::unique_ptr<CompressedClip, CompressedClipDeleter>;
+
+		// A synthetic clip along with the skeleton it animates
+		struct TestClip
+		{
+			SkeletonPtr skeleton;
+			AnimationClipPtr clip;
+		};
+
+		inline SkeletonPtr make_test_skeleton(IAllocator& allocator, uint16_t num_bones)
+		{
+			std::vector<RigidBone> bones(num_bones);
+			for (uint16_t bone_index = 0; bone_index < num_bones; ++bone_index)
+			{
+				bones[bone_index].parent_index = bone_index == 0 ? k_invalid_bone_index : uint16_t(bone_index - 1);
+				bones[bone_index].vertex_distance = 3.0;
+			}
+
+			return make_unique<RigidSkeleton>(allocator, allocator, bones.data(), num_bones);
+		}
+
+		// Bones cycle through every track type: animated, default, and constant
+		inline AnimationClipPtr make_test_clip(IAllocator& allocator, const RigidSkeleton& skeleton, uint32_t num_samples)
+		{
+			constexpr uint32_t k_sample_rate = 30;
+
+			AnimationClipPtr clip = make_unique<AnimationClip>(allocator, allocator, skeleton, num_samples, k_sample_rate, String(allocator, "test_clip"), 0.0001f);
+			AnimatedBone* bones = clip->get_bones();
+
+			for (uint16_t bone_index = 0; bone_index < skeleton.get_num_bones(); ++bone_index)
+			{
+				AnimatedBone& bone = bones[bone_index];
+				const uint32_t track_pattern = bone_index % 4;
+				const double bone_phase = double(bone_index) * 0.37;
+
+				for (uint32_t sample_index = 0; sample_index < num_samples; ++sample_index)
+				{
+					const double time = double(sample_index) / double(k_sample_rate);
+					const double animated_angle = bone_phase + std::sin(time * 2.3 + bone_phase) * 1.2;
+
+					Quat_64 rotation;
+					Vector4_64 translation;
+					Vector4_64 scale;
+
+					switch (track_pattern)
+					{
+					default:
+					case 0:	// Everything is animated
+						rotation = quat_from_euler(animated_angle, animated_angle * 0.5, bone_phase);
+						translation = vector_set(std::cos(time + bone_phase) * 4.0, 1.5 + time * 0.25, bone_phase);
+						scale = vector_set(1.0 + std::sin(time * 3.1) * 0.2, 1.0, 1.0 + bone_phase * 0.01);
+						break;
+					case 1:	// Everything is default
+						rotation = quat_identity_64();
+						translation = vector_zero_64();
+						scale = vector_set(1.0);
+						break;
+					case 2:	// Everything is constant
+						rotation = quat_from_euler(bone_phase, 0.25, -bone_phase);
+						translation = vector_set(bone_phase, 2.0, -1.0);
+						scale = vector_set(1.5, 1.5, 1.5);
+						break;
+					case 3:	// Mixed
+						rotation = quat_from_euler(0.1, animated_angle, 0.2);
+						translation = vector_zero_64();
+						scale = vector_set(2.0, 2.0 + std::cos(time) * 0.5, 2.0);
+						break;
+					}
+
+					bone.rotation_track.set_sample(sample_index, rotation);
+					bone.translation_track.set_sample(sample_index, translation);
+					bone.scale_track.set_sample(sample_index, scale);
+				}
+			}
+
+			return clip;
+		}
+
+		inline TestClip make_test_clip(IAllocator& allocator, uint16_t num_bones, uint32_t num_samples)
+		{
+			TestClip test_clip;
+			test_clip.skeleton = make_test_skeleton(allocator, num_bones);
+			test_clip.clip = make_test_clip(allocator, *test_clip.skeleton, num_samples);
+			return test_clip;
+		}
+
+		inline CompressedClipPtr compress_test_clip(IAllocator& allocator, IAllocator& scratch_allocator, const AnimationClip& clip, const RigidSkeleton& skeleton, CompressionSettings settings)
+		{
+			TransformErrorMetric error_metric;
+			settings.error_metric = &error_metric;
+
+			OutputStats stats;
+			CompressedClip* compressed_clip = uniformly_sampled::compress_clip(allocator, scratch_allocator, clip, skeleton, settings, stats);
+			REQUIRE(compressed_clip != nullptr);
+			REQUIRE(compressed_clip->is_valid(true));
+
+			return CompressedClipPtr(compressed_clip, CompressedClipDeleter{ &allocator });
+		}
+
+		inline CompressedClipPtr compress_test_clip(IAllocator& allocator, const AnimationClip& clip, const RigidSkeleton& skeleton, CompressionSettings settings)
+		{
+			return compress_test_clip(allocator, allocator, clip, skeleton, settings);
+		}
+
+		inline CompressedClipPtr compress_test_clip(IAllocator& allocator, IAllocator& scratch_allocator, const TestClip& test_clip, CompressionSettings settings)
+		{
+			return compress_test_clip(allocator, scratch_allocator, *test_clip.clip, *test_clip.skeleton, settings);
+		}
+
+		inline CompressedClipPtr compress_test_clip(IAllocator& allocator, const TestClip& test_clip, CompressionSettings settings)
+		{
+			return compress_test_clip(allocator, allocator, test_clip, settings);
+		}
+
+		inline CompressionSettings make_fixed_compression_settings()
+		{
+			CompressionSettings settings;
+			settings.rotation_format = RotationFormat8::QuatDropW_48;
+			settings.translation_format = VectorFormat8::Vector3_48;
+			settings.scale_format = VectorFormat8::Vector3_48;
+			settings.range_reduction = RangeReductionFlags8::Rotations | RangeReductionFlags8::Translations | RangeReductionFlags8::Scales;
+			return settings;
+		}
+
+		inline CompressionSettings make_variable_compression_settings()
+		{
+			CompressionSettings settings;
+			settings.rotation_format = RotationFormat8::QuatDropW_Variable;
+			settings.translation_format = VectorFormat8::Vector3_Variable;
+			settings.scale_format = VectorFormat8::Vector3_Variable;
+			settings.range_reduction = RangeReductionFlags8::Rotations | RangeReductionFlags8::Translations | RangeReductionFlags8::Scales;
+			settings.segmenting.enabled = true;
+			settings.segmenting.range_reduction = RangeReductionFlags8::Rotations | RangeReductionFlags8::Translations | RangeReductionFlags8::Scales;
+			return settings;
+		}
+
+		// Small segments leave plenty of segment boundaries to cross
+		inline CompressionSettings make_segmented_compression_settings()
+		{
+			CompressionSettings settings = make_variable_compression_settings();
+			settings.segmenting.ideal_num_samples = 8;
+			settings.segmenting.max_num_samples = 15;
+			return settings;
+		}
+
+		// Opts into the structure of arrays path, it is off by default
+		struct SoADecompressionSettings : public uniformly_sampled::DecompressionSettings
+		{
+			constexpr bool supports_soa_decompression() const { return true; }
+		};
+
+		inline void require_transform_near_equal(const Transform_32& transform, const Transform_32& reference, float threshold = 0.00001f)
+		{
+			REQUIRE(quat_near_equal(transform.rotation, reference.rotation, threshold));
+			REQUIRE(vector_all_near_equal3(transform.translation, reference.translation, threshold));
+			REQUIRE(vector_all_near_equal3(transform.scale, reference.scale, threshold));
+		}
+
+		inline void require_pose_near_equal(const Transform_32* transforms, const Transform_32* reference_transforms, uint16_t num_bones, float threshold = 0.00001f)
+		{
+			for (uint16_t bone_index = 0; bone_index < num_bones; ++bone_index)
+				require_transform_near_equal(transforms[bone_index], reference_transforms[bone_index], threshold);
+		}
+
+		// Decompresses a batch of instances spread throughout the clip and compares them with one pose at a time
+		inline void validate_batch_decompression(IAllocator& allocator, const CompressedClip& compressed_clip, uint16_t num_bones, float clip_duration, uint32_t num_instances)
+		{
+			using namespace uniformly_sampled;
+
+			DecompressionSettings settings;
+
+			std::vector<void*> contexts(num_instances);
+			std::vector<Transform_32> batch_transforms(num_instances * num_bones);
+			std::vector<DefaultOutputWriter> writers;
+			std::vector<DecompressionInstance<DefaultOutputWriter>> instances(num_instances);
+
+			writers.reserve(num_instances);
+			for (uint32_t instance_index = 0; instance_index < num_instances; ++instance_index)
+			{
+				contexts[instance_index] = allocate_decompression_context(allocator, settings, compressed_clip);
+				writers.emplace_back(&batch_transforms[instance_index * num_bones], num_bones);
+
+				instances[instance_index].context = contexts[instance_index];
+				instances[instance_index].sample_time = num_instances > 1 ? (clip_duration * float(instance_index) / float(num_instances - 1)) : 0.5f * clip_duration;
+				instances[instance_index].writer = &writers[instance_index];
+			}
+
+			decompress_poses(settings, compressed_clip, instances.data(), num_instances);
+
+			void* reference_context = allocate_decompression_context(allocator, settings, compressed_clip);
+			std::vector<Transform_32> reference_transforms(num_bones);
+			DefaultOutputWriter reference_writer(reference_transforms.data(), num_bones);
+
+			for (uint32_t instance_index = 0; instance_index < num_instances; ++instance_index)
+			{
+				decompress_pose(settings, compressed_clip, reference_context, instances[instance_index].sample_time, reference_writer);
+
+				require_pose_near_equal(&batch_transforms[instance_index * num_bones], reference_transforms.data(), num_bones);
+			}
+
+			deallocate_decompression_context(allocator, reference_context);
+			for (void* context : contexts)
+				deallocate_decompression_context(allocator, context);
+		}
+	}
+}
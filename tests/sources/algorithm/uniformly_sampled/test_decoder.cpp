@@ -0,0 +1,908 @@
+////////////////////////////////////////////////////////////////////////////////
+// The MIT License (MIT)
+//
+// Copyright (c) 2017 Nicholas Frechette & Animation Compression Library contributors
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+////////////////////////////////////////////////////////////////////////////////
+
+#include <catch.hpp>
+
+#include "../../error_exceptions.h"
+#include "test_clip_utils.h"
+
+#include <acl/algorithm/uniformly_sampled/decoder.h>
+#include <acl/core/ansi_allocator.h>
+#include <acl/decompression/default_output_writer.h>
+#include <acl/decompression/key_frame_layout.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <functional>
+#include <vector>
+
+using namespace acl;
+using namespace acl::test_utils;
+using namespace acl::uniformly_sampled;
+
+TEST_CASE("uniformly sampled seek cache", "[algorithm][uniformly_sampled]")
+{
+	ANSIAllocator allocator;
+
+	constexpr uint16_t k_num_bones = 5;
+	constexpr uint32_t k_num_samples = 70;
+
+	const TestClip test_clip = make_test_clip(allocator, k_num_bones, k_num_samples);
+
+	CompressionSettings compression_settings = make_segmented_compression_settings();
+
+	CompressedClipPtr compressed_clip = compress_test_clip(allocator, test_clip, compression_settings);
+	REQUIRE(get_clip_header(*compressed_clip).num_segments > 4);
+
+	DecompressionSettings settings;
+	void* cached_context = allocate_decompression_context(allocator, settings, *compressed_clip);
+
+	Transform_32 cached_transforms[k_num_bones];
+	Transform_32 reference_transforms[k_num_bones];
+	DefaultOutputWriter cached_writer(cached_transforms, k_num_bones);
+	DefaultOutputWriter reference_writer(reference_transforms, k_num_bones);
+
+	const float clip_duration = test_clip.clip->get_duration();
+	const uint32_t num_sample_times = k_num_samples * 3;
+
+	auto validate_sample_time = [&](float sample_time)
+	{
+		// A fresh context has nothing cached and always takes the slow path
+		void* reference_context = allocate_decompression_context(allocator, settings, *compressed_clip);
+		decompress_pose(settings, *compressed_clip, reference_context, sample_time, reference_writer);
+		deallocate_decompression_context(allocator, reference_context);
+
+		decompress_pose(settings, *compressed_clip, cached_context, sample_time, cached_writer);
+
+		require_pose_near_equal(cached_transforms, reference_transforms, k_num_bones);
+	};
+
+	// Forward playback
+	for (uint32_t sample_index = 0; sample_index < num_sample_times; ++sample_index)
+		validate_sample_time(clip_duration * float(sample_index) / float(num_sample_times - 1));
+
+	// Backward playback
+	for (uint32_t sample_index = num_sample_times; sample_index-- > 0;)
+		validate_sample_time(clip_duration * float(sample_index) / float(num_sample_times - 1));
+
+	// Random seeks
+	uint32_t seed = 12345;
+	for (uint32_t sample_index = 0; sample_index < num_sample_times; ++sample_index)
+	{
+		seed = seed * 1664525 + 1013904223;
+		validate_sample_time(clip_duration * float(seed >> 8) / float(0xFFFFFF));
+	}
+
+	// Same sample time twice in a row
+	validate_sample_time(clip_duration * 0.5f);
+	validate_sample_time(clip_duration * 0.5f);
+
+	deallocate_decompression_context(allocator, cached_context);
+}
+
+TEST_CASE("uniformly sampled key frame cache", "[algorithm][uniformly_sampled]")
+{
+	ANSIAllocator allocator;
+
+	constexpr uint16_t k_num_bones = 7;
+	constexpr uint32_t k_num_samples = 70;
+
+	const TestClip test_clip = make_test_clip(allocator, k_num_bones, k_num_samples);
+
+	CompressionSettings variable_settings = make_segmented_compression_settings();
+
+	CompressionSettings block_settings = variable_settings;
+	block_settings.key_frame_block_size = 4;
+
+	const CompressionSettings compression_settings_list[] = { make_fixed_compression_settings(), variable_settings, block_settings };
+	for (const CompressionSettings& compression_settings : compression_settings_list)
+	{
+		CompressedClipPtr compressed_clip = compress_test_clip(allocator, test_clip, compression_settings);
+
+		const uint32_t cache_size = get_key_frame_cache_size(*compressed_clip);
+		REQUIRE(cache_size == sizeof(uniformly_sampled::impl::KeyFrameCacheHeader) + (sizeof(Vector4_32) * 3 * k_num_bones * 2));
+		Vector4_32* cache = allocate_type_array<Vector4_32>(allocator, cache_size / sizeof(Vector4_32));
+
+		MemoryAccessRecorder recorder(allocator);
+		InstrumentedDecompressionSettings<> settings(recorder);
+
+		void* cached_context = allocate_decompression_context(allocator, settings, *compressed_clip);
+		void* reference_context = allocate_decompression_context(allocator, settings, *compressed_clip);
+		set_key_frame_cache(cached_context, cache, cache_size);
+
+		Transform_32 cached_transforms[k_num_bones];
+		Transform_32 reference_transforms[k_num_bones];
+		DefaultOutputWriter cached_writer(cached_transforms, k_num_bones);
+		DefaultOutputWriter reference_writer(reference_transforms, k_num_bones);
+
+		uint32_t num_cached_read_bytes = 0;
+		uint32_t num_reference_read_bytes = 0;
+
+		auto validate_sample_time = [&](float sample_time)
+		{
+			recorder.reset();
+			decompress_pose(settings, *compressed_clip, reference_context, sample_time, reference_writer);
+			num_reference_read_bytes += recorder.get_num_read_bytes(CompressedDataSection8::AnimatedTrackData);
+
+			recorder.reset();
+			decompress_pose(settings, *compressed_clip, cached_context, sample_time, cached_writer);
+			num_cached_read_bytes += recorder.get_num_read_bytes(CompressedDataSection8::AnimatedTrackData);
+
+			require_pose_near_equal(cached_transforms, reference_transforms, k_num_bones);
+		};
+
+		const float clip_duration = test_clip.clip->get_duration();
+
+		// Playing back at the sample rate only unpacks one key frame per pose once the first pose is decompressed
+		for (uint32_t sample_index = 0; sample_index < k_num_samples; ++sample_index)
+			validate_sample_time(clip_duration * float(sample_index) / float(k_num_samples - 1));
+
+		REQUIRE(num_cached_read_bytes * 10 < num_reference_read_bytes * 6);
+
+		// Slower than the sample rate, backward
+		const uint32_t num_sample_times = k_num_samples * 3;
+		for (uint32_t sample_index = num_sample_times; sample_index-- > 0;)
+			validate_sample_time(clip_duration * float(sample_index) / float(num_sample_times - 1));
+
+		// Random seeks fall back to unpacking both key frames
+		uint32_t seed = 12345;
+		for (uint32_t sample_index = 0; sample_index < num_sample_times; ++sample_index)
+		{
+			seed = seed * 1664525 + 1013904223;
+			validate_sample_time(clip_duration * float(seed >> 8) / float(0xFFFFFF));
+		}
+
+		// The last key frame interpolates with itself
+		validate_sample_time(clip_duration);
+		validate_sample_time(clip_duration);
+
+		// Partial poses and single bones don't use the cache but they leave it intact
+		Quat_32 rotation;
+		decompress_bone(settings, *compressed_clip, cached_context, clip_duration * 0.25f, k_num_bones - 1, &rotation, nullptr, nullptr);
+		validate_sample_time(clip_duration * 0.5f);
+		validate_sample_time(clip_duration * 0.5f + (1.0f / 30.0f));
+
+		// Detaching the cache goes back to regular decompression
+		set_key_frame_cache(cached_context, nullptr, 0);
+		validate_sample_time(clip_duration * 0.75f);
+
+		deallocate_decompression_context(allocator, reference_context);
+		deallocate_decompression_context(allocator, cached_context);
+		deallocate_type_array(allocator, cache, cache_size / sizeof(Vector4_32));
+	}
+}
+
+TEST_CASE("uniformly sampled track offset index", "[algorithm][uniformly_sampled]")
+{
+	ANSIAllocator allocator;
+
+	constexpr uint16_t k_num_bones = 9;
+	constexpr uint32_t k_num_samples = 40;
+
+	const TestClip test_clip = make_test_clip(allocator, k_num_bones, k_num_samples);
+
+	CompressionSettings variable_settings = make_segmented_compression_settings();
+
+	// Mixed packing requires padding between fixed width and variable tracks
+	CompressionSettings mixed_settings = make_variable_compression_settings();
+	mixed_settings.translation_format = VectorFormat8::Vector3_96;
+
+	const CompressionSettings compression_settings_list[] = { make_fixed_compression_settings(), variable_settings, mixed_settings };
+	for (const CompressionSettings& compression_settings : compression_settings_list)
+	{
+		CompressedClipPtr compressed_clip = compress_test_clip(allocator, test_clip, compression_settings);
+		const ClipHeader& header = get_clip_header(*compressed_clip);
+
+		DecompressionSettings settings;
+		TrackOffsetIndex* index = allocate_track_offset_index(allocator, settings, *compressed_clip);
+		REQUIRE(index->size == get_track_offset_index_size(header));
+
+		void* reference_context = allocate_decompression_context(allocator, settings, *compressed_clip);
+		void* indexed_context = allocate_decompression_context(allocator, settings, *compressed_clip);
+		set_track_offset_index(indexed_context, index);
+
+		const float clip_duration = test_clip.clip->get_duration();
+		for (uint32_t sample_index = 0; sample_index <= k_num_samples * 2; ++sample_index)
+		{
+			const float sample_time = clip_duration * float(sample_index) / float(k_num_samples * 2);
+
+			// Sample bones out of order to make sure we do not depend on the previous bone
+			for (uint16_t bone_offset = 0; bone_offset < k_num_bones; ++bone_offset)
+			{
+				const uint16_t bone_index = (bone_offset * 5) % k_num_bones;
+
+				Quat_32 reference_rotation;
+				Vector4_32 reference_translation;
+				Vector4_32 reference_scale;
+				decompress_bone(settings, *compressed_clip, reference_context, sample_time, bone_index, &reference_rotation, &reference_translation, &reference_scale);
+
+				Quat_32 indexed_rotation;
+				Vector4_32 indexed_translation;
+				Vector4_32 indexed_scale;
+				decompress_bone(settings, *compressed_clip, indexed_context, sample_time, bone_index, &indexed_rotation, &indexed_translation, &indexed_scale);
+
+				REQUIRE(quat_near_equal(indexed_rotation, reference_rotation));
+				REQUIRE(vector_all_near_equal3(indexed_translation, reference_translation));
+				REQUIRE(vector_all_near_equal3(indexed_scale, reference_scale));
+			}
+		}
+
+		deallocate_decompression_context(allocator, indexed_context);
+		deallocate_decompression_context(allocator, reference_context);
+		deallocate_track_offset_index(allocator, index);
+	}
+}
+
+TEST_CASE("uniformly sampled partial pose decompression", "[algorithm][uniformly_sampled]")
+{
+	ANSIAllocator allocator;
+
+	constexpr uint16_t k_num_bones = 23;
+	constexpr uint32_t k_num_samples = 31;
+
+	const TestClip test_clip = make_test_clip(allocator, k_num_bones, k_num_samples);
+
+	CompressionSettings mixed_settings = make_variable_compression_settings();
+	mixed_settings.translation_format = VectorFormat8::Vector3_96;
+
+	const CompressionSettings compression_settings_list[] = { make_fixed_compression_settings(), make_variable_compression_settings(), mixed_settings };
+	for (const CompressionSettings& compression_settings : compression_settings_list)
+	{
+		CompressedClipPtr compressed_clip = compress_test_clip(allocator, test_clip, compression_settings);
+
+		DecompressionSettings settings;
+		TrackOffsetIndex* index = allocate_track_offset_index(allocator, settings, *compressed_clip);
+
+		void* reference_context = allocate_decompression_context(allocator, settings, *compressed_clip);
+		void* partial_context = allocate_decompression_context(allocator, settings, *compressed_clip);
+
+		Transform_32 reference_transforms[k_num_bones];
+		Transform_32 partial_transforms[k_num_bones];
+		DefaultOutputWriter reference_writer(reference_transforms, k_num_bones);
+		DefaultOutputWriter partial_writer(partial_transforms, k_num_bones);
+
+		constexpr BitSetDescription bone_mask_desc = BitSetDescription::make_from_num_bits<k_num_bones>();
+		uint32_t bone_mask[bone_mask_desc.get_size()];
+
+		const Transform_32 sentinel_transform = { quat_set(0.0f, 0.0f, 0.0f, 0.0f), vector_set(-1.0f), vector_set(-1.0f) };
+
+		auto validate_partial_pose = [&](float sample_time, const std::function<bool(uint16_t)>& is_bone_expected)
+		{
+			decompress_pose(settings, *compressed_clip, reference_context, sample_time, reference_writer);
+
+			for (uint16_t bone_index = 0; bone_index < k_num_bones; ++bone_index)
+			{
+				const Transform_32& transform = is_bone_expected(bone_index) ? reference_transforms[bone_index] : sentinel_transform;
+				require_transform_near_equal(partial_transforms[bone_index], transform);
+			}
+		};
+
+		for (bool use_index : { false, true })
+		{
+			set_track_offset_index(partial_context, use_index ? index : nullptr);
+
+			uint32_t seed = 7;
+			for (uint32_t iteration = 0; iteration < 20; ++iteration)
+			{
+				const float sample_time = test_clip.clip->get_duration() * float(iteration) / 19.0f;
+
+				// Random masks, with runs of masked out bones of various length
+				bitset_reset(bone_mask, bone_mask_desc, false);
+				for (uint16_t bone_index = 0; bone_index < k_num_bones; ++bone_index)
+				{
+					seed = seed * 1664525 + 1013904223;
+					bitset_set(bone_mask, bone_mask_desc, bone_index, ((seed >> 16) % 4) == 0);
+				}
+
+				std::fill(std::begin(partial_transforms), std::end(partial_transforms), sentinel_transform);
+				decompress_partial_pose(settings, *compressed_clip, partial_context, sample_time, bone_mask, bone_mask_desc, partial_writer);
+				validate_partial_pose(sample_time, [&](uint16_t bone_index) { return bitset_test(bone_mask, bone_mask_desc, bone_index); });
+
+				// Only the last bone
+				bitset_reset(bone_mask, bone_mask_desc, false);
+				bitset_set(bone_mask, bone_mask_desc, k_num_bones - 1, true);
+
+				std::fill(std::begin(partial_transforms), std::end(partial_transforms), sentinel_transform);
+				decompress_partial_pose(settings, *compressed_clip, partial_context, sample_time, bone_mask, bone_mask_desc, partial_writer);
+				validate_partial_pose(sample_time, [&](uint16_t bone_index) { return bone_index == k_num_bones - 1; });
+
+				// The first few bones
+				const uint16_t num_bones_to_decompress = uint16_t(iteration * 2);
+
+				std::fill(std::begin(partial_transforms), std::end(partial_transforms), sentinel_transform);
+				decompress_partial_pose(settings, *compressed_clip, partial_context, sample_time, num_bones_to_decompress, partial_writer);
+				validate_partial_pose(sample_time, [&](uint16_t bone_index) { return bone_index < num_bones_to_decompress; });
+
+				// Every single bone on its own
+				for (uint16_t bone_index = 0; bone_index < k_num_bones; ++bone_index)
+				{
+					Quat_32 rotation;
+					Vector4_32 translation;
+					Vector4_32 scale;
+					decompress_bone(settings, *compressed_clip, partial_context, sample_time, bone_index, &rotation, &translation, &scale);
+
+					REQUIRE(quat_near_equal(rotation, reference_transforms[bone_index].rotation));
+					REQUIRE(vector_all_near_equal3(translation, reference_transforms[bone_index].translation));
+					REQUIRE(vector_all_near_equal3(scale, reference_transforms[bone_index].scale));
+				}
+			}
+		}
+
+		deallocate_decompression_context(allocator, partial_context);
+		deallocate_decompression_context(allocator, reference_context);
+		deallocate_track_offset_index(allocator, index);
+	}
+}
+
+TEST_CASE("uniformly sampled soa decompression", "[algorithm][uniformly_sampled]")
+{
+	ANSIAllocator allocator;
+
+	// Not a multiple of 4 to leave partial batches behind
+	constexpr uint16_t k_num_bones = 23;
+	constexpr uint32_t k_num_samples = 40;
+
+	const TestClip test_clip = make_test_clip(allocator, k_num_bones, k_num_samples);
+
+	CompressionSettings segmented_settings = make_segmented_compression_settings();
+
+	CompressionSettings clip_range_only_settings = make_variable_compression_settings();
+	clip_range_only_settings.segmenting.range_reduction = RangeReductionFlags8::None;
+
+	const CompressionSettings compression_settings_list[] = { make_variable_compression_settings(), segmented_settings, clip_range_only_settings };
+	for (const CompressionSettings& compression_settings : compression_settings_list)
+	{
+		CompressedClipPtr compressed_clip = compress_test_clip(allocator, test_clip, compression_settings);
+
+		SoADecompressionSettings settings;
+		DecompressionSettings scalar_settings;
+		REQUIRE(uniformly_sampled::impl::is_soa_decompression_enabled(settings, get_clip_header(*compressed_clip)));
+		REQUIRE_FALSE(uniformly_sampled::impl::is_soa_decompression_enabled(scalar_settings, get_clip_header(*compressed_clip)));
+
+		void* soa_context = allocate_decompression_context(allocator, settings, *compressed_clip);
+		void* scalar_context = allocate_decompression_context(allocator, scalar_settings, *compressed_clip);
+
+		std::vector<Transform_32> soa_transforms(k_num_bones);
+		std::vector<Transform_32> scalar_transforms(k_num_bones);
+		DefaultOutputWriter soa_writer(soa_transforms.data(), k_num_bones);
+		DefaultOutputWriter scalar_writer(scalar_transforms.data(), k_num_bones);
+
+		const float clip_duration = test_clip.clip->get_duration();
+		for (uint32_t sample_index = 0; sample_index <= k_num_samples * 3; ++sample_index)
+		{
+			const float sample_time = clip_duration * float(sample_index) / float(k_num_samples * 3);
+
+			decompress_pose(settings, *compressed_clip, soa_context, sample_time, soa_writer);
+			decompress_pose(scalar_settings, *compressed_clip, scalar_context, sample_time, scalar_writer);
+
+			require_pose_near_equal(soa_transforms.data(), scalar_transforms.data(), k_num_bones);
+		}
+
+		deallocate_decompression_context(allocator, scalar_context);
+		deallocate_decompression_context(allocator, soa_context);
+	}
+
+	// Mixed packing has fixed width tracks and falls back to the scalar path
+	CompressionSettings mixed_settings = make_variable_compression_settings();
+	mixed_settings.translation_format = VectorFormat8::Vector3_96;
+
+	CompressedClipPtr mixed_clip = compress_test_clip(allocator, test_clip, mixed_settings);
+	REQUIRE_FALSE(uniformly_sampled::impl::is_soa_decompression_enabled(SoADecompressionSettings(), get_clip_header(*mixed_clip)));
+}
+
+TEST_CASE("uniformly sampled memory access recording", "[algorithm][uniformly_sampled]")
+{
+	ANSIAllocator allocator;
+
+	{
+		// Overlapping and adjacent ranges are merged, cache lines are reported in the order they are first touched
+		alignas(64) uint8_t buffer[256];
+
+		MemoryAccessRecorder recorder(allocator);
+		recorder.record(CompressedDataSection8::ClipHeader, buffer + 128, 8);
+		recorder.record(CompressedDataSection8::ClipRangeData, buffer + 4, 8);
+		recorder.record(CompressedDataSection8::ClipRangeData, buffer + 8, 8);
+		recorder.record(CompressedDataSection8::AnimatedTrackData, buffer + 60, 8);
+		recorder.record(CompressedDataSection8::AnimatedTrackData, buffer + 16, 0);
+
+		REQUIRE(recorder.get_num_accesses() == 4);
+		REQUIRE(recorder.get_num_read_bytes(CompressedDataSection8::ClipRangeData) == 16);
+		REQUIRE(recorder.calculate_num_touched_bytes() == 8 + 12 + 8);
+		REQUIRE(recorder.calculate_num_touched_cache_lines(64) == 3);
+
+		uintptr_t cache_lines[4];
+		REQUIRE(recorder.calculate_touched_cache_lines(64, cache_lines, 4) == 3);
+		REQUIRE(cache_lines[0] == reinterpret_cast<uintptr_t>(buffer + 128));
+		REQUIRE(cache_lines[1] == reinterpret_cast<uintptr_t>(buffer));
+		REQUIRE(cache_lines[2] == reinterpret_cast<uintptr_t>(buffer + 64));
+
+		recorder.reset();
+		REQUIRE(recorder.get_num_accesses() == 0);
+		REQUIRE(recorder.calculate_num_touched_bytes() == 0);
+	}
+
+	constexpr uint16_t k_num_bones = 23;
+	constexpr uint32_t k_num_samples = 40;
+
+	const TestClip test_clip = make_test_clip(allocator, k_num_bones, k_num_samples);
+
+	CompressionSettings segmented_settings = make_segmented_compression_settings();
+
+	// Fixed formats take the scalar path and variable formats the SoA path
+	const CompressionSettings compression_settings_list[] = { make_fixed_compression_settings(), make_variable_compression_settings(), segmented_settings };
+	for (const CompressionSettings& compression_settings : compression_settings_list)
+	{
+		CompressedClipPtr compressed_clip = compress_test_clip(allocator, test_clip, compression_settings);
+		const uintptr_t clip_start = reinterpret_cast<uintptr_t>(compressed_clip.get());
+		const uintptr_t clip_end = clip_start + compressed_clip->get_size();
+
+		MemoryAccessRecorder recorder(allocator);
+		InstrumentedDecompressionSettings<> instrumented_settings(recorder);
+		DecompressionSettings settings;
+
+		void* instrumented_context = allocate_decompression_context(allocator, instrumented_settings, *compressed_clip);
+		void* context = allocate_decompression_context(allocator, settings, *compressed_clip);
+
+		std::vector<Transform_32> instrumented_transforms(k_num_bones);
+		std::vector<Transform_32> transforms(k_num_bones);
+		DefaultOutputWriter instrumented_writer(instrumented_transforms.data(), k_num_bones);
+		DefaultOutputWriter writer(transforms.data(), k_num_bones);
+
+		const float clip_duration = test_clip.clip->get_duration();
+		for (uint32_t sample_index = 0; sample_index <= k_num_samples; ++sample_index)
+		{
+			const float sample_time = clip_duration * float(sample_index) / float(k_num_samples);
+
+			recorder.reset();
+			decompress_pose(instrumented_settings, *compressed_clip, instrumented_context, sample_time, instrumented_writer);
+			decompress_pose(settings, *compressed_clip, context, sample_time, writer);
+
+			// Recording must not change what we decompress
+			REQUIRE(std::memcmp(instrumented_transforms.data(), transforms.data(), sizeof(Transform_32) * k_num_bones) == 0);
+
+			const uint32_t num_accesses = recorder.get_num_accesses();
+			REQUIRE(num_accesses != 0);
+			REQUIRE(recorder.get_accesses()[0].section == CompressedDataSection8::ClipHeader);
+			for (uint32_t access_index = 0; access_index < num_accesses; ++access_index)
+			{
+				const MemoryAccess& access = recorder.get_accesses()[access_index];
+				REQUIRE(access.address >= clip_start);
+				REQUIRE(access.address + access.size <= clip_end);
+			}
+
+			const uint32_t num_pose_touched_bytes = recorder.calculate_num_touched_bytes();
+			REQUIRE(num_pose_touched_bytes <= compressed_clip->get_size());
+			REQUIRE(recorder.get_num_read_bytes(CompressedDataSection8::AnimatedTrackData) != 0);
+			REQUIRE(recorder.calculate_num_touched_cache_lines() >= 1);
+
+			// A single bone reads a subset of what the whole pose reads
+			recorder.reset();
+			Transform_32 bone_transform;
+			decompress_bone(instrumented_settings, *compressed_clip, instrumented_context, sample_time, k_num_bones - 1, &bone_transform.rotation, &bone_transform.translation, &bone_transform.scale);
+			REQUIRE(recorder.get_num_accesses() != 0);
+			REQUIRE(recorder.calculate_num_touched_bytes() <= num_pose_touched_bytes);
+		}
+
+		deallocate_decompression_context(allocator, context);
+		deallocate_decompression_context(allocator, instrumented_context);
+	}
+}
+
+TEST_CASE("uniformly sampled key frame blocks", "[algorithm][uniformly_sampled]")
+{
+	ANSIAllocator allocator;
+
+	constexpr uint16_t k_num_bones = 23;
+	constexpr uint32_t k_num_samples = 40;
+
+	const TestClip test_clip = make_test_clip(allocator, k_num_bones, k_num_samples);
+
+	CompressionSettings segmented_settings = make_segmented_compression_settings();
+
+	CompressionSettings mixed_settings = make_variable_compression_settings();
+	mixed_settings.translation_format = VectorFormat8::Vector3_96;
+
+	CompressionSettings invalid_settings = make_variable_compression_settings();
+	invalid_settings.key_frame_block_size = 0;
+	REQUIRE(invalid_settings.get_error() != nullptr);
+	invalid_settings.key_frame_block_size = k_max_key_frame_block_size + 1;
+	REQUIRE(invalid_settings.get_error() != nullptr);
+
+	const float clip_duration = test_clip.clip->get_duration();
+	const float sample_rate = float(test_clip.clip->get_sample_rate());
+
+	const CompressionSettings compression_settings_list[] = { make_fixed_compression_settings(), make_variable_compression_settings(), segmented_settings, mixed_settings };
+	for (const CompressionSettings& compression_settings : compression_settings_list)
+	{
+		CompressedClipPtr reference_clip = compress_test_clip(allocator, test_clip, compression_settings);
+		REQUIRE(get_clip_header(*reference_clip).key_frame_block_size == 1);
+
+		for (uint8_t key_frame_block_size : { 2, 3, 8 })
+		{
+			CompressionSettings block_settings = compression_settings;
+			block_settings.key_frame_block_size = key_frame_block_size;
+
+			// Blocks only change the order of the animated samples
+			CompressedClipPtr block_clip = compress_test_clip(allocator, test_clip, block_settings);
+			REQUIRE(get_clip_header(*block_clip).key_frame_block_size == key_frame_block_size);
+			REQUIRE(block_clip->get_size() == reference_clip->get_size());
+
+			SoADecompressionSettings settings;
+			DecompressionSettings scalar_settings;
+			void* reference_context = allocate_decompression_context(allocator, settings, *reference_clip);
+			void* scalar_reference_context = allocate_decompression_context(allocator, scalar_settings, *reference_clip);
+			void* block_context = allocate_decompression_context(allocator, settings, *block_clip);
+			void* scalar_block_context = allocate_decompression_context(allocator, scalar_settings, *block_clip);
+			void* indexed_block_context = allocate_decompression_context(allocator, settings, *block_clip);
+
+			TrackOffsetIndex* index = allocate_track_offset_index(allocator, settings, *block_clip);
+			set_track_offset_index(indexed_block_context, index);
+
+			std::vector<Transform_32> reference_transforms(k_num_bones);
+			std::vector<Transform_32> block_transforms(k_num_bones);
+			std::vector<Transform_32> scalar_reference_transforms(k_num_bones);
+			std::vector<Transform_32> scalar_block_transforms(k_num_bones);
+			DefaultOutputWriter reference_writer(reference_transforms.data(), k_num_bones);
+			DefaultOutputWriter block_writer(block_transforms.data(), k_num_bones);
+			DefaultOutputWriter scalar_reference_writer(scalar_reference_transforms.data(), k_num_bones);
+			DefaultOutputWriter scalar_block_writer(scalar_block_transforms.data(), k_num_bones);
+
+			for (uint32_t sample_index = 0; sample_index <= k_num_samples * 3; ++sample_index)
+			{
+				const float sample_time = clip_duration * float(sample_index) / float(k_num_samples * 3);
+
+				decompress_pose(settings, *reference_clip, reference_context, sample_time, reference_writer);
+				decompress_pose(settings, *block_clip, block_context, sample_time, block_writer);
+				REQUIRE(std::memcmp(reference_transforms.data(), block_transforms.data(), sizeof(Transform_32) * k_num_bones) == 0);
+
+				decompress_pose(scalar_settings, *reference_clip, scalar_reference_context, sample_time, scalar_reference_writer);
+				decompress_pose(scalar_settings, *block_clip, scalar_block_context, sample_time, scalar_block_writer);
+				REQUIRE(std::memcmp(scalar_reference_transforms.data(), scalar_block_transforms.data(), sizeof(Transform_32) * k_num_bones) == 0);
+
+				for (uint16_t bone_index = 0; bone_index < k_num_bones; ++bone_index)
+				{
+					Transform_32 bone_transform;
+					decompress_bone(settings, *block_clip, block_context, sample_time, bone_index, &bone_transform.rotation, &bone_transform.translation, &bone_transform.scale);
+					require_transform_near_equal(bone_transform, reference_transforms[bone_index]);
+
+					Transform_32 indexed_transform;
+					decompress_bone(settings, *block_clip, indexed_block_context, sample_time, bone_index, &indexed_transform.rotation, &indexed_transform.translation, &indexed_transform.scale);
+					require_transform_near_equal(indexed_transform, bone_transform);
+				}
+			}
+
+			validate_batch_decompression(allocator, *block_clip, k_num_bones, clip_duration, 7);
+
+			// The cache lines we expect the layout to touch must match what the decoder reads
+			MemoryAccessRecorder recorder(allocator);
+			InstrumentedDecompressionSettings<> instrumented_settings(recorder);
+			void* instrumented_context = allocate_decompression_context(allocator, instrumented_settings, *block_clip);
+
+			for (uint32_t key_frame = 0; key_frame + 1 < k_num_samples; ++key_frame)
+			{
+				recorder.reset();
+				decompress_pose(instrumented_settings, *block_clip, instrumented_context, (float(key_frame) + 0.5f) / sample_rate, block_writer);
+
+				std::vector<uintptr_t> animated_cache_lines;
+				for (uint32_t access_index = 0; access_index < recorder.get_num_accesses(); ++access_index)
+				{
+					const MemoryAccess& access = recorder.get_accesses()[access_index];
+					if (access.section != CompressedDataSection8::AnimatedTrackData)
+						continue;
+
+					for (uintptr_t cache_line = access.address & ~uintptr_t(63); cache_line < access.address + access.size; cache_line += 64)
+						animated_cache_lines.push_back(cache_line);
+				}
+
+				std::sort(animated_cache_lines.begin(), animated_cache_lines.end());
+				const size_t num_animated_cache_lines = std::unique(animated_cache_lines.begin(), animated_cache_lines.end()) - animated_cache_lines.begin();
+				REQUIRE(calculate_num_animated_touched_cache_lines(*block_clip, key_frame, key_frame + 1, key_frame_block_size) == num_animated_cache_lines);
+			}
+
+			deallocate_decompression_context(allocator, instrumented_context);
+			deallocate_decompression_context(allocator, scalar_reference_context);
+			deallocate_decompression_context(allocator, indexed_block_context);
+			deallocate_decompression_context(allocator, scalar_block_context);
+			deallocate_decompression_context(allocator, block_context);
+			deallocate_decompression_context(allocator, reference_context);
+			deallocate_track_offset_index(allocator, index);
+		}
+	}
+}
+
+TEST_CASE("uniformly sampled rotation formats", "[algorithm][uniformly_sampled]")
+{
+	ANSIAllocator allocator;
+
+	constexpr uint16_t k_num_bones = 9;
+	constexpr uint32_t k_num_samples = 45;
+
+	const TestClip test_clip = make_test_clip(allocator, k_num_bones, k_num_samples);
+
+	const RotationFormat8 rotation_formats[] = { RotationFormat8::Quat_32_Largest, RotationFormat8::QuatLog_96, RotationFormat8::QuatLog_48, RotationFormat8::QuatLog_32, RotationFormat8::QuatLog_Variable };
+	for (RotationFormat8 rotation_format : rotation_formats)
+	{
+		CompressionSettings settings = is_rotation_format_variable(rotation_format) ? make_variable_compression_settings() : make_fixed_compression_settings();
+		settings.rotation_format = rotation_format;
+
+		// The largest component format cannot be range reduced
+		if (get_rotation_variant(rotation_format) == RotationVariant8::QuatDropLargest)
+		{
+			settings.range_reduction &= ~RangeReductionFlags8::Rotations;
+			settings.segmenting.range_reduction &= ~RangeReductionFlags8::Rotations;
+		}
+
+		CompressedClipPtr compressed_clip = compress_test_clip(allocator, test_clip, settings);
+
+		const ClipHeader& header = get_clip_header(*compressed_clip);
+		REQUIRE(header.rotation_format == rotation_format);
+
+		DecompressionSettings decompression_settings;
+		void* context = allocate_decompression_context(allocator, decompression_settings, *compressed_clip);
+
+		std::vector<Transform_32> raw_transforms(k_num_bones);
+		std::vector<Transform_32> lossy_transforms(k_num_bones);
+		DefaultOutputWriter writer(lossy_transforms.data(), k_num_bones);
+
+		for (uint32_t sample_index = 0; sample_index < k_num_samples; ++sample_index)
+		{
+			const float sample_time = test_clip.clip->get_duration() * float(sample_index) / float(k_num_samples - 1);
+			test_clip.clip->sample_pose(sample_time, raw_transforms.data(), k_num_bones);
+			decompress_pose(decompression_settings, *compressed_clip, context, sample_time, writer);
+
+			for (uint16_t bone_index = 0; bone_index < k_num_bones; ++bone_index)
+			{
+				const Quat_32 raw_rotation = quat_ensure_positive_w(raw_transforms[bone_index].rotation);
+				const Quat_32 lossy_rotation = quat_ensure_positive_w(lossy_transforms[bone_index].rotation);
+				REQUIRE(quat_near_equal(raw_rotation, lossy_rotation, 1.0e-2f));
+			}
+		}
+
+		deallocate_decompression_context(allocator, context);
+	}
+}
+
+namespace
+{
+	// A stand-in for a streamer that reads segments from a file, it keeps a segment and its neighbors resident
+	class FileSegmentStreamer final : public ISegmentStreamer
+	{
+	public:
+		FileSegmentStreamer(std::FILE* file, const CompressedClip& clip)
+			: m_file(file)
+			, m_segments(get_clip_header(clip).num_segments)
+			, m_num_loads(0)
+			, m_num_misses(0)
+		{
+			const uint32_t first_segment_data_offset = get_resident_clip_size(clip);
+			for (uint16_t segment_index = 0; segment_index < m_segments.size(); ++segment_index)
+			{
+				m_segments[segment_index].file_offset = get_segment_data_offset(clip, segment_index) - first_segment_data_offset;
+				m_segments[segment_index].size = get_segment_data_size(clip, segment_index);
+			}
+		}
+
+		virtual const uint8_t* get_segment_data(uint16_t segment_index) override
+		{
+			REQUIRE(segment_index < m_segments.size());
+
+			for (uint16_t other_segment_index = 0; other_segment_index < m_segments.size(); ++other_segment_index)
+			{
+				if (std::abs(int32_t(other_segment_index) - int32_t(segment_index)) > 1)
+					m_segments[other_segment_index].data.clear();
+			}
+
+			Segment& segment = m_segments[segment_index];
+			if (segment.data.empty())
+			{
+				m_num_misses++;
+				load_segment(segment);
+			}
+
+			return segment.data.data();
+		}
+
+		virtual void prefetch_segment(uint16_t segment_index) override
+		{
+			REQUIRE(segment_index < m_segments.size());
+
+			Segment& segment = m_segments[segment_index];
+			if (segment.data.empty())
+				load_segment(segment);
+		}
+
+		uint32_t get_num_loads() const { return m_num_loads; }
+		uint32_t get_num_misses() const { return m_num_misses; }
+
+	private:
+		struct Segment
+		{
+			uint32_t file_offset;
+			uint32_t size;
+			std::vector<uint8_t> data;
+		};
+
+		void load_segment(Segment& segment)
+		{
+			segment.data.resize(segment.size);
+			REQUIRE(std::fseek(m_file, long(segment.file_offset), SEEK_SET) == 0);
+			REQUIRE(std::fread(segment.data.data(), 1, segment.size, m_file) == segment.size);
+			m_num_loads++;
+		}
+
+		std::FILE* m_file;
+		std::vector<Segment> m_segments;
+		uint32_t m_num_loads;
+		uint32_t m_num_misses;
+	};
+}
+
+TEST_CASE("uniformly sampled segment streaming", "[algorithm][uniformly_sampled]")
+{
+	ANSIAllocator allocator;
+
+	constexpr uint16_t k_num_bones = 7;
+	constexpr uint32_t k_num_samples = 90;
+
+	const TestClip test_clip = make_test_clip(allocator, k_num_bones, k_num_samples);
+
+	CompressionSettings fixed_settings = make_fixed_compression_settings();
+	fixed_settings.segmenting.enabled = true;
+	fixed_settings.segmenting.ideal_num_samples = 8;
+	fixed_settings.segmenting.max_num_samples = 15;
+
+	CompressionSettings variable_settings = make_segmented_compression_settings();
+
+	const CompressionSettings compression_settings_list[] = { fixed_settings, variable_settings };
+	for (const CompressionSettings& compression_settings : compression_settings_list)
+	{
+		CompressedClipPtr compressed_clip = compress_test_clip(allocator, test_clip, compression_settings);
+		const ClipHeader& header = get_clip_header(*compressed_clip);
+		REQUIRE(header.num_segments > 4);
+
+		// Segments follow the resident data and each other without gaps
+		const uint32_t resident_size = get_resident_clip_size(*compressed_clip);
+		uint32_t total_size = resident_size;
+		for (uint16_t segment_index = 0; segment_index < header.num_segments; ++segment_index)
+		{
+			REQUIRE(get_segment_data_offset(*compressed_clip, segment_index) == total_size);
+			total_size += get_segment_data_size(*compressed_clip, segment_index);
+		}
+		REQUIRE(total_size == compressed_clip->get_size());
+
+		// Only the resident data is kept in memory, the segments are written to a file
+		uint8_t* resident_buffer = allocate_type_array_aligned<uint8_t>(allocator, resident_size, alignof(CompressedClip));
+		std::memcpy(resident_buffer, compressed_clip.get(), resident_size);
+		const CompressedClip& resident_clip = *safe_ptr_cast<const CompressedClip>(resident_buffer);
+
+		std::FILE* segment_file = std::tmpfile();
+		REQUIRE(segment_file != nullptr);
+
+		const uint8_t* segment_data = safe_ptr_cast<const uint8_t>(compressed_clip.get()) + resident_size;
+		REQUIRE(std::fwrite(segment_data, 1, total_size - resident_size, segment_file) == total_size - resident_size);
+
+		DecompressionSettings settings;
+		void* reference_context = allocate_decompression_context(allocator, settings, *compressed_clip);
+
+		Transform_32 reference_transforms[k_num_bones];
+		Transform_32 streamed_transforms[k_num_bones];
+		DefaultOutputWriter reference_writer(reference_transforms, k_num_bones);
+		DefaultOutputWriter streamed_writer(streamed_transforms, k_num_bones);
+
+		const float clip_duration = test_clip.clip->get_duration();
+		const uint32_t num_sample_times = k_num_samples * 3;
+
+		auto validate_playback = [&](const std::function<float(uint32_t)>& get_sample_time)
+		{
+			FileSegmentStreamer streamer(segment_file, *compressed_clip);
+
+			void* streamed_context = allocate_decompression_context(allocator, settings, resident_clip);
+			set_segment_streamer(streamed_context, &streamer);
+
+			for (uint32_t sample_index = 0; sample_index < num_sample_times; ++sample_index)
+			{
+				const float sample_time = get_sample_time(sample_index);
+				decompress_pose(settings, *compressed_clip, reference_context, sample_time, reference_writer);
+				decompress_pose(settings, resident_clip, streamed_context, sample_time, streamed_writer);
+
+				require_pose_near_equal(streamed_transforms, reference_transforms, k_num_bones);
+			}
+
+			deallocate_decompression_context(allocator, streamed_context);
+			return streamer.get_num_misses();
+		};
+
+		// With prefetching, sequential playback only waits for the segments it starts with
+		const uint32_t num_forward_misses = validate_playback([&](uint32_t sample_index) { return clip_duration * float(sample_index) / float(num_sample_times - 1); });
+		REQUIRE(num_forward_misses <= 2);
+
+		// The direction of playback is only known once we cross our first segment boundary
+		const uint32_t num_backward_misses = validate_playback([&](uint32_t sample_index) { return clip_duration * float(num_sample_times - 1 - sample_index) / float(num_sample_times - 1); });
+		REQUIRE(num_backward_misses <= 3);
+
+		uint32_t seed = 12345;
+		validate_playback([&](uint32_t) { seed = seed * 1664525 + 1013904223; return clip_duration * float(seed >> 8) / float(0xFFFFFF); });
+
+		deallocate_decompression_context(allocator, reference_context);
+		std::fclose(segment_file);
+		deallocate_type_array(allocator, resident_buffer, resident_size);
+	}
+}
+
+// Hidden by default, run explicitly with: acl_unit_tests [benchmark]
+TEST_CASE("uniformly sampled soa decompression benchmark", "[.][benchmark]")
+{
+	ANSIAllocator allocator;
+
+	constexpr uint16_t k_num_bones = 32;
+	constexpr uint32_t k_num_samples = 61;
+	constexpr uint32_t k_num_sample_times = 32;
+	constexpr uint32_t k_num_iterations = 2000;
+
+	const TestClip test_clip = make_test_clip(allocator, k_num_bones, k_num_samples);
+	CompressedClipPtr compressed_clip = compress_test_clip(allocator, test_clip, make_variable_compression_settings());
+
+	SoADecompressionSettings settings;
+	DecompressionSettings scalar_settings;
+	const float clip_duration = test_clip.clip->get_duration();
+
+	void* soa_context = allocate_decompression_context(allocator, settings, *compressed_clip);
+	void* scalar_context = allocate_decompression_context(allocator, scalar_settings, *compressed_clip);
+
+	std::vector<Transform_32> transforms(k_num_bones);
+	DefaultOutputWriter writer(transforms.data(), k_num_bones);
+
+	// Minimum time of each path, scalar first. Timed runs are kept short so that some of them are not interrupted.
+	double elapsed_ns[2] = { 1.0e30, 1.0e30 };
+
+	for (uint32_t iteration = 0; iteration < k_num_iterations; ++iteration)
+	{
+		// Alternate which path runs first, the first one pays for warming up the caches
+		for (uint32_t run_index = 0; run_index < 2; ++run_index)
+		{
+			const uint32_t path_index = (iteration + run_index) % 2;
+
+			const auto start = std::chrono::high_resolution_clock::now();
+			for (uint32_t sample_index = 0; sample_index < k_num_sample_times; ++sample_index)
+			{
+				const float sample_time = clip_duration * float(sample_index) / float(k_num_sample_times - 1);
+				if (path_index == 0)
+					decompress_pose(scalar_settings, *compressed_clip, scalar_context, sample_time, writer);
+				else
+					decompress_pose(settings, *compressed_clip, soa_context, sample_time, writer);
+			}
+			const auto end = std::chrono::high_resolution_clock::now();
+
+			elapsed_ns[path_index] = std::min(elapsed_ns[path_index], double(std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count()));
+		}
+	}
+
+	std::printf("Pose decompression of %u bones with %u SoA lanes: scalar %8.1f ns, soa %8.1f ns\n", k_num_bones, k_num_soa_lanes, elapsed_ns[0] / k_num_sample_times, elapsed_ns[1] / k_num_sample_times);
+
+	deallocate_decompression_context(allocator, scalar_context);
+	deallocate_decompression_context(allocator, soa_context);
+}
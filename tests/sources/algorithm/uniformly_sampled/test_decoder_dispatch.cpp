@@ -0,0 +1,93 @@
+////////////////////////////////////////////////////////////////////////////////
+// The MIT License (MIT)
+//
+// Copyright (c) 2017 Nicholas Frechette & Animation Compression Library contributors
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+////////////////////////////////////////////////////////////////////////////////
+
+#include <catch.hpp>
+
+#include "../../error_exceptions.h"
+#include "test_clip_utils.h"
+
+#include <acl/algorithm/uniformly_sampled/decoder.h>
+#include <acl/algorithm/uniformly_sampled/decoder_dispatch.h>
+#include <acl/core/ansi_allocator.h>
+#include <acl/core/cpu_instruction_set.h>
+#include <acl/decompression/default_output_writer.h>
+
+#include <vector>
+
+using namespace acl;
+using namespace acl::test_utils;
+using namespace acl::uniformly_sampled;
+
+#if defined(ACL_TEST_DECODER_DISPATCH)
+TEST_CASE("uniformly sampled runtime dispatch", "[algorithm][uniformly_sampled]")
+{
+	ANSIAllocator allocator;
+
+	constexpr uint16_t k_num_bones = 9;
+	constexpr uint32_t k_num_samples = 40;
+
+	const TestClip test_clip = make_test_clip(allocator, k_num_bones, k_num_samples);
+
+	const CPUInstructionSet8 cpu_instruction_set = get_cpu_instruction_set();
+	REQUIRE(uint8_t(cpu_instruction_set) >= uint8_t(CPUInstructionSet8::SSE2));
+
+	const CompressionSettings compression_settings_list[] = { make_fixed_compression_settings(), make_variable_compression_settings() };
+	for (const CompressionSettings& compression_settings : compression_settings_list)
+	{
+		CompressedClipPtr compressed_clip = compress_test_clip(allocator, test_clip, compression_settings);
+
+		DecompressionSettings settings;
+		void* reference_context = allocate_decompression_context(allocator, settings, *compressed_clip);
+
+		std::vector<Transform_32> reference_transforms(k_num_bones);
+		std::vector<Transform_32> dispatched_transforms(k_num_bones);
+		DefaultOutputWriter reference_writer(reference_transforms.data(), k_num_bones);
+
+		// Every instruction set the CPU supports, the selection is capped by the CPU
+		for (uint8_t instruction_set_value = uint8_t(CPUInstructionSet8::SSE2); instruction_set_value <= uint8_t(CPUInstructionSet8::AVX2); ++instruction_set_value)
+		{
+			const CPUInstructionSet8 max_instruction_set = CPUInstructionSet8(instruction_set_value);
+			void* dispatched_context = allocate_dispatched_decompression_context(allocator, *compressed_clip, max_instruction_set);
+
+			const CPUInstructionSet8 expected_instruction_set = instruction_set_value <= uint8_t(cpu_instruction_set) ? max_instruction_set : cpu_instruction_set;
+			REQUIRE(get_dispatched_instruction_set(dispatched_context) == expected_instruction_set);
+
+			const float clip_duration = test_clip.clip->get_duration();
+			for (uint32_t sample_index = 0; sample_index <= k_num_samples * 2; ++sample_index)
+			{
+				const float sample_time = clip_duration * float(sample_index) / float(k_num_samples * 2);
+
+				decompress_pose(settings, *compressed_clip, reference_context, sample_time, reference_writer);
+				decompress_pose_dispatched(*compressed_clip, dispatched_context, sample_time, dispatched_transforms.data(), k_num_bones);
+
+				require_pose_near_equal(reference_transforms.data(), dispatched_transforms.data(), k_num_bones);
+			}
+
+			deallocate_dispatched_decompression_context(allocator, dispatched_context);
+		}
+
+		deallocate_decompression_context(allocator, reference_context);
+	}
+}
+#endif
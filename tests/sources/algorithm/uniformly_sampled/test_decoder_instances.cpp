@@ -0,0 +1,233 @@
+////////////////////////////////////////////////////////////////////////////////
+// The MIT License (MIT)
+//
+// Copyright (c) 2017 Nicholas Frechette & Animation Compression Library contributors
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+////////////////////////////////////////////////////////////////////////////////
+
+#include <catch.hpp>
+
+#include "../../error_exceptions.h"
+#include "test_clip_utils.h"
+
+#include <acl/algorithm/uniformly_sampled/decoder.h>
+#include <acl/core/ansi_allocator.h>
+#include <acl/core/pool_allocator.h>
+#include <acl/decompression/default_output_writer.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <vector>
+
+using namespace acl;
+using namespace acl::test_utils;
+using namespace acl::uniformly_sampled;
+
+TEST_CASE("uniformly sampled batch decompression", "[algorithm][uniformly_sampled]")
+{
+	ANSIAllocator allocator;
+
+	constexpr uint16_t k_num_bones = 9;
+	constexpr uint32_t k_num_samples = 45;
+
+	const TestClip test_clip = make_test_clip(allocator, k_num_bones, k_num_samples);
+
+	{
+		CompressedClipPtr compressed_clip = compress_test_clip(allocator, test_clip, make_fixed_compression_settings());
+
+		for (uint32_t num_instances : { 1, 2, 7 })
+			validate_batch_decompression(allocator, *compressed_clip, k_num_bones, test_clip.clip->get_duration(), num_instances);
+	}
+
+	{
+		CompressedClipPtr compressed_clip = compress_test_clip(allocator, test_clip, make_variable_compression_settings());
+
+		for (uint32_t num_instances : { 1, 2, 7 })
+			validate_batch_decompression(allocator, *compressed_clip, k_num_bones, test_clip.clip->get_duration(), num_instances);
+	}
+}
+
+TEST_CASE("uniformly sampled shared decompression context", "[algorithm][uniformly_sampled]")
+{
+	ANSIAllocator allocator;
+
+	constexpr uint16_t k_num_bones = 6;
+	constexpr uint32_t k_num_samples = 70;
+	constexpr uint32_t k_num_instances = 7;
+
+	const TestClip test_clip = make_test_clip(allocator, k_num_bones, k_num_samples);
+
+	CompressionSettings variable_settings = make_segmented_compression_settings();
+
+	const CompressionSettings compression_settings_list[] = { make_fixed_compression_settings(), variable_settings };
+	for (const CompressionSettings& compression_settings : compression_settings_list)
+	{
+		CompressedClipPtr compressed_clip = compress_test_clip(allocator, test_clip, compression_settings);
+
+		DecompressionSettings settings;
+		void* shared_context = allocate_shared_decompression_context(allocator, settings, *compressed_clip);
+
+		PoolAllocator pool_allocator(allocator, get_instance_decompression_context_size(), get_instance_decompression_context_alignment(), 4);
+
+		void* instance_contexts[k_num_instances];
+		void* reference_contexts[k_num_instances];
+		for (uint32_t instance_index = 0; instance_index < k_num_instances; ++instance_index)
+		{
+			instance_contexts[instance_index] = allocate_instance_decompression_context(pool_allocator);
+			reference_contexts[instance_index] = allocate_decompression_context(allocator, settings, *compressed_clip);
+		}
+
+		REQUIRE(pool_allocator.get_num_pages() == 2);
+
+		Transform_32 instance_transforms[k_num_bones];
+		Transform_32 reference_transforms[k_num_bones];
+		DefaultOutputWriter instance_writer(instance_transforms, k_num_bones);
+		DefaultOutputWriter reference_writer(reference_transforms, k_num_bones);
+
+		// Every instance plays back forward from its own offset in the clip and wraps around
+		const float clip_duration = test_clip.clip->get_duration();
+		const uint32_t num_sample_times = k_num_samples * 2;
+		for (uint32_t sample_index = 0; sample_index < num_sample_times; ++sample_index)
+		{
+			for (uint32_t instance_index = 0; instance_index < k_num_instances; ++instance_index)
+			{
+				const uint32_t instance_sample_index = (sample_index + ((instance_index * num_sample_times) / k_num_instances)) % num_sample_times;
+				const float sample_time = clip_duration * float(instance_sample_index) / float(num_sample_times - 1);
+
+				decompress_pose(settings, *compressed_clip, reference_contexts[instance_index], sample_time, reference_writer);
+				decompress_pose(settings, *compressed_clip, shared_context, instance_contexts[instance_index], sample_time, instance_writer);
+
+				require_pose_near_equal(instance_transforms, reference_transforms, k_num_bones, 0.0f);
+
+				Quat_32 rotation;
+				Vector4_32 translation;
+				decompress_bone(settings, *compressed_clip, shared_context, instance_contexts[instance_index], sample_time, k_num_bones - 1, &rotation, &translation, nullptr);
+				REQUIRE(quat_near_equal(rotation, reference_transforms[k_num_bones - 1].rotation, 0.0f));
+				REQUIRE(vector_all_near_equal3(translation, reference_transforms[k_num_bones - 1].translation, 0.0f));
+			}
+		}
+
+		for (uint32_t instance_index = 0; instance_index < k_num_instances; ++instance_index)
+		{
+			deallocate_instance_decompression_context(pool_allocator, instance_contexts[instance_index]);
+			deallocate_decompression_context(allocator, reference_contexts[instance_index]);
+		}
+
+		deallocate_shared_decompression_context(allocator, shared_context);
+	}
+
+	// A full context must not grow past the two cache lines of the context that predates shared contexts
+	constexpr size_t k_baseline_context_size = 128;
+	REQUIRE(get_decompression_context_size() <= k_baseline_context_size);
+	REQUIRE(get_shared_decompression_context_size() == 64);
+
+	{
+		// With many instances, the per instance state is all that matters
+		constexpr uint32_t k_num_large_instances = 10000;
+
+		PoolAllocator pool_allocator(allocator, get_instance_decompression_context_size(), get_instance_decompression_context_alignment());
+		std::vector<void*> instance_contexts(k_num_large_instances);
+		for (void*& instance_context : instance_contexts)
+			instance_context = allocate_instance_decompression_context(pool_allocator);
+
+		const size_t baseline_contexts_size = k_baseline_context_size * k_num_large_instances;
+		const size_t shared_contexts_size = get_shared_decompression_context_size() + pool_allocator.get_reserved_size();
+		REQUIRE(shared_contexts_size * 3 < baseline_contexts_size);
+
+		for (void* instance_context : instance_contexts)
+			deallocate_instance_decompression_context(pool_allocator, instance_context);
+	}
+}
+
+// Hidden by default, run explicitly with: acl_unit_tests [benchmark]
+TEST_CASE("uniformly sampled batch decompression benchmark", "[.][benchmark]")
+{
+	ANSIAllocator allocator;
+
+	constexpr uint16_t k_num_bones = 32;
+	constexpr uint32_t k_num_samples = 61;
+	constexpr uint32_t k_max_num_instances = 256;
+	constexpr uint32_t k_num_iterations = 200;
+
+	const TestClip test_clip = make_test_clip(allocator, k_num_bones, k_num_samples);
+	CompressedClipPtr compressed_clip = compress_test_clip(allocator, test_clip, make_variable_compression_settings());
+
+	DecompressionSettings settings;
+	const float clip_duration = test_clip.clip->get_duration();
+
+	std::vector<void*> contexts(k_max_num_instances);
+	std::vector<Transform_32> transforms(k_max_num_instances * k_num_bones);
+	std::vector<DefaultOutputWriter> writers;
+	std::vector<DecompressionInstance<DefaultOutputWriter>> instances(k_max_num_instances);
+	std::vector<float> sample_times(k_max_num_instances);
+
+	writers.reserve(k_max_num_instances);
+	for (uint32_t instance_index = 0; instance_index < k_max_num_instances; ++instance_index)
+	{
+		contexts[instance_index] = allocate_decompression_context(allocator, settings, *compressed_clip);
+		writers.emplace_back(&transforms[instance_index * k_num_bones], k_num_bones);
+
+		// Scatter our instances throughout the clip
+		sample_times[instance_index] = clip_duration * float((instance_index * 37) % k_max_num_instances) / float(k_max_num_instances - 1);
+
+		instances[instance_index].context = contexts[instance_index];
+		instances[instance_index].sample_time = sample_times[instance_index];
+		instances[instance_index].writer = &writers[instance_index];
+	}
+
+	std::printf("Batch decompression of %u bones, per instance cost:\n", k_num_bones);
+
+	for (uint32_t num_instances = 1; num_instances <= k_max_num_instances; num_instances *= 2)
+	{
+		double single_elapsed_ns = 1.0e30;
+		double batch_elapsed_ns = 1.0e30;
+
+		for (uint32_t iteration = 0; iteration < k_num_iterations; ++iteration)
+		{
+			// Whichever runs second is measured a few percent slower, alternate to cancel it out
+			for (uint32_t run_index = 0; run_index < 2; ++run_index)
+			{
+				if (((iteration + run_index) % 2) == 0)
+				{
+					const auto single_start = std::chrono::high_resolution_clock::now();
+					for (uint32_t instance_index = 0; instance_index < num_instances; ++instance_index)
+						decompress_pose(settings, *compressed_clip, contexts[instance_index], sample_times[instance_index], writers[instance_index]);
+					const auto single_end = std::chrono::high_resolution_clock::now();
+
+					single_elapsed_ns = std::min(single_elapsed_ns, double(std::chrono::duration_cast<std::chrono::nanoseconds>(single_end - single_start).count()));
+				}
+				else
+				{
+					const auto batch_start = std::chrono::high_resolution_clock::now();
+					decompress_poses(settings, *compressed_clip, instances.data(), num_instances);
+					const auto batch_end = std::chrono::high_resolution_clock::now();
+
+					batch_elapsed_ns = std::min(batch_elapsed_ns, double(std::chrono::duration_cast<std::chrono::nanoseconds>(batch_end - batch_start).count()));
+				}
+			}
+		}
+
+		std::printf("    N = %3u: decompress_pose %8.1f ns, decompress_poses %8.1f ns\n", num_instances, single_elapsed_ns / num_instances, batch_elapsed_ns / num_instances);
+	}
+
+	for (void* context : contexts)
+		deallocate_decompression_context(allocator, context);
+}
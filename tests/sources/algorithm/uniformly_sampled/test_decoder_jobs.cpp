@@ -0,0 +1,122 @@
+////////////////////////////////////////////////////////////////////////////////
+// The MIT License (MIT)
+//
+// Copyright (c) 2017 Nicholas Frechette & Animation Compression Library contributors
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+////////////////////////////////////////////////////////////////////////////////
+
+#include <catch.hpp>
+
+#include "../../error_exceptions.h"
+#include "test_clip_utils.h"
+
+#include <acl/algorithm/uniformly_sampled/decoder.h>
+#include <acl/algorithm/uniformly_sampled/decoder_jobs.h>
+#include <acl/core/ansi_allocator.h>
+#include <acl/core/thread_job_executor.h>
+#include <acl/decompression/default_output_writer.h>
+
+#include <algorithm>
+#include <vector>
+
+using namespace acl;
+using namespace acl::test_utils;
+using namespace acl::uniformly_sampled;
+
+TEST_CASE("uniformly sampled parallel decompression requests", "[algorithm][uniformly_sampled]")
+{
+	ANSIAllocator allocator;
+
+	constexpr uint32_t k_num_clips = 2;
+	constexpr uint32_t k_num_requests = 300;
+	const uint16_t num_bones_per_clip[k_num_clips] = { 7, 13 };
+	const uint32_t num_samples_per_clip[k_num_clips] = { 45, 31 };
+
+	CompressionSettings compression_settings = make_segmented_compression_settings();
+
+	TestClip test_clips[k_num_clips];
+	CompressedClipPtr compressed_clips[k_num_clips];
+	for (uint32_t clip_index = 0; clip_index < k_num_clips; ++clip_index)
+	{
+		test_clips[clip_index] = make_test_clip(allocator, num_bones_per_clip[clip_index], num_samples_per_clip[clip_index]);
+		compressed_clips[clip_index] = compress_test_clip(allocator, test_clips[clip_index], compression_settings);
+	}
+
+	DecompressionSettings settings;
+
+	// Requests for both clips are interleaved and sample times are scattered to exercise the sort
+	const uint16_t max_num_bones = *std::max_element(num_bones_per_clip, num_bones_per_clip + k_num_clips);
+	std::vector<Transform_32> transforms(k_num_requests * max_num_bones);
+	std::vector<DefaultOutputWriter> writers;
+	std::vector<DecompressionRequest<DefaultOutputWriter>> requests(k_num_requests);
+	writers.reserve(k_num_requests);
+	for (uint32_t request_index = 0; request_index < k_num_requests; ++request_index)
+	{
+		const uint32_t clip_index = (request_index * 7) % k_num_clips;
+		const uint16_t num_bones = num_bones_per_clip[clip_index];
+		writers.emplace_back(&transforms[request_index * max_num_bones], num_bones);
+
+		requests[request_index].clip = compressed_clips[clip_index].get();
+		requests[request_index].context = allocate_decompression_context(allocator, settings, *compressed_clips[clip_index]);
+		requests[request_index].sample_time = test_clips[clip_index].clip->get_duration() * float((request_index * 37) % 101) / 100.0f;
+		requests[request_index].writer = &writers[request_index];
+	}
+
+	void* reference_contexts[k_num_clips];
+	for (uint32_t clip_index = 0; clip_index < k_num_clips; ++clip_index)
+		reference_contexts[clip_index] = allocate_decompression_context(allocator, settings, *compressed_clips[clip_index]);
+
+	std::vector<Transform_32> reference_transforms(max_num_bones);
+
+	ThreadJobExecutor single_thread_executor(1);
+	ThreadJobExecutor multi_thread_executor(4);
+	IJobExecutor* executors[] = { &single_thread_executor, &multi_thread_executor };
+	const uint32_t max_num_requests_per_job_list[] = { 1, 8, k_default_max_num_requests_per_job, k_num_requests };
+
+	for (IJobExecutor* executor : executors)
+	{
+		for (const uint32_t max_num_requests_per_job : max_num_requests_per_job_list)
+		{
+			std::fill(transforms.begin(), transforms.end(), transform_identity_32());
+
+			decompress_poses(allocator, *executor, settings, requests.data(), k_num_requests, max_num_requests_per_job);
+
+			for (uint32_t request_index = 0; request_index < k_num_requests; ++request_index)
+			{
+				const uint32_t clip_index = (request_index * 7) % k_num_clips;
+				const uint16_t num_bones = num_bones_per_clip[clip_index];
+
+				DefaultOutputWriter reference_writer(reference_transforms.data(), num_bones);
+				decompress_pose(settings, *compressed_clips[clip_index], reference_contexts[clip_index], requests[request_index].sample_time, reference_writer);
+
+				require_pose_near_equal(&transforms[request_index * max_num_bones], reference_transforms.data(), num_bones);
+			}
+		}
+	}
+
+	// Nothing to do is fine
+	decompress_poses(allocator, multi_thread_executor, settings, requests.data(), 0);
+
+	for (uint32_t clip_index = 0; clip_index < k_num_clips; ++clip_index)
+		deallocate_decompression_context(allocator, reference_contexts[clip_index]);
+
+	for (const DecompressionRequest<DefaultOutputWriter>& request : requests)
+		deallocate_decompression_context(allocator, request.context);
+}
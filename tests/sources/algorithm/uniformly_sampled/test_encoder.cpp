@@ -0,0 +1,135 @@
+////////////////////////////////////////////////////////////////////////////////
+// The MIT License (MIT)
+//
+// Copyright (c) 2017 Nicholas Frechette & Animation Compression Library contributors
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+////////////////////////////////////////////////////////////////////////////////
+
+#include <catch.hpp>
+
+#include "../../error_exceptions.h"
+#include "test_clip_utils.h"
+
+#include <acl/algorithm/uniformly_sampled/encoder.h>
+#include <acl/core/ansi_allocator.h>
+#include <acl/core/ijob_executor.h>
+#include <acl/core/linear_allocator.h>
+#include <acl/core/thread_job_executor.h>
+
+#include <cstring>
+#include <vector>
+
+using namespace acl;
+using namespace acl::test_utils;
+using namespace acl::uniformly_sampled;
+
+namespace
+{
+	// Runs every job serially in reverse order
+	class ReverseJobExecutor final : public IJobExecutor
+	{
+	public:
+		virtual void run_jobs(uint32_t num_jobs, JobFunction function, void* user_data) override
+		{
+			for (uint32_t job_index = num_jobs; job_index != 0; --job_index)
+				function(user_data, job_index - 1);
+		}
+	};
+
+	bool are_compressed_clips_identical(const CompressedClip& lhs, const CompressedClip& rhs)
+	{
+		return lhs.get_size() == rhs.get_size() && std::memcmp(&lhs, &rhs, lhs.get_size()) == 0;
+	}
+}
+
+TEST_CASE("uniformly sampled parallel segment quantization", "[algorithm][uniformly_sampled]")
+{
+	ANSIAllocator allocator;
+
+	constexpr uint16_t k_num_bones = 9;
+	constexpr uint32_t k_num_samples = 90;
+
+	const TestClip test_clip = make_test_clip(allocator, k_num_bones, k_num_samples);
+
+	CompressionSettings variable_settings = make_segmented_compression_settings();
+
+	CompressionSettings fixed_settings = make_fixed_compression_settings();
+	fixed_settings.segmenting = variable_settings.segmenting;
+
+	const CompressionSettings compression_settings_list[] = { variable_settings, fixed_settings };
+	for (const CompressionSettings& compression_settings : compression_settings_list)
+	{
+		CompressedClipPtr serial_clip = compress_test_clip(allocator, test_clip, compression_settings);
+		REQUIRE(get_clip_header(*serial_clip).num_segments > 1);
+
+		ThreadJobExecutor thread_executor(4);
+		CompressionSettings threaded_settings = compression_settings;
+		threaded_settings.job_executor = &thread_executor;
+
+		CompressedClipPtr threaded_clip = compress_test_clip(allocator, test_clip, threaded_settings);
+		REQUIRE(thread_executor.get_num_jobs_run() == get_clip_header(*serial_clip).num_segments);
+		REQUIRE(are_compressed_clips_identical(*serial_clip, *threaded_clip));
+
+		ReverseJobExecutor reverse_executor;
+		CompressionSettings reverse_settings = compression_settings;
+		reverse_settings.job_executor = &reverse_executor;
+
+		CompressedClipPtr reverse_clip = compress_test_clip(allocator, test_clip, reverse_settings);
+		REQUIRE(are_compressed_clips_identical(*serial_clip, *reverse_clip));
+	}
+}
+
+TEST_CASE("uniformly sampled scratch allocator", "[algorithm][uniformly_sampled]")
+{
+	ANSIAllocator allocator;
+
+	constexpr uint16_t k_num_bones = 9;
+	constexpr uint32_t k_num_samples = 90;
+
+	const TestClip test_clip = make_test_clip(allocator, k_num_bones, k_num_samples);
+
+	CompressionSettings variable_settings = make_segmented_compression_settings();
+
+	const CompressionSettings compression_settings_list[] = { variable_settings, make_fixed_compression_settings() };
+	for (const CompressionSettings& compression_settings : compression_settings_list)
+	{
+		CompressedClipPtr reference_clip = compress_test_clip(allocator, test_clip, compression_settings);
+
+		LinearAllocator scratch_allocator(allocator, 16 * 1024);
+		CompressedClipPtr scratch_clip = compress_test_clip(allocator, scratch_allocator, test_clip, compression_settings);
+		REQUIRE(are_compressed_clips_identical(*reference_clip, *scratch_clip));
+
+		// Every transient allocation is released once compression completes and the last page is kept around
+		REQUIRE(scratch_allocator.get_allocation_count() == 0);
+		REQUIRE(scratch_allocator.get_num_pages() == 1);
+
+		// The compressed clip must not live in the scratch allocator since the clip outlives it
+		CompressedClipPtr second_scratch_clip = compress_test_clip(allocator, scratch_allocator, test_clip, compression_settings);
+		REQUIRE(are_compressed_clips_identical(*reference_clip, *second_scratch_clip));
+		REQUIRE(scratch_allocator.get_allocation_count() == 0);
+
+		// Segments quantized in parallel would race on the scratch allocator
+		ThreadJobExecutor thread_executor(2);
+		CompressionSettings threaded_settings = compression_settings;
+		threaded_settings.job_executor = &thread_executor;
+		REQUIRE_THROWS(compress_test_clip(allocator, scratch_allocator, test_clip, threaded_settings));
+		REQUIRE(scratch_allocator.get_allocation_count() == 0);
+	}
+}
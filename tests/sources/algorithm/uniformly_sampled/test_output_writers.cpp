@@ -0,0 +1,418 @@
+////////////////////////////////////////////////////////////////////////////////
+// The MIT License (MIT)
+//
+// Copyright (c) 2017 Nicholas Frechette & Animation Compression Library contributors
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+////////////////////////////////////////////////////////////////////////////////
+
+#include <catch.hpp>
+
+#include "../../error_exceptions.h"
+#include "test_clip_utils.h"
+
+#include <acl/algorithm/uniformly_sampled/decoder.h>
+#include <acl/core/ansi_allocator.h>
+#include <acl/decompression/blend_output_writer.h>
+#include <acl/decompression/default_output_writer.h>
+#include <acl/decompression/object_space_output_writer.h>
+#include <acl/decompression/soa_output_writer.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <vector>
+
+using namespace acl;
+using namespace acl::test_utils;
+using namespace acl::uniformly_sampled;
+
+namespace
+{
+	template<uint32_t NumLanes>
+	void validate_soa_output_writer(IAllocator& allocator, const CompressedClip& compressed_clip, uint16_t num_bones, float clip_duration)
+	{
+		SoADecompressionSettings settings;
+		void* context = allocate_decompression_context(allocator, settings, compressed_clip);
+
+		std::vector<Transform_32> reference_transforms(num_bones);
+		DefaultOutputWriter reference_writer(reference_transforms.data(), num_bones);
+
+		const uint32_t num_groups = get_num_soa_transform_groups<NumLanes>(num_bones);
+		SoATransformGroup<NumLanes>* groups = allocate_type_array_aligned<SoATransformGroup<NumLanes>>(allocator, num_groups, alignof(SoATransformGroup<NumLanes>));
+		SoAOutputWriter<NumLanes> soa_writer(groups, num_bones);
+
+		for (uint32_t sample_index = 0; sample_index <= 20; ++sample_index)
+		{
+			const float sample_time = clip_duration * float(sample_index) / 20.0f;
+
+			decompress_pose(settings, compressed_clip, context, sample_time, reference_writer);
+			decompress_pose(settings, compressed_clip, context, sample_time, soa_writer);
+
+			for (uint16_t bone_index = 0; bone_index < num_bones; ++bone_index)
+			{
+				const Transform_32 soa_transform = get_soa_transform(groups, bone_index);
+				require_transform_near_equal(soa_transform, reference_transforms[bone_index], 0.0f);
+			}
+		}
+
+		deallocate_type_array(allocator, groups, num_groups);
+		deallocate_decompression_context(allocator, context);
+	}
+}
+
+TEST_CASE("uniformly sampled soa output writer", "[algorithm][uniformly_sampled]")
+{
+	ANSIAllocator allocator;
+
+	// Not a multiple of 4 to leave partial batches and groups behind
+	constexpr uint16_t k_num_bones = 23;
+	constexpr uint32_t k_num_samples = 40;
+
+	REQUIRE(get_num_soa_transform_groups<4>(k_num_bones) == 6);
+	REQUIRE(get_num_soa_transform_groups<8>(k_num_bones) == 3);
+
+	SkeletonPtr skeleton = make_test_skeleton(allocator, k_num_bones);
+
+	// Mixed track types scatter most of the animated lanes
+	AnimationClipPtr mixed_clip = make_test_clip(allocator, *skeleton, k_num_samples);
+
+	// When every track is animated, batches hold consecutive bones and are written with wide stores
+	AnimationClipPtr animated_clip = make_test_clip(allocator, *skeleton, k_num_samples);
+	AnimatedBone* animated_bones = animated_clip->get_bones();
+	for (uint16_t bone_index = 0; bone_index < k_num_bones; ++bone_index)
+	{
+		const AnimatedBone& source_bone = animated_bones[(bone_index / 4) * 4];
+		for (uint32_t sample_index = 0; sample_index < k_num_samples; ++sample_index)
+		{
+			const double offset = double(bone_index) * 0.01;
+			animated_bones[bone_index].rotation_track.set_sample(sample_index, quat_mul(source_bone.rotation_track.get_sample(sample_index), quat_from_euler(offset, 0.0, 0.0)));
+			animated_bones[bone_index].translation_track.set_sample(sample_index, vector_add(source_bone.translation_track.get_sample(sample_index), vector_set(offset)));
+			animated_bones[bone_index].scale_track.set_sample(sample_index, vector_add(source_bone.scale_track.get_sample(sample_index), vector_set(offset)));
+		}
+	}
+
+	const AnimationClip* clips[] = { mixed_clip.get(), animated_clip.get() };
+	for (const AnimationClip* clip : clips)
+	{
+		const CompressionSettings compression_settings_list[] = { make_fixed_compression_settings(), make_variable_compression_settings() };
+		for (const CompressionSettings& compression_settings : compression_settings_list)
+		{
+			CompressedClipPtr compressed_clip = compress_test_clip(allocator, *clip, *skeleton, compression_settings);
+
+			validate_soa_output_writer<4>(allocator, *compressed_clip, k_num_bones, clip->get_duration());
+			validate_soa_output_writer<8>(allocator, *compressed_clip, k_num_bones, clip->get_duration());
+		}
+	}
+}
+
+TEST_CASE("uniformly sampled object space output writer", "[algorithm][uniformly_sampled]")
+{
+	ANSIAllocator allocator;
+
+	constexpr uint16_t k_num_bones = 11;
+	constexpr uint32_t k_num_samples = 40;
+
+	const TestClip test_clip = make_test_clip(allocator, k_num_bones, k_num_samples);
+
+	// A tree with a few branches and a second root
+	uint16_t parent_indices[k_num_bones];
+	for (uint16_t bone_index = 0; bone_index < k_num_bones; ++bone_index)
+		parent_indices[bone_index] = (bone_index == 0 || bone_index == 7) ? k_root_bone_parent_index : uint16_t((bone_index - 1) / 2);
+
+	const CompressionSettings compression_settings_list[] = { make_fixed_compression_settings(), make_variable_compression_settings() };
+	for (const CompressionSettings& compression_settings : compression_settings_list)
+	{
+		CompressedClipPtr compressed_clip = compress_test_clip(allocator, test_clip, compression_settings);
+
+		DecompressionSettings settings;
+		void* context = allocate_decompression_context(allocator, settings, *compressed_clip);
+
+		Transform_32 local_transforms[k_num_bones];
+		Transform_32 object_transforms[k_num_bones];
+		AffineMatrix_32 object_matrices[k_num_bones];
+		DefaultOutputWriter local_writer(local_transforms, k_num_bones);
+		ObjectSpaceOutputWriter object_writer(object_transforms, parent_indices, k_num_bones);
+		ObjectSpaceMatrixOutputWriter object_matrix_writer(object_matrices, parent_indices, k_num_bones);
+
+		const float clip_duration = test_clip.clip->get_duration();
+		for (uint32_t sample_index = 0; sample_index <= 20; ++sample_index)
+		{
+			const float sample_time = clip_duration * float(sample_index) / 20.0f;
+
+			decompress_pose(settings, *compressed_clip, context, sample_time, local_writer);
+			decompress_pose(settings, *compressed_clip, context, sample_time, object_writer);
+			decompress_pose(settings, *compressed_clip, context, sample_time, object_matrix_writer);
+
+			// Reference conversion in a second pass, the local pose might come from the structure of arrays path
+			Transform_32 reference_transforms[k_num_bones];
+			AffineMatrix_32 reference_matrices[k_num_bones];
+			for (uint16_t bone_index = 0; bone_index < k_num_bones; ++bone_index)
+			{
+				const uint16_t parent_index = parent_indices[bone_index];
+				if (parent_index == k_root_bone_parent_index)
+				{
+					reference_transforms[bone_index] = local_transforms[bone_index];
+					reference_matrices[bone_index] = matrix_from_transform(local_transforms[bone_index]);
+				}
+				else
+				{
+					reference_transforms[bone_index] = transform_mul(local_transforms[bone_index], reference_transforms[parent_index]);
+					reference_matrices[bone_index] = matrix_mul(matrix_from_transform(local_transforms[bone_index]), reference_matrices[parent_index]);
+				}
+			}
+
+			for (uint16_t bone_index = 0; bone_index < k_num_bones; ++bone_index)
+			{
+				require_transform_near_equal(object_transforms[bone_index], reference_transforms[bone_index]);
+
+				REQUIRE(vector_all_near_equal(object_matrices[bone_index].x_axis, reference_matrices[bone_index].x_axis));
+				REQUIRE(vector_all_near_equal(object_matrices[bone_index].y_axis, reference_matrices[bone_index].y_axis));
+				REQUIRE(vector_all_near_equal(object_matrices[bone_index].z_axis, reference_matrices[bone_index].z_axis));
+				REQUIRE(vector_all_near_equal(object_matrices[bone_index].w_axis, reference_matrices[bone_index].w_axis));
+			}
+		}
+
+		deallocate_decompression_context(allocator, context);
+	}
+}
+
+namespace
+{
+	// Blends poses that were first decompressed into temporary poses, what callers had to do without 'BlendOutputWriter'
+	void blend_decompressed_poses(const Transform_32* const* layer_transforms, const float* layer_weights, uint32_t num_layers, uint16_t num_bones, Transform_32* out_transforms)
+	{
+		float total_weight = 0.0f;
+		for (uint32_t layer_index = 0; layer_index < num_layers; ++layer_index)
+			total_weight += layer_weights[layer_index];
+
+		const float inv_total_weight = 1.0f / total_weight;
+
+		for (uint16_t bone_index = 0; bone_index < num_bones; ++bone_index)
+		{
+			Vector4_32 rotation = vector_zero_32();
+			Vector4_32 translation = vector_zero_32();
+			Vector4_32 scale = vector_zero_32();
+
+			for (uint32_t layer_index = 0; layer_index < num_layers; ++layer_index)
+			{
+				const Transform_32& layer_transform = layer_transforms[layer_index][bone_index];
+				const Vector4_32 layer_rotation = quat_to_vector(layer_transform.rotation);
+				const float weight = layer_weights[layer_index];
+				const float rotation_weight = vector_dot(rotation, layer_rotation) >= 0.0f ? weight : -weight;
+
+				rotation = vector_add(rotation, vector_mul(layer_rotation, rotation_weight));
+				translation = vector_add(translation, vector_mul(layer_transform.translation, weight));
+				scale = vector_add(scale, vector_mul(layer_transform.scale, weight));
+			}
+
+			out_transforms[bone_index].rotation = quat_normalize(vector_to_quat(rotation));
+			out_transforms[bone_index].translation = vector_mul(translation, inv_total_weight);
+			out_transforms[bone_index].scale = vector_mul(scale, inv_total_weight);
+		}
+	}
+}
+
+TEST_CASE("uniformly sampled blend output writer", "[algorithm][uniformly_sampled]")
+{
+	ANSIAllocator allocator;
+
+	constexpr uint16_t k_num_bones = 11;
+	constexpr uint32_t k_num_samples = 40;
+	constexpr uint32_t k_num_layers = 3;
+
+	const TestClip test_clip = make_test_clip(allocator, k_num_bones, k_num_samples);
+	CompressedClipPtr compressed_clip = compress_test_clip(allocator, test_clip, make_variable_compression_settings());
+
+	DecompressionSettings settings;
+	void* context = allocate_decompression_context(allocator, settings, *compressed_clip);
+
+	const float clip_duration = test_clip.clip->get_duration();
+	const float layer_sample_times[k_num_layers] = { 0.1f * clip_duration, 0.45f * clip_duration, 0.8f * clip_duration };
+
+	Transform_32 layer_transforms[k_num_layers][k_num_bones];
+	for (uint32_t layer_index = 0; layer_index < k_num_layers; ++layer_index)
+	{
+		DefaultOutputWriter layer_writer(layer_transforms[layer_index], k_num_bones);
+		decompress_pose(settings, *compressed_clip, context, layer_sample_times[layer_index], layer_writer);
+	}
+
+	const Transform_32* layer_transform_ptrs[k_num_layers] = { layer_transforms[0], layer_transforms[1], layer_transforms[2] };
+
+	// Two layers with weights that sum to one match a plain interpolation
+	{
+		constexpr float k_alpha = 0.3f;
+
+		Transform_32 blended_transforms[k_num_bones];
+		blend_pose_reset(blended_transforms, k_num_bones);
+
+		BlendOutputWriter layer0_writer(blended_transforms, k_num_bones, 1.0f - k_alpha);
+		decompress_pose(settings, *compressed_clip, context, layer_sample_times[0], layer0_writer);
+		BlendOutputWriter layer1_writer(blended_transforms, k_num_bones, k_alpha);
+		decompress_pose(settings, *compressed_clip, context, layer_sample_times[1], layer1_writer);
+
+		blend_pose_finalize(blended_transforms, k_num_bones, 1.0f);
+
+		for (uint16_t bone_index = 0; bone_index < k_num_bones; ++bone_index)
+		{
+			REQUIRE(quat_near_equal(blended_transforms[bone_index].rotation, quat_lerp(layer_transforms[0][bone_index].rotation, layer_transforms[1][bone_index].rotation, k_alpha)));
+			REQUIRE(vector_all_near_equal3(blended_transforms[bone_index].translation, vector_lerp(layer_transforms[0][bone_index].translation, layer_transforms[1][bone_index].translation, k_alpha)));
+			REQUIRE(vector_all_near_equal3(blended_transforms[bone_index].scale, vector_lerp(layer_transforms[0][bone_index].scale, layer_transforms[1][bone_index].scale, k_alpha)));
+		}
+	}
+
+	// Weights that do not sum to one are normalized when the pose is finalized
+	{
+		const float layer_weights[k_num_layers] = { 0.75f, 0.5f, 1.25f };
+
+		Transform_32 reference_transforms[k_num_bones];
+		blend_decompressed_poses(layer_transform_ptrs, layer_weights, k_num_layers, k_num_bones, reference_transforms);
+
+		Transform_32 blended_transforms[k_num_bones];
+		blend_pose_reset(blended_transforms, k_num_bones);
+
+		float total_weight = 0.0f;
+		for (uint32_t layer_index = 0; layer_index < k_num_layers; ++layer_index)
+		{
+			BlendOutputWriter writer(blended_transforms, k_num_bones, layer_weights[layer_index]);
+			decompress_pose(settings, *compressed_clip, context, layer_sample_times[layer_index], writer);
+			total_weight += layer_weights[layer_index];
+		}
+
+		blend_pose_finalize(blended_transforms, k_num_bones, total_weight);
+
+		require_pose_near_equal(blended_transforms, reference_transforms, k_num_bones);
+	}
+
+	// Additive layers are applied on top of the base pose, a zero weight leaves it untouched
+	{
+		const float additive_weights[] = { 0.0f, 0.4f, 1.0f };
+		for (const float additive_weight : additive_weights)
+		{
+			Transform_32 blended_transforms[k_num_bones];
+			std::memcpy(blended_transforms, layer_transforms[0], sizeof(blended_transforms));
+
+			AdditiveBlendOutputWriter writer(blended_transforms, k_num_bones, additive_weight);
+			decompress_pose(settings, *compressed_clip, context, layer_sample_times[2], writer);
+
+			for (uint16_t bone_index = 0; bone_index < k_num_bones; ++bone_index)
+			{
+				const Transform_32& base = layer_transforms[0][bone_index];
+				const Transform_32& additive = layer_transforms[2][bone_index];
+
+				const Quat_32 expected_rotation = quat_mul(quat_lerp(quat_identity_32(), additive.rotation, additive_weight), base.rotation);
+				const Vector4_32 expected_translation = vector_add(base.translation, vector_mul(additive.translation, additive_weight));
+				const Vector4_32 expected_scale = vector_mul(base.scale, vector_lerp(vector_set(1.0f), additive.scale, additive_weight));
+
+				REQUIRE(quat_near_equal(blended_transforms[bone_index].rotation, expected_rotation));
+				REQUIRE(vector_all_near_equal3(blended_transforms[bone_index].translation, expected_translation));
+				REQUIRE(vector_all_near_equal3(blended_transforms[bone_index].scale, expected_scale));
+			}
+		}
+	}
+
+	deallocate_decompression_context(allocator, context);
+}
+
+// Hidden by default, run explicitly with: acl_unit_tests [benchmark]
+TEST_CASE("uniformly sampled blend output writer benchmark", "[.][benchmark]")
+{
+	ANSIAllocator allocator;
+
+	constexpr uint16_t k_num_bones = 64;
+	constexpr uint32_t k_num_samples = 61;
+	constexpr uint32_t k_num_sample_times = 64;
+	constexpr uint32_t k_num_iterations = 20;
+	constexpr uint32_t k_max_num_layers = 8;
+
+	const TestClip test_clip = make_test_clip(allocator, k_num_bones, k_num_samples);
+	CompressedClipPtr compressed_clip = compress_test_clip(allocator, test_clip, make_variable_compression_settings());
+
+	DecompressionSettings settings;
+	const float clip_duration = test_clip.clip->get_duration();
+
+	void* contexts[k_max_num_layers];
+	for (uint32_t layer_index = 0; layer_index < k_max_num_layers; ++layer_index)
+		contexts[layer_index] = allocate_decompression_context(allocator, settings, *compressed_clip);
+
+	std::vector<Transform_32> layer_transforms(k_max_num_layers * k_num_bones);
+	std::vector<Transform_32> blended_transforms(k_num_bones);
+
+	std::vector<DefaultOutputWriter> layer_writers;
+	const Transform_32* layer_transform_ptrs[k_max_num_layers];
+	float layer_weights[k_max_num_layers];
+	for (uint32_t layer_index = 0; layer_index < k_max_num_layers; ++layer_index)
+	{
+		layer_writers.emplace_back(&layer_transforms[layer_index * k_num_bones], k_num_bones);
+		layer_transform_ptrs[layer_index] = &layer_transforms[layer_index * k_num_bones];
+		layer_weights[layer_index] = 1.0f / float(layer_index + 1);
+	}
+
+	const uint32_t num_layers_list[] = { 2, 4, 8 };
+	for (const uint32_t num_layers : num_layers_list)
+	{
+		float total_weight = 0.0f;
+		for (uint32_t layer_index = 0; layer_index < num_layers; ++layer_index)
+			total_weight += layer_weights[layer_index];
+
+		double temporary_elapsed_ns = 1.0e30;
+		double writer_elapsed_ns = 1.0e30;
+
+		for (uint32_t iteration = 0; iteration < k_num_iterations; ++iteration)
+		{
+			const auto temporary_start = std::chrono::high_resolution_clock::now();
+			for (uint32_t sample_index = 0; sample_index < k_num_sample_times; ++sample_index)
+			{
+				for (uint32_t layer_index = 0; layer_index < num_layers; ++layer_index)
+				{
+					const float sample_time = clip_duration * float((sample_index + layer_index * 7) % k_num_sample_times) / float(k_num_sample_times - 1);
+					decompress_pose(settings, *compressed_clip, contexts[layer_index], sample_time, layer_writers[layer_index]);
+				}
+
+				blend_decompressed_poses(layer_transform_ptrs, layer_weights, num_layers, k_num_bones, blended_transforms.data());
+			}
+			const auto temporary_end = std::chrono::high_resolution_clock::now();
+
+			const auto writer_start = std::chrono::high_resolution_clock::now();
+			for (uint32_t sample_index = 0; sample_index < k_num_sample_times; ++sample_index)
+			{
+				blend_pose_reset(blended_transforms.data(), k_num_bones);
+
+				for (uint32_t layer_index = 0; layer_index < num_layers; ++layer_index)
+				{
+					const float sample_time = clip_duration * float((sample_index + layer_index * 7) % k_num_sample_times) / float(k_num_sample_times - 1);
+					BlendOutputWriter writer(blended_transforms.data(), k_num_bones, layer_weights[layer_index]);
+					decompress_pose(settings, *compressed_clip, contexts[layer_index], sample_time, writer);
+				}
+
+				blend_pose_finalize(blended_transforms.data(), k_num_bones, total_weight);
+			}
+			const auto writer_end = std::chrono::high_resolution_clock::now();
+
+			temporary_elapsed_ns = std::min(temporary_elapsed_ns, double(std::chrono::duration_cast<std::chrono::nanoseconds>(temporary_end - temporary_start).count()));
+			writer_elapsed_ns = std::min(writer_elapsed_ns, double(std::chrono::duration_cast<std::chrono::nanoseconds>(writer_end - writer_start).count()));
+		}
+
+		std::printf("Blend of %u layers with %u bones: decompress then blend %8.1f ns, blend in writer %8.1f ns\n", num_layers, k_num_bones, temporary_elapsed_ns / k_num_sample_times, writer_elapsed_ns / k_num_sample_times);
+	}
+
+	for (uint32_t layer_index = 0; layer_index < k_max_num_layers; ++layer_index)
+		deallocate_decompression_context(allocator, contexts[layer_index]);
+}
@@ -38,6 +38,7 @@ TEST_CASE("ANSI allocator", "[core][memory]")
 {
 	ANSIAllocator allocator;
 	REQUIRE(allocator.get_allocation_count() == 0);
+	REQUIRE(allocator.is_thread_safe());
 
 	void* ptr0 = allocator.allocate(32);
 	REQUIRE(allocator.get_allocation_count() == 1);
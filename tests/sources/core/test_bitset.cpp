@@ -118,4 +118,9 @@ TEST_CASE("bitset", "[core][utils]")
 
 	bitset_data[2] = 0xFFFFFFFF;
 	REQUIRE(bitset_count_set_bits(&bitset_data[0], desc) == 4);
+
+	REQUIRE(count_set_bits(0x00000000) == 0);
+	REQUIRE(count_set_bits(0x80000001) == 2);
+	REQUIRE(count_set_bits(0x92492492) == 11);
+	REQUIRE(count_set_bits(0xFFFFFFFF) == 32);
 }
@@ -0,0 +1,93 @@
+////////////////////////////////////////////////////////////////////////////////
+// The MIT License (MIT)
+//
+// Copyright (c) 2018 Nicholas Frechette & Animation Compression Library contributors
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+////////////////////////////////////////////////////////////////////////////////
+
+#include <catch.hpp>
+
+#include "../error_exceptions.h"
+#include <acl/core/ansi_allocator.h>
+#include <acl/core/linear_allocator.h>
+#include <acl/core/memory_utils.h>
+
+#include <cstring>
+
+using namespace acl;
+
+TEST_CASE("linear allocator", "[core][memory]")
+{
+	ANSIAllocator backing_allocator;
+
+	{
+		LinearAllocator allocator(backing_allocator, 1024);
+		REQUIRE(allocator.get_allocation_count() == 0);
+		REQUIRE(allocator.get_num_pages() == 0);
+
+		void* ptr0 = allocator.allocate(32);
+		REQUIRE(allocator.get_allocation_count() == 1);
+		REQUIRE(allocator.get_num_pages() == 1);
+		REQUIRE(is_aligned_to(ptr0, IAllocator::k_default_alignment));
+
+		void* ptr1 = allocator.allocate(48, 256);
+		REQUIRE(allocator.get_allocation_count() == 2);
+		REQUIRE(allocator.get_num_pages() == 1);
+		REQUIRE(is_aligned_to(ptr1, 256));
+		REQUIRE(ptr1 > ptr0);
+
+		// The most recent allocation is reclaimed immediately
+		allocator.deallocate(ptr1, 48);
+		REQUIRE(allocator.get_allocation_count() == 1);
+		void* ptr2 = allocator.allocate(48, 256);
+		REQUIRE(ptr2 == ptr1);
+
+		// Allocations larger than a page get a dedicated page
+		void* ptr3 = allocator.allocate(4096);
+		REQUIRE(allocator.get_allocation_count() == 3);
+		REQUIRE(allocator.get_num_pages() == 2);
+		std::memset(ptr3, 0xCD, 4096);
+
+		// Filling up a page requests a new one
+		void* ptr4 = allocator.allocate(900);
+		REQUIRE(allocator.get_num_pages() == 3);
+
+		allocator.deallocate(ptr0, 32);
+		allocator.deallocate(ptr2, 48);
+		allocator.deallocate(ptr3, 4096);
+		REQUIRE(allocator.get_allocation_count() == 1);
+		REQUIRE(allocator.get_num_pages() == 3);
+
+		// Once everything is released, only the last page remains and it is reused
+		allocator.deallocate(ptr4, 900);
+		REQUIRE(allocator.get_allocation_count() == 0);
+		REQUIRE(allocator.get_num_pages() == 1);
+
+		void* ptr5 = allocator.allocate(900);
+		REQUIRE(ptr5 == ptr4);
+		REQUIRE(allocator.get_num_pages() == 1);
+		allocator.deallocate(ptr5, 900);
+
+		allocator.deallocate(nullptr, 0);
+		REQUIRE(allocator.get_allocation_count() == 0);
+	}
+
+	REQUIRE(backing_allocator.get_allocation_count() == 0);
+}
@@ -0,0 +1,108 @@
+////////////////////////////////////////////////////////////////////////////////
+// The MIT License (MIT)
+//
+// Copyright (c) 2018 Nicholas Frechette & Animation Compression Library contributors
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+////////////////////////////////////////////////////////////////////////////////
+
+#include <catch.hpp>
+
+#include "../error_exceptions.h"
+#include <acl/core/ansi_allocator.h>
+#include <acl/core/memory_utils.h>
+#include <acl/core/pool_allocator.h>
+
+#include <cstring>
+
+using namespace acl;
+
+TEST_CASE("pool allocator", "[core][memory]")
+{
+	ANSIAllocator backing_allocator;
+
+	{
+		PoolAllocator allocator(backing_allocator, 72, 8, 4);
+		REQUIRE(allocator.get_block_size() == 72);
+		REQUIRE(allocator.get_allocation_count() == 0);
+		REQUIRE(allocator.get_num_pages() == 0);
+		REQUIRE(allocator.get_reserved_size() == 0);
+
+		// Blocks are handed out contiguously within a page
+		void* ptrs[5];
+		for (uint32_t block_index = 0; block_index < 4; ++block_index)
+		{
+			ptrs[block_index] = allocator.allocate(72, 8);
+			REQUIRE(is_aligned_to(ptrs[block_index], 8));
+			std::memset(ptrs[block_index], 0xCD, 72);
+
+			if (block_index != 0)
+				REQUIRE(ptrs[block_index] == add_offset_to_ptr<void>(ptrs[block_index - 1], 72));
+		}
+
+		REQUIRE(allocator.get_allocation_count() == 4);
+		REQUIRE(allocator.get_num_pages() == 1);
+
+		// A full page requests a new one
+		ptrs[4] = allocator.allocate(72, 8);
+		REQUIRE(allocator.get_allocation_count() == 5);
+		REQUIRE(allocator.get_num_pages() == 2);
+
+		// Released blocks are reused first
+		allocator.deallocate(ptrs[2], 72);
+		REQUIRE(allocator.get_allocation_count() == 4);
+		void* ptr = allocator.allocate(64, 8);
+		REQUIRE(ptr == ptrs[2]);
+		ptrs[2] = ptr;
+
+		for (void* block : ptrs)
+			allocator.deallocate(block, 72);
+
+		allocator.deallocate(nullptr, 0);
+		REQUIRE(allocator.get_allocation_count() == 0);
+
+		// Pages are kept until the pool is destroyed
+		REQUIRE(allocator.get_num_pages() == 2);
+		REQUIRE(backing_allocator.get_allocation_count() == 2);
+	}
+
+	REQUIRE(backing_allocator.get_allocation_count() == 0);
+
+	{
+		// Blocks are large enough to be threaded in the free list and are padded to their alignment
+		PoolAllocator allocator(backing_allocator, 1, 1, 2);
+		REQUIRE(allocator.get_block_size() == sizeof(void*));
+
+		PoolAllocator aligned_allocator(backing_allocator, 20, 16, 2);
+		REQUIRE(aligned_allocator.get_block_size() == 32);
+
+		void* ptr0 = aligned_allocator.allocate(20, 16);
+		void* ptr1 = aligned_allocator.allocate(20, 16);
+		REQUIRE(is_aligned_to(ptr0, 16));
+		REQUIRE(is_aligned_to(ptr1, 16));
+
+		REQUIRE_THROWS(aligned_allocator.allocate(33, 16));
+		REQUIRE_THROWS(aligned_allocator.allocate(16, 64));
+
+		aligned_allocator.deallocate(ptr0, 20);
+		aligned_allocator.deallocate(ptr1, 20);
+	}
+
+	REQUIRE(backing_allocator.get_allocation_count() == 0);
+}
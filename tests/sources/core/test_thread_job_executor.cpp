@@ -0,0 +1,107 @@
+////////////////////////////////////////////////////////////////////////////////
+// The MIT License (MIT)
+//
+// Copyright (c) 2018 Nicholas Frechette & Animation Compression Library contributors
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+////////////////////////////////////////////////////////////////////////////////
+
+#include <catch.hpp>
+
+#include "../error_exceptions.h"
+#include <acl/core/thread_job_executor.h>
+
+#include <atomic>
+#include <chrono>
+#include <thread>
+#include <vector>
+
+using namespace acl;
+
+namespace
+{
+	struct JobCounters
+	{
+		std::vector<std::atomic<uint32_t>> num_runs;
+		uint32_t slow_job_index_end;
+
+		JobCounters(uint32_t num_jobs, uint32_t slow_job_index_end_) : num_runs(num_jobs), slow_job_index_end(slow_job_index_end_)
+		{
+			for (std::atomic<uint32_t>& num_run : num_runs)
+				num_run = 0;
+		}
+
+		static void run_job(void* user_data, uint32_t job_index)
+		{
+			JobCounters& counters = *static_cast<JobCounters*>(user_data);
+
+			// The first jobs are much slower than the rest, the workers that own them need help
+			if (job_index < counters.slow_job_index_end)
+				std::this_thread::sleep_for(std::chrono::milliseconds(2));
+
+			counters.num_runs[job_index]++;
+		}
+	};
+}
+
+TEST_CASE("thread job executor", "[core][jobs]")
+{
+	{
+		ThreadJobExecutor executor(1);
+		REQUIRE(executor.get_num_threads() == 1);
+
+		JobCounters counters(37, 0);
+		executor.run_jobs(37, &JobCounters::run_job, &counters);
+
+		for (const std::atomic<uint32_t>& num_runs : counters.num_runs)
+			REQUIRE(num_runs == 1);
+
+		REQUIRE(executor.get_num_jobs_stolen() == 0);
+		REQUIRE(executor.get_num_jobs_run() == 37);
+	}
+
+	{
+		ThreadJobExecutor executor(4);
+		REQUIRE(executor.get_num_threads() == 4);
+
+		// Nothing to do returns right away
+		executor.run_jobs(0, &JobCounters::run_job, nullptr);
+
+		// Fewer jobs than threads, many jobs, and the executor is reused between runs
+		const uint32_t num_jobs_list[] = { 1, 3, 1000, 17 };
+		for (const uint32_t num_jobs : num_jobs_list)
+		{
+			JobCounters counters(num_jobs, 0);
+			executor.run_jobs(num_jobs, &JobCounters::run_job, &counters);
+
+			for (const std::atomic<uint32_t>& num_runs : counters.num_runs)
+				REQUIRE(num_runs == 1);
+		}
+
+		// Every slow job starts out on the first worker, the others steal them once they are done
+		JobCounters counters(64, 16);
+		executor.run_jobs(64, &JobCounters::run_job, &counters);
+
+		for (const std::atomic<uint32_t>& num_runs : counters.num_runs)
+			REQUIRE(num_runs == 1);
+
+		REQUIRE(executor.get_num_jobs_stolen() != 0);
+		REQUIRE(executor.get_num_jobs_run() == 1 + 3 + 1000 + 17 + 64);
+	}
+}
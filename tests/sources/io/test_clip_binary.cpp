@@ -0,0 +1,206 @@
+////////////////////////////////////////////////////////////////////////////////
+// The MIT License (MIT)
+//
+// Copyright (c) 2018 Nicholas Frechette & Animation Compression Library contributors
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+////////////////////////////////////////////////////////////////////////////////
+
+#include "../algorithm/uniformly_sampled/test_clip_utils.h"
+
+#include <acl/core/ansi_allocator.h>
+#include <acl/io/clip_binary_reader.h>
+#include <acl/io/clip_binary_writer.h>
+
+#include <cstring>
+
+using namespace acl;
+using namespace acl::test_utils;
+
+namespace
+{
+	SkeletonPtr make_named_test_skeleton(IAllocator& allocator)
+	{
+		const char* bone_names[] = { "root", "spine", "left_arm", "right_arm", "head", "" };
+		const uint16_t parent_indices[] = { k_invalid_bone_index, 0, 1, 1, 1, 4 };
+		constexpr uint16_t k_num_bones = uint16_t(get_array_size(parent_indices));
+
+		RigidBone bones[k_num_bones];
+		for (uint16_t bone_index = 0; bone_index < k_num_bones; ++bone_index)
+		{
+			RigidBone& bone = bones[bone_index];
+			bone.name = String(allocator, bone_names[bone_index]);
+			bone.parent_index = parent_indices[bone_index];
+			bone.vertex_distance = 1.0 + bone_index;
+			bone.bind_transform = transform_set(quat_from_euler(0.1 * bone_index, 0.2, -0.3), vector_set(1.0, 2.0 * bone_index, 3.0), vector_set(1.0, 1.5, 2.0));
+		}
+
+		return make_unique<RigidSkeleton>(allocator, allocator, &bones[0], k_num_bones);
+	}
+
+	void write_test_clip_binary(IAllocator& allocator, const RigidSkeleton& skeleton, const AnimationClip& clip, uint8_t*& out_buffer, uint32_t& out_buffer_size)
+	{
+		out_buffer_size = get_acl_clip_binary_size(skeleton, clip);
+		out_buffer = allocate_type_array_aligned<uint8_t>(allocator, out_buffer_size, k_clip_binary_alignment);
+		REQUIRE(write_acl_clip_binary(skeleton, clip, out_buffer, out_buffer_size));
+	}
+}
+
+TEST_CASE("binary clip round trip", "[io]")
+{
+	ANSIAllocator allocator;
+
+	SkeletonPtr skeleton = make_named_test_skeleton(allocator);
+	AnimationClipPtr clip = make_test_clip(allocator, *skeleton, 37);
+
+	uint8_t* buffer;
+	uint32_t buffer_size;
+	write_test_clip_binary(allocator, *skeleton, *clip, buffer, buffer_size);
+	REQUIRE(is_clip_binary(buffer, buffer_size));
+	REQUIRE(is_aligned_to(buffer_size, k_clip_binary_alignment));
+
+	{
+		ClipBinaryReader reader(allocator, buffer, buffer_size);
+
+		SkeletonPtr binary_skeleton;
+		REQUIRE(reader.read(binary_skeleton));
+		REQUIRE(reader.get_error() == ClipBinaryError::None);
+		REQUIRE(binary_skeleton->get_num_bones() == skeleton->get_num_bones());
+
+		for (uint16_t bone_index = 0; bone_index < skeleton->get_num_bones(); ++bone_index)
+		{
+			const RigidBone& bone = skeleton->get_bone(bone_index);
+			const RigidBone& binary_bone = binary_skeleton->get_bone(bone_index);
+
+			REQUIRE(binary_bone.name == bone.name);
+			REQUIRE(binary_bone.parent_index == bone.parent_index);
+			REQUIRE(binary_bone.vertex_distance == bone.vertex_distance);
+			REQUIRE(quat_near_equal(binary_bone.bind_transform.rotation, bone.bind_transform.rotation, 0.0));
+			REQUIRE(vector_all_near_equal3(binary_bone.bind_transform.translation, bone.bind_transform.translation, 0.0));
+			REQUIRE(vector_all_near_equal3(binary_bone.bind_transform.scale, bone.bind_transform.scale, 0.0));
+		}
+
+		AnimationClipPtr binary_clip;
+		REQUIRE(reader.read(binary_clip, *binary_skeleton));
+		REQUIRE(binary_clip->get_name() == clip->get_name());
+		REQUIRE(binary_clip->get_num_bones() == clip->get_num_bones());
+		REQUIRE(binary_clip->get_num_samples() == clip->get_num_samples());
+		REQUIRE(binary_clip->get_sample_rate() == clip->get_sample_rate());
+		REQUIRE(binary_clip->get_error_threshold() == clip->get_error_threshold());
+
+		for (uint16_t bone_index = 0; bone_index < clip->get_num_bones(); ++bone_index)
+		{
+			const AnimatedBone& bone = clip->get_animated_bone(bone_index);
+			const AnimatedBone& binary_bone = binary_clip->get_animated_bone(bone_index);
+
+			// Samples are used in place
+			REQUIRE_FALSE(binary_bone.rotation_track.is_sample_data_owned());
+			REQUIRE_FALSE(binary_bone.translation_track.is_sample_data_owned());
+			REQUIRE_FALSE(binary_bone.scale_track.is_sample_data_owned());
+			REQUIRE_THROWS(const_cast<AnimatedBone&>(binary_bone).scale_track.set_sample(0, vector_set(1.0)));
+
+			for (uint32_t sample_index = 0; sample_index < clip->get_num_samples(); ++sample_index)
+			{
+				REQUIRE(quat_near_equal(binary_bone.rotation_track.get_sample(sample_index), bone.rotation_track.get_sample(sample_index), 0.0));
+				REQUIRE(vector_all_near_equal3(binary_bone.translation_track.get_sample(sample_index), bone.translation_track.get_sample(sample_index), 0.0));
+				REQUIRE(vector_all_near_equal3(binary_bone.scale_track.get_sample(sample_index), bone.scale_track.get_sample(sample_index), 0.0));
+			}
+		}
+
+		// Both clips must compress to the exact same data
+		CompressedClipPtr compressed_clip = compress_test_clip(allocator, *clip, *skeleton, make_variable_compression_settings());
+		CompressedClipPtr binary_compressed_clip = compress_test_clip(allocator, *binary_clip, *binary_skeleton, make_variable_compression_settings());
+		REQUIRE(compressed_clip->get_size() == binary_compressed_clip->get_size());
+		REQUIRE(std::memcmp(compressed_clip.get(), binary_compressed_clip.get(), compressed_clip->get_size()) == 0);
+	}
+
+	deallocate_type_array(allocator, buffer, buffer_size);
+}
+
+TEST_CASE("binary clip validation", "[io]")
+{
+	ANSIAllocator allocator;
+
+	SkeletonPtr skeleton = make_named_test_skeleton(allocator);
+	AnimationClipPtr clip = make_test_clip(allocator, *skeleton, 8);
+
+	uint8_t* buffer;
+	uint32_t buffer_size;
+	write_test_clip_binary(allocator, *skeleton, *clip, buffer, buffer_size);
+
+	ClipBinaryHeader& header = *reinterpret_cast<ClipBinaryHeader*>(buffer);
+	SkeletonPtr binary_skeleton;
+
+	{
+		ClipBinaryReader reader(allocator, nullptr, buffer_size);
+		REQUIRE_FALSE(reader.read(binary_skeleton));
+		REQUIRE(reader.get_error() == ClipBinaryError::InvalidBuffer);
+	}
+
+	{
+		ClipBinaryReader reader(allocator, buffer + 8, buffer_size - 8);
+		REQUIRE_FALSE(reader.read(binary_skeleton));
+		REQUIRE(reader.get_error() == ClipBinaryError::InvalidBuffer);
+	}
+
+	{
+		ClipBinaryReader reader(allocator, buffer, buffer_size - 16);
+		REQUIRE_FALSE(reader.read(binary_skeleton));
+		REQUIRE(reader.get_error() == ClipBinaryError::InvalidSize);
+	}
+
+	{
+		header.tag = 0;
+		ClipBinaryReader reader(allocator, buffer, buffer_size);
+		REQUIRE_FALSE(reader.read(binary_skeleton));
+		REQUIRE(reader.get_error() == ClipBinaryError::InvalidTag);
+		header.tag = k_clip_binary_tag;
+	}
+
+	{
+		header.version = k_clip_binary_version + 1;
+		ClipBinaryReader reader(allocator, buffer, buffer_size);
+		REQUIRE_FALSE(reader.read(binary_skeleton));
+		REQUIRE(reader.get_error() == ClipBinaryError::UnsupportedVersion);
+		header.version = k_clip_binary_version;
+	}
+
+	{
+		ClipBinaryBone* bones = const_cast<ClipBinaryBone*>(header.bones_offset.add_to(buffer));
+		const PtrOffset32<const double> scales_offset = bones[2].scales_offset;
+		bones[2].scales_offset = header.size - 16;
+
+		ClipBinaryReader reader(allocator, buffer, buffer_size);
+		REQUIRE_FALSE(reader.read(binary_skeleton));
+		REQUIRE(reader.get_error() == ClipBinaryError::InvalidOffset);
+		bones[2].scales_offset = scales_offset;
+	}
+
+	{
+		ClipBinaryReader reader(allocator, buffer, buffer_size);
+		REQUIRE(reader.read(binary_skeleton));
+
+		SkeletonPtr other_skeleton = make_test_skeleton(allocator, 3);
+		AnimationClipPtr binary_clip;
+		REQUIRE_FALSE(reader.read(binary_clip, *other_skeleton));
+		REQUIRE(reader.get_error() == ClipBinaryError::InvalidNumBones);
+	}
+
+	deallocate_type_array(allocator, buffer, buffer_size);
+}
@@ -148,6 +148,16 @@ static void test_quat_impl(const Vector4Type& zero, const QuatType& identity, co
 		REQUIRE(quat_near_equal(result, result_ref, threshold));
 	}
 
+	{
+		QuatType quat = quat_from_euler(deg2rad(FloatType(30.0)), deg2rad(FloatType(-45.0)), deg2rad(FloatType(90.0)));
+		Vector4Type quat_ln = quat_log(quat);
+		REQUIRE(scalar_near_equal(vector_length3(quat_ln), quat_get_angle(quat) * FloatType(0.5), threshold));
+		REQUIRE(quat_near_equal(quat_exp(quat_ln), quat, threshold));
+
+		REQUIRE(vector_all_near_equal3(quat_log(identity), zero, threshold));
+		REQUIRE(quat_near_equal(quat_exp(zero), identity, threshold));
+	}
+
 	{
 		Vector4Type x_axis = vector_set(FloatType(1.0), FloatType(0.0), FloatType(0.0));
 		Vector4Type y_axis = vector_set(FloatType(0.0), FloatType(1.0), FloatType(0.0));
@@ -81,14 +81,53 @@ TEST_CASE("quat packing math", "[math][quat][packing]")
 		REQUIRE(scalar_near_equal(quat_get_w(quat0), quat_get_w(quat1), 1.0e-3f));
 	}
 
+	{
+		UnalignedBuffer tmp0;
+		pack_quat_32_largest(quat0, &tmp0.buffer[0]);
+		Quat_32 quat1 = unpack_quat_32_largest(&tmp0.buffer[0]);
+		REQUIRE(quat_near_equal(quat0, quat1, 2.0e-3f));
+
+		// The sign of the largest component is dropped, the quaternion is the same rotation
+		pack_quat_32_largest(quat_neg(quat0), &tmp0.buffer[0]);
+		quat1 = unpack_quat_32_largest(&tmp0.buffer[0]);
+		REQUIRE(quat_near_equal(quat0, quat1, 2.0e-3f));
+	}
+
+	{
+		UnalignedBuffer tmp0;
+		pack_quat_log_96(quat0, &tmp0.buffer[0]);
+		Quat_32 quat1 = unpack_quat_log_96(&tmp0.buffer[0]);
+		REQUIRE(quat_near_equal(quat0, quat1, 1.0e-5f));
+	}
+
+	{
+		UnalignedBuffer tmp0;
+		pack_quat_log_48(quat0, &tmp0.buffer[0]);
+		Quat_32 quat1 = unpack_quat_log_48(&tmp0.buffer[0]);
+		REQUIRE(quat_near_equal(quat0, quat1, 1.0e-4f));
+	}
+
+	{
+		UnalignedBuffer tmp0;
+		pack_quat_log_32(quat0, &tmp0.buffer[0]);
+		Quat_32 quat1 = unpack_quat_log_32(&tmp0.buffer[0]);
+		REQUIRE(quat_near_equal(quat0, quat1, 2.0e-3f));
+	}
+
 	REQUIRE(get_packed_rotation_size(RotationFormat8::Quat_128) == 16);
 	REQUIRE(get_packed_rotation_size(RotationFormat8::QuatDropW_96) == 12);
 	REQUIRE(get_packed_rotation_size(RotationFormat8::QuatDropW_48) == 6);
 	REQUIRE(get_packed_rotation_size(RotationFormat8::QuatDropW_32) == 4);
+	REQUIRE(get_packed_rotation_size(RotationFormat8::Quat_32_Largest) == 4);
+	REQUIRE(get_packed_rotation_size(RotationFormat8::QuatLog_96) == 12);
+	REQUIRE(get_packed_rotation_size(RotationFormat8::QuatLog_48) == 6);
+	REQUIRE(get_packed_rotation_size(RotationFormat8::QuatLog_32) == 4);
 
 	REQUIRE(get_range_reduction_rotation_size(RotationFormat8::Quat_128) == 32);
 	REQUIRE(get_range_reduction_rotation_size(RotationFormat8::QuatDropW_96) == 24);
 	REQUIRE(get_range_reduction_rotation_size(RotationFormat8::QuatDropW_48) == 24);
 	REQUIRE(get_range_reduction_rotation_size(RotationFormat8::QuatDropW_32) == 24);
 	REQUIRE(get_range_reduction_rotation_size(RotationFormat8::QuatDropW_Variable) == 24);
+	REQUIRE(get_range_reduction_rotation_size(RotationFormat8::QuatLog_96) == 24);
+	REQUIRE(get_range_reduction_rotation_size(RotationFormat8::QuatLog_Variable) == 24);
 }
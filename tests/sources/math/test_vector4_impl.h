@@ -282,6 +282,17 @@ void test_vector4_impl(const Vector4Type& zero, const QuatType& identity, const
 	REQUIRE(scalar_near_equal(vector_get_z(vector_reciprocal(test_value0)), acl::reciprocal(test_value0_flt[2]), threshold));
 	REQUIRE(scalar_near_equal(vector_get_w(vector_reciprocal(test_value0)), acl::reciprocal(test_value0_flt[3]), threshold));
 
+	const Vector4Type test_value_abs0 = vector_abs(test_value0);
+	REQUIRE(scalar_near_equal(vector_get_x(vector_sqrt(test_value_abs0)), acl::sqrt(acl::abs(test_value0_flt[0])), threshold));
+	REQUIRE(scalar_near_equal(vector_get_y(vector_sqrt(test_value_abs0)), acl::sqrt(acl::abs(test_value0_flt[1])), threshold));
+	REQUIRE(scalar_near_equal(vector_get_z(vector_sqrt(test_value_abs0)), acl::sqrt(acl::abs(test_value0_flt[2])), threshold));
+	REQUIRE(scalar_near_equal(vector_get_w(vector_sqrt(test_value_abs0)), acl::sqrt(acl::abs(test_value0_flt[3])), threshold));
+
+	REQUIRE(scalar_near_equal(vector_get_x(vector_sqrt_reciprocal(test_value_abs0)), acl::sqrt_reciprocal(acl::abs(test_value0_flt[0])), threshold));
+	REQUIRE(scalar_near_equal(vector_get_y(vector_sqrt_reciprocal(test_value_abs0)), acl::sqrt_reciprocal(acl::abs(test_value0_flt[1])), threshold));
+	REQUIRE(scalar_near_equal(vector_get_z(vector_sqrt_reciprocal(test_value_abs0)), acl::sqrt_reciprocal(acl::abs(test_value0_flt[2])), threshold));
+	REQUIRE(scalar_near_equal(vector_get_w(vector_sqrt_reciprocal(test_value_abs0)), acl::sqrt_reciprocal(acl::abs(test_value0_flt[3])), threshold));
+
 	const Vector4Type scalar_cross3_result = scalar_cross3<Vector4Type>(test_value0, test_value1);
 	const Vector4Type vector_cross3_result = vector_cross3(test_value0, test_value1);
 	REQUIRE(scalar_near_equal(vector_get_x(vector_cross3_result), vector_get_x(scalar_cross3_result), threshold));
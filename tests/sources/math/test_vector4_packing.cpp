@@ -286,3 +286,91 @@ TEST_CASE("vector4 packing math", "[math][vector4][packing]")
 	REQUIRE(get_packed_vector_size(VectorFormat8::Vector3_32) == 4);
 
 }
+
+TEST_CASE("vector4 variable bit rate unpacking", "[math][vector4][packing]")
+{
+	struct UnalignedBuffer
+	{
+		uint32_t padding0;
+		uint16_t padding1;
+		uint8_t buffer[64];
+	};
+
+	// Writes the value in big-endian order with the same layout as our compressed variable bit rate data
+	auto write_bits = [](uint32_t value, uint8_t num_bits, uint8_t* buffer, uint32_t bit_offset)
+	{
+		const uint32_t value_be = byte_swap(value << (32 - num_bits));
+		memcpy_bits(buffer, bit_offset, &value_be, 0, num_bits);
+	};
+
+	// Every value at every variable bit rate, with every offset within a byte, against the scalar reference.
+	// The second sample always uses the next bit rate to make sure the samples don't share their number of bits.
+	uint32_t num_errors = 0;
+	for (uint8_t bit_rate = k_lowest_bit_rate; bit_rate < k_highest_bit_rate; ++bit_rate)
+	{
+		const uint8_t num_bits0 = get_num_bits_at_bit_rate(bit_rate);
+		const uint8_t num_bits1 = get_num_bits_at_bit_rate(bit_rate + 1 < k_highest_bit_rate ? bit_rate + 1 : k_lowest_bit_rate);
+		const uint32_t max_value0 = (1 << num_bits0) - 1;
+		const uint32_t max_value1 = (1 << num_bits1) - 1;
+
+		for (uint32_t value = 0; value <= max_value0; ++value)
+		{
+			const uint32_t x0 = value;
+			const uint32_t y0 = (value * 7 + 3) & max_value0;
+			const uint32_t z0 = max_value0 - value;
+			const uint32_t x1 = (value * 3 + 1) & max_value1;
+			const uint32_t y1 = value & max_value1;
+			const uint32_t z1 = max_value1 - (value & max_value1);
+
+			const uint32_t bit_offset0 = value % 8;
+			const uint32_t bit_offset1 = (value + 3) % 8 + 8;
+
+			UnalignedBuffer tmp0;
+			UnalignedBuffer tmp1;
+			std::memset(&tmp0, 0, sizeof(tmp0));
+			std::memset(&tmp1, 0, sizeof(tmp1));
+			write_bits(x0, num_bits0, &tmp0.buffer[0], bit_offset0);
+			write_bits(y0, num_bits0, &tmp0.buffer[0], bit_offset0 + num_bits0);
+			write_bits(z0, num_bits0, &tmp0.buffer[0], bit_offset0 + num_bits0 * 2);
+			write_bits(x1, num_bits1, &tmp1.buffer[0], bit_offset1);
+			write_bits(y1, num_bits1, &tmp1.buffer[0], bit_offset1 + num_bits1);
+			write_bits(z1, num_bits1, &tmp1.buffer[0], bit_offset1 + num_bits1 * 2);
+
+			for (uint32_t is_unsigned = 0; is_unsigned < 2; ++is_unsigned)
+			{
+				const Vector4_32 ref0 = is_unsigned != 0
+					? vector_set(unpack_scalar_unsigned(x0, num_bits0), unpack_scalar_unsigned(y0, num_bits0), unpack_scalar_unsigned(z0, num_bits0))
+					: vector_set(unpack_scalar_signed(x0, num_bits0), unpack_scalar_signed(y0, num_bits0), unpack_scalar_signed(z0, num_bits0));
+				const Vector4_32 ref1 = is_unsigned != 0
+					? vector_set(unpack_scalar_unsigned(x1, num_bits1), unpack_scalar_unsigned(y1, num_bits1), unpack_scalar_unsigned(z1, num_bits1))
+					: vector_set(unpack_scalar_signed(x1, num_bits1), unpack_scalar_signed(y1, num_bits1), unpack_scalar_signed(z1, num_bits1));
+
+				const Vector4_32 vec0 = unpack_vector3_n(num_bits0, num_bits0, num_bits0, is_unsigned != 0, &tmp0.buffer[0], int32_t(bit_offset0));
+				if (std::memcmp(&vec0, &ref0, sizeof(Vector4_32)) != 0)
+					num_errors++;
+
+				Vector4_32 vec0_x2;
+				Vector4_32 vec1_x2;
+				unpack_vector3_n_x2(num_bits0, &tmp0.buffer[0], int32_t(bit_offset0), num_bits1, &tmp1.buffer[0], int32_t(bit_offset1), is_unsigned != 0, vec0_x2, vec1_x2);
+				if (std::memcmp(&vec0_x2, &ref0, sizeof(Vector4_32)) != 0)
+					num_errors++;
+				if (std::memcmp(&vec1_x2, &ref1, sizeof(Vector4_32)) != 0)
+					num_errors++;
+			}
+		}
+	}
+	REQUIRE(num_errors == 0);
+
+	{
+		// Mixed number of bits per component
+		UnalignedBuffer tmp0;
+		std::memset(&tmp0, 0, sizeof(tmp0));
+		write_bits(1234, 11, &tmp0.buffer[0], 5);
+		write_bits(77, 7, &tmp0.buffer[0], 5 + 11);
+		write_bits(65535, 16, &tmp0.buffer[0], 5 + 11 + 7);
+
+		const Vector4_32 ref = vector_set(unpack_scalar_unsigned(1234, 11), unpack_scalar_unsigned(77, 7), unpack_scalar_unsigned(65535, 16));
+		const Vector4_32 vec = unpack_vector3_n(11, 7, 16, true, &tmp0.buffer[0], 5);
+		REQUIRE(std::memcmp(&vec, &ref, sizeof(Vector4_32)) == 0);
+	}
+}
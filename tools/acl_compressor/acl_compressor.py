@@ -246,11 +246,15 @@ def compress_clips(options):
 		stat_dirname = dirpath.replace(acl_dir, stat_dir)
 
 		for filename in filenames:
-			if not filename.endswith('.acl.sjson'):
+			if filename.endswith('.acl.sjson'):
+				acl_extension = '.acl.sjson'
+			elif filename.endswith('.acl.bin'):
+				acl_extension = '.acl.bin'
+			else:
 				continue
 
 			acl_filename = os.path.join(dirpath, filename)
-			stat_filename = os.path.join(stat_dirname, filename.replace('.acl.sjson', '_stats.sjson'))
+			stat_filename = os.path.join(stat_dirname, filename.replace(acl_extension, '_stats.sjson'))
 
 			stat_files.append(stat_filename)
 
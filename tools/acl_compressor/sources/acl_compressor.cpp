@@ -70,13 +70,18 @@ static void assert_impl(bool expression, const char* format, ...)
 #include "acl/core/range_reduction_types.h"
 #include "acl/core/ansi_allocator.h"
 #include "acl/core/string.h"
+#include "acl/core/thread_job_executor.h"
 #include "acl/compression/skeleton.h"
 #include "acl/compression/animation_clip.h"
 #include "acl/io/clip_reader.h"
+#include "acl/io/clip_binary_reader.h"
+#include "acl/io/clip_binary_writer.h"
 #include "acl/compression/skeleton_error_metric.h"
 
 #include "acl/algorithm/uniformly_sampled/algorithm.h"
 
+#include <algorithm>
+#include <atomic>
 #include <cstring>
 #include <cstdio>
 #include <fstream>
@@ -84,6 +89,17 @@ static void assert_impl(bool expression, const char* format, ...)
 #include <sstream>
 #include <string>
 #include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#if !defined(_WIN32) && !defined(__ANDROID__)
+#include <dirent.h>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
 
 #ifdef _WIN32
 #include <conio.h>
@@ -150,6 +166,11 @@ struct Options
 #else
 	const char*		input_filename;
 	const char*		config_filename;
+	const char*		output_binary_filename;
+	const char*		output_compressed_filename;
+
+	const char*		batch_input_path;
+	uint32_t		num_threads;
 #endif
 
 	bool			output_stats;
@@ -169,6 +190,10 @@ struct Options
 #else
 		: input_filename(nullptr)
 		, config_filename(nullptr)
+		, output_binary_filename(nullptr)
+		, output_compressed_filename(nullptr)
+		, batch_input_path(nullptr)
+		, num_threads(0)
 #endif
 		, output_stats(false)
 		, output_stats_filename(nullptr)
@@ -185,6 +210,10 @@ struct Options
 #else
 		: input_filename(other.input_filename)
 		, config_filename(other.config_filename)
+		, output_binary_filename(other.output_binary_filename)
+		, output_compressed_filename(other.output_compressed_filename)
+		, batch_input_path(other.batch_input_path)
+		, num_threads(other.num_threads)
 #endif
 		, output_stats(other.output_stats)
 		, output_stats_filename(other.output_stats_filename)
@@ -210,6 +239,10 @@ struct Options
 #else
 		std::swap(input_filename, rhs.input_filename);
 		std::swap(config_filename, rhs.config_filename);
+		std::swap(output_binary_filename, rhs.output_binary_filename);
+		std::swap(output_compressed_filename, rhs.output_compressed_filename);
+		std::swap(batch_input_path, rhs.batch_input_path);
+		std::swap(num_threads, rhs.num_threads);
 #endif
 		std::swap(output_stats, rhs.output_stats);
 		std::swap(output_stats_filename, rhs.output_stats_filename);
@@ -240,6 +273,100 @@ constexpr const char* k_acl_input_file_option = "-acl=";
 constexpr const char* k_config_input_file_option = "-config=";
 constexpr const char* k_stats_output_option = "-stats";
 constexpr const char* k_regression_test_option = "-test";
+constexpr const char* k_binary_output_option = "-bin=";
+constexpr const char* k_compressed_output_option = "-out=";
+constexpr const char* k_batch_input_option = "-batch=";
+constexpr const char* k_num_threads_option = "-threads=";
+
+static bool is_binary_clip_filename(const char* filename)
+{
+	const size_t filename_len = std::strlen(filename);
+	return filename_len >= 8 && std::strncmp(filename + filename_len - 8, ".acl.bin", 8) == 0;
+}
+
+// Holds the binary clip data, clips read from it reference the data in place and it must outlive them
+class ClipBinaryFile
+{
+public:
+	ClipBinaryFile() : m_allocator(nullptr), m_data(nullptr), m_size(0), m_is_mapped(false) {}
+
+	~ClipBinaryFile()
+	{
+#if !defined(_WIN32) && !defined(__ANDROID__)
+		if (m_is_mapped)
+			munmap(m_data, m_size);
+		else
+#endif
+		if (m_allocator != nullptr)
+			deallocate_type_array(*m_allocator, static_cast<uint8_t*>(m_data), m_size);
+	}
+
+	ClipBinaryFile(const ClipBinaryFile&) = delete;
+	ClipBinaryFile& operator=(const ClipBinaryFile&) = delete;
+
+	bool open(IAllocator& allocator, const char* filename)
+	{
+#if !defined(_WIN32) && !defined(__ANDROID__)
+		(void)allocator;
+
+		const int fd = ::open(filename, O_RDONLY);
+		if (fd < 0)
+			return false;
+
+		struct stat file_stat;
+		if (fstat(fd, &file_stat) != 0 || file_stat.st_size <= 0)
+		{
+			close(fd);
+			return false;
+		}
+
+		// Mapped pages are page aligned which satisfies the binary clip alignment
+		m_size = size_t(file_stat.st_size);
+		m_data = mmap(nullptr, m_size, PROT_READ, MAP_PRIVATE, fd, 0);
+		close(fd);
+
+		m_is_mapped = m_data != MAP_FAILED;
+		if (!m_is_mapped)
+			m_data = nullptr;
+
+		return m_is_mapped;
+#else
+		std::FILE* file = nullptr;
+#ifdef _WIN32
+		fopen_s(&file, filename, "rb");
+#else
+		file = fopen(filename, "rb");
+#endif
+		if (file == nullptr)
+			return false;
+
+		std::fseek(file, 0, SEEK_END);
+		const long file_size = std::ftell(file);
+		std::fseek(file, 0, SEEK_SET);
+
+		bool success = file_size > 0;
+		if (success)
+		{
+			m_allocator = &allocator;
+			m_size = size_t(file_size);
+			m_data = allocate_type_array_aligned<uint8_t>(allocator, m_size, k_clip_binary_alignment);
+			success = std::fread(m_data, 1, m_size, file) == m_size;
+		}
+
+		std::fclose(file);
+		return success;
+#endif
+	}
+
+	const void* get_data() const { return m_data; }
+	size_t get_size() const { return m_size; }
+
+private:
+	IAllocator*		m_allocator;
+	void*			m_data;
+	size_t			m_size;
+	bool			m_is_mapped;
+};
 
 static bool parse_options(int argc, char** argv, Options& options)
 {
@@ -301,6 +428,46 @@ static bool parse_options(int argc, char** argv, Options& options)
 			continue;
 		}
 
+#if !defined(__ANDROID__)
+		option_length = std::strlen(k_binary_output_option);
+		if (std::strncmp(argument, k_binary_output_option, option_length) == 0)
+		{
+			options.output_binary_filename = argument + option_length;
+			if (!is_binary_clip_filename(options.output_binary_filename))
+			{
+				printf("Binary output file must be an ACL binary file (.acl.bin).\n");
+				return false;
+			}
+			continue;
+		}
+
+		option_length = std::strlen(k_compressed_output_option);
+		if (std::strncmp(argument, k_compressed_output_option, option_length) == 0)
+		{
+			options.output_compressed_filename = argument + option_length;
+			continue;
+		}
+
+		option_length = std::strlen(k_batch_input_option);
+		if (std::strncmp(argument, k_batch_input_option, option_length) == 0)
+		{
+			options.batch_input_path = argument + option_length;
+			continue;
+		}
+
+		option_length = std::strlen(k_num_threads_option);
+		if (std::strncmp(argument, k_num_threads_option, option_length) == 0)
+		{
+			options.num_threads = uint32_t(std::strtoul(argument + option_length, nullptr, 10));
+			if (options.num_threads == 0)
+			{
+				printf("At least one thread is required.\n");
+				return false;
+			}
+			continue;
+		}
+#endif
+
 		printf("Unrecognized option %s\n", argument);
 		return false;
 	}
@@ -308,13 +475,29 @@ static bool parse_options(int argc, char** argv, Options& options)
 #if defined(__ANDROID__)
 	if (options.input_buffer == nullptr || options.input_buffer_size == 0)
 #else
-	if (options.input_filename == nullptr || std::strlen(options.input_filename) == 0)
+	if (options.batch_input_path != nullptr)
+	{
+		if (options.input_filename != nullptr || options.output_binary_filename != nullptr)
+		{
+			printf("Batch mode cannot be combined with an input or binary output file.\n");
+			return false;
+		}
+	}
+	else if (options.input_filename == nullptr || std::strlen(options.input_filename) == 0)
 #endif
 	{
 		printf("An input file is required.\n");
 		return false;
 	}
 
+#if !defined(__ANDROID__)
+	if (options.output_compressed_filename != nullptr && (options.config_filename == nullptr || std::strlen(options.config_filename) == 0))
+	{
+		printf("A config file is required to output a compressed clip.\n");
+		return false;
+	}
+#endif
+
 	return true;
 }
 
@@ -361,12 +544,68 @@ static void validate_accuracy(IAllocator& allocator, const AnimationClip& clip,
 		ACL_ENSURE(vector_all_near_equal3(test_scale, lossy_pose_transforms[sample_bone_index].scale), "Failed to sample bone index: %u", sample_bone_index);
 	}
 
+	{
+		// Validate that the decoder can decompress multiple instances at different sample times in a single batch
+		constexpr uint32_t k_num_instances = 5;
+
+		void* contexts[k_num_instances];
+		float sample_times[k_num_instances];
+		Transform_32* batch_pose_transforms[k_num_instances];
+
+		for (uint32_t instance_index = 0; instance_index < k_num_instances; ++instance_index)
+		{
+			contexts[instance_index] = algorithm.allocate_decompression_context(allocator, compressed_clip);
+			sample_times[instance_index] = clip_duration * float(instance_index) / float(k_num_instances - 1);
+			batch_pose_transforms[instance_index] = allocate_type_array<Transform_32>(allocator, num_bones);
+		}
+
+		algorithm.decompress_poses(compressed_clip, contexts, sample_times, batch_pose_transforms, num_bones, k_num_instances);
+
+		for (uint32_t instance_index = 0; instance_index < k_num_instances; ++instance_index)
+		{
+			algorithm.decompress_pose(compressed_clip, context, sample_times[instance_index], lossy_pose_transforms, num_bones);
+
+			for (uint16_t bone_index = 0; bone_index < num_bones; ++bone_index)
+			{
+				const Transform_32& batch_transform = batch_pose_transforms[instance_index][bone_index];
+				ACL_ENSURE(quat_near_equal(batch_transform.rotation, lossy_pose_transforms[bone_index].rotation), "Failed to batch sample bone index: %u", bone_index);
+				ACL_ENSURE(vector_all_near_equal3(batch_transform.translation, lossy_pose_transforms[bone_index].translation), "Failed to batch sample bone index: %u", bone_index);
+				ACL_ENSURE(vector_all_near_equal3(batch_transform.scale, lossy_pose_transforms[bone_index].scale), "Failed to batch sample bone index: %u", bone_index);
+			}
+		}
+
+		for (uint32_t instance_index = 0; instance_index < k_num_instances; ++instance_index)
+		{
+			algorithm.deallocate_decompression_context(allocator, contexts[instance_index]);
+			deallocate_type_array(allocator, batch_pose_transforms[instance_index], num_bones);
+		}
+	}
+
 	deallocate_type_array(allocator, raw_pose_transforms, num_bones);
 	deallocate_type_array(allocator, lossy_pose_transforms, num_bones);
 	algorithm.deallocate_decompression_context(allocator, context);
 }
 
-static void try_algorithm(const Options& options, IAllocator& allocator, const AnimationClip& clip, const RigidSkeleton& skeleton, IAlgorithm &algorithm, StatLogging logging, sjson::ArrayWriter* runs_writer, double regression_error_threshold)
+#if !defined(__ANDROID__)
+// The compressed clip is written as is, it can be loaded back in a 16 byte aligned buffer and decompressed
+static bool write_compressed_clip(const CompressedClip& compressed_clip, const char* filename)
+{
+	std::FILE* file = nullptr;
+#ifdef _WIN32
+	fopen_s(&file, filename, "wb");
+#else
+	file = fopen(filename, "wb");
+#endif
+	if (file == nullptr)
+		return false;
+
+	const bool success = std::fwrite(&compressed_clip, 1, compressed_clip.get_size(), file) == compressed_clip.get_size();
+	std::fclose(file);
+	return success;
+}
+#endif
+
+static void try_algorithm(const Options& options, IAllocator& allocator, const AnimationClip& clip, const RigidSkeleton& skeleton, IAlgorithm &algorithm, StatLogging logging, sjson::ArrayWriter* runs_writer, double regression_error_threshold, const char* output_compressed_filename)
 {
 	auto try_algorithm_impl = [&](sjson::ObjectWriter* stats_writer)
 	{
@@ -378,6 +617,16 @@ static void try_algorithm(const Options& options, IAllocator& allocator, const A
 		if (options.regression_testing)
 			validate_accuracy(allocator, clip, skeleton, *compressed_clip, algorithm, regression_error_threshold);
 
+#if !defined(__ANDROID__)
+		if (output_compressed_filename != nullptr)
+		{
+			const bool is_written = write_compressed_clip(*compressed_clip, output_compressed_filename);
+			ACL_ENSURE(is_written, "Failed to write compressed clip: %s", output_compressed_filename);
+		}
+#else
+		(void)output_compressed_filename;
+#endif
+
 		allocator.deallocate(compressed_clip, compressed_clip->get_size());
 	};
 
@@ -389,20 +638,11 @@ static void try_algorithm(const Options& options, IAllocator& allocator, const A
 		try_algorithm_impl(nullptr);
 }
 
-static bool read_clip(IAllocator& allocator, const Options& options,
-					  std::unique_ptr<AnimationClip, Deleter<AnimationClip>>& clip,
-					  std::unique_ptr<RigidSkeleton, Deleter<RigidSkeleton>>& skeleton)
+static bool read_clip_sjson(IAllocator& allocator, const char* buffer, size_t buffer_size,
+							std::unique_ptr<AnimationClip, Deleter<AnimationClip>>& clip,
+							std::unique_ptr<RigidSkeleton, Deleter<RigidSkeleton>>& skeleton)
 {
-#if defined(__ANDROID__)
-	ClipReader reader(allocator, options.input_buffer, options.input_buffer_size - 1);
-#else
-	std::ifstream t(options.input_filename);
-	std::stringstream buffer;
-	buffer << t.rdbuf();
-	std::string str = buffer.str();
-
-	ClipReader reader(allocator, str.c_str(), str.length());
-#endif
+	ClipReader reader(allocator, buffer, buffer_size);
 
 	if (!reader.read(skeleton) || !reader.read(clip, *skeleton))
 	{
@@ -414,18 +654,55 @@ static bool read_clip(IAllocator& allocator, const Options& options,
 	return true;
 }
 
-static bool read_config(IAllocator& allocator, const Options& options, AlgorithmType8& out_algorithm_type, CompressionSettings& out_settings, double& out_regression_error_threshold)
+#if !defined(__ANDROID__)
+static bool read_clip_file(IAllocator& allocator, const char* input_filename,
+						   ClipBinaryFile& binary_file,
+						   std::unique_ptr<AnimationClip, Deleter<AnimationClip>>& clip,
+						   std::unique_ptr<RigidSkeleton, Deleter<RigidSkeleton>>& skeleton)
 {
-#if defined(__ANDROID__)
-	sjson::Parser parser(options.config_buffer, options.config_buffer_size - 1);
-#else
-	std::ifstream t(options.config_filename);
+	if (is_binary_clip_filename(input_filename))
+	{
+		if (!binary_file.open(allocator, input_filename))
+		{
+			printf("\nFailed to open binary clip: %s\n", input_filename);
+			return false;
+		}
+
+		ClipBinaryReader reader(allocator, binary_file.get_data(), binary_file.get_size());
+		if (!reader.read(skeleton) || !reader.read(clip, *skeleton))
+		{
+			printf("\nError: %s\n", get_clip_binary_error_description(reader.get_error()));
+			return false;
+		}
+
+		return true;
+	}
+
+	std::ifstream t(input_filename);
 	std::stringstream buffer;
 	buffer << t.rdbuf();
 	std::string str = buffer.str();
 
-	sjson::Parser parser(str.c_str(), str.length());
+	return read_clip_sjson(allocator, str.c_str(), str.length(), clip, skeleton);
+}
+#endif
+
+static bool read_clip(IAllocator& allocator, const Options& options,
+					  ClipBinaryFile& binary_file,
+					  std::unique_ptr<AnimationClip, Deleter<AnimationClip>>& clip,
+					  std::unique_ptr<RigidSkeleton, Deleter<RigidSkeleton>>& skeleton)
+{
+#if defined(__ANDROID__)
+	(void)binary_file;
+	return read_clip_sjson(allocator, options.input_buffer, options.input_buffer_size - 1, clip, skeleton);
+#else
+	return read_clip_file(allocator, options.input_filename, binary_file, clip, skeleton);
 #endif
+}
+
+static bool read_config_sjson(IAllocator& allocator, const char* buffer, size_t buffer_size, AlgorithmType8& out_algorithm_type, CompressionSettings& out_settings, double& out_regression_error_threshold)
+{
+	sjson::Parser parser(buffer, buffer_size);
 
 	double version = 0.0;
 	if (!parser.read("version", version))
@@ -524,6 +801,18 @@ static bool read_config(IAllocator& allocator, const Options& options, Algorithm
 		}
 	}
 
+	double key_frame_block_size;
+	if (parser.try_read("key_frame_block_size", key_frame_block_size, 1.0))
+	{
+		if (key_frame_block_size < 1.0 || key_frame_block_size > double(k_max_key_frame_block_size))
+		{
+			printf("Invalid key frame block size: %f\n", key_frame_block_size);
+			return false;
+		}
+
+		out_settings.key_frame_block_size = uint8_t(key_frame_block_size);
+	}
+
 	parser.try_read("regression_error_threshold", out_regression_error_threshold, 0.0);
 
 	if (!parser.remainder_is_comments_and_whitespace())
@@ -538,101 +827,536 @@ static bool read_config(IAllocator& allocator, const Options& options, Algorithm
 	return true;
 }
 
-static int safe_main_impl(int argc, char* argv[])
+#if !defined(__ANDROID__)
+static bool read_config_file(IAllocator& allocator, const char* config_filename, AlgorithmType8& out_algorithm_type, CompressionSettings& out_settings, double& out_regression_error_threshold)
 {
-	Options options;
+	std::ifstream t(config_filename);
+	std::stringstream buffer;
+	buffer << t.rdbuf();
+	std::string str = buffer.str();
 
-	if (!parse_options(argc, argv, options))
-		return -1;
+	return read_config_sjson(allocator, str.c_str(), str.length(), out_algorithm_type, out_settings, out_regression_error_threshold);
+}
+#endif
 
-	ANSIAllocator allocator;
+static bool read_config(IAllocator& allocator, const Options& options, AlgorithmType8& out_algorithm_type, CompressionSettings& out_settings, double& out_regression_error_threshold)
+{
+#if defined(__ANDROID__)
+	return read_config_sjson(allocator, options.config_buffer, options.config_buffer_size - 1, out_algorithm_type, out_settings, out_regression_error_threshold);
+#else
+	return read_config_file(allocator, options.config_filename, out_algorithm_type, out_settings, out_regression_error_threshold);
+#endif
+}
+
+// A compression config is parsed once and shared by every clip compressed with it
+struct CompressionConfig
+{
+	const char*				filename;
+	bool					use_external_config;
+	AlgorithmType8			algorithm_type;
+	CompressionSettings		settings;
+	double					regression_error_threshold;
+
+	CompressionConfig()
+		: filename(nullptr)
+		, use_external_config(false)
+		, algorithm_type(AlgorithmType8::UniformlySampled)
+		, settings()
+		, regression_error_threshold(0.0)
+	{}
+};
+
+static void compress_clip_with_config(const Options& options, IAllocator& allocator, const AnimationClip& clip, const RigidSkeleton& skeleton, const CompressionConfig& config, sjson::ArrayWriter* runs_writer, const char* output_compressed_filename)
+{
+	StatLogging logging = options.output_stats ? StatLogging::Summary : StatLogging::None;
+
+	if (config.use_external_config)
+	{
+		ACL_ENSURE(config.algorithm_type == AlgorithmType8::UniformlySampled, "Only UniformlySampled is supported for now");
+
+		UniformlySampledAlgorithm algorithm(config.settings);
+		try_algorithm(options, allocator, clip, skeleton, algorithm, logging, runs_writer, config.regression_error_threshold, output_compressed_filename);
+	}
+	else
+	{
+		// Use defaults
+		bool use_segmenting_options[] = { false, true };
+		for (size_t segmenting_option_index = 0; segmenting_option_index < get_array_size(use_segmenting_options); ++segmenting_option_index)
+		{
+			bool use_segmenting = use_segmenting_options[segmenting_option_index];
+
+			UniformlySampledAlgorithm uniform_tests[] =
+			{
+				UniformlySampledAlgorithm(RotationFormat8::Quat_128, VectorFormat8::Vector3_96, VectorFormat8::Vector3_96, RangeReductionFlags8::None, use_segmenting),
+				UniformlySampledAlgorithm(RotationFormat8::Quat_128, VectorFormat8::Vector3_96, VectorFormat8::Vector3_96, RangeReductionFlags8::Rotations, use_segmenting),
+				UniformlySampledAlgorithm(RotationFormat8::Quat_128, VectorFormat8::Vector3_96, VectorFormat8::Vector3_96, RangeReductionFlags8::Translations, use_segmenting),
+				UniformlySampledAlgorithm(RotationFormat8::Quat_128, VectorFormat8::Vector3_96, VectorFormat8::Vector3_96, RangeReductionFlags8::Rotations | RangeReductionFlags8::Translations, use_segmenting),
+
+				UniformlySampledAlgorithm(RotationFormat8::QuatDropW_96, VectorFormat8::Vector3_96, VectorFormat8::Vector3_96, RangeReductionFlags8::None, use_segmenting),
+				UniformlySampledAlgorithm(RotationFormat8::QuatDropW_96, VectorFormat8::Vector3_96, VectorFormat8::Vector3_96, RangeReductionFlags8::Rotations, use_segmenting),
+				UniformlySampledAlgorithm(RotationFormat8::QuatDropW_96, VectorFormat8::Vector3_96, VectorFormat8::Vector3_96, RangeReductionFlags8::Translations, use_segmenting),
+				UniformlySampledAlgorithm(RotationFormat8::QuatDropW_96, VectorFormat8::Vector3_96, VectorFormat8::Vector3_96, RangeReductionFlags8::Rotations | RangeReductionFlags8::Translations, use_segmenting),
+
+				UniformlySampledAlgorithm(RotationFormat8::QuatDropW_Variable, VectorFormat8::Vector3_Variable, VectorFormat8::Vector3_96, RangeReductionFlags8::Translations, use_segmenting),
+				UniformlySampledAlgorithm(RotationFormat8::QuatDropW_Variable, VectorFormat8::Vector3_Variable, VectorFormat8::Vector3_96, RangeReductionFlags8::Rotations | RangeReductionFlags8::Translations, use_segmenting),
+
+				UniformlySampledAlgorithm(RotationFormat8::QuatDropW_Variable, VectorFormat8::Vector3_Variable, VectorFormat8::Vector3_Variable, RangeReductionFlags8::Rotations | RangeReductionFlags8::Translations | RangeReductionFlags8::Scales, use_segmenting),
+
+				UniformlySampledAlgorithm(RotationFormat8::Quat_32_Largest, VectorFormat8::Vector3_96, VectorFormat8::Vector3_96, RangeReductionFlags8::Translations, use_segmenting),
+
+				UniformlySampledAlgorithm(RotationFormat8::QuatLog_96, VectorFormat8::Vector3_96, VectorFormat8::Vector3_96, RangeReductionFlags8::Rotations | RangeReductionFlags8::Translations, use_segmenting),
+				UniformlySampledAlgorithm(RotationFormat8::QuatLog_Variable, VectorFormat8::Vector3_Variable, VectorFormat8::Vector3_Variable, RangeReductionFlags8::Rotations | RangeReductionFlags8::Translations | RangeReductionFlags8::Scales, use_segmenting),
+			};
+
+			for (UniformlySampledAlgorithm& algorithm : uniform_tests)
+				try_algorithm(options, allocator, clip, skeleton, algorithm, logging, runs_writer, config.regression_error_threshold, output_compressed_filename);
+		}
+
+		{
+			UniformlySampledAlgorithm uniform_tests[] =
+			{
+				UniformlySampledAlgorithm(RotationFormat8::Quat_128, VectorFormat8::Vector3_96, VectorFormat8::Vector3_96, RangeReductionFlags8::Rotations, true, RangeReductionFlags8::Rotations),
+				UniformlySampledAlgorithm(RotationFormat8::Quat_128, VectorFormat8::Vector3_96, VectorFormat8::Vector3_96, RangeReductionFlags8::Translations, true, RangeReductionFlags8::Translations),
+				UniformlySampledAlgorithm(RotationFormat8::Quat_128, VectorFormat8::Vector3_96, VectorFormat8::Vector3_96, RangeReductionFlags8::Rotations | RangeReductionFlags8::Translations, true, RangeReductionFlags8::Rotations | RangeReductionFlags8::Translations),
+
+				UniformlySampledAlgorithm(RotationFormat8::QuatDropW_96, VectorFormat8::Vector3_96, VectorFormat8::Vector3_96, RangeReductionFlags8::Rotations, true, RangeReductionFlags8::Rotations),
+				UniformlySampledAlgorithm(RotationFormat8::QuatDropW_96, VectorFormat8::Vector3_96, VectorFormat8::Vector3_96, RangeReductionFlags8::Translations, true, RangeReductionFlags8::Translations),
+				UniformlySampledAlgorithm(RotationFormat8::QuatDropW_96, VectorFormat8::Vector3_96, VectorFormat8::Vector3_96, RangeReductionFlags8::Rotations | RangeReductionFlags8::Translations, true, RangeReductionFlags8::Rotations | RangeReductionFlags8::Translations),
+				UniformlySampledAlgorithm(RotationFormat8::QuatDropW_Variable, VectorFormat8::Vector3_Variable, VectorFormat8::Vector3_96, RangeReductionFlags8::Translations, true, RangeReductionFlags8::Translations),
+				UniformlySampledAlgorithm(RotationFormat8::QuatDropW_Variable, VectorFormat8::Vector3_Variable, VectorFormat8::Vector3_96, RangeReductionFlags8::Rotations | RangeReductionFlags8::Translations, true, RangeReductionFlags8::Rotations | RangeReductionFlags8::Translations),
+
+				UniformlySampledAlgorithm(RotationFormat8::QuatDropW_Variable, VectorFormat8::Vector3_Variable, VectorFormat8::Vector3_Variable, RangeReductionFlags8::Rotations | RangeReductionFlags8::Translations | RangeReductionFlags8::Scales, true, RangeReductionFlags8::Rotations | RangeReductionFlags8::Translations | RangeReductionFlags8::Scales),
+
+				UniformlySampledAlgorithm(RotationFormat8::QuatLog_Variable, VectorFormat8::Vector3_Variable, VectorFormat8::Vector3_Variable, RangeReductionFlags8::Rotations | RangeReductionFlags8::Translations | RangeReductionFlags8::Scales, true, RangeReductionFlags8::Rotations | RangeReductionFlags8::Translations | RangeReductionFlags8::Scales),
+			};
+
+			for (UniformlySampledAlgorithm& algorithm : uniform_tests)
+				try_algorithm(options, allocator, clip, skeleton, algorithm, logging, runs_writer, config.regression_error_threshold, output_compressed_filename);
+		}
+	}
+}
+
+#if !defined(__ANDROID__)
+static bool is_directory(const char* path)
+{
+#ifdef _WIN32
+	const DWORD attributes = GetFileAttributesA(path);
+	return attributes != INVALID_FILE_ATTRIBUTES && (attributes & FILE_ATTRIBUTE_DIRECTORY) != 0;
+#else
+	struct stat path_stat;
+	return stat(path, &path_stat) == 0 && S_ISDIR(path_stat.st_mode);
+#endif
+}
+
+static bool ends_with(const std::string& str, const char* suffix)
+{
+	const size_t suffix_len = std::strlen(suffix);
+	return str.size() >= suffix_len && str.compare(str.size() - suffix_len, suffix_len, suffix) == 0;
+}
+
+static bool is_clip_filename(const std::string& filename) { return ends_with(filename, ".acl.sjson") || ends_with(filename, ".acl.bin"); }
+static bool is_config_filename(const std::string& filename) { return ends_with(filename, ".config.sjson"); }
+
+// Recursively finds every file in a directory that passes the filter
+static void find_files(const std::string& directory, bool (*filter)(const std::string&), std::vector<std::string>& out_filenames)
+{
+#ifdef _WIN32
+	WIN32_FIND_DATAA find_data;
+	const std::string pattern = directory + "/*";
+	HANDLE find_handle = FindFirstFileA(pattern.c_str(), &find_data);
+	if (find_handle == INVALID_HANDLE_VALUE)
+		return;
+
+	do
+	{
+		const std::string name = find_data.cFileName;
+		if (name == "." || name == "..")
+			continue;
+
+		const std::string path = directory + "/" + name;
+		if ((find_data.dwFileAttributes & FILE_ATTRIBUTE_DIRECTORY) != 0)
+			find_files(path, filter, out_filenames);
+		else if (filter(path))
+			out_filenames.push_back(path);
+	} while (FindNextFileA(find_handle, &find_data));
+
+	FindClose(find_handle);
+#else
+	DIR* dir = opendir(directory.c_str());
+	if (dir == nullptr)
+		return;
+
+	while (const dirent* entry = readdir(dir))
+	{
+		const std::string name = entry->d_name;
+		if (name == "." || name == "..")
+			continue;
+
+		const std::string path = directory + "/" + name;
+		if (is_directory(path.c_str()))
+			find_files(path, filter, out_filenames);
+		else if (filter(path))
+			out_filenames.push_back(path);
+	}
+
+	closedir(dir);
+#endif
+}
+
+// A manifest lists one clip per line, empty lines and lines starting with '#' are ignored.
+// Relative paths are relative to the manifest.
+static bool read_manifest(const char* manifest_filename, std::vector<std::string>& out_filenames)
+{
+	std::ifstream manifest(manifest_filename);
+	if (!manifest.is_open())
+		return false;
+
+	const std::string manifest_path = manifest_filename;
+	const size_t separator_offset = manifest_path.find_last_of("/\\");
+	const std::string manifest_directory = separator_offset != std::string::npos ? manifest_path.substr(0, separator_offset + 1) : std::string();
+
+	std::string line;
+	while (std::getline(manifest, line))
+	{
+		const size_t first = line.find_first_not_of(" \t\r");
+		if (first == std::string::npos || line[first] == '#')
+			continue;
+
+		const size_t last = line.find_last_not_of(" \t\r");
+		const std::string filename = line.substr(first, last - first + 1);
+
+		const bool is_absolute = filename[0] == '/' || filename[0] == '\\' || (filename.size() > 1 && filename[1] == ':');
+		out_filenames.push_back(is_absolute ? filename : (manifest_directory + filename));
+	}
+
+	return true;
+}
+
+static size_t get_file_size(const char* filename)
+{
+	std::ifstream file(filename, std::ios::binary | std::ios::ate);
+	return file.is_open() ? size_t(file.tellg()) : 0;
+}
+
+static std::string get_filename_stem(const std::string& path, const char* extension)
+{
+	const size_t separator_offset = path.find_last_of("/\\");
+	std::string filename = separator_offset != std::string::npos ? path.substr(separator_offset + 1) : path;
+	if (ends_with(filename, extension))
+		filename.resize(filename.size() - std::strlen(extension));
+	return filename;
+}
+
+struct BatchTask
+{
+	const char*					clip_filename;
+	const CompressionConfig*	config;
+	std::string					output_compressed_filename;
+	size_t						clip_size;
+};
+
+#if defined(SJSON_CPP_WRITER)
+class StringStreamWriter final : public sjson::StreamWriter
+{
+public:
+	virtual void write(const void* buffer, size_t buffer_size) override { m_buffer.append(static_cast<const char*>(buffer), buffer_size); }
+
+	const std::string& get_buffer() const { return m_buffer; }
+
+private:
+	std::string m_buffer;
+};
+
+// Workers write the stats of each clip in their own buffer and we append them to the
+// output as soon as they complete, in completion order
+class BatchStatsWriter
+{
+public:
+	explicit BatchStatsWriter(std::FILE* file) : m_lock(), m_file(file)
+	{
+		std::fputs("clips = [\n", m_file);
+	}
+
+	~BatchStatsWriter()
+	{
+		std::fputs("]\n", m_file);
+		std::fflush(m_file);
+	}
+
+	BatchStatsWriter(const BatchStatsWriter&) = delete;
+	BatchStatsWriter& operator=(const BatchStatsWriter&) = delete;
+
+	void write(const std::string& clip_stats)
+	{
+		std::lock_guard<std::mutex> lock(m_lock);
+
+		std::fputs("\t{\n", m_file);
+
+		size_t line_start = 0;
+		while (line_start < clip_stats.size())
+		{
+			size_t line_end = clip_stats.find('\n', line_start);
+			line_end = line_end != std::string::npos ? (line_end + 1) : clip_stats.size();
+
+			std::fputs("\t\t", m_file);
+			std::fwrite(clip_stats.data() + line_start, 1, line_end - line_start, m_file);
+			line_start = line_end;
+		}
+
+		std::fputs("\t}\n", m_file);
+		std::fflush(m_file);
+	}
+
+private:
+	std::mutex		m_lock;
+	std::FILE*		m_file;
+};
+#else
+class BatchStatsWriter {};
+#endif
+
+struct BatchJobs
+{
+	const Options*					options;
+	const std::vector<BatchTask>*	tasks;
+	BatchStatsWriter*				stats_writer;
+	std::atomic<uint32_t>			num_failed_tasks;
+};
+
+static void run_batch_task(void* user_data, uint32_t task_index)
+{
+	BatchJobs& jobs = *static_cast<BatchJobs*>(user_data);
+	const Options& options = *jobs.options;
+	BatchStatsWriter* stats_writer = jobs.stats_writer;
+
+	// Every worker thread reuses a single allocator for all the tasks it runs. Allocation counting is atomic but
+	// the ACL_ALLOCATOR_TRACK_ALL_ALLOCATIONS debug map is not, sharing one allocator across workers would race on it.
+	static thread_local ANSIAllocator allocator;
+
+	const BatchTask& task = (*jobs.tasks)[task_index];
+	const char* output_compressed_filename = task.output_compressed_filename.empty() ? nullptr : task.output_compressed_filename.c_str();
+
+	ClipBinaryFile binary_file;
 	std::unique_ptr<AnimationClip, Deleter<AnimationClip>> clip;
 	std::unique_ptr<RigidSkeleton, Deleter<RigidSkeleton>> skeleton;
 
-	if (!read_clip(allocator, options, clip, skeleton))
-		return -1;
+	// Reading errors are reported as they happen, we keep going with the other clips
+	const bool is_clip_read = read_clip_file(allocator, task.clip_filename, binary_file, clip, skeleton);
+	if (!is_clip_read)
+		jobs.num_failed_tasks++;
 
-	bool use_external_config = false;
-	AlgorithmType8 external_algorithm_type = AlgorithmType8::UniformlySampled;
-	CompressionSettings external_settings;
-	TransformErrorMetric default_error_metric;
-	double regression_error_threshold;
+#if defined(SJSON_CPP_WRITER)
+	if (stats_writer != nullptr)
+	{
+		StringStreamWriter stream_writer;
 
-#if defined(__ANDROID__)
-	if (options.config_buffer != nullptr && options.config_buffer_size != 0)
+		{
+			sjson::Writer writer(stream_writer);
+
+			writer["clip"] = task.clip_filename;
+			if (task.config->filename != nullptr)
+				writer["config"] = task.config->filename;
+
+			if (is_clip_read)
+				writer["runs"] = [&](sjson::ArrayWriter& writer) { compress_clip_with_config(options, allocator, *clip.get(), *skeleton.get(), *task.config, &writer, output_compressed_filename); };
+			else
+				writer["error"] = "Failed to read clip";
+		}
+
+		stats_writer->write(stream_writer.get_buffer());
+	}
+	else
 #else
-	if (options.config_filename != nullptr && std::strlen(options.config_filename) != 0)
+	(void)stats_writer;
 #endif
+	if (is_clip_read)
+		compress_clip_with_config(options, allocator, *clip.get(), *skeleton.get(), *task.config, nullptr, output_compressed_filename);
+}
+
+//////////////////////////////////////////////////////////////////////////
+// Compresses every clip of a directory or manifest with every config in a single process.
+// Configs are parsed once and shared, every clip and config pair is a task executed on a pool
+// of worker threads.
+//////////////////////////////////////////////////////////////////////////
+static int run_batch(const Options& options)
+{
+	ANSIAllocator allocator;
+
+	std::vector<std::string> clip_filenames;
+	if (is_directory(options.batch_input_path))
+		find_files(options.batch_input_path, is_clip_filename, clip_filenames);
+	else if (!read_manifest(options.batch_input_path, clip_filenames))
 	{
-		if (!read_config(allocator, options, external_algorithm_type, external_settings, regression_error_threshold))
-			return -1;
+		printf("Failed to read batch manifest: %s\n", options.batch_input_path);
+		return -1;
+	}
 
-		use_external_config = true;
-		external_settings.error_metric = &default_error_metric;
+	if (clip_filenames.empty())
+	{
+		printf("No clips found in: %s\n", options.batch_input_path);
+		return -1;
 	}
 
-	// Compress & Decompress
-	auto exec_algos = [&](sjson::ArrayWriter* runs_writer)
+	// Sorted to keep the task list the same from run to run
+	std::sort(clip_filenames.begin(), clip_filenames.end());
+
+	std::vector<std::string> config_filenames;
+	if (options.config_filename != nullptr && std::strlen(options.config_filename) != 0)
 	{
-		StatLogging logging = options.output_stats ? StatLogging::Summary : StatLogging::None;
+		if (is_directory(options.config_filename))
+			find_files(options.config_filename, is_config_filename, config_filenames);
+		else
+			config_filenames.push_back(options.config_filename);
 
-		if (use_external_config)
+		if (config_filenames.empty())
 		{
-			ACL_ENSURE(external_algorithm_type == AlgorithmType8::UniformlySampled, "Only UniformlySampled is supported for now");
+			printf("No configs found in: %s\n", options.config_filename);
+			return -1;
+		}
+
+		std::sort(config_filenames.begin(), config_filenames.end());
+	}
 
-			UniformlySampledAlgorithm algorithm(external_settings);
-			try_algorithm(options, allocator, *clip.get(), *skeleton.get(), algorithm, logging, runs_writer, regression_error_threshold);
+	if (options.output_compressed_filename != nullptr && !is_directory(options.output_compressed_filename))
+	{
+		printf("Compressed clips output must be a directory in batch mode: %s\n", options.output_compressed_filename);
+		return -1;
+	}
+
+	// Without a config, every clip is compressed with the default algorithms
+	TransformErrorMetric default_error_metric;
+	std::vector<CompressionConfig> configs(std::max<size_t>(config_filenames.size(), 1));
+	for (size_t config_index = 0; config_index < config_filenames.size(); ++config_index)
+	{
+		CompressionConfig& config = configs[config_index];
+		config.filename = config_filenames[config_index].c_str();
+
+		if (!read_config_file(allocator, config.filename, config.algorithm_type, config.settings, config.regression_error_threshold))
+		{
+			printf("Failed to read config: %s\n", config.filename);
+			return -1;
 		}
-		else
+
+		config.use_external_config = true;
+		config.settings.error_metric = &default_error_metric;
+	}
+
+	std::vector<BatchTask> tasks;
+	tasks.reserve(clip_filenames.size() * configs.size());
+	for (const std::string& clip_filename : clip_filenames)
+	{
+		const size_t clip_size = get_file_size(clip_filename.c_str());
+
+		for (const CompressionConfig& config : configs)
 		{
-			// Use defaults
-			bool use_segmenting_options[] = { false, true };
-			for (size_t segmenting_option_index = 0; segmenting_option_index < get_array_size(use_segmenting_options); ++segmenting_option_index)
+			BatchTask task;
+			task.clip_filename = clip_filename.c_str();
+			task.config = &config;
+			task.clip_size = clip_size;
+
+			if (options.output_compressed_filename != nullptr)
 			{
-				bool use_segmenting = use_segmenting_options[segmenting_option_index];
+				const std::string clip_stem = get_filename_stem(clip_filename, is_binary_clip_filename(task.clip_filename) ? ".acl.bin" : ".acl.sjson");
+				const std::string config_stem = get_filename_stem(config.filename, ".config.sjson");
+				task.output_compressed_filename = std::string(options.output_compressed_filename) + "/" + clip_stem + "." + config_stem + ".aclc";
+			}
 
-				UniformlySampledAlgorithm uniform_tests[] =
-				{
-					UniformlySampledAlgorithm(RotationFormat8::Quat_128, VectorFormat8::Vector3_96, VectorFormat8::Vector3_96, RangeReductionFlags8::None, use_segmenting),
-					UniformlySampledAlgorithm(RotationFormat8::Quat_128, VectorFormat8::Vector3_96, VectorFormat8::Vector3_96, RangeReductionFlags8::Rotations, use_segmenting),
-					UniformlySampledAlgorithm(RotationFormat8::Quat_128, VectorFormat8::Vector3_96, VectorFormat8::Vector3_96, RangeReductionFlags8::Translations, use_segmenting),
-					UniformlySampledAlgorithm(RotationFormat8::Quat_128, VectorFormat8::Vector3_96, VectorFormat8::Vector3_96, RangeReductionFlags8::Rotations | RangeReductionFlags8::Translations, use_segmenting),
+			tasks.push_back(std::move(task));
+		}
+	}
 
-					UniformlySampledAlgorithm(RotationFormat8::QuatDropW_96, VectorFormat8::Vector3_96, VectorFormat8::Vector3_96, RangeReductionFlags8::None, use_segmenting),
-					UniformlySampledAlgorithm(RotationFormat8::QuatDropW_96, VectorFormat8::Vector3_96, VectorFormat8::Vector3_96, RangeReductionFlags8::Rotations, use_segmenting),
-					UniformlySampledAlgorithm(RotationFormat8::QuatDropW_96, VectorFormat8::Vector3_96, VectorFormat8::Vector3_96, RangeReductionFlags8::Translations, use_segmenting),
-					UniformlySampledAlgorithm(RotationFormat8::QuatDropW_96, VectorFormat8::Vector3_96, VectorFormat8::Vector3_96, RangeReductionFlags8::Rotations | RangeReductionFlags8::Translations, use_segmenting),
+	// Large clips take the longest to compress, we start with them to avoid having a single worker busy at the end.
+	// Every worker runs its share of the tasks front to back and steals from the others once it runs out.
+	std::stable_sort(tasks.begin(), tasks.end(), [](const BatchTask& lhs, const BatchTask& rhs) { return lhs.clip_size > rhs.clip_size; });
 
-					UniformlySampledAlgorithm(RotationFormat8::QuatDropW_Variable, VectorFormat8::Vector3_Variable, VectorFormat8::Vector3_96, RangeReductionFlags8::Translations, use_segmenting),
-					UniformlySampledAlgorithm(RotationFormat8::QuatDropW_Variable, VectorFormat8::Vector3_Variable, VectorFormat8::Vector3_96, RangeReductionFlags8::Rotations | RangeReductionFlags8::Translations, use_segmenting),
+	uint32_t num_threads = options.num_threads != 0 ? options.num_threads : std::max<uint32_t>(std::thread::hardware_concurrency(), 1);
+	num_threads = std::min<uint32_t>(num_threads, uint32_t(tasks.size()));
 
-					UniformlySampledAlgorithm(RotationFormat8::QuatDropW_Variable, VectorFormat8::Vector3_Variable, VectorFormat8::Vector3_Variable, RangeReductionFlags8::Rotations | RangeReductionFlags8::Translations | RangeReductionFlags8::Scales, use_segmenting),
-				};
+	BatchJobs jobs;
+	jobs.options = &options;
+	jobs.tasks = &tasks;
+	jobs.num_failed_tasks = 0;
 
-				for (UniformlySampledAlgorithm& algorithm : uniform_tests)
-					try_algorithm(options, allocator, *clip.get(), *skeleton.get(), algorithm, logging, runs_writer, regression_error_threshold);
-			}
+	{
+#if defined(SJSON_CPP_WRITER)
+		std::unique_ptr<BatchStatsWriter> stats_writer(options.output_stats ? new BatchStatsWriter(options.output_stats_file) : nullptr);
+#else
+		std::unique_ptr<BatchStatsWriter> stats_writer;
+#endif
+		jobs.stats_writer = stats_writer.get();
 
-			{
-				UniformlySampledAlgorithm uniform_tests[] =
-				{
-					UniformlySampledAlgorithm(RotationFormat8::Quat_128, VectorFormat8::Vector3_96, VectorFormat8::Vector3_96, RangeReductionFlags8::Rotations, true, RangeReductionFlags8::Rotations),
-					UniformlySampledAlgorithm(RotationFormat8::Quat_128, VectorFormat8::Vector3_96, VectorFormat8::Vector3_96, RangeReductionFlags8::Translations, true, RangeReductionFlags8::Translations),
-					UniformlySampledAlgorithm(RotationFormat8::Quat_128, VectorFormat8::Vector3_96, VectorFormat8::Vector3_96, RangeReductionFlags8::Rotations | RangeReductionFlags8::Translations, true, RangeReductionFlags8::Rotations | RangeReductionFlags8::Translations),
+		ThreadJobExecutor executor(num_threads);
+		executor.run_jobs(uint32_t(tasks.size()), run_batch_task, &jobs);
+	}
+
+	const uint32_t num_failed_tasks = jobs.num_failed_tasks.load();
+	if (num_failed_tasks != 0)
+	{
+		printf("%u out of %u tasks failed\n", num_failed_tasks, uint32_t(tasks.size()));
+		return -1;
+	}
 
-					UniformlySampledAlgorithm(RotationFormat8::QuatDropW_96, VectorFormat8::Vector3_96, VectorFormat8::Vector3_96, RangeReductionFlags8::Rotations, true, RangeReductionFlags8::Rotations),
-					UniformlySampledAlgorithm(RotationFormat8::QuatDropW_96, VectorFormat8::Vector3_96, VectorFormat8::Vector3_96, RangeReductionFlags8::Translations, true, RangeReductionFlags8::Translations),
-					UniformlySampledAlgorithm(RotationFormat8::QuatDropW_96, VectorFormat8::Vector3_96, VectorFormat8::Vector3_96, RangeReductionFlags8::Rotations | RangeReductionFlags8::Translations, true, RangeReductionFlags8::Rotations | RangeReductionFlags8::Translations),
-					UniformlySampledAlgorithm(RotationFormat8::QuatDropW_Variable, VectorFormat8::Vector3_Variable, VectorFormat8::Vector3_96, RangeReductionFlags8::Translations, true, RangeReductionFlags8::Translations),
-					UniformlySampledAlgorithm(RotationFormat8::QuatDropW_Variable, VectorFormat8::Vector3_Variable, VectorFormat8::Vector3_96, RangeReductionFlags8::Rotations | RangeReductionFlags8::Translations, true, RangeReductionFlags8::Rotations | RangeReductionFlags8::Translations),
+	return 0;
+}
+#endif
 
-					UniformlySampledAlgorithm(RotationFormat8::QuatDropW_Variable, VectorFormat8::Vector3_Variable, VectorFormat8::Vector3_Variable, RangeReductionFlags8::Rotations | RangeReductionFlags8::Translations | RangeReductionFlags8::Scales, true, RangeReductionFlags8::Rotations | RangeReductionFlags8::Translations | RangeReductionFlags8::Scales),
-				};
+static int safe_main_impl(int argc, char* argv[])
+{
+	Options options;
 
-				for (UniformlySampledAlgorithm& algorithm : uniform_tests)
-					try_algorithm(options, allocator, *clip.get(), *skeleton.get(), algorithm, logging, runs_writer, regression_error_threshold);
-			}
+	if (!parse_options(argc, argv, options))
+		return -1;
+
+#if !defined(__ANDROID__)
+	if (options.batch_input_path != nullptr)
+		return run_batch(options);
+#endif
+
+	ANSIAllocator allocator;
+	ClipBinaryFile binary_file;
+	std::unique_ptr<AnimationClip, Deleter<AnimationClip>> clip;
+	std::unique_ptr<RigidSkeleton, Deleter<RigidSkeleton>> skeleton;
+
+	if (!read_clip(allocator, options, binary_file, clip, skeleton))
+		return -1;
+
+#if !defined(__ANDROID__)
+	if (options.output_binary_filename != nullptr)
+	{
+		if (!write_acl_clip_binary(allocator, *skeleton, *clip, options.output_binary_filename))
+		{
+			printf("Failed to write binary clip: %s\n", options.output_binary_filename);
+			return -1;
 		}
+	}
+#endif
+
+	CompressionConfig config;
+	TransformErrorMetric default_error_metric;
+
+#if defined(__ANDROID__)
+	if (options.config_buffer != nullptr && options.config_buffer_size != 0)
+#else
+	if (options.config_filename != nullptr && std::strlen(options.config_filename) != 0)
+#endif
+	{
+		if (!read_config(allocator, options, config.algorithm_type, config.settings, config.regression_error_threshold))
+			return -1;
+
+		config.use_external_config = true;
+		config.settings.error_metric = &default_error_metric;
+	}
+
+#if defined(__ANDROID__)
+	const char* output_compressed_filename = nullptr;
+#else
+	const char* output_compressed_filename = options.output_compressed_filename;
+#endif
+
+	// Compress & Decompress
+	auto exec_algos = [&](sjson::ArrayWriter* runs_writer)
+	{
+		compress_clip_with_config(options, allocator, *clip.get(), *skeleton.get(), config, runs_writer, output_compressed_filename);
 	};
 
 #if defined(SJSON_CPP_WRITER)
@@ -0,0 +1,744 @@
+////////////////////////////////////////////////////////////////////////////////
+// The MIT License (MIT)
+//
+// Copyright (c) 2018 Nicholas Frechette & Animation Compression Library contributors
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+////////////////////////////////////////////////////////////////////////////////
+
+
+#include "acl_decompressor.h"
+
+#include <assert.h>
+#include <cstdlib>
+#include <cstdio>
+#include <cstdarg>
+
+static void assert_impl(bool expression, const char* format, ...)
+{
+	if (expression)
+		return;
+
+	va_list args;
+	va_start(args, format);
+
+	std::vprintf(format, args);
+	printf("\n");
+
+	va_end(args);
+
+#if !defined(NDEBUG)
+	assert(expression);
+#endif
+
+	std::abort();
+}
+
+#if !defined(ACL_ASSERT) && !defined(ACL_NO_ERROR_CHECKS)
+	#define ACL_ASSERT(expression, format, ...) assert_impl(expression, format, ## __VA_ARGS__)
+	#define ACL_ENSURE(expression, format, ...) assert_impl(expression, format, ## __VA_ARGS__)
+#endif
+
+#include <sjson/writer.h>
+
+#include "acl/core/ansi_allocator.h"
+#include "acl/core/compressed_clip.h"
+#include "acl/core/iallocator.h"
+#include "acl/core/memory_cache.h"
+#include "acl/core/pool_allocator.h"
+#include "acl/core/scope_profiler.h"
+#include "acl/core/thread_job_executor.h"
+#include "acl/core/utils.h"
+#include "acl/algorithm/uniformly_sampled/decoder.h"
+#include "acl/algorithm/uniformly_sampled/decoder_jobs.h"
+#include "acl/decompression/default_output_writer.h"
+#include "acl/decompression/key_frame_layout.h"
+
+#include <algorithm>
+#include <cstring>
+#include <stdexcept>
+#include <thread>
+#include <utility>
+#include <vector>
+
+//////////////////////////////////////////////////////////////////////////
+// Measures how fast compressed clips decompress, independently of how they were compressed.
+//
+// Compressed clips are produced with: acl_compressor -acl=<clip> -config=<config> -out=<compressed clip>
+// and benchmarked with: acl_decompressor -clip=<compressed clip> [-clip=<compressed clip> ...] [-stats=<output.sjson>]
+//
+// Every clip is decompressed with a warm and a cold CPU cache, in forward, backward,
+// and random playback order, with 'decompress_pose' and 'decompress_bone' as well as
+// with many instances playing back the same clip, on one thread and spread over
+// a pool of worker threads (-threads=<count>, all cores by default). Results are
+// written in SJSON to be tracked for regressions.
+//////////////////////////////////////////////////////////////////////////
+
+using namespace acl;
+using namespace acl::uniformly_sampled;
+
+struct Options
+{
+	std::vector<const char*>	input_filenames;
+	const char*					output_stats_filename;
+
+	uint32_t					num_passes;
+	uint32_t					num_instances;
+	uint32_t					num_threads;
+
+	bool						measure_warm_cache;
+	bool						measure_cold_cache;
+
+	//////////////////////////////////////////////////////////////////////////
+
+	Options()
+		: input_filenames()
+		, output_stats_filename(nullptr)
+		, num_passes(5)
+		, num_instances(64)
+		, num_threads(std::thread::hardware_concurrency())
+		, measure_warm_cache(true)
+		, measure_cold_cache(true)
+	{}
+};
+
+constexpr const char* k_input_file_option = "-clip=";
+constexpr const char* k_stats_output_option = "-stats=";
+constexpr const char* k_num_passes_option = "-passes=";
+constexpr const char* k_num_instances_option = "-instances=";
+constexpr const char* k_num_threads_option = "-threads=";
+constexpr const char* k_cache_option = "-cache=";
+
+enum class PlaybackOrder8 : uint8_t
+{
+	Forward,
+	Backward,
+	Random,
+};
+
+static const char* get_playback_order_name(PlaybackOrder8 order)
+{
+	switch (order)
+	{
+	case PlaybackOrder8::Forward:	return "forward";
+	case PlaybackOrder8::Backward:	return "backward";
+	case PlaybackOrder8::Random:	return "random";
+	default:						return "<Invalid>";
+	}
+}
+
+static bool parse_options(int argc, char** argv, Options& options)
+{
+	for (int arg_index = 1; arg_index < argc; ++arg_index)
+	{
+		const char* argument = argv[arg_index];
+
+		size_t option_length = std::strlen(k_input_file_option);
+		if (std::strncmp(argument, k_input_file_option, option_length) == 0)
+		{
+			options.input_filenames.push_back(argument + option_length);
+			continue;
+		}
+
+		option_length = std::strlen(k_stats_output_option);
+		if (std::strncmp(argument, k_stats_output_option, option_length) == 0)
+		{
+			options.output_stats_filename = argument + option_length;
+			size_t filename_len = std::strlen(options.output_stats_filename);
+			if (filename_len < 6 || strncmp(options.output_stats_filename + filename_len - 6, ".sjson", 6) != 0)
+			{
+				printf("Stats output file must be an SJSON file.\n");
+				return false;
+			}
+			continue;
+		}
+
+		option_length = std::strlen(k_num_passes_option);
+		if (std::strncmp(argument, k_num_passes_option, option_length) == 0)
+		{
+			options.num_passes = uint32_t(std::strtoul(argument + option_length, nullptr, 10));
+			if (options.num_passes == 0)
+			{
+				printf("At least one pass is required.\n");
+				return false;
+			}
+			continue;
+		}
+
+		option_length = std::strlen(k_num_instances_option);
+		if (std::strncmp(argument, k_num_instances_option, option_length) == 0)
+		{
+			options.num_instances = uint32_t(std::strtoul(argument + option_length, nullptr, 10));
+			if (options.num_instances == 0)
+			{
+				printf("At least one instance is required.\n");
+				return false;
+			}
+			continue;
+		}
+
+		option_length = std::strlen(k_num_threads_option);
+		if (std::strncmp(argument, k_num_threads_option, option_length) == 0)
+		{
+			options.num_threads = uint32_t(std::strtoul(argument + option_length, nullptr, 10));
+			if (options.num_threads == 0)
+			{
+				printf("At least one thread is required.\n");
+				return false;
+			}
+			continue;
+		}
+
+		option_length = std::strlen(k_cache_option);
+		if (std::strncmp(argument, k_cache_option, option_length) == 0)
+		{
+			const char* cache = argument + option_length;
+			options.measure_warm_cache = std::strcmp(cache, "warm") == 0 || std::strcmp(cache, "both") == 0;
+			options.measure_cold_cache = std::strcmp(cache, "cold") == 0 || std::strcmp(cache, "both") == 0;
+			if (!options.measure_warm_cache && !options.measure_cold_cache)
+			{
+				printf("Cache must be one of: warm, cold, both.\n");
+				return false;
+			}
+			continue;
+		}
+
+		printf("Unrecognized option %s\n", argument);
+		return false;
+	}
+
+	if (options.input_filenames.empty())
+	{
+		printf("An input file is required.\n");
+		return false;
+	}
+
+	return true;
+}
+
+// Holds a compressed clip read from disk, it is aligned as required by the decoder
+class CompressedClipFile
+{
+public:
+	explicit CompressedClipFile(IAllocator& allocator) : m_allocator(allocator), m_buffer(nullptr), m_size(0) {}
+
+	~CompressedClipFile()
+	{
+		if (m_buffer != nullptr)
+			deallocate_type_array(m_allocator, m_buffer, m_size);
+	}
+
+	CompressedClipFile(const CompressedClipFile&) = delete;
+	CompressedClipFile& operator=(const CompressedClipFile&) = delete;
+
+	bool read(const char* filename)
+	{
+		std::FILE* file = nullptr;
+#ifdef _WIN32
+		fopen_s(&file, filename, "rb");
+#else
+		file = fopen(filename, "rb");
+#endif
+		if (file == nullptr)
+			return false;
+
+		std::fseek(file, 0, SEEK_END);
+		const long file_size = std::ftell(file);
+		std::fseek(file, 0, SEEK_SET);
+
+		bool success = file_size >= long(sizeof(CompressedClip));
+		if (success)
+		{
+			m_size = size_t(file_size);
+			m_buffer = allocate_type_array_aligned<uint8_t>(m_allocator, m_size, alignof(CompressedClip));
+			success = std::fread(m_buffer, 1, m_size, file) == m_size;
+		}
+
+		std::fclose(file);
+
+		const CompressedClip* clip = get_clip();
+		return success && clip->get_size() == m_size && clip->is_valid(true) && clip->get_algorithm_type() == AlgorithmType8::UniformlySampled;
+	}
+
+	const CompressedClip* get_clip() const { return safe_ptr_cast<const CompressedClip>(m_buffer); }
+
+private:
+	IAllocator&		m_allocator;
+	uint8_t*		m_buffer;
+	size_t			m_size;
+};
+
+// Returns an upper bound of how many bytes of compressed data a pose touches: the clip wide data,
+// and for both key frames their segment data that precedes the animated data and their animated pose
+static uint32_t calculate_touched_bytes_upper_bound(const CompressedClip& clip, float sample_time)
+{
+	const ClipHeader& header = get_clip_header(clip);
+	const SegmentHeader* segment_headers = header.get_segment_headers();
+	const float clip_duration = float(header.num_samples - 1) / float(header.sample_rate);
+
+	uint32_t key_frames[2];
+	float interpolation_alpha;
+	calculate_interpolation_keys(header.num_samples, clip_duration, sample_time, key_frames[0], key_frames[1], interpolation_alpha);
+
+	uint32_t touched_bytes = get_resident_clip_size(clip);
+	uint16_t previous_segment_index = 0xFFFF;
+
+	for (uint32_t key_frame : key_frames)
+	{
+		uint16_t segment_index = 0;
+		while (segment_index + 1 < header.num_segments && segment_headers[segment_index + 1].clip_sample_offset <= key_frame)
+			segment_index++;
+
+		const SegmentHeader& segment_header = segment_headers[segment_index];
+		if (segment_index != previous_segment_index && segment_header.track_data_offset.is_valid())
+			touched_bytes += get_segment_data_size(clip, segment_index) - ((segment_header.num_samples * segment_header.animated_pose_bit_size) / 8);
+
+		touched_bytes += (segment_header.animated_pose_bit_size + 7) / 8;
+		previous_segment_index = segment_index;
+	}
+
+	return touched_bytes;
+}
+
+struct TouchedMemory
+{
+	double			bytes;
+	double			animated_cache_lines;					// With the key frame block size of the clip
+	double			pose_major_animated_cache_lines;		// With whole poses stored one after the other
+
+	TouchedMemory() : bytes(0.0), animated_cache_lines(0.0), pose_major_animated_cache_lines(0.0) {}
+};
+
+static void accumulate_touched_memory(const CompressedClip& clip, float sample_time, TouchedMemory& touched)
+{
+	const ClipHeader& header = get_clip_header(clip);
+	const float clip_duration = float(header.num_samples - 1) / float(header.sample_rate);
+
+	uint32_t key_frame0;
+	uint32_t key_frame1;
+	float interpolation_alpha;
+	calculate_interpolation_keys(header.num_samples, clip_duration, sample_time, key_frame0, key_frame1, interpolation_alpha);
+
+	touched.bytes += double(calculate_touched_bytes_upper_bound(clip, sample_time));
+	touched.animated_cache_lines += double(calculate_num_animated_touched_cache_lines(clip, key_frame0, key_frame1, header.key_frame_block_size));
+	touched.pose_major_animated_cache_lines += double(calculate_num_animated_touched_cache_lines(clip, key_frame0, key_frame1, 1));
+}
+
+static std::vector<float> get_sample_times(const CompressedClip& clip, PlaybackOrder8 order)
+{
+	const ClipHeader& header = get_clip_header(clip);
+	const uint32_t num_samples = header.num_samples;
+	const float clip_duration = float(num_samples - 1) / float(header.sample_rate);
+
+	std::vector<uint32_t> sample_indices(num_samples);
+	for (uint32_t sample_index = 0; sample_index < num_samples; ++sample_index)
+		sample_indices[sample_index] = order == PlaybackOrder8::Backward ? (num_samples - sample_index - 1) : sample_index;
+
+	if (order == PlaybackOrder8::Random)
+	{
+		// Shuffle with a fixed seed to keep the results reproducible
+		uint32_t seed = 0x9E3779B9;
+		for (uint32_t sample_index = num_samples - 1; sample_index > 0; --sample_index)
+		{
+			seed = seed * 1664525 + 1013904223;
+			const uint32_t swap_index = (seed >> 8) % (sample_index + 1);
+			std::swap(sample_indices[sample_index], sample_indices[swap_index]);
+		}
+	}
+
+	std::vector<float> sample_times(num_samples);
+	for (uint32_t sample_index = 0; sample_index < num_samples; ++sample_index)
+		sample_times[sample_index] = num_samples > 1 ? (clip_duration * float(sample_indices[sample_index]) / float(num_samples - 1)) : 0.0f;
+
+	return sample_times;
+}
+
+// Runs every step once per pass and returns the fastest pass in seconds. With a cold cache, the CPU
+// cache is flushed before every step and only the steps are timed. With a warm cache, we run once
+// before we start measuring.
+template<class StepFunction>
+static double measure_fastest_pass(const Options& options, Vector4_32* cache_flush_buffer, bool is_cold_cache, uint32_t num_steps, StepFunction step_function)
+{
+	if (!is_cold_cache)
+	{
+		for (uint32_t step_index = 0; step_index < num_steps; ++step_index)
+			step_function(step_index);
+	}
+
+	double fastest_pass_time = 0.0;
+	for (uint32_t pass_index = 0; pass_index < options.num_passes; ++pass_index)
+	{
+		double pass_time = 0.0;
+
+		if (is_cold_cache)
+		{
+			for (uint32_t step_index = 0; step_index < num_steps; ++step_index)
+			{
+				flush_cache(cache_flush_buffer);
+
+				ScopeProfiler timer;
+				step_function(step_index);
+				timer.stop();
+
+				pass_time += timer.get_elapsed_seconds();
+			}
+		}
+		else
+		{
+			ScopeProfiler timer;
+			for (uint32_t step_index = 0; step_index < num_steps; ++step_index)
+				step_function(step_index);
+			timer.stop();
+
+			pass_time = timer.get_elapsed_seconds();
+		}
+
+		if (pass_index == 0 || pass_time < fastest_pass_time)
+			fastest_pass_time = pass_time;
+	}
+
+	return fastest_pass_time;
+}
+
+struct RunDescription
+{
+	const char*		function_name;
+	PlaybackOrder8	order;
+	bool			is_cold_cache;
+	uint32_t		num_instances;
+	uint32_t		num_decompressions;			// Per pass
+	uint32_t		num_bones_per_decompression;
+	bool			is_pose;
+	TouchedMemory	touched;					// Per pass
+};
+
+static void write_run_stats(const RunDescription& run, double elapsed_seconds, sjson::ArrayWriter& writer)
+{
+	writer.push([&](sjson::ObjectWriter& writer)
+	{
+		const double elapsed_ns = elapsed_seconds * 1.0e9;
+		const double num_bones = double(run.num_decompressions) * double(run.num_bones_per_decompression);
+
+		writer["function"] = run.function_name;
+		writer["playback"] = get_playback_order_name(run.order);
+		writer["cache"] = run.is_cold_cache ? "cold" : "warm";
+		writer["num_instances"] = run.num_instances;
+		writer["num_decompressions"] = run.num_decompressions;
+		writer["num_bones_per_decompression"] = run.num_bones_per_decompression;
+		writer["total_time_ms"] = elapsed_seconds * 1.0e3;
+		writer["ns_per_decompression"] = elapsed_ns / double(run.num_decompressions);
+		writer["ns_per_bone"] = elapsed_ns / num_bones;
+		writer["decompressions_per_second"] = double(run.num_decompressions) / elapsed_seconds;
+
+		if (run.is_pose)
+			writer["poses_per_second"] = double(run.num_decompressions) / elapsed_seconds;
+
+		writer["touched_bytes_per_decompression"] = run.touched.bytes / double(run.num_decompressions);
+
+		// Only a pose touches the animated data of every track
+		if (run.is_pose)
+		{
+			writer["animated_touched_cache_lines_per_decompression"] = run.touched.animated_cache_lines / double(run.num_decompressions);
+			writer["touched_cache_lines_delta_per_decompression"] = (run.touched.animated_cache_lines - run.touched.pose_major_animated_cache_lines) / double(run.num_decompressions);
+		}
+	});
+}
+
+static void benchmark_clip(const Options& options, IAllocator& allocator, IJobExecutor& executor, const CompressedClip& clip, Vector4_32* cache_flush_buffer, sjson::ArrayWriter& writer)
+{
+	const ClipHeader& header = get_clip_header(clip);
+	const uint16_t num_bones = header.num_bones;
+	const uint32_t num_samples = header.num_samples;
+
+	DecompressionSettings settings;
+
+	std::vector<Transform_32> pose_transforms(size_t(num_bones) * options.num_instances);
+	std::vector<DefaultOutputWriter> pose_writers;
+	pose_writers.reserve(options.num_instances);
+	for (uint32_t instance_index = 0; instance_index < options.num_instances; ++instance_index)
+		pose_writers.emplace_back(&pose_transforms[size_t(instance_index) * num_bones], num_bones);
+
+	std::vector<void*> contexts(options.num_instances);
+	for (void*& context : contexts)
+		context = allocate_decompression_context(allocator, settings, clip);
+
+	const uint32_t key_frame_cache_size = get_key_frame_cache_size(clip);
+	Vector4_32* key_frame_cache = allocate_type_array<Vector4_32>(allocator, key_frame_cache_size / sizeof(Vector4_32));
+
+	PoolAllocator instance_context_allocator(allocator, get_instance_decompression_context_size(), get_instance_decompression_context_alignment());
+	void* shared_context = allocate_shared_decompression_context(allocator, settings, clip);
+	std::vector<void*> instance_contexts(options.num_instances);
+	for (void*& instance_context : instance_contexts)
+		instance_context = allocate_instance_decompression_context(instance_context_allocator);
+
+	const PlaybackOrder8 orders[] = { PlaybackOrder8::Forward, PlaybackOrder8::Backward, PlaybackOrder8::Random };
+	const bool cache_states[] = { false, true };
+
+	for (bool is_cold_cache : cache_states)
+	{
+		if ((is_cold_cache && !options.measure_cold_cache) || (!is_cold_cache && !options.measure_warm_cache))
+			continue;
+
+		for (PlaybackOrder8 order : orders)
+		{
+			const std::vector<float> sample_times = get_sample_times(clip, order);
+
+			TouchedMemory touched;
+			for (float sample_time : sample_times)
+				accumulate_touched_memory(clip, sample_time, touched);
+
+			{
+				void* context = contexts[0];
+				DefaultOutputWriter& pose_writer = pose_writers[0];
+				const double elapsed_seconds = measure_fastest_pass(options, cache_flush_buffer, is_cold_cache, num_samples,
+					[&](uint32_t step_index) { decompress_pose(settings, clip, context, sample_times[step_index], pose_writer); });
+
+				const RunDescription run = { "decompress_pose", order, is_cold_cache, 1, num_samples, num_bones, true, touched };
+				write_run_stats(run, elapsed_seconds, writer);
+			}
+
+			{
+				void* context = contexts[0];
+				DefaultOutputWriter& pose_writer = pose_writers[0];
+				set_key_frame_cache(context, key_frame_cache, key_frame_cache_size);
+
+				const double elapsed_seconds = measure_fastest_pass(options, cache_flush_buffer, is_cold_cache, num_samples,
+					[&](uint32_t step_index) { decompress_pose(settings, clip, context, sample_times[step_index], pose_writer); });
+
+				set_key_frame_cache(context, nullptr, 0);
+
+				const RunDescription run = { "decompress_pose_key_frame_cache", order, is_cold_cache, 1, num_samples, num_bones, true, touched };
+				write_run_stats(run, elapsed_seconds, writer);
+			}
+
+			{
+				// The last bone is the worst case when we skip the bones that precede it
+				void* context = contexts[0];
+				const uint16_t sample_bone_index = num_bones - 1;
+				const double elapsed_seconds = measure_fastest_pass(options, cache_flush_buffer, is_cold_cache, num_samples,
+					[&](uint32_t step_index)
+					{
+						Quat_32 rotation;
+						Vector4_32 translation;
+						Vector4_32 scale;
+						decompress_bone(settings, clip, context, sample_times[step_index], sample_bone_index, &rotation, &translation, &scale);
+					});
+
+				const RunDescription run = { "decompress_bone", order, is_cold_cache, 1, num_samples, 1, false, touched };
+				write_run_stats(run, elapsed_seconds, writer);
+			}
+		}
+
+		// Many instances play back the same clip forward, each with its own offset in the clip
+		const std::vector<float> sample_times = get_sample_times(clip, PlaybackOrder8::Forward);
+		const uint32_t num_instances = options.num_instances;
+		const uint32_t num_decompressions = num_samples * num_instances;
+
+		auto get_instance_sample_time = [&](uint32_t step_index, uint32_t instance_index)
+		{
+			return sample_times[(step_index + ((instance_index * num_samples) / num_instances)) % num_samples];
+		};
+
+		TouchedMemory touched;
+		for (uint32_t step_index = 0; step_index < num_samples; ++step_index)
+		{
+			for (uint32_t instance_index = 0; instance_index < num_instances; ++instance_index)
+				accumulate_touched_memory(clip, get_instance_sample_time(step_index, instance_index), touched);
+		}
+
+		{
+			const double elapsed_seconds = measure_fastest_pass(options, cache_flush_buffer, is_cold_cache, num_samples,
+				[&](uint32_t step_index)
+				{
+					for (uint32_t instance_index = 0; instance_index < num_instances; ++instance_index)
+						decompress_pose(settings, clip, contexts[instance_index], get_instance_sample_time(step_index, instance_index), pose_writers[instance_index]);
+				});
+
+			const RunDescription run = { "decompress_pose", PlaybackOrder8::Forward, is_cold_cache, num_instances, num_decompressions, num_bones, true, touched };
+			write_run_stats(run, elapsed_seconds, writer);
+		}
+
+		{
+			std::vector<DecompressionInstance<DefaultOutputWriter>> instances(num_instances);
+			for (uint32_t instance_index = 0; instance_index < num_instances; ++instance_index)
+			{
+				instances[instance_index].context = contexts[instance_index];
+				instances[instance_index].writer = &pose_writers[instance_index];
+			}
+
+			const double elapsed_seconds = measure_fastest_pass(options, cache_flush_buffer, is_cold_cache, num_samples,
+				[&](uint32_t step_index)
+				{
+					for (uint32_t instance_index = 0; instance_index < num_instances; ++instance_index)
+						instances[instance_index].sample_time = get_instance_sample_time(step_index, instance_index);
+
+					decompress_poses(settings, clip, instances.data(), num_instances);
+				});
+
+			const RunDescription run = { "decompress_poses", PlaybackOrder8::Forward, is_cold_cache, num_instances, num_decompressions, num_bones, true, touched };
+			write_run_stats(run, elapsed_seconds, writer);
+		}
+
+		{
+			const double elapsed_seconds = measure_fastest_pass(options, cache_flush_buffer, is_cold_cache, num_samples,
+				[&](uint32_t step_index)
+				{
+					for (uint32_t instance_index = 0; instance_index < num_instances; ++instance_index)
+						decompress_pose(settings, clip, shared_context, instance_contexts[instance_index], get_instance_sample_time(step_index, instance_index), pose_writers[instance_index]);
+				});
+
+			const RunDescription run = { "decompress_pose_shared", PlaybackOrder8::Forward, is_cold_cache, num_instances, num_decompressions, num_bones, true, touched };
+			write_run_stats(run, elapsed_seconds, writer);
+		}
+
+		{
+			std::vector<DecompressionRequest<DefaultOutputWriter>> requests(num_instances);
+			for (uint32_t instance_index = 0; instance_index < num_instances; ++instance_index)
+			{
+				requests[instance_index].clip = &clip;
+				requests[instance_index].context = contexts[instance_index];
+				requests[instance_index].writer = &pose_writers[instance_index];
+			}
+
+			const double elapsed_seconds = measure_fastest_pass(options, cache_flush_buffer, is_cold_cache, num_samples,
+				[&](uint32_t step_index)
+				{
+					for (uint32_t instance_index = 0; instance_index < num_instances; ++instance_index)
+						requests[instance_index].sample_time = get_instance_sample_time(step_index, instance_index);
+
+					decompress_poses(allocator, executor, settings, requests.data(), num_instances);
+				});
+
+			const RunDescription run = { "decompress_poses_parallel", PlaybackOrder8::Forward, is_cold_cache, num_instances, num_decompressions, num_bones, true, touched };
+			write_run_stats(run, elapsed_seconds, writer);
+		}
+	}
+
+	for (void* instance_context : instance_contexts)
+		deallocate_instance_decompression_context(instance_context_allocator, instance_context);
+	deallocate_shared_decompression_context(allocator, shared_context);
+
+	for (void* context : contexts)
+		deallocate_decompression_context(allocator, context);
+
+	deallocate_type_array(allocator, key_frame_cache, key_frame_cache_size / sizeof(Vector4_32));
+}
+
+static int safe_main_impl(int argc, char* argv[])
+{
+	Options options;
+
+	if (!parse_options(argc, argv, options))
+		return -1;
+
+	std::FILE* output_stats_file = stdout;
+	if (options.output_stats_filename != nullptr)
+	{
+#ifdef _WIN32
+		fopen_s(&output_stats_file, options.output_stats_filename, "w");
+#else
+		output_stats_file = fopen(options.output_stats_filename, "w");
+#endif
+		if (output_stats_file == nullptr)
+		{
+			printf("Failed to open stats output file: %s\n", options.output_stats_filename);
+			return -1;
+		}
+	}
+
+	ANSIAllocator allocator;
+	Vector4_32* cache_flush_buffer = allocate_cache_flush_buffer(allocator);
+	ThreadJobExecutor executor(options.num_threads);
+	int result = 0;
+
+	{
+		sjson::FileStreamWriter stream_writer(output_stats_file);
+		sjson::Writer writer(stream_writer);
+
+		writer["version"] = 1;
+		writer["num_passes"] = options.num_passes;
+		writer["num_threads"] = executor.get_num_threads();
+		writer["clips"] = [&](sjson::ArrayWriter& writer)
+		{
+			for (const char* input_filename : options.input_filenames)
+			{
+				CompressedClipFile clip_file(allocator);
+				if (!clip_file.read(input_filename))
+				{
+					printf("Failed to read compressed clip: %s\n", input_filename);
+					result = -1;
+					continue;
+				}
+
+				const CompressedClip& clip = *clip_file.get_clip();
+				const ClipHeader& header = get_clip_header(clip);
+
+				writer.push([&](sjson::ObjectWriter& writer)
+				{
+					writer["filename"] = input_filename;
+					writer["size"] = clip.get_size();
+					writer["num_bones"] = header.num_bones;
+					writer["num_samples"] = header.num_samples;
+					writer["num_segments"] = header.num_segments;
+					writer["sample_rate"] = header.sample_rate;
+					writer["key_frame_block_size"] = header.key_frame_block_size;
+					writer["context_memory"] = [&](sjson::ObjectWriter& writer)
+					{
+						// Every instance owns a full context or they all share one and only own their playback state
+						const size_t full_contexts_size = get_decompression_context_size() * options.num_instances;
+						const size_t shared_contexts_size = get_shared_decompression_context_size() + (get_instance_decompression_context_size() * options.num_instances);
+						writer["num_instances"] = options.num_instances;
+						writer["full_contexts_size"] = uint32_t(full_contexts_size);
+						writer["shared_contexts_size"] = uint32_t(shared_contexts_size);
+						writer["saved_size"] = uint32_t(full_contexts_size - shared_contexts_size);
+					};
+					writer["runs"] = [&](sjson::ArrayWriter& writer) { benchmark_clip(options, allocator, executor, clip, cache_flush_buffer, writer); };
+				});
+			}
+		};
+	}
+
+	deallocate_cache_flush_buffer(allocator, cache_flush_buffer);
+
+	if (output_stats_file != stdout)
+		std::fclose(output_stats_file);
+
+	return result;
+}
+
+int main_impl(int argc, char* argv[])
+{
+	int result = -1;
+	try
+	{
+		result = safe_main_impl(argc, argv);
+	}
+	catch (const std::runtime_error& exception)
+	{
+		printf("Exception occurred: %s", exception.what());
+		result = -1;
+	}
+	catch (...)
+	{
+		printf("Unknown exception occurred");
+		result = -1;
+	}
+
+	return result;
+}